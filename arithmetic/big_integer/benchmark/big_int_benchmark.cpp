@@ -0,0 +1,221 @@
+#include <big_int.h>
+#include <fraction.h>
+
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+// an operation whose last run took longer than this is not timed on larger operands
+constexpr double size_cutoff_ms = 1000;
+
+// each measurement repeats the operation until this much time has passed
+constexpr double measure_budget_ms = 20;
+
+big_int random_big_int(size_t limbs, std::mt19937 &gen)
+{
+    std::vector<unsigned int> words(limbs * sizeof(big_int::value_type) / sizeof(unsigned int));
+    for (auto &word : words)
+    {
+        word = gen();
+    }
+    words.back() |= 1u << 31;
+
+    return big_int(words);
+}
+
+double measure_us(std::function<void()> const &f)
+{
+    size_t repeats = 0;
+    auto start = std::chrono::steady_clock::now();
+    double elapsed_ms = 0;
+    do
+    {
+        f();
+        ++repeats;
+        elapsed_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    } while (elapsed_ms < measure_budget_ms);
+
+    return elapsed_ms * 1000 / static_cast<double>(repeats);
+}
+
+std::string format_us(double us)
+{
+    std::ostringstream stream;
+    stream << std::fixed << std::setprecision(us < 10 ? 3 : us < 1000 ? 1 : 0) << us;
+    return stream.str();
+}
+
+struct operation
+{
+    std::string name;
+    std::function<void(big_int const &, big_int const &, std::string const &)> run;
+    bool skipped = false;
+};
+
+void operations_table(std::mt19937 &gen)
+{
+    big_int sink;
+    std::string text;
+
+    std::vector<operation> operations{
+        { "add", [&](auto &a, auto &b, auto &) { sink = a + b; } },
+        { "sub", [&](auto &a, auto &b, auto &) { sink = a - b; } },
+        { "mul", [&](auto &a, auto &b, auto &) { sink = a * b; } },
+        { "sqr", [&](auto &a, auto &, auto &) { sink = a.square(); } },
+        { "div 2n/n", [&](auto &a, auto &b, auto &) { sink = a * a / b; } },
+        { "mod 2n/n", [&](auto &a, auto &b, auto &) { sink = a * a % b; } },
+        { "and", [&](auto &a, auto &b, auto &) { sink = a & b; } },
+        { "xor", [&](auto &a, auto &b, auto &) { sink = a ^ b; } },
+        { "shl 37", [&](auto &a, auto &, auto &) { sink = a << 37; } },
+        { "shr 37", [&](auto &a, auto &, auto &) { sink = a >> 37; } },
+        { "to_string", [&](auto &a, auto &, auto &) { text = a.to_string(); } },
+        { "parse", [&](auto &, auto &, auto &s) { sink = big_int(s); } },
+    };
+
+    std::cout << "big_int operations, us per call (div and mod include the 2n-limb square of the dividend)" << std::endl;
+    std::cout << std::setw(10) << "limbs";
+    for (auto const &op : operations)
+    {
+        std::cout << std::setw(12) << op.name;
+    }
+    std::cout << std::endl;
+
+    for (size_t limbs : {1, 4, 16, 64, 256, 1024, 4096, 16384, 65536, 262144, 1048576})
+    {
+        big_int a = random_big_int(limbs, gen);
+        big_int b = random_big_int(limbs, gen);
+        bool need_text = false;
+        for (auto const &op : operations)
+        {
+            need_text |= op.name == "parse" && !op.skipped;
+        }
+        std::string decimal = need_text ? a.to_string() : std::string();
+
+        std::cout << std::setw(10) << limbs;
+        for (auto &op : operations)
+        {
+            if (op.skipped)
+            {
+                std::cout << std::setw(12) << "-";
+                continue;
+            }
+
+            double us = measure_us([&] { op.run(a, b, decimal); });
+            op.skipped = us > size_cutoff_ms * 1000;
+            std::cout << std::setw(12) << format_us(us) << std::flush;
+        }
+        std::cout << std::endl;
+    }
+    std::cout << std::endl;
+}
+
+/** Times schoolbook against Karatsuba products of equal sizes. Below the compiled threshold both rules run the
+ *  same kernel, so the crossover can only be located at or above it
+ */
+void multiplication_crossover(std::mt19937 &gen)
+{
+    std::cout << "multiplication crossover (decide_mult), us per product" << std::endl;
+    std::cout << std::setw(10) << "limbs" << std::setw(14) << "schoolbook" << std::setw(14) << "Karatsuba"
+              << std::setw(10) << "ratio" << std::endl;
+
+    size_t crossover = 0;
+    for (size_t limbs : {8, 12, 16, 24, 32, 40, 48, 64, 80, 96, 128, 192, 256, 384, 512})
+    {
+        big_int a = random_big_int(limbs, gen);
+        big_int b = random_big_int(limbs, gen);
+        big_int product;
+
+        double schoolbook = measure_us([&] { product = a; product.multiply_assign(b, big_int::multiplication_rule::trivial); });
+        double karatsuba = measure_us([&] { product = a; product.multiply_assign(b, big_int::multiplication_rule::Karatsuba); });
+
+        std::cout << std::setw(10) << limbs << std::setw(14) << format_us(schoolbook) << std::setw(14)
+                  << format_us(karatsuba) << std::setw(10) << std::fixed << std::setprecision(2)
+                  << schoolbook / karatsuba << std::endl;
+
+        if (karatsuba < schoolbook * 0.97)
+        {
+            if (crossover == 0)
+            {
+                crossover = limbs;
+            }
+        }
+        else
+        {
+            crossover = 0;
+        }
+    }
+
+    std::cout << "compiled karatsuba threshold: " << MP_OS_BIG_INT_KARATSUBA_THRESHOLD << " limbs" << std::endl;
+    if (crossover == 0)
+    {
+        std::cout << "Karatsuba does not stay ahead in the measured range, raise the threshold above 512 limbs" << std::endl;
+    }
+    else
+    {
+        std::cout << "suggested: -DMP_OS_BIG_INT_KARATSUBA_THRESHOLD=" << crossover;
+        if (crossover <= MP_OS_BIG_INT_KARATSUBA_THRESHOLD)
+        {
+            std::cout << " (already ahead at the compiled threshold, rebuild with a lower one to look further down)";
+        }
+        std::cout << std::endl;
+    }
+    std::cout << "decide_div: only Knuth division is implemented, there is no crossover to tune" << std::endl << std::endl;
+}
+
+void fraction_table()
+{
+    std::cout << "fraction functions, us per call" << std::endl;
+    std::cout << std::setw(10) << "digits";
+    for (auto name : {"sin", "cos", "tg", "arctg", "ln", "lg", "root 3"})
+    {
+        std::cout << std::setw(12) << name;
+    }
+    std::cout << std::endl;
+
+    fraction x(big_int(123456789), big_int(100000000));
+    for (size_t digits : {10, 100, 1000})
+    {
+        fraction epsilon(big_int(1), big_int("1" + std::string(digits, '0')));
+        fraction sink;
+
+        std::vector<std::function<void()>> functions{
+            [&] { sink = x.sin(epsilon); },
+            [&] { sink = x.cos(epsilon); },
+            [&] { sink = x.tg(epsilon); },
+            [&] { sink = x.arctg(epsilon); },
+            [&] { sink = x.ln(epsilon); },
+            [&] { sink = x.lg(epsilon); },
+            [&] { sink = x.root(3, epsilon); },
+        };
+
+        std::cout << std::setw(10) << digits;
+        for (auto const &f : functions)
+        {
+            std::cout << std::setw(12) << format_us(measure_us(f)) << std::flush;
+        }
+        std::cout << std::endl;
+    }
+}
+
+}
+
+int main()
+{
+    std::mt19937 gen(42);
+
+    std::cout << "big_int limb width: " << sizeof(big_int::value_type) * 8 << " bits" << std::endl << std::endl;
+
+    multiplication_crossover(gen);
+    operations_table(gen);
+    fraction_table();
+
+    return 0;
+}
@@ -0,0 +1,92 @@
+#include <big_int.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+big_int random_big_int(size_t bits, std::mt19937 &gen)
+{
+    std::vector<unsigned int> words((bits + 31) / 32);
+    for (auto &word : words)
+    {
+        word = gen();
+    }
+    words.back() |= 1u << 31;
+
+    return big_int(words);
+}
+
+template<typename F>
+double measure_ms(size_t repeats, F &&f)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < repeats; ++i)
+    {
+        f();
+    }
+    auto finish = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double, std::milli>(finish - start).count() / static_cast<double>(repeats);
+}
+
+}
+
+int main()
+{
+    std::mt19937 gen(42);
+
+    size_t max_threads = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<size_t> thread_counts;
+    for (size_t threads = 1; threads < max_threads; threads *= 2)
+    {
+        thread_counts.push_back(threads);
+    }
+    thread_counts.push_back(max_threads);
+
+    std::cout << "big_int limb width: " << sizeof(big_int::value_type) * 8 << " bits" << std::endl;
+    std::cout << std::setw(10) << "bits" << std::setw(10) << "threads"
+              << std::setw(14) << "mul, ms" << std::setw(10) << "speedup" << std::endl;
+
+    for (size_t bits : {262144, 1048576, 4194304})
+    {
+        big_int a = random_big_int(bits, gen);
+        big_int b = random_big_int(bits, gen);
+        size_t repeats = bits >= 4194304 ? 1 : 3;
+
+        big_int expected = a * b;
+        double serial = 0;
+
+        for (size_t threads : thread_counts)
+        {
+            big_int::set_parallel_multiplication(threads);
+
+            big_int sink;
+            double mul = measure_ms(repeats, [&] { sink = a * b; });
+            if (threads == 1)
+            {
+                serial = mul;
+            }
+
+            std::cout << std::setw(10) << bits << std::setw(10) << threads
+                      << std::setw(14) << std::fixed << std::setprecision(2) << mul
+                      << std::setw(10) << serial / mul << std::endl;
+
+            if (sink != expected)
+            {
+                std::cout << "parallel product differs from the serial one" << std::endl;
+                return 1;
+            }
+        }
+    }
+
+    big_int::set_parallel_multiplication(1);
+
+    return 0;
+}
@@ -8,22 +8,72 @@
 #include <not_implemented.h>
 #include <pp_allocator.h>
 
+#include <algorithm>
+#include <compare>
 #include <concepts>
+#include <cstdint>
 #include <iostream>
+#include <stdexcept>
+#include <string_view>
 #include <utility>
 #include <vector>
 
-namespace __detail {
-constexpr unsigned int generate_half_mask() {
-	unsigned int res = 0;
+#if defined(MP_OS_BIG_INT_64BIT_LIMBS) && (defined(__x86_64__) || defined(_M_X64))
+#include <immintrin.h>
+#endif
 
-	for (size_t i = 0; i < sizeof(unsigned int) * 4; ++i) {
-		res |= (1u << i);
+namespace __detail {
+#ifdef MP_OS_BIG_INT_64BIT_LIMBS
+#ifndef __SIZEOF_INT128__
+#error "MP_OS_BIG_INT_64BIT_LIMBS requires compiler support for unsigned __int128"
+#endif
+using limb_type = unsigned long long;
+using double_limb_type = unsigned __int128;
+#else
+using limb_type = unsigned int;
+using double_limb_type = unsigned long long;
+#endif
+
+constexpr size_t limb_bits = sizeof(limb_type) * 8;
+
+constexpr limb_type generate_half_mask() {
+	limb_type res = 0;
+
+	for (size_t i = 0; i < sizeof(limb_type) * 4; ++i) {
+		res |= (limb_type(1) << i);
 	}
 
 	return res;
 }
 
+/** Returns a + b + carry, carry is updated to the outgoing carry bit
+ */
+inline limb_type add_with_carry(limb_type a, limb_type b, unsigned char &carry) noexcept {
+#if defined(MP_OS_BIG_INT_64BIT_LIMBS) && (defined(__x86_64__) || defined(_M_X64))
+	unsigned long long res;
+	carry = _addcarry_u64(carry, a, b, &res);
+	return res;
+#else
+	double_limb_type sum = static_cast<double_limb_type>(a) + b + carry;
+	carry = static_cast<unsigned char>(sum >> limb_bits);
+	return static_cast<limb_type>(sum);
+#endif
+}
+
+/** Returns a - b - borrow, borrow is updated to the outgoing borrow bit
+ */
+inline limb_type sub_with_borrow(limb_type a, limb_type b, unsigned char &borrow) noexcept {
+#if defined(MP_OS_BIG_INT_64BIT_LIMBS) && (defined(__x86_64__) || defined(_M_X64))
+	unsigned long long res;
+	borrow = _subborrow_u64(borrow, a, b, &res);
+	return res;
+#else
+	double_limb_type diff = static_cast<double_limb_type>(a) - b - borrow;
+	borrow = static_cast<unsigned char>((diff >> limb_bits) & 1);
+	return static_cast<limb_type>(diff);
+#endif
+}
+
 constexpr size_t nearest_greater_power_of_2(size_t size) noexcept {
 	int ones_counter = 0, index = -1;
 
@@ -38,14 +88,238 @@ constexpr size_t nearest_greater_power_of_2(size_t size) noexcept {
 
 	return ones_counter <= 1 ? (1u << index) : (1u << (index + 1));
 }
+
+struct big_int_expression_tag {};
+
+template <class E>
+concept big_int_expression = std::derived_from<std::remove_cvref_t<E>, big_int_expression_tag>;
+
+struct big_int_ref;
+}  // namespace __detail
+
+/** Big integer of at most Limbs limbs with no heap storage, usable in constant expressions.
+ *  Literals and precomputed tables are built at compile time and copied into a big_int with a single
+ *  allocation. Overflowing the capacity throws std::overflow_error, which is a compile error in constant evaluation
+ */
+template <size_t Limbs>
+class fixed_big_int {
+	static_assert(Limbs > 0, "fixed_big_int needs at least one limb");
+
+   public:
+	using value_type = __detail::limb_type;
+
+   private:
+	value_type _digits[Limbs]{};
+	size_t _size = 1;
+	bool _sign = true;  // 1 +  0 -
+
+	constexpr void remove_leading_zeros() noexcept {
+		while (_size > 1 && _digits[_size - 1] == 0) --_size;
+		if (_size == 1 && _digits[0] == 0) _sign = true;
+	}
+
+	constexpr int compare_magnitude(const fixed_big_int &other) const noexcept {
+		if (_size != other._size) return _size < other._size ? -1 : 1;
+		for (size_t i = _size; i-- > 0;) {
+			if (_digits[i] != other._digits[i]) return _digits[i] < other._digits[i] ? -1 : 1;
+		}
+		return 0;
+	}
+
+	/** |this| += |other| if add, otherwise |this| = ||this| - |other||, the sign follows the larger operand
+	 */
+	constexpr void add_magnitude(const fixed_big_int &other, bool add, bool other_sign) {
+		if (add) {
+			value_type carry = 0;
+			size_t n = std::max(_size, other._size);
+			for (size_t i = 0; i < n; ++i) {
+				__detail::double_limb_type sum = static_cast<__detail::double_limb_type>(i < _size ? _digits[i] : 0) +
+				                                 (i < other._size ? other._digits[i] : 0) + carry;
+				_digits[i] = static_cast<value_type>(sum);
+				carry = static_cast<value_type>(sum >> __detail::limb_bits);
+			}
+			_size = n;
+			if (carry) push_limb(carry);
+			return;
+		}
+
+		const bool swap = compare_magnitude(other) < 0;
+		const fixed_big_int &larger = swap ? other : *this;
+		const fixed_big_int &smaller = swap ? *this : other;
+		value_type borrow = 0;
+		value_type result[Limbs]{};
+		for (size_t i = 0; i < larger._size; ++i) {
+			value_type b = i < smaller._size ? smaller._digits[i] : 0;
+			value_type diff = larger._digits[i] - b - borrow;
+			borrow = (larger._digits[i] < b || (larger._digits[i] == b && borrow)) ? 1 : 0;
+			result[i] = diff;
+		}
+		_size = larger._size;
+		for (size_t i = 0; i < Limbs; ++i) _digits[i] = result[i];
+		if (swap) _sign = other_sign;
+		remove_leading_zeros();
+	}
+
+	constexpr void push_limb(value_type limb) {
+		if (_size == Limbs) throw std::overflow_error("fixed_big_int capacity exceeded");
+		_digits[_size++] = limb;
+	}
+
+   public:
+	constexpr fixed_big_int() noexcept = default;
+
+	template <std::integral Num>
+	constexpr fixed_big_int(Num d) : _sign(d >= 0 || std::is_unsigned_v<Num>) {
+		using Unsigned = std::make_unsigned_t<Num>;
+		Unsigned abs_val = _sign ? static_cast<Unsigned>(d) : static_cast<Unsigned>(Unsigned(0) - static_cast<Unsigned>(d));
+
+		_digits[0] = static_cast<value_type>(abs_val);
+		if constexpr (sizeof(Unsigned) > sizeof(value_type)) {
+			for (abs_val >>= __detail::limb_bits; abs_val != 0; abs_val >>= __detail::limb_bits) {
+				push_limb(static_cast<value_type>(abs_val));
+			}
+		}
+	}
+
+	/** Optional '-' followed by digits of radix 2..36, digit separators ' are skipped
+	 */
+	constexpr explicit fixed_big_int(std::string_view num, unsigned int radix = 10) {
+		if (radix < 2 || radix > 36) throw std::invalid_argument("Radix must be between 2 and 36");
+
+		size_t start = !num.empty() && num[0] == '-' ? 1 : 0;
+		if (start == num.size()) throw std::invalid_argument("Number string is too short.");
+
+		for (char ch : num.substr(start)) {
+			if (ch == '\'') continue;
+
+			unsigned int digit = ch >= '0' && ch <= '9'   ? ch - '0'
+			                     : ch >= 'a' && ch <= 'z' ? ch - 'a' + 10
+			                     : ch >= 'A' && ch <= 'Z' ? ch - 'A' + 10
+			                                              : radix;
+			if (digit >= radix) throw std::invalid_argument("Invalid characters for the given radix.");
+			multiply_add(radix, digit);
+		}
+
+		_sign = start == 0;
+		remove_leading_zeros();
+	}
+
+	/** |this| = |this| * factor + addend
+	 */
+	constexpr fixed_big_int &multiply_add(value_type factor, value_type addend) {
+		value_type carry = addend;
+		for (size_t i = 0; i < _size; ++i) {
+			__detail::double_limb_type product = static_cast<__detail::double_limb_type>(_digits[i]) * factor + carry;
+			_digits[i] = static_cast<value_type>(product);
+			carry = static_cast<value_type>(product >> __detail::limb_bits);
+		}
+		if (carry) push_limb(carry);
+		remove_leading_zeros();
+		return *this;
+	}
+
+	constexpr fixed_big_int &operator+=(const fixed_big_int &other) {
+		add_magnitude(other, _sign == other._sign, other._sign);
+		return *this;
+	}
+
+	constexpr fixed_big_int &operator-=(const fixed_big_int &other) {
+		add_magnitude(other, _sign != other._sign, !other._sign);
+		return *this;
+	}
+
+	constexpr fixed_big_int &operator*=(const fixed_big_int &other) {
+		value_type result[Limbs]{};
+		size_t size = 1;
+		for (size_t i = 0; i < _size; ++i) {
+			value_type carry = 0;
+			for (size_t j = 0; j < other._size; ++j) {
+				__detail::double_limb_type product =
+				    static_cast<__detail::double_limb_type>(_digits[i]) * other._digits[j] + carry;
+				if (i + j < Limbs) {
+					product += result[i + j];
+					result[i + j] = static_cast<value_type>(product);
+					size = std::max(size, i + j + 1);
+				} else if (static_cast<value_type>(product) != 0) {
+					throw std::overflow_error("fixed_big_int capacity exceeded");
+				}
+				carry = static_cast<value_type>(product >> __detail::limb_bits);
+			}
+			if (carry) {
+				if (i + other._size >= Limbs) throw std::overflow_error("fixed_big_int capacity exceeded");
+				result[i + other._size] = carry;
+				size = std::max(size, i + other._size + 1);
+			}
+		}
+
+		for (size_t i = 0; i < Limbs; ++i) _digits[i] = result[i];
+		_size = size;
+		_sign = _sign == other._sign;
+		remove_leading_zeros();
+		return *this;
+	}
+
+	constexpr fixed_big_int operator+(const fixed_big_int &other) const { return fixed_big_int(*this) += other; }
+	constexpr fixed_big_int operator-(const fixed_big_int &other) const { return fixed_big_int(*this) -= other; }
+	constexpr fixed_big_int operator*(const fixed_big_int &other) const { return fixed_big_int(*this) *= other; }
+
+	constexpr fixed_big_int operator-() const noexcept {
+		fixed_big_int result(*this);
+		result._sign = !_sign;
+		result.remove_leading_zeros();
+		return result;
+	}
+
+	constexpr std::strong_ordering operator<=>(const fixed_big_int &other) const noexcept {
+		if (_sign != other._sign) return _sign ? std::strong_ordering::greater : std::strong_ordering::less;
+		int cmp = _sign ? compare_magnitude(other) : other.compare_magnitude(*this);
+		return cmp < 0 ? std::strong_ordering::less : cmp > 0 ? std::strong_ordering::greater : std::strong_ordering::equal;
+	}
+
+	constexpr bool operator==(const fixed_big_int &other) const noexcept {
+		return (*this <=> other) == std::strong_ordering::equal;
+	}
+
+	constexpr bool is_negative() const noexcept { return !_sign; }
+
+	/** Limbs of the magnitude, little-endian, without leading zeros
+	 */
+	constexpr const value_type *data() const noexcept { return _digits; }
+
+	constexpr size_t size() const noexcept { return _size; }
+};
+
+namespace __detail {
+template <char... Chars>
+constexpr char literal_text[] = {Chars...};
+
+/** Parses the characters of an integer literal: decimal, 0x hexadecimal, 0b binary or 0 octal
+ */
+template <char... Chars>
+consteval auto parse_big_int_literal() {
+	constexpr std::string_view literal(literal_text<Chars...>, sizeof...(Chars));
+
+	constexpr bool prefixed = literal.size() > 2 && literal[0] == '0';
+	constexpr unsigned int radix = prefixed && (literal[1] == 'x' || literal[1] == 'X')   ? 16
+	                               : prefixed && (literal[1] == 'b' || literal[1] == 'B') ? 2
+	                               : literal.size() > 1 && literal[0] == '0'              ? 8
+	                                                                                      : 10;
+	constexpr std::string_view digits = radix == 16 || radix == 2 ? literal.substr(2) : literal;
+
+	// no digit of radix <= 16 carries more than 4 bits
+	return fixed_big_int<(digits.size() * 4 + limb_bits - 1) / limb_bits>(digits, radix);
+}
 }  // namespace __detail
 
 class big_int {
 	// Call optimise after every operation!!!
 	bool _sign;  // 1 +  0 -
-	std::vector<unsigned int, pp_allocator<unsigned int>> _digits;
+	std::vector<__detail::limb_type, pp_allocator<__detail::limb_type>> _digits;
 
    public:
+	using value_type = __detail::limb_type;
+	using double_value_type = __detail::double_limb_type;
+
 	enum class multiplication_rule { trivial, Karatsuba, SchonhageStrassen };
 
 	enum class division_rule { trivial, Newton, BurnikelZiegler };
@@ -56,24 +330,61 @@ class big_int {
 	multiplication_rule decide_mult(size_t rhs) const noexcept;
 	division_rule decide_div(size_t rhs) const noexcept;
 
-   public:
-	using value_type = unsigned int;
+	/** Compares |this| with p[0, n) shifted left by shift limbs, returns -1, 0 or 1
+	 */
+	int compare_magnitude(const value_type *p, size_t n, size_t shift) const noexcept;
+
+	/** this += (sign ? 1 : -1) * p[0, n) * base^shift, in place. p must not point into _digits
+	 */
+	void add_magnitude(const value_type *p, size_t n, bool sign, size_t shift);
+
+	/** result = |lhs| * |rhs|, scratch for Karatsuba is taken from the tail of result
+	 */
+	static void multiply_magnitudes(std::vector<value_type, pp_allocator<value_type>> &result, const big_int &lhs,
+	                                const big_int &rhs, multiplication_rule rule);
+
+	/** result = |value|^2, cross products are computed once
+	 */
+	static void square_magnitude(std::vector<value_type, pp_allocator<value_type>> &result, const big_int &value,
+	                             multiplication_rule rule);
+
+	/** Knuth division of |this| by |divisor|, either output may be nullptr
+	 */
+	void divide_magnitudes(const big_int &divisor, big_int *quotient, big_int *remainder) const;
+
+	big_int &addmul_impl(const big_int &lhs, const big_int &rhs, bool negate);
+
+	/** this = op(this, other) on infinite two's complement, in place. Op is one of the limb kernels of big_int.cpp
+	 */
+	template <class Op>
+	big_int &bitwise_assign(const big_int &other, Op op) &;
+
+	template <class Op>
+	big_int bitwise(const big_int &other, Op op) const;
 
+   public:
+	/** Digits are 32-bit words in little-endian order regardless of the limb width
+	 */
 	template <class alloc>
 	explicit big_int(const std::vector<unsigned int, alloc> &digits, bool sign = true,
-	                 pp_allocator<unsigned int> allocator = pp_allocator<unsigned int>());
+	                 pp_allocator<value_type> allocator = pp_allocator<value_type>());
+
+	explicit big_int(const std::vector<value_type, pp_allocator<value_type>> &digits, bool sign = true);
 
-	explicit big_int(const std::vector<unsigned int, pp_allocator<unsigned int>> &digits, bool sign = true);
+	explicit big_int(std::vector<value_type, pp_allocator<value_type>> &&digits, bool sign = true) noexcept;
 
-	explicit big_int(std::vector<unsigned int, pp_allocator<unsigned int>> &&digits, bool sign = true) noexcept;
+	/** Copies the limbs of a compile-time constant, no parsing and a single allocation
+	 */
+	template <size_t Limbs>
+	big_int(const fixed_big_int<Limbs> &value, pp_allocator<value_type> allocator = pp_allocator<value_type>());
 
 	explicit big_int(const std::string &num, unsigned int radix = 10,
-	                 pp_allocator<unsigned int> = pp_allocator<unsigned int>());
+	                 pp_allocator<value_type> = pp_allocator<value_type>());
 
 	template <std::integral Num>
-	big_int(Num d, pp_allocator<unsigned int> = pp_allocator<unsigned int>());
+	big_int(Num d, pp_allocator<value_type> = pp_allocator<value_type>());
 
-	big_int(pp_allocator<unsigned int> = pp_allocator<unsigned int>());
+	big_int(pp_allocator<value_type> = pp_allocator<value_type>());
 
 	explicit operator bool() const noexcept;  // false if 0 , else true
 
@@ -97,6 +408,15 @@ class big_int {
 
 	big_int &minus_assign(const big_int &other, size_t shift = 0) &;
 
+	/** Fused multiply-add: this += lhs * rhs without a temporary for the product when the
+	 *  signs agree and rhs is short, otherwise with a single product buffer
+	 */
+	big_int &addmul(const big_int &lhs, const big_int &rhs) &;
+
+	/** Fused multiply-subtract: this -= lhs * rhs
+	 */
+	big_int &submul(const big_int &lhs, const big_int &rhs) &;
+
 	/** Delegates to multiply_assign and calls decide_mult
 	 */
 	big_int &operator*=(const big_int &other) &;
@@ -129,6 +449,9 @@ class big_int {
 	big_int operator<<(size_t shift) const;
 	big_int operator>>(size_t shift) const;
 
+	/** Bitwise operators treat negative values as infinite two's complement, ~x == -x - 1.
+	 *  Shifts act on the magnitude and keep the sign
+	 */
 	big_int operator~() const;
 
 	big_int &operator&=(const big_int &other) &;
@@ -142,19 +465,264 @@ class big_int {
 	big_int operator^(const big_int &other) const;
 	big_int abs() const;
 
+	/** Number of set bits of |this|
+	 */
+	size_t popcount() const noexcept;
+
+	/** Position of the highest set bit of |this| plus one, 0 for zero
+	 */
+	size_t bit_length() const noexcept;
+
+	/** Position of the lowest set bit, the same for this and -this, 0 for zero
+	 */
+	size_t trailing_zeros() const noexcept;
+
+	/** this * this, cheaper than a general product; x * x and x *= x take this path too
+	 */
+	big_int square() const;
+
+	/** this^exponent by left-to-right sliding windows
+	 */
+	big_int pow(size_t exponent) const;
+
+	/** this^exponent mod modulus in [0, modulus). Odd moduli use Montgomery multiplication, even ones plain
+	 *  reduction; throws std::invalid_argument for a non-positive modulus or a negative exponent
+	 */
+	big_int powmod(const big_int &exponent, const big_int &modulus) const;
+
+	/** Greatest common divisor of |lhs| and |rhs| by binary (Stein) reduction on limbs
+	 */
+	static big_int gcd(big_int lhs, big_int rhs);
+
+	size_t limbs_count() const noexcept { return _digits.size(); }
+
+	/** Opt-in parallel multiplication: Karatsuba subproducts and the blocks of unbalanced products run on a
+	 *  shared work-stealing pool of threads workers while operands have at least threshold_limbs limbs.
+	 *  threads <= 1 switches back to serial multiplication
+	 */
+	static void set_parallel_multiplication(size_t threads, size_t threshold_limbs = 1024);
+
 	friend std::ostream &operator<<(std::ostream &stream, big_int const &value);
 
 	friend std::istream &operator>>(std::istream &stream, big_int &value);
 
 	std::string to_string() const;
+
+	/** Binary record for B_tree_disk and other serializable containers: an 8-byte little-endian header
+	 *  holding (word count << 1) | negative, then the magnitude as little-endian 32-bit words. The format
+	 *  does not depend on the limb width, on little-endian hosts limbs are copied as is
+	 */
+	void serialize(std::ostream &stream) const;
+
+	/** Reads a record written by serialize straight into the limb storage of the result, allocated from allocator.
+	 *  Throws std::runtime_error if the stream ends before the record does
+	 */
+	static big_int deserialize(std::istream &stream, pp_allocator<value_type> allocator = pp_allocator<value_type>());
+
+	size_t serialize_size() const noexcept;
+
+   public:
+	/** Starts a lazily evaluated expression: a.lazy() * b + c * d - e is evaluated with one pass
+	 *  of in-place plus_assign/addmul into the destination instead of a temporary per operator.
+	 *  Expressions hold references to their operands and must be consumed within the full-expression
+	 */
+	__detail::big_int_ref lazy() const noexcept;
+
+	template <__detail::big_int_expression E>
+	big_int(const E &expression);
+
+	template <__detail::big_int_expression E>
+	big_int &operator=(const E &expression) &;
+
+	template <__detail::big_int_expression E>
+	big_int &operator+=(const E &expression) &;
+
+	template <__detail::big_int_expression E>
+	big_int &operator-=(const E &expression) &;
+};
+
+namespace __detail {
+/** Leaf of a lazy expression, refers to an existing big_int
+ */
+struct big_int_ref : big_int_expression_tag {
+	const big_int *value;
+
+	explicit big_int_ref(const big_int &v) noexcept : value(&v) {}
+
+	bool references(const big_int *p) const noexcept { return value == p; }
+
+	void assign_to(big_int &dest) const {
+		if (&dest != value) dest = *value;
+	}
+
+	void accumulate(big_int &dest, bool negate) const {
+		negate ? dest.minus_assign(*value) : dest.plus_assign(*value);
+	}
+};
+
+/** Calls f with the value of e, leaves are passed through without a copy
+ */
+template <class E, class F>
+void with_value(const E &e, F &&f) {
+	if constexpr (std::is_same_v<E, big_int_ref>) {
+		f(*e.value);
+	} else {
+		big_int storage;
+		e.assign_to(storage);
+		f(storage);
+	}
+}
+
+template <class L, class R>
+struct big_int_sum : big_int_expression_tag {
+	L lhs;
+	R rhs;
+
+	big_int_sum(const L &l, const R &r) : lhs(l), rhs(r) {}
+
+	bool references(const big_int *p) const noexcept { return lhs.references(p) || rhs.references(p); }
+
+	void assign_to(big_int &dest) const {
+		lhs.assign_to(dest);
+		rhs.accumulate(dest, false);
+	}
+
+	void accumulate(big_int &dest, bool negate) const {
+		lhs.accumulate(dest, negate);
+		rhs.accumulate(dest, negate);
+	}
+};
+
+template <class L, class R>
+struct big_int_difference : big_int_expression_tag {
+	L lhs;
+	R rhs;
+
+	big_int_difference(const L &l, const R &r) : lhs(l), rhs(r) {}
+
+	bool references(const big_int *p) const noexcept { return lhs.references(p) || rhs.references(p); }
+
+	void assign_to(big_int &dest) const {
+		lhs.assign_to(dest);
+		rhs.accumulate(dest, true);
+	}
+
+	void accumulate(big_int &dest, bool negate) const {
+		lhs.accumulate(dest, negate);
+		rhs.accumulate(dest, !negate);
+	}
+};
+
+template <class L, class R>
+struct big_int_product : big_int_expression_tag {
+	L lhs;
+	R rhs;
+
+	big_int_product(const L &l, const R &r) : lhs(l), rhs(r) {}
+
+	bool references(const big_int *p) const noexcept { return lhs.references(p) || rhs.references(p); }
+
+	void assign_to(big_int &dest) const {
+		with_value(rhs, [&](const big_int &r) {
+			lhs.assign_to(dest);
+			dest *= r;
+		});
+	}
+
+	/** Products of leaves go straight through addmul/submul, nested operands are materialised once
+	 */
+	void accumulate(big_int &dest, bool negate) const {
+		with_value(lhs, [&](const big_int &l) {
+			with_value(rhs, [&](const big_int &r) { negate ? dest.submul(l, r) : dest.addmul(l, r); });
+		});
+	}
 };
 
+template <class E>
+using big_int_operand = std::conditional_t<big_int_expression<E>, std::remove_cvref_t<E>, big_int_ref>;
+
+template <class E>
+concept big_int_operand_like = big_int_expression<E> || std::same_as<std::remove_cvref_t<E>, big_int>;
+
+template <class E>
+big_int_operand<E> make_big_int_operand(const E &e) {
+	if constexpr (big_int_expression<E>) {
+		return e;
+	} else {
+		return big_int_ref(e);
+	}
+}
+}  // namespace __detail
+
+template <__detail::big_int_operand_like L, __detail::big_int_operand_like R>
+    requires(__detail::big_int_expression<L> || __detail::big_int_expression<R>)
+auto operator+(const L &lhs, const R &rhs) {
+	return __detail::big_int_sum<__detail::big_int_operand<L>, __detail::big_int_operand<R>>(
+	    __detail::make_big_int_operand(lhs), __detail::make_big_int_operand(rhs));
+}
+
+template <__detail::big_int_operand_like L, __detail::big_int_operand_like R>
+    requires(__detail::big_int_expression<L> || __detail::big_int_expression<R>)
+auto operator-(const L &lhs, const R &rhs) {
+	return __detail::big_int_difference<__detail::big_int_operand<L>, __detail::big_int_operand<R>>(
+	    __detail::make_big_int_operand(lhs), __detail::make_big_int_operand(rhs));
+}
+
+template <__detail::big_int_operand_like L, __detail::big_int_operand_like R>
+    requires(__detail::big_int_expression<L> || __detail::big_int_expression<R>)
+auto operator*(const L &lhs, const R &rhs) {
+	return __detail::big_int_product<__detail::big_int_operand<L>, __detail::big_int_operand<R>>(
+	    __detail::make_big_int_operand(lhs), __detail::make_big_int_operand(rhs));
+}
+
+inline __detail::big_int_ref big_int::lazy() const noexcept { return __detail::big_int_ref(*this); }
+
+template <__detail::big_int_expression E>
+big_int::big_int(const E &expression) : big_int() {
+	expression.assign_to(*this);
+}
+
+template <__detail::big_int_expression E>
+big_int &big_int::operator=(const E &expression) & {
+	if (expression.references(this)) {
+		big_int result(_digits.get_allocator());
+		expression.assign_to(result);
+		return *this = std::move(result);
+	}
+	expression.assign_to(*this);
+	return *this;
+}
+
+template <__detail::big_int_expression E>
+big_int &big_int::operator+=(const E &expression) & {
+	if (expression.references(this)) {
+		return *this += big_int(expression);
+	}
+	expression.accumulate(*this, false);
+	return *this;
+}
+
+template <__detail::big_int_expression E>
+big_int &big_int::operator-=(const E &expression) & {
+	if (expression.references(this)) {
+		return *this -= big_int(expression);
+	}
+	expression.accumulate(*this, true);
+	return *this;
+}
+
 template <class Alloc>
-big_int::big_int(const std::vector<unsigned int, Alloc> &digits, bool sign, pp_allocator<unsigned int> allocator)
+big_int::big_int(const std::vector<unsigned int, Alloc> &digits, bool sign, pp_allocator<value_type> allocator)
     : _sign(sign), _digits(allocator) {
-	_digits.reserve(digits.size());
-	for (auto digit : digits) {
-		_digits.push_back(digit);
+	constexpr size_t words_per_limb = sizeof(value_type) / sizeof(unsigned int);
+
+	_digits.reserve((digits.size() + words_per_limb - 1) / words_per_limb);
+	for (size_t i = 0; i < digits.size(); i += words_per_limb) {
+		value_type limb = 0;
+		for (size_t j = 0; j < words_per_limb && i + j < digits.size(); ++j) {
+			limb |= static_cast<value_type>(digits[i + j]) << (j * sizeof(unsigned int) * 8);
+		}
+		_digits.push_back(limb);
 	}
 
 	while (!_digits.empty() && _digits.back() == 0) {
@@ -167,23 +735,27 @@ big_int::big_int(const std::vector<unsigned int, Alloc> &digits, bool sign, pp_a
 	}
 }
 
+template <size_t Limbs>
+big_int::big_int(const fixed_big_int<Limbs> &value, pp_allocator<value_type> allocator)
+    : _sign(!value.is_negative()), _digits(value.data(), value.data() + value.size(), allocator) {}
+
 template <std::integral Num>
-big_int::big_int(Num d, pp_allocator<unsigned int> allocator)
+big_int::big_int(Num d, pp_allocator<value_type> allocator)
     : _sign(d >= 0 || std::is_unsigned_v<Num>), _digits(allocator) {
 	using Unsigned = std::make_unsigned_t<Num>;
 	Unsigned abs_val;
 
 	if constexpr (std::is_signed_v<Num>) {
-		abs_val = static_cast<Unsigned>(std::abs(static_cast<std::make_signed_t<Num>>(d)));
+		abs_val = d < 0 ? static_cast<Unsigned>(Unsigned(0) - static_cast<Unsigned>(d)) : static_cast<Unsigned>(d);
 	} else {
 		abs_val = d;
 	}
 
-	constexpr size_t BITS_PER_DIGIT = sizeof(unsigned int) * 8;
+	constexpr size_t BITS_PER_DIGIT = __detail::limb_bits;
 
 	do {
-		_digits.push_back(static_cast<unsigned int>(abs_val));
-		if constexpr (sizeof(Unsigned) > sizeof(unsigned int)) {
+		_digits.push_back(static_cast<value_type>(abs_val));
+		if constexpr (sizeof(Unsigned) > sizeof(value_type)) {
 			abs_val >>= BITS_PER_DIGIT;
 		} else {
 			abs_val = 0;
@@ -195,6 +767,14 @@ big_int::big_int(Num d, pp_allocator<unsigned int> allocator)
 		_sign = true;
 	}
 }
-big_int operator""_bi(unsigned long long n);
+
+/** The literal is parsed at compile time, at run time only the limbs are copied. Accepts the same
+ *  decimal, 0x, 0b and octal forms as built-in integer literals, without their range limit
+ */
+template <char... Chars>
+big_int operator""_bi() {
+	static constexpr auto value = __detail::parse_big_int_literal<Chars...>();
+	return big_int(value);
+}
 
 #endif  // MP_OS_BIG_INT_H
\ No newline at end of file
@@ -0,0 +1,78 @@
+#ifndef MP_OS_WORK_STEALING_POOL_H
+#define MP_OS_WORK_STEALING_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace __detail {
+
+/** Fixed set of worker threads, each owning a deque. A worker pops its own deque from the back and steals
+ *  from the front of the others. Threads waiting on a task_group run pending tasks instead of blocking,
+ *  so nested fork-join never exhausts the pool
+ */
+class work_stealing_pool final {
+   public:
+	class task_group final {
+		work_stealing_pool &_pool;
+		std::atomic<size_t> _pending{0};
+		std::mutex _error_mutex;
+		std::exception_ptr _error;
+
+	   public:
+		explicit task_group(work_stealing_pool &pool) noexcept;
+
+		task_group(const task_group &) = delete;
+		task_group &operator=(const task_group &) = delete;
+
+		~task_group() noexcept;
+
+		void run(std::function<void()> task);
+
+		/** Helps with queued work until every task of the group has finished, rethrows the first failure
+		 */
+		void wait();
+	};
+
+   private:
+	struct queue {
+		std::mutex mutex;
+		std::deque<std::function<void()>> tasks;
+	};
+
+	std::vector<std::unique_ptr<queue>> _queues;
+	std::vector<std::thread> _workers;
+	std::atomic<size_t> _queued{0};
+	std::atomic<size_t> _next_queue{0};
+	std::mutex _sleep_mutex;
+	std::condition_variable _wake;
+	bool _stopping = false;
+
+	void push(std::function<void()> task);
+
+	bool try_run_one();
+
+	void worker_loop(size_t index);
+
+   public:
+	explicit work_stealing_pool(size_t threads);
+
+	work_stealing_pool(const work_stealing_pool &) = delete;
+	work_stealing_pool &operator=(const work_stealing_pool &) = delete;
+
+	~work_stealing_pool() noexcept;
+
+	size_t size() const noexcept;
+};
+
+}  // namespace __detail
+
+#endif  // MP_OS_WORK_STEALING_POOL_H
@@ -3,15 +3,26 @@
 //
 
 #include "../include/big_int.h"
+#include "../include/work_stealing_pool.h"
 
 #include <algorithm>
+#include <atomic>
+#include <bit>
 #include <cmath>
 #include <compare>
 #include <exception>
+#include <limits>
+#include <memory>
+#include <mutex>
 #include <ranges>
 #include <sstream>
+#include <stdexcept>
 #include <string>
 
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
 void big_int::remove_leading_zeros() {
 	while (_digits.size() > 1 && _digits.back() == 0) {
 		_digits.pop_back();
@@ -38,6 +49,902 @@ bool validating_string(const std::string &str, int radix) {
 	});
 }
 
+#ifndef MP_OS_BIG_INT_KARATSUBA_THRESHOLD
+#define MP_OS_BIG_INT_KARATSUBA_THRESHOLD 32
+#endif
+
+namespace __detail {
+constexpr size_t karatsuba_threshold = MP_OS_BIG_INT_KARATSUBA_THRESHOLD;
+static_assert(karatsuba_threshold >= 4, "Karatsuba recursion needs at least two limbs per half");
+
+/** r[0, n) = a[0, n) + b[0, m), m <= n, returns outgoing carry. r may alias a
+ */
+limb_type add_n(limb_type *r, const limb_type *a, size_t n, const limb_type *b, size_t m) noexcept {
+	unsigned char carry = 0;
+	size_t i = 0;
+	for (; i < m; ++i) {
+		r[i] = add_with_carry(a[i], b[i], carry);
+	}
+	for (; carry && i < n; ++i) {
+		r[i] = add_with_carry(a[i], 0, carry);
+	}
+	if (r != a) {
+		std::copy(a + i, a + n, r + i);
+	}
+	return carry;
+}
+
+/** r[0, n) = a[0, n) - b[0, m), m <= n, returns outgoing borrow. r may alias a
+ */
+limb_type sub_n(limb_type *r, const limb_type *a, size_t n, const limb_type *b, size_t m) noexcept {
+	unsigned char borrow = 0;
+	size_t i = 0;
+	for (; i < m; ++i) {
+		r[i] = sub_with_borrow(a[i], b[i], borrow);
+	}
+	for (; borrow && i < n; ++i) {
+		r[i] = sub_with_borrow(a[i], 0, borrow);
+	}
+	if (r != a) {
+		std::copy(a + i, a + n, r + i);
+	}
+	return borrow;
+}
+
+/** r[0, n) += a[0, n) * b, returns the limb carried out of r[n - 1]
+ */
+limb_type addmul_1(limb_type *r, const limb_type *a, size_t n, limb_type b) noexcept {
+	limb_type carry = 0;
+	for (size_t i = 0; i < n; ++i) {
+		double_limb_type cur = static_cast<double_limb_type>(a[i]) * b + r[i] + carry;
+		r[i] = static_cast<limb_type>(cur);
+		carry = static_cast<limb_type>(cur >> limb_bits);
+	}
+	return carry;
+}
+
+/** r[0, n) -= a[0, n) * b, returns the limb borrowed from r[n]
+ */
+limb_type submul_1(limb_type *r, const limb_type *a, size_t n, limb_type b) noexcept {
+	limb_type borrow = 0;
+	for (size_t i = 0; i < n; ++i) {
+		double_limb_type prod = static_cast<double_limb_type>(a[i]) * b + borrow;
+		limb_type low = static_cast<limb_type>(prod);
+		limb_type prev = r[i];
+		borrow = static_cast<limb_type>(prod >> limb_bits);
+		r[i] = prev - low;
+		borrow += r[i] > prev;
+	}
+	return borrow;
+}
+
+/** r[0, n + m) = a[0, n) * b[0, m). r must not overlap a or b
+ */
+void mul_basecase(limb_type *r, const limb_type *a, size_t n, const limb_type *b, size_t m) noexcept {
+	std::fill(r, r + n + m, 0);
+	for (size_t j = 0; j < m; ++j) {
+		r[j + n] = b[j] == 0 ? 0 : addmul_1(r + j, a, n, b[j]);
+	}
+}
+
+size_t karatsuba_scratch_size(size_t n) noexcept {
+	if (n < karatsuba_threshold) return 0;
+	size_t k = n - n / 2;
+	return 4 * k + 4 + karatsuba_scratch_size(k);
+}
+
+/** r[0, 2n) = a[0, n) * b[0, n), all intermediates live in scratch[0, karatsuba_scratch_size(n))
+ */
+void karatsuba(limb_type *r, const limb_type *a, const limb_type *b, size_t n, limb_type *scratch) noexcept {
+	if (n < karatsuba_threshold) {
+		mul_basecase(r, a, n, b, n);
+		return;
+	}
+
+	const size_t h = n / 2, k = n - h;
+
+	karatsuba(r, a, b, h, scratch);
+	karatsuba(r + 2 * h, a + h, b + h, k, scratch);
+
+	limb_type *sa = scratch, *sb = scratch + k + 1, *t = scratch + 2 * k + 2;
+	sa[k] = add_n(sa, a + h, k, a, h);
+	sb[k] = add_n(sb, b + h, k, b, h);
+
+	karatsuba(t, sa, sb, k, t + 2 * k + 2);
+	t[2 * k] = t[2 * k + 1] = 0;
+	if (sa[k]) add_n(t + k, t + k, k + 2, sb, k);
+	if (sb[k]) add_n(t + k, t + k, k + 2, sa, k);
+	if (sa[k] && sb[k]) {
+		const limb_type one = 1;
+		add_n(t + 2 * k, t + 2 * k, 2, &one, 1);
+	}
+
+	sub_n(t, t, 2 * k + 2, r, 2 * h);
+	sub_n(t, t, 2 * k + 2, r + 2 * h, 2 * k);
+	add_n(r + h, r + h, h + 2 * k, t, 2 * k + 2);
+}
+
+size_t mul_scratch_size(size_t n, size_t m) noexcept {
+	if (m < karatsuba_threshold) return 0;
+	if (n == m) return karatsuba_scratch_size(n);
+	size_t rest = n % m;
+	return 2 * m + std::max(karatsuba_scratch_size(m), rest == 0 ? 0 : mul_scratch_size(m, rest));
+}
+
+/** r[0, n + m) = a[0, n) * b[0, m), n >= m. Unbalanced operands are cut into m-limb Karatsuba blocks
+ */
+void mul(limb_type *r, const limb_type *a, size_t n, const limb_type *b, size_t m, limb_type *scratch) noexcept {
+	if (m < karatsuba_threshold) {
+		mul_basecase(r, a, n, b, m);
+		return;
+	}
+	if (n == m) {
+		karatsuba(r, a, b, n, scratch);
+		return;
+	}
+
+	std::fill(r, r + n + m, 0);
+	limb_type *block = scratch;
+	for (size_t offset = 0; offset < n; offset += m) {
+		size_t len = std::min(m, n - offset);
+		if (len == m) {
+			karatsuba(block, a + offset, b, m, scratch + 2 * m);
+		} else {
+			mul(block, b, m, a + offset, len, scratch + 2 * m);
+		}
+		add_n(r + offset, r + offset, n + m - offset, block, len + m);
+	}
+}
+
+/** karatsuba() with the two half products forked to the pool while n >= threshold, each branch gets its own scratch
+ */
+void karatsuba_parallel(limb_type *r, const limb_type *a, const limb_type *b, size_t n, work_stealing_pool &pool,
+                        size_t threshold) {
+	if (n < threshold || n < karatsuba_threshold) {
+		std::vector<limb_type> scratch(karatsuba_scratch_size(n));
+		karatsuba(r, a, b, n, scratch.data());
+		return;
+	}
+
+	const size_t h = n / 2, k = n - h;
+	std::vector<limb_type> buffer(4 * k + 4);
+	limb_type *sa = buffer.data(), *sb = sa + k + 1, *t = sa + 2 * k + 2;
+
+	work_stealing_pool::task_group group(pool);
+	group.run([=, &pool] { karatsuba_parallel(r, a, b, h, pool, threshold); });
+	group.run([=, &pool] { karatsuba_parallel(r + 2 * h, a + h, b + h, k, pool, threshold); });
+
+	sa[k] = add_n(sa, a + h, k, a, h);
+	sb[k] = add_n(sb, b + h, k, b, h);
+	karatsuba_parallel(t, sa, sb, k, pool, threshold);
+	group.wait();
+
+	t[2 * k] = t[2 * k + 1] = 0;
+	if (sa[k]) add_n(t + k, t + k, k + 2, sb, k);
+	if (sb[k]) add_n(t + k, t + k, k + 2, sa, k);
+	if (sa[k] && sb[k]) {
+		const limb_type one = 1;
+		add_n(t + 2 * k, t + 2 * k, 2, &one, 1);
+	}
+
+	sub_n(t, t, 2 * k + 2, r, 2 * h);
+	sub_n(t, t, 2 * k + 2, r + 2 * h, 2 * k);
+	add_n(r + h, r + h, h + 2 * k, t, 2 * k + 2);
+}
+
+/** mul() with every m-limb block of an unbalanced product computed as a separate task
+ */
+void mul_parallel(limb_type *r, const limb_type *a, size_t n, const limb_type *b, size_t m, work_stealing_pool &pool,
+                  size_t threshold) {
+	if (m < threshold || m < karatsuba_threshold) {
+		std::vector<limb_type> scratch(mul_scratch_size(n, m));
+		mul(r, a, n, b, m, scratch.data());
+		return;
+	}
+	if (n == m) {
+		karatsuba_parallel(r, a, b, n, pool, threshold);
+		return;
+	}
+
+	const size_t blocks = (n + m - 1) / m;
+	std::vector<limb_type> products(blocks * 2 * m);
+	{
+		work_stealing_pool::task_group group(pool);
+		for (size_t i = 0; i < blocks; ++i) {
+			group.run([=, &pool, &products] {
+				size_t offset = i * m, len = std::min(m, n - offset);
+				limb_type *block = products.data() + i * 2 * m;
+				if (len == m) {
+					karatsuba_parallel(block, a + offset, b, m, pool, threshold);
+				} else {
+					mul_parallel(block, b, m, a + offset, len, pool, threshold);
+				}
+			});
+		}
+		group.wait();
+	}
+
+	std::fill(r, r + n + m, 0);
+	for (size_t i = 0; i < blocks; ++i) {
+		size_t offset = i * m, len = std::min(m, n - offset);
+		add_n(r + offset, r + offset, n + m - offset, products.data() + i * 2 * m, len + m);
+	}
+}
+
+/** Knuth's algorithm D. u[0, n] is the normalised dividend with a spare top limb, v[0, m) the normalised
+ *  divisor with m >= 2. Writes n - m + 1 quotient limbs to q and leaves the remainder in u[0, m)
+ */
+void divmod_knuth(limb_type *q, limb_type *u, size_t n, const limb_type *v, size_t m) noexcept {
+	constexpr double_limb_type max_limb = std::numeric_limits<limb_type>::max();
+	const limb_type v_top = v[m - 1], v_next = v[m - 2];
+
+	for (size_t j = n - m + 1; j-- > 0;) {
+		double_limb_type num = (static_cast<double_limb_type>(u[j + m]) << limb_bits) | u[j + m - 1];
+		double_limb_type qhat = num / v_top;
+		double_limb_type rhat = num % v_top;
+
+		while (qhat > max_limb || qhat * v_next > ((rhat << limb_bits) | u[j + m - 2])) {
+			--qhat;
+			rhat += v_top;
+			if (rhat > max_limb) break;
+		}
+
+		limb_type borrow = submul_1(u + j, v, m, static_cast<limb_type>(qhat));
+		limb_type top = u[j + m];
+		u[j + m] = top - borrow;
+		if (top < borrow) {
+			--qhat;
+			u[j + m] += add_n(u + j, u + j, m, v, m);
+		}
+		q[j] = static_cast<limb_type>(qhat);
+	}
+}
+
+size_t trailing_zero_bits(const limb_type *a, size_t n) noexcept {
+	size_t i = 0;
+	while (i < n && a[i] == 0) ++i;
+	return i == n ? 0 : i * limb_bits + std::countr_zero(a[i]);
+}
+
+#if defined(__AVX2__)
+constexpr size_t simd_lanes = 32 / sizeof(limb_type);
+using simd_type = __m256i;
+
+inline simd_type simd_load(const limb_type *p) noexcept { return _mm256_loadu_si256(reinterpret_cast<const simd_type *>(p)); }
+inline void simd_store(limb_type *p, simd_type x) noexcept { _mm256_storeu_si256(reinterpret_cast<simd_type *>(p), x); }
+inline simd_type simd_broadcast(limb_type x) noexcept {
+	if constexpr (limb_bits == 64) return _mm256_set1_epi64x(static_cast<long long>(x));
+	else return _mm256_set1_epi32(static_cast<int>(x));
+}
+inline simd_type simd_and(simd_type x, simd_type y) noexcept { return _mm256_and_si256(x, y); }
+inline simd_type simd_or(simd_type x, simd_type y) noexcept { return _mm256_or_si256(x, y); }
+inline simd_type simd_xor(simd_type x, simd_type y) noexcept { return _mm256_xor_si256(x, y); }
+inline simd_type simd_shl(simd_type x, __m128i count) noexcept {
+	if constexpr (limb_bits == 64) return _mm256_sll_epi64(x, count);
+	else return _mm256_sll_epi32(x, count);
+}
+inline simd_type simd_shr(simd_type x, __m128i count) noexcept {
+	if constexpr (limb_bits == 64) return _mm256_srl_epi64(x, count);
+	else return _mm256_srl_epi32(x, count);
+}
+#elif defined(__SSE2__)
+constexpr size_t simd_lanes = 16 / sizeof(limb_type);
+using simd_type = __m128i;
+
+inline simd_type simd_load(const limb_type *p) noexcept { return _mm_loadu_si128(reinterpret_cast<const simd_type *>(p)); }
+inline void simd_store(limb_type *p, simd_type x) noexcept { _mm_storeu_si128(reinterpret_cast<simd_type *>(p), x); }
+inline simd_type simd_broadcast(limb_type x) noexcept {
+	if constexpr (limb_bits == 64) return _mm_set1_epi64x(static_cast<long long>(x));
+	else return _mm_set1_epi32(static_cast<int>(x));
+}
+inline simd_type simd_and(simd_type x, simd_type y) noexcept { return _mm_and_si128(x, y); }
+inline simd_type simd_or(simd_type x, simd_type y) noexcept { return _mm_or_si128(x, y); }
+inline simd_type simd_xor(simd_type x, simd_type y) noexcept { return _mm_xor_si128(x, y); }
+inline simd_type simd_shl(simd_type x, __m128i count) noexcept {
+	if constexpr (limb_bits == 64) return _mm_sll_epi64(x, count);
+	else return _mm_sll_epi32(x, count);
+}
+inline simd_type simd_shr(simd_type x, __m128i count) noexcept {
+	if constexpr (limb_bits == 64) return _mm_srl_epi64(x, count);
+	else return _mm_srl_epi32(x, count);
+}
+#endif
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#define MP_OS_BIG_INT_SIMD 1
+#endif
+
+/** Bitwise operations applied to single limbs and, where available, to vectors of limbs
+ */
+struct and_op {
+	limb_type operator()(limb_type x, limb_type y) const noexcept { return x & y; }
+#ifdef MP_OS_BIG_INT_SIMD
+	simd_type operator()(simd_type x, simd_type y) const noexcept { return simd_and(x, y); }
+#endif
+};
+
+struct or_op {
+	limb_type operator()(limb_type x, limb_type y) const noexcept { return x | y; }
+#ifdef MP_OS_BIG_INT_SIMD
+	simd_type operator()(simd_type x, simd_type y) const noexcept { return simd_or(x, y); }
+#endif
+};
+
+struct xor_op {
+	limb_type operator()(limb_type x, limb_type y) const noexcept { return x ^ y; }
+#ifdef MP_OS_BIG_INT_SIMD
+	simd_type operator()(simd_type x, simd_type y) const noexcept { return simd_xor(x, y); }
+#endif
+};
+
+/** r[0, n) = op(a[0, n), b[0, n)). r may alias a or b
+ */
+template <class Op>
+void bitwise_n(limb_type *r, const limb_type *a, const limb_type *b, size_t n, Op op) noexcept {
+	size_t i = 0;
+#ifdef MP_OS_BIG_INT_SIMD
+	for (; i + simd_lanes <= n; i += simd_lanes) {
+		simd_store(r + i, op(simd_load(a + i), simd_load(b + i)));
+	}
+#endif
+	for (; i < n; ++i) r[i] = op(a[i], b[i]);
+}
+
+/** r[0, n) = op(a[0, n), fill) for every limb. r may alias a
+ */
+template <class Op>
+void bitwise_fill_n(limb_type *r, const limb_type *a, limb_type fill, size_t n, Op op) noexcept {
+	size_t i = 0;
+#ifdef MP_OS_BIG_INT_SIMD
+	const simd_type fill_vector = simd_broadcast(fill);
+	for (; i + simd_lanes <= n; i += simd_lanes) {
+		simd_store(r + i, op(simd_load(a + i), fill_vector));
+	}
+#endif
+	for (; i < n; ++i) r[i] = op(a[i], fill);
+}
+
+/** r[0, n) = -a[0, n) mod base^n, the two's complement. r may alias a
+ */
+void negate_n(limb_type *r, const limb_type *a, size_t n) noexcept {
+	size_t i = 0;
+	for (; i < n && a[i] == 0; ++i) r[i] = 0;
+	if (i == n) return;
+
+	// past the lowest non-zero limb the +1 no longer carries
+	r[i] = limb_type(0) - a[i];
+	++i;
+	bitwise_fill_n(r + i, a + i, ~limb_type(0), n - i, xor_op{});
+}
+
+/** r[0, n) = a[0, n) << s for 0 < s < limb_bits, returns the bits shifted out. r may be a or lie above a
+ */
+limb_type lshift_n(limb_type *r, const limb_type *a, size_t n, unsigned int s) noexcept {
+	const limb_type out = a[n - 1] >> (limb_bits - s);
+	size_t i = n;
+#ifdef MP_OS_BIG_INT_SIMD
+	const __m128i left = _mm_cvtsi32_si128(static_cast<int>(s));
+	const __m128i right = _mm_cvtsi32_si128(static_cast<int>(limb_bits - s));
+	// each block is loaded whole before it is stored, blocks run downwards
+	for (; i > simd_lanes; i -= simd_lanes) {
+		simd_type high = simd_load(a + i - simd_lanes), low = simd_load(a + i - simd_lanes - 1);
+		simd_store(r + i - simd_lanes, simd_or(simd_shl(high, left), simd_shr(low, right)));
+	}
+#endif
+	for (; i > 1; --i) r[i - 1] = (a[i - 1] << s) | (a[i - 2] >> (limb_bits - s));
+	r[0] = a[0] << s;
+	return out;
+}
+
+/** r[0, n) = a[0, n) >> s for 0 < s < limb_bits. r may be a or lie below a
+ */
+void rshift_bits_n(limb_type *r, const limb_type *a, size_t n, unsigned int s) noexcept {
+	size_t i = 0;
+#ifdef MP_OS_BIG_INT_SIMD
+	const __m128i right = _mm_cvtsi32_si128(static_cast<int>(s));
+	const __m128i left = _mm_cvtsi32_si128(static_cast<int>(limb_bits - s));
+	for (; i + simd_lanes < n; i += simd_lanes) {
+		simd_type low = simd_load(a + i), high = simd_load(a + i + 1);
+		simd_store(r + i, simd_or(simd_shr(low, right), simd_shl(high, left)));
+	}
+#endif
+	for (; i + 1 < n; ++i) r[i] = (a[i] >> s) | (a[i + 1] << (limb_bits - s));
+	r[n - 1] = a[n - 1] >> s;
+}
+
+size_t popcount_n(const limb_type *a, size_t n) noexcept {
+	// independent sums keep several popcnt instructions in flight
+	size_t c0 = 0, c1 = 0, c2 = 0, c3 = 0, i = 0;
+	for (; i + 4 <= n; i += 4) {
+		c0 += std::popcount(a[i]);
+		c1 += std::popcount(a[i + 1]);
+		c2 += std::popcount(a[i + 2]);
+		c3 += std::popcount(a[i + 3]);
+	}
+	for (; i < n; ++i) c0 += std::popcount(a[i]);
+	return c0 + c1 + c2 + c3;
+}
+
+/** a[0, n) >>= bits in place, returns the new length without leading zero limbs
+ */
+size_t rshift_n(limb_type *a, size_t n, size_t bits) noexcept {
+	const size_t limbs = bits / limb_bits, s = bits % limb_bits;
+	if (limbs >= n) return 0;
+
+	size_t len = n - limbs;
+	if (s == 0) {
+		std::copy(a + limbs, a + n, a);
+	} else {
+		rshift_bits_n(a, a + limbs, len, static_cast<unsigned int>(s));
+	}
+	while (len > 0 && a[len - 1] == 0) --len;
+	return len;
+}
+
+limb_type gcd_1(limb_type u, limb_type v) noexcept {
+	if (u == 0) return v;
+	if (v == 0) return u;
+
+	int k = std::countr_zero(u | v);
+	u >>= std::countr_zero(u);
+	while (v != 0) {
+		v >>= std::countr_zero(v);
+		if (u > v) std::swap(u, v);
+		v -= u;
+	}
+	return u << k;
+}
+
+/** r[0, 2n) = a[0, n)^2. Every cross product a_i * a_j with i < j is formed once and doubled by a shift
+ */
+void sqr_basecase(limb_type *r, const limb_type *a, size_t n) noexcept {
+	std::fill(r, r + 2 * n, 0);
+	for (size_t i = 0; i + 1 < n; ++i) {
+		r[i + n] = a[i] == 0 ? 0 : addmul_1(r + 2 * i + 1, a + i + 1, n - i - 1, a[i]);
+	}
+
+	for (size_t i = 2 * n - 1; i > 0; --i) {
+		r[i] = (r[i] << 1) | (r[i - 1] >> (limb_bits - 1));
+	}
+	r[0] <<= 1;
+
+	unsigned char carry = 0;
+	for (size_t i = 0; i < n; ++i) {
+		double_limb_type square = static_cast<double_limb_type>(a[i]) * a[i];
+		r[2 * i] = add_with_carry(r[2 * i], static_cast<limb_type>(square), carry);
+		r[2 * i + 1] = add_with_carry(r[2 * i + 1], static_cast<limb_type>(square >> limb_bits), carry);
+	}
+}
+
+/** r[0, 2n) = a[0, n)^2 by Karatsuba with three half-size squares, scratch as for karatsuba()
+ */
+void karatsuba_sqr(limb_type *r, const limb_type *a, size_t n, limb_type *scratch) noexcept {
+	if (n < karatsuba_threshold) {
+		sqr_basecase(r, a, n);
+		return;
+	}
+
+	const size_t h = n / 2, k = n - h;
+
+	karatsuba_sqr(r, a, h, scratch);
+	karatsuba_sqr(r + 2 * h, a + h, k, scratch);
+
+	limb_type *sa = scratch, *t = scratch + k + 1;
+	sa[k] = add_n(sa, a + h, k, a, h);
+
+	karatsuba_sqr(t, sa, k, t + 2 * k + 2);
+	t[2 * k] = t[2 * k + 1] = 0;
+	if (sa[k]) {
+		add_n(t + k, t + k, k + 2, sa, k);
+		add_n(t + k, t + k, k + 2, sa, k);
+		const limb_type one = 1;
+		add_n(t + 2 * k, t + 2 * k, 2, &one, 1);
+	}
+
+	sub_n(t, t, 2 * k + 2, r, 2 * h);
+	sub_n(t, t, 2 * k + 2, r + 2 * h, 2 * k);
+	add_n(r + h, r + h, h + 2 * k, t, 2 * k + 2);
+}
+
+/** -m^-1 mod base for odd m, by Newton iteration that doubles the correct low bits each step
+ */
+limb_type montgomery_inverse(limb_type m) noexcept {
+	limb_type x = m;  // m * m == 1 mod 8
+	for (size_t bits = 3; bits < limb_bits; bits *= 2) {
+		x *= 2 - m * x;
+	}
+	return 0 - x;
+}
+
+/** Montgomery reduction: r[0, n) = t[0, 2n) / base^n mod m[0, n), t[2n] is a spare limb and gets clobbered.
+ *  Requires t < m * base^n
+ */
+void montgomery_reduce(limb_type *r, limb_type *t, const limb_type *m, size_t n, limb_type m_inverse) noexcept {
+	t[2 * n] = 0;
+	for (size_t i = 0; i < n; ++i) {
+		limb_type carry = addmul_1(t + i, m, n, t[i] * m_inverse);
+		add_n(t + i + n, t + i + n, n + 1 - i, &carry, 1);
+	}
+
+	// the quotient is below 2m
+	bool reduce = t[2 * n] != 0;
+	if (!reduce) {
+		size_t i = n;
+		while (i > 0 && t[n + i - 1] == m[i - 1]) --i;
+		reduce = i == 0 || t[n + i - 1] > m[i - 1];
+	}
+	if (reduce) {
+		sub_n(r, t + n, n, m, n);
+	} else {
+		std::copy(t + n, t + 2 * n, r);
+	}
+}
+
+/** Left-to-right sliding window exponentiation over the lowest bits of an exponent. bit(i) reads exponent bit i,
+ *  square(x) and multiply(x, y) update x in place
+ */
+template <typename Value, typename Bit, typename Square, typename Multiply>
+Value sliding_window_pow(const Value &base, Value result, size_t bits, Bit bit, Square square, Multiply multiply) {
+	const size_t window = bits > 512 ? 5 : bits > 128 ? 4 : bits > 32 ? 3 : bits > 4 ? 2 : 1;
+
+	// base^1, base^3, ..., base^(2^window - 1)
+	std::vector<Value> odd_powers{base};
+	if (window > 1) {
+		Value base_squared = base;
+		square(base_squared);
+		for (size_t i = 1; i < (size_t(1) << (window - 1)); ++i) {
+			Value next = odd_powers.back();
+			multiply(next, base_squared);
+			odd_powers.push_back(std::move(next));
+		}
+	}
+
+	size_t i = bits;
+	while (i > 0) {
+		if (!bit(i - 1)) {
+			square(result);
+			--i;
+			continue;
+		}
+
+		// longest window [low, i) of at most window bits that ends in a set bit
+		size_t low = i > window ? i - window : 0;
+		while (!bit(low)) ++low;
+
+		size_t value = 0;
+		for (size_t j = i; j > low; --j) {
+			square(result);
+			value = value << 1 | bit(j - 1);
+		}
+		multiply(result, odd_powers[value >> 1]);
+		i = low;
+	}
+
+	return result;
+}
+}  // namespace __detail
+
+big_int big_int::square() const {
+	big_int result(_digits.get_allocator());
+	square_magnitude(result._digits, *this, decide_mult(_digits.size()));
+	result._sign = true;
+	result.remove_leading_zeros();
+	return result;
+}
+
+big_int big_int::pow(size_t exponent) const {
+	return __detail::sliding_window_pow(
+	    *this, big_int(1, _digits.get_allocator()), std::bit_width(exponent),
+	    [exponent](size_t i) { return (exponent >> i) & 1; }, [](big_int &x) { x = x.square(); },
+	    [](big_int &x, const big_int &y) { x *= y; });
+}
+
+big_int big_int::powmod(const big_int &exponent, const big_int &modulus) const {
+	if (!modulus || !modulus._sign) throw std::invalid_argument("Modulus must be positive");
+	if (!exponent._sign && exponent) throw std::invalid_argument("Exponent must be non-negative");
+
+	big_int base = *this % modulus;
+	if (!base._sign && base) base += modulus;
+	if (modulus._digits.size() == 1 && modulus._digits[0] == 1) return big_int(0, _digits.get_allocator());
+
+	const auto &e = exponent._digits;
+	const size_t bits = (e.size() - 1) * __detail::limb_bits + std::bit_width(e.back());
+	auto bit = [&e](size_t i) { return (e[i / __detail::limb_bits] >> (i % __detail::limb_bits)) & 1; };
+
+	if ((modulus._digits[0] & 1) == 0) {
+		return __detail::sliding_window_pow(
+		    base, big_int(1, _digits.get_allocator()), bits, bit, [&modulus](big_int &x) { x = x.square() % modulus; },
+		    [&modulus](big_int &x, const big_int &y) { x = x * y % modulus; });
+	}
+
+	// Montgomery form x * base^n mod m, products are reduced without division
+	using limbs = std::vector<value_type>;
+	const value_type *m = modulus._digits.data();
+	const size_t n = modulus._digits.size();
+	const value_type m_inverse = __detail::montgomery_inverse(m[0]);
+
+	auto to_limbs = [n](const big_int &x) {
+		limbs result(x._digits.begin(), x._digits.end());
+		result.resize(n, 0);
+		return result;
+	};
+
+	limbs t(2 * n + 1), scratch(__detail::karatsuba_scratch_size(n));
+	auto square = [&](limbs &x) {
+		if (n < __detail::karatsuba_threshold) {
+			__detail::sqr_basecase(t.data(), x.data(), n);
+		} else {
+			__detail::karatsuba_sqr(t.data(), x.data(), n, scratch.data());
+		}
+		__detail::montgomery_reduce(x.data(), t.data(), m, n, m_inverse);
+	};
+	auto multiply = [&](limbs &x, const limbs &y) {
+		__detail::mul(t.data(), x.data(), n, y.data(), n, scratch.data());
+		__detail::montgomery_reduce(x.data(), t.data(), m, n, m_inverse);
+	};
+
+	const size_t shift = n * __detail::limb_bits;
+	limbs power = __detail::sliding_window_pow(to_limbs((base << shift) % modulus),
+	                                           to_limbs((big_int(1) << shift) % modulus), bits, bit, square, multiply);
+
+	std::fill(t.begin(), t.end(), 0);
+	std::copy(power.begin(), power.end(), t.begin());
+	__detail::montgomery_reduce(power.data(), t.data(), m, n, m_inverse);
+
+	big_int result(std::vector<value_type, pp_allocator<value_type>>(power.begin(), power.end(), _digits.get_allocator()));
+	result.remove_leading_zeros();
+	return result;
+}
+
+big_int big_int::gcd(big_int lhs, big_int rhs) {
+	lhs._sign = rhs._sign = true;
+	if (!lhs) return rhs;
+	if (!rhs) return lhs;
+
+	auto *x = &lhs._digits, *y = &rhs._digits;
+	const size_t common_twos = std::min(__detail::trailing_zero_bits(x->data(), x->size()),
+	                                    __detail::trailing_zero_bits(y->data(), y->size()));
+
+	size_t nx = __detail::rshift_n(x->data(), x->size(), __detail::trailing_zero_bits(x->data(), x->size()));
+	size_t ny = __detail::rshift_n(y->data(), y->size(), __detail::trailing_zero_bits(y->data(), y->size()));
+
+	// Stein's algorithm on odd operands: subtract the smaller one and strip the twos, all in place.
+	// When the lengths drift apart one Knuth division brings the larger operand down first
+	while (true) {
+		if (nx < ny) {
+			std::swap(x, y);
+			std::swap(nx, ny);
+		}
+
+		if (nx == 1) {
+			(*x)[0] = __detail::gcd_1((*x)[0], (*y)[0]);
+			break;
+		}
+
+		if (nx > ny + 1) {
+			x->resize(nx);
+			y->resize(ny);
+			big_int &larger = x == &lhs._digits ? lhs : rhs;
+			const big_int &smaller = x == &lhs._digits ? rhs : lhs;
+			larger.divide_magnitudes(smaller, nullptr, &larger);
+			if (!larger) {
+				std::swap(x, y);
+				nx = ny;
+				break;
+			}
+			nx = __detail::rshift_n(x->data(), x->size(), __detail::trailing_zero_bits(x->data(), x->size()));
+			continue;
+		}
+
+		int cmp = nx != ny ? 1 : 0;
+		for (size_t i = nx; cmp == 0 && i-- > 0;) {
+			if ((*x)[i] != (*y)[i]) cmp = (*x)[i] < (*y)[i] ? -1 : 1;
+		}
+		if (cmp == 0) break;
+		if (cmp < 0) std::swap(x, y);
+
+		__detail::sub_n(x->data(), x->data(), nx, y->data(), ny);
+		nx = __detail::rshift_n(x->data(), nx, __detail::trailing_zero_bits(x->data(), nx));
+	}
+
+	x->resize(std::max<size_t>(nx, 1));
+	big_int &result = x == &lhs._digits ? lhs : rhs;
+	result.remove_leading_zeros();
+	return result << common_twos;
+}
+
+int big_int::compare_magnitude(const value_type *p, size_t n, size_t shift) const noexcept {
+	if (_digits.size() != n + shift) {
+		return _digits.size() < n + shift ? -1 : 1;
+	}
+	for (size_t i = n; i-- > 0;) {
+		if (_digits[i + shift] != p[i]) {
+			return _digits[i + shift] < p[i] ? -1 : 1;
+		}
+	}
+	for (size_t i = 0; i < shift; ++i) {
+		if (_digits[i] != 0) return 1;
+	}
+	return 0;
+}
+
+void big_int::add_magnitude(const value_type *p, size_t n, bool sign, size_t shift) {
+	while (n > 0 && p[n - 1] == 0) --n;
+	if (n == 0) return;
+
+	if (!*this) {
+		_digits.assign(shift + n, 0);
+		std::copy(p, p + n, _digits.begin() + shift);
+		_sign = sign;
+		return;
+	}
+
+	value_type *d = _digits.data();
+
+	if (_sign == sign) {
+		size_t len = std::max(_digits.size(), shift + n);
+		_digits.reserve(len + 1);
+		_digits.resize(len, 0);
+		d = _digits.data();
+		value_type carry = __detail::add_n(d + shift, d + shift, len - shift, p, n);
+		if (carry) _digits.push_back(carry);
+		return;
+	}
+
+	int cmp = compare_magnitude(p, n, shift);
+	if (cmp >= 0) {
+		__detail::sub_n(d + shift, d + shift, _digits.size() - shift, p, n);
+	} else {
+		size_t len = shift + n;
+		_digits.resize(len, 0);
+		d = _digits.data();
+		unsigned char borrow = 0;
+		for (size_t i = 0; i < shift; ++i) {
+			d[i] = __detail::sub_with_borrow(0, d[i], borrow);
+		}
+		for (size_t i = shift; i < len; ++i) {
+			d[i] = __detail::sub_with_borrow(p[i - shift], d[i], borrow);
+		}
+		_sign = sign;
+	}
+	remove_leading_zeros();
+}
+
+namespace {
+// parallel multiplication settings, threshold 0 means serial
+std::mutex parallel_mutex;
+std::shared_ptr<__detail::work_stealing_pool> parallel_pool;
+std::atomic<size_t> parallel_threshold{0};
+}  // namespace
+
+void big_int::set_parallel_multiplication(size_t threads, size_t threshold_limbs) {
+	std::shared_ptr<__detail::work_stealing_pool> pool;
+	if (threads > 1) {
+		pool = std::make_shared<__detail::work_stealing_pool>(threads);
+	}
+
+	std::lock_guard lock(parallel_mutex);
+	// a product already running keeps its own reference to the old pool
+	parallel_pool = std::move(pool);
+	parallel_threshold.store(parallel_pool ? std::max<size_t>(threshold_limbs, __detail::karatsuba_threshold) : 0,
+	                         std::memory_order_release);
+}
+
+void big_int::multiply_magnitudes(std::vector<value_type, pp_allocator<value_type>> &result, const big_int &lhs,
+                                  const big_int &rhs, multiplication_rule rule) {
+	if (&lhs == &rhs) {
+		square_magnitude(result, lhs, rule);
+		return;
+	}
+
+	const big_int &a = lhs._digits.size() >= rhs._digits.size() ? lhs : rhs;
+	const big_int &b = lhs._digits.size() >= rhs._digits.size() ? rhs : lhs;
+	const size_t n = a._digits.size(), m = b._digits.size();
+
+	if (rule == multiplication_rule::trivial || m < __detail::karatsuba_threshold) {
+		result.resize(n + m);
+		__detail::mul_basecase(result.data(), a._digits.data(), n, b._digits.data(), m);
+		return;
+	}
+
+	if (size_t threshold = parallel_threshold.load(std::memory_order_acquire); threshold != 0 && m >= threshold) {
+		std::shared_ptr<__detail::work_stealing_pool> pool;
+		{
+			std::lock_guard lock(parallel_mutex);
+			pool = parallel_pool;
+		}
+		if (pool) {
+			result.resize(n + m);
+			__detail::mul_parallel(result.data(), a._digits.data(), n, b._digits.data(), m, *pool, threshold);
+			return;
+		}
+	}
+
+	// Product and Karatsuba scratch share one allocation
+	result.resize(n + m + __detail::mul_scratch_size(n, m));
+	__detail::mul(result.data(), a._digits.data(), n, b._digits.data(), m, result.data() + n + m);
+	result.resize(n + m);
+}
+
+void big_int::square_magnitude(std::vector<value_type, pp_allocator<value_type>> &result, const big_int &value,
+                               multiplication_rule rule) {
+	const size_t n = value._digits.size();
+	const value_type *a = value._digits.data();
+
+	if (rule == multiplication_rule::trivial || n < __detail::karatsuba_threshold) {
+		result.resize(2 * n);
+		__detail::sqr_basecase(result.data(), a, n);
+		return;
+	}
+
+	if (size_t threshold = parallel_threshold.load(std::memory_order_acquire); threshold != 0 && n >= threshold) {
+		std::shared_ptr<__detail::work_stealing_pool> pool;
+		{
+			std::lock_guard lock(parallel_mutex);
+			pool = parallel_pool;
+		}
+		if (pool) {
+			result.resize(2 * n);
+			__detail::karatsuba_parallel(result.data(), a, a, n, *pool, threshold);
+			return;
+		}
+	}
+
+	result.resize(2 * n + __detail::karatsuba_scratch_size(n));
+	__detail::karatsuba_sqr(result.data(), a, n, result.data() + 2 * n);
+	result.resize(2 * n);
+}
+
+void big_int::divide_magnitudes(const big_int &divisor, big_int *quotient, big_int *remainder) const {
+	const size_t n = _digits.size(), m = divisor._digits.size();
+	auto alloc = _digits.get_allocator();
+
+	if (compare_magnitude(divisor._digits.data(), m, 0) < 0) {
+		if (remainder) *remainder = *this;
+		if (quotient) *quotient = big_int(alloc);
+		return;
+	}
+
+	std::vector<value_type, pp_allocator<value_type>> q(n - m + 1, 0, alloc);
+
+	if (m == 1) {
+		const double_value_type v = divisor._digits[0];
+		double_value_type rem = 0;
+		for (size_t i = n; i-- > 0;) {
+			double_value_type cur = (rem << __detail::limb_bits) | _digits[i];
+			q[i] = static_cast<value_type>(cur / v);
+			rem = cur % v;
+		}
+		if (remainder) *remainder = big_int(static_cast<value_type>(rem), alloc);
+	} else {
+		const int s = std::countl_zero(divisor._digits.back());
+
+		// Normalised divisor and dividend share one scratch buffer
+		std::vector<value_type, pp_allocator<value_type>> scratch(m + n + 1, 0, alloc);
+		value_type *v = scratch.data(), *u = scratch.data() + m;
+
+		for (size_t i = m; i-- > 0;) {
+			v[i] = (divisor._digits[i] << s) | (s && i ? divisor._digits[i - 1] >> (__detail::limb_bits - s) : 0);
+		}
+		u[n] = s ? _digits[n - 1] >> (__detail::limb_bits - s) : 0;
+		for (size_t i = n; i-- > 0;) {
+			u[i] = (_digits[i] << s) | (s && i ? _digits[i - 1] >> (__detail::limb_bits - s) : 0);
+		}
+
+		__detail::divmod_knuth(q.data(), u, n, v, m);
+
+		if (remainder) {
+			std::vector<value_type, pp_allocator<value_type>> r(m, 0, alloc);
+			for (size_t i = 0; i < m; ++i) {
+				r[i] = (u[i] >> s) | (s && i + 1 < m ? u[i + 1] << (__detail::limb_bits - s) : 0);
+			}
+			*remainder = big_int(std::move(r));
+		}
+	}
+
+	if (quotient) *quotient = big_int(std::move(q));
+}
+
 std::strong_ordering big_int::operator<=>(const big_int &other) const noexcept {
 	if (_sign != other._sign) {
 		return _sign ? std::strong_ordering::greater : std::strong_ordering::less;
@@ -90,39 +997,7 @@ big_int big_int::operator--(int) {
 	return temp;
 }
 
-big_int &big_int::operator+=(const big_int &other) & {
-	if (_sign == other._sign) {
-		const size_t n = std::max(_digits.size(), other._digits.size());
-		_digits.resize(n, 0);
-
-		const unsigned int limb_bits = sizeof(unsigned int) * 8;
-		using wide_t = unsigned long long;
-		const wide_t BASE = wide_t(1) << limb_bits;
-		wide_t carry = 0;
-
-		for (size_t i = 0; i < n; ++i) {
-			wide_t lhs = static_cast<wide_t>(_digits[i]);
-			wide_t rhs = (i < other._digits.size()) ? static_cast<wide_t>(other._digits[i]) : 0;
-			wide_t sum = lhs + rhs + carry;
-			_digits[i] = static_cast<unsigned int>(sum % BASE);
-			carry = sum / BASE;
-		}
-		if (carry != 0) {
-			_digits.push_back(static_cast<unsigned int>(carry));
-		}
-	} else {
-		if (this->abs() >= other.abs()) {
-			this->minus_assign(other.abs());
-		} else {
-			big_int tmp = other.abs();
-			tmp.minus_assign(this->abs());
-			*this = std::move(tmp);
-			_sign = other._sign;
-		}
-	}
-	remove_leading_zeros();
-	return *this;
-}
+big_int &big_int::operator+=(const big_int &other) & { return plus_assign(other, 0); }
 
 big_int big_int::abs() const {
 	big_int result(*this);
@@ -130,11 +1005,7 @@ big_int big_int::abs() const {
 	return result;
 }
 
-big_int &big_int::operator-=(const big_int &other) & {
-	big_int temp = other;
-	temp._sign = !temp._sign;
-	return *this += temp;
-}
+big_int &big_int::operator-=(const big_int &other) & { return minus_assign(other, 0); }
 
 big_int big_int::operator+(const big_int &other) const {
 	big_int result(*this);
@@ -146,255 +1017,124 @@ big_int big_int::operator-(const big_int &other) const {
 	return result -= other;
 }
 
-//common
 big_int big_int::operator*(const big_int &other) const {
-	if (!(*this) || !other) return big_int(0);
-
-	std::vector<unsigned int, pp_allocator<unsigned int>> result;
-	result.resize(_digits.size() + other._digits.size(), 0);
-
-	constexpr size_t half_bits = sizeof(unsigned int) * 4;
-
-	constexpr unsigned int half_mask = __detail::generate_half_mask();
-
-	constexpr uint64_t full_mask = (static_cast<uint64_t>(half_mask) << half_bits) | half_mask;
-
-	constexpr size_t full_bits = half_bits * 2;
-
-	for (size_t i = 0; i < _digits.size(); ++i) {
-		uint64_t carry = 0;
-		for (size_t j = 0; j < other._digits.size() || carry; ++j) {
-			uint64_t multiplier = (j < other._digits.size()) ? other._digits[j] : 0;
-			uint64_t cur = result[i + j] + static_cast<uint64_t>(_digits[i]) * multiplier + carry;
-			result[i + j] = static_cast<unsigned int>(cur & full_mask);
-			carry = cur >> full_bits;
-		}
-	}
-
-	while (result.size() > 1 && result.back() == 0) result.pop_back();
-
-	bool res_sign = (_sign == other._sign);
-	return big_int(std::move(result), res_sign);
-}
-
-//Karatsuba
-// big_int big_int::operator*(const big_int &other) const {
-//     if (!(*this) || !other) {
-//         return big_int(0);
-//     }
-
-//     if (_digits.size() == 1 && other._digits.size() == 1) {
-//         uint64_t product = static_cast<uint64_t>(_digits[0]) * static_cast<uint64_t>(other._digits[0]);
-//         std::vector<unsigned int, pp_allocator<unsigned int>> result;
-        
-//         if (product > std::numeric_limits<unsigned int>::max()) {
-//             result.push_back(static_cast<unsigned int>(product));
-//             result.push_back(static_cast<unsigned int>(product >> (sizeof(unsigned int) * 8)));
-//         } else {
-//             result.push_back(static_cast<unsigned int>(product));
-//         }
-        
-//         return big_int(std::move(result), _sign == other._sign);
-//     }
-
-//     size_t max_size = std::max(_digits.size(), other._digits.size());
-//     size_t half = (max_size + 1) / 2;
-
-//     big_int high1, low1;
-//     if (_digits.size() > half) {
-//         high1 = big_int(std::vector<unsigned int>(_digits.begin() + half, _digits.end()), true);
-//         low1 = big_int(std::vector<unsigned int>(_digits.begin(), _digits.begin() + half), true);
-//     } else {
-//         high1 = big_int(0);
-//         low1 = *this;
-//         low1._sign = true;
-//     }
-
-//     big_int high2, low2;
-//     if (other._digits.size() > half) {
-//         high2 = big_int(std::vector<unsigned int>(other._digits.begin() + half, other._digits.end()), true);
-//         low2 = big_int(std::vector<unsigned int>(other._digits.begin(), other._digits.begin() + half), true);
-//     } else {
-//         high2 = big_int(0);
-//         low2 = other;
-//         low2._sign = true;
-//     }
-
-//     big_int z0 = low1 * low2;
-//     big_int z2 = high1 * high2;
-//     big_int z1 = (low1 + high1) * (low2 + high2) - z2 - z0;
-
-//     big_int result = (z2 << (2 * half * sizeof(unsigned int) * 8)) + 
-//                    (z1 << (half * sizeof(unsigned int) * 8)) + 
-//                    z0;
-
-//     result._sign = (_sign == other._sign);
-    
-//     return result;
-// }
-
-big_int &big_int::operator*=(const big_int &other) & {
-	*this = *this * other;
-	return *this;
+	if (!(*this) || !other) return big_int(_digits.get_allocator());
+
+	std::vector<value_type, pp_allocator<value_type>> result(_digits.get_allocator());
+	multiply_magnitudes(result, *this, other, decide_mult(other._digits.size()));
+
+	return big_int(std::move(result), _sign == other._sign);
 }
 
+big_int &big_int::operator*=(const big_int &other) & { return multiply_assign(other, decide_mult(other._digits.size())); }
+
 big_int big_int::operator/(const big_int &other) const {
-	if (other == big_int(0)) throw std::runtime_error("Division by zero");
-
-	big_int dividend = this->abs();
-	big_int divisor = other.abs();
-
-	if (dividend < divisor) return big_int(0);
-
-	size_t n = dividend._digits.size();
-	big_int quotient;
-	quotient._digits.resize(n, 0);
-	big_int R(0);
-
-	for (int i = static_cast<int>(n) - 1; i >= 0; i--) {
-		R = R << sizeof(unsigned int) * 8;
-		R += big_int(dividend._digits[i]);
-		unsigned long long left = 0, right = std::numeric_limits<unsigned int>::max();
-		unsigned int q_digit = 0;
-		while (left <= right) {
-			unsigned long long mid = left + (right - left) / 2;
-			big_int mid_val(mid);
-			big_int candidate = divisor * mid_val;
-			if (candidate <= R) {
-				q_digit = static_cast<unsigned int>(mid);
-				left = mid + 1;
-			} else {
-				right = mid - 1;
-			}
-		}
-		quotient._digits[i] = q_digit;
-		R = R - (divisor * big_int(q_digit));
-	}
+	if (!other) throw std::runtime_error("Division by zero");
 
+	big_int quotient(_digits.get_allocator());
+	divide_magnitudes(other, &quotient, nullptr);
 	quotient._sign = (this->_sign == other._sign);
 	quotient.remove_leading_zeros();
 	return quotient;
 }
 
 big_int big_int::operator%(const big_int &other) const {
-	if (other == big_int(0)) throw std::runtime_error("Modulo by zero");
-	big_int quotient = *this / other;
-	big_int product = quotient * other;
-	big_int remainder = *this - product;
-
-	if (remainder._digits.size() == 1 && remainder._digits[0] == 0)
-		remainder._sign = true;
-	else
-		remainder._sign = this->_sign;
+	if (!other) throw std::runtime_error("Modulo by zero");
 
+	big_int remainder(_digits.get_allocator());
+	divide_magnitudes(other, nullptr, &remainder);
+	remainder._sign = this->_sign;
+	remainder.remove_leading_zeros();
 	return remainder;
 }
 
-// big_int big_int::operator%(const big_int &other) const {
-//     if (other == big_int(0)) {
-//         throw std::runtime_error("Modulo by zero");
-//     }
-
-//     if (other._digits.size() > this->_digits.size()) {
-//         big_int remainder = *this;
-//         remainder._sign = this->_sign;
-//         return remainder;
-//     }
-
-//     big_int dividend = *this;
-//     dividend._sign = true;
-//     big_int divisor = other;
-//     divisor._sign = true;
-
-//     big_int remainder = 0;
-
-//     for (int i = (int)dividend._digits.size() - 1; i >= 0; --i) {
-//         remainder = remainder * big_int(10) + big_int(dividend._digits[i]);
-//         if (remainder < divisor) {
-//             continue;
-//         }
-
-//         big_int k = remainder / divisor;
-//         remainder = remainder - k * divisor;
-//     }
-
-//     remainder._sign = this->_sign;
-//     return remainder;
-// }
+template <class Op>
+big_int &big_int::bitwise_assign(const big_int &other, Op op) & {
+	if (&other == this) {
+		big_int copy(other);
+		return bitwise_assign(copy, op);
+	}
 
-big_int big_int::operator&(const big_int &other) const {
-	big_int result;
+	const size_t n = _digits.size(), m = other._digits.size(), len = std::max(n, m);
+	const value_type fill = _sign ? 0 : ~value_type(0), other_fill = other._sign ? 0 : ~value_type(0);
 
-	if (!_sign && other._sign)
-		result._sign = true;
-	else
-		result._sign = _sign;
+	// negative operands take part as infinite two's complement: this one in place, other through a copy
+	std::vector<value_type, pp_allocator<value_type>> scratch(_digits.get_allocator());
+	const value_type *rhs = other._digits.data();
+	if (!other._sign) {
+		scratch.resize(m);
+		__detail::negate_n(scratch.data(), rhs, m);
+		rhs = scratch.data();
+	}
 
-	size_t min_size = std::min(_digits.size(), other._digits.size());
-	result._digits.resize(min_size);
+	_digits.resize(len + 1);
+	value_type *r = _digits.data();
+	if (!_sign) __detail::negate_n(r, r, n);
 
-	for (size_t i = 0; i < min_size; ++i) {
-		result._digits[i] = _digits[i] & other._digits[i];
+	__detail::bitwise_n(r, r, rhs, std::min(n, m), op);
+	if (n < m) {
+		__detail::bitwise_fill_n(r + n, rhs + n, fill, m - n, op);
+	} else {
+		__detail::bitwise_fill_n(r + m, r + m, other_fill, n - m, op);
 	}
+	r[len] = op(fill, other_fill);
 
-	return result;
+	_sign = r[len] == 0;
+	if (!_sign) __detail::negate_n(r, r, len + 1);
+	remove_leading_zeros();
+	return *this;
 }
 
-big_int big_int::operator|(const big_int &other) const { return ~((~*this) & (~other)); }
+template <class Op>
+big_int big_int::bitwise(const big_int &other, Op op) const {
+	big_int result(_digits.get_allocator());
+	result._digits.reserve(std::max(_digits.size(), other._digits.size()) + 1);
+	result._digits.assign(_digits.begin(), _digits.end());
+	result._sign = _sign;
+	result.bitwise_assign(other, op);
+	return result;
+}
 
-big_int big_int::operator^(const big_int &other) const { return ((~*this) & other) | (*this & (~other)); }
+big_int big_int::operator&(const big_int &other) const { return bitwise(other, __detail::and_op{}); }
 
-big_int big_int::operator<<(size_t shift) const {
-	big_int result = *this;
+big_int big_int::operator|(const big_int &other) const { return bitwise(other, __detail::or_op{}); }
 
-	if (shift / (8 * sizeof(unsigned int)) > 0) {
-		size_t n = shift / (8 * sizeof(unsigned int));
-		std::vector<unsigned int> vec(n, 0);
-		result._digits.insert(result._digits.begin(), vec.begin(), vec.end());
-		shift %= 8 * sizeof(unsigned int);
-	}
+big_int big_int::operator^(const big_int &other) const { return bitwise(other, __detail::xor_op{}); }
 
-	if (shift == 0) return result;
+big_int big_int::operator<<(size_t shift) const {
+	if (!*this || shift == 0) return *this;
 
-	unsigned int c = 0;
+	const size_t limbs = shift / __detail::limb_bits, n = _digits.size();
+	const auto s = static_cast<unsigned int>(shift % __detail::limb_bits);
 
-	for (auto &num : result._digits) {
-		auto tmp = num;
-		num = (num << shift) | c;
-		c = tmp >> (8 * sizeof(unsigned int) - shift);
+	big_int result(_digits.get_allocator());
+	result._sign = _sign;
+	result._digits.resize(n + limbs + 1);
+	value_type *r = result._digits.data();
+	if (s == 0) {
+		std::copy(_digits.begin(), _digits.end(), r + limbs);
+	} else {
+		r[n + limbs] = __detail::lshift_n(r + limbs, _digits.data(), n, s);
 	}
-
-	if (c != 0) result._digits.push_back(c);
-
+	result.remove_leading_zeros();
 	return result;
 }
 
 big_int big_int::operator>>(size_t shift) const {
-	big_int result(*this);
-	if (shift / (8 * sizeof(unsigned int)) > 0) {
-		size_t n = shift / (8 * sizeof(unsigned int));
+	const size_t limbs = shift / __detail::limb_bits, n = _digits.size();
+	const auto s = static_cast<unsigned int>(shift % __detail::limb_bits);
 
-		if (n >= result._digits.size()) {
-			result._sign = true;
-			result._digits.clear();
-			result._digits.push_back(0);
-			return result;
-		}
+	big_int result(_digits.get_allocator());
+	if (limbs >= n) return result;
 
-		result._digits.erase(result._digits.begin(), result._digits.begin() + n);
-		shift %= 8 * sizeof(unsigned int);
-	}
-
-	if (shift == 0) return result;
-
-	unsigned int c = 0;
-
-	for (auto &num : std::views::reverse(result._digits)) {
-		auto tmp = num;
-		num = (num >> shift) | c;
-		c = tmp << (8 * sizeof(unsigned int) - shift);
+	result._sign = _sign;
+	result._digits.resize(n - limbs);
+	if (s == 0) {
+		std::copy(_digits.begin() + limbs, _digits.end(), result._digits.begin());
+	} else {
+		__detail::rshift_bits_n(result._digits.data(), _digits.data() + limbs, n - limbs, s);
 	}
-
+	result.remove_leading_zeros();
 	return result;
 }
 
@@ -404,79 +1144,111 @@ big_int &big_int::operator%=(const big_int &other) & {
 }
 
 big_int big_int::operator~() const {
-	if (_sign <= 0) {
-		throw std::runtime_error("Bitwise NOT on non-positive numbers not supported");
-	}
-	return (big_int(-1) * *this) - big_int(1);
+	// ~x = -x - 1 = -(x + 1)
+	big_int result(*this);
+	++result;
+	result._sign = !result._sign;
+	result.remove_leading_zeros();
+	return result;
 }
 
-big_int &big_int::operator&=(const big_int &other) & {
-	*this = *this & other;
-	return *this;
-}
+big_int &big_int::operator&=(const big_int &other) & { return bitwise_assign(other, __detail::and_op{}); }
 
-big_int &big_int::operator|=(const big_int &other) & {
-	*this = *this | other;
-	return *this;
-}
+big_int &big_int::operator|=(const big_int &other) & { return bitwise_assign(other, __detail::or_op{}); }
 
-big_int &big_int::operator^=(const big_int &other) & {
-	*this = *this ^ other;
-	return *this;
-}
+big_int &big_int::operator^=(const big_int &other) & { return bitwise_assign(other, __detail::xor_op{}); }
 
 big_int &big_int::operator<<=(size_t shift) & {
-	*this = *this << shift;
+	if (!*this || shift == 0) return *this;
+
+	const size_t limbs = shift / __detail::limb_bits, n = _digits.size();
+	const auto s = static_cast<unsigned int>(shift % __detail::limb_bits);
+
+	_digits.resize(n + limbs + (s == 0 ? 0 : 1));
+	value_type *d = _digits.data();
+	if (s == 0) {
+		std::copy_backward(d, d + n, d + n + limbs);
+	} else {
+		d[n + limbs] = __detail::lshift_n(d + limbs, d, n, s);
+	}
+	std::fill(d, d + limbs, value_type(0));
+	remove_leading_zeros();
 	return *this;
 }
 
 big_int &big_int::operator>>=(size_t shift) & {
-	*this = *this >> shift;
+	const size_t len = __detail::rshift_n(_digits.data(), _digits.size(), shift);
+	if (len == 0) {
+		_digits.assign(1, 0);
+		_sign = true;
+	} else {
+		_digits.resize(len);
+	}
 	return *this;
 }
 
+size_t big_int::popcount() const noexcept { return __detail::popcount_n(_digits.data(), _digits.size()); }
+
+size_t big_int::bit_length() const noexcept {
+	return (_digits.size() - 1) * __detail::limb_bits + std::bit_width(_digits.back());
+}
+
+size_t big_int::trailing_zeros() const noexcept {
+	return __detail::trailing_zero_bits(_digits.data(), _digits.size());
+}
+
 big_int &big_int::plus_assign(const big_int &other, size_t shift) & {
-	throw not_implemented("big_int &big_int::plus_assign(const big_int &, size_t)", "your code should be here...");
+	if (&other == this) {
+		big_int copy(other);
+		return plus_assign(copy, shift);
+	}
+	add_magnitude(other._digits.data(), other._digits.size(), other._sign, shift);
+	return *this;
 }
 
 big_int &big_int::minus_assign(const big_int &other, size_t shift) & {
-	const unsigned int limb_bits = sizeof(unsigned int) * 8;
-	const unsigned long long BASE = 1ULL << limb_bits;
+	if (&other == this) {
+		big_int copy(other);
+		return minus_assign(copy, shift);
+	}
+	add_magnitude(other._digits.data(), other._digits.size(), !other._sign, shift);
+	return *this;
+}
 
-	long long borrow = 0;
+big_int &big_int::addmul(const big_int &lhs, const big_int &rhs) & { return addmul_impl(lhs, rhs, false); }
 
-	for (size_t i = 0; i < other._digits.size(); ++i) {
-		size_t pos = i + shift;
-		if (pos >= _digits.size()) {
-			_digits.resize(pos + 1, 0);
-		}
+big_int &big_int::submul(const big_int &lhs, const big_int &rhs) & { return addmul_impl(lhs, rhs, true); }
 
-		long long diff = static_cast<long long>(_digits[pos]) - borrow - static_cast<long long>(other._digits[i]);
+big_int &big_int::addmul_impl(const big_int &lhs, const big_int &rhs, bool negate) {
+	if (!lhs || !rhs) return *this;
 
-		if (diff < 0) {
-			diff += BASE;
-			borrow = 1;
-		} else {
-			borrow = 0;
-		}
-		_digits[pos] = static_cast<unsigned int>(diff);
+	if (&lhs == this || &rhs == this) {
+		big_int copy(*this);
+		return addmul_impl(&lhs == this ? copy : lhs, &rhs == this ? copy : rhs, negate);
 	}
 
-	size_t pos = other._digits.size() + shift;
-	while (borrow && pos < _digits.size()) {
-		long long diff = static_cast<long long>(_digits[pos]) - borrow;
-		if (diff < 0) {
-			diff += BASE;
-			borrow = 1;
-		} else {
-			borrow = 0;
+	const big_int &a = lhs._digits.size() >= rhs._digits.size() ? lhs : rhs;
+	const big_int &b = lhs._digits.size() >= rhs._digits.size() ? rhs : lhs;
+	const size_t n = a._digits.size(), m = b._digits.size();
+	const bool product_sign = (lhs._sign == rhs._sign) != negate;
+
+	if ((product_sign == _sign || !*this) && m < __detail::karatsuba_threshold) {
+		// Accumulate a * b[j] row by row straight into the destination
+		size_t len = std::max(_digits.size(), n + m) + 1;
+		_digits.resize(len, 0);
+		value_type *d = _digits.data();
+		for (size_t j = 0; j < m; ++j) {
+			value_type carry = __detail::addmul_1(d + j, a._digits.data(), n, b._digits[j]);
+			__detail::add_n(d + j + n, d + j + n, len - j - n, &carry, 1);
 		}
-		_digits[pos] = static_cast<unsigned int>(diff);
-		++pos;
+		_sign = product_sign;
+		remove_leading_zeros();
+		return *this;
 	}
 
-	remove_leading_zeros();
-
+	std::vector<value_type, pp_allocator<value_type>> product(_digits.get_allocator());
+	multiply_magnitudes(product, a, b, decide_mult(m));
+	add_magnitude(product.data(), product.size(), product_sign, 0);
 	return *this;
 }
 
@@ -488,24 +1260,28 @@ big_int &big_int::operator/=(const big_int &other) & {
 std::string big_int::to_string() const {
 	if (_digits.size() == 1 && _digits[0] == 0) return "0";
 
-	std::vector<unsigned int, pp_allocator<unsigned int>> temp(_digits);
+	std::vector<value_type, pp_allocator<value_type>> temp(_digits);
 
-	constexpr size_t half_bits = sizeof(unsigned int) * 4;
-	constexpr unsigned int half_mask = __detail::generate_half_mask();
-	constexpr uint64_t full_mask = (static_cast<uint64_t>(half_mask) << half_bits) | half_mask;
-	constexpr uint64_t base = full_mask + 1;
+	// Peel off the largest power of ten fitting into a limb per pass instead of a single decimal digit
+	constexpr value_type chunk_base = sizeof(value_type) == 8 ? 10000000000000000000ull : 1000000000u;
+	constexpr size_t chunk_digits = sizeof(value_type) == 8 ? 19 : 9;
 
 	std::string result;
 
 	while (!(temp.size() == 1 && temp[0] == 0)) {
-		unsigned int carry = 0;
+		value_type carry = 0;
 		for (int i = static_cast<int>(temp.size()) - 1; i >= 0; --i) {
-			uint64_t current = static_cast<uint64_t>(carry) * base + temp[i];
-			temp[i] = static_cast<unsigned int>(current / 10);
-			carry = static_cast<unsigned int>(current % 10);
+			double_value_type current = (static_cast<double_value_type>(carry) << __detail::limb_bits) | temp[i];
+			temp[i] = static_cast<value_type>(current / chunk_base);
+			carry = static_cast<value_type>(current % chunk_base);
 		}
-		result.push_back('0' + carry);
 		while (temp.size() > 1 && temp.back() == 0) temp.pop_back();
+
+		bool last = temp.size() == 1 && temp[0] == 0;
+		for (size_t k = 0; k < chunk_digits && (!last || carry != 0); ++k) {
+			result.push_back(static_cast<char>('0' + carry % 10));
+			carry /= 10;
+		}
 	}
 
 	std::reverse(result.begin(), result.end());
@@ -527,6 +1303,89 @@ std::istream &operator>>(std::istream &stream, big_int &value) {
 	return stream;
 }
 
+namespace {
+constexpr size_t serialized_header_size = 8;
+constexpr size_t serialized_word_size = 4;
+
+/** Number of 32-bit words in the magnitude, 0 for zero
+ */
+size_t serialized_words(const big_int::value_type *digits, size_t n) noexcept {
+	if (n == 1 && digits[0] == 0) return 0;
+
+	constexpr size_t words_per_limb = sizeof(big_int::value_type) / serialized_word_size;
+	size_t words = n * words_per_limb;
+	if constexpr (words_per_limb == 2) {
+		if ((digits[n - 1] >> 32) == 0) --words;
+	}
+	return words;
+}
+}  // namespace
+
+void big_int::serialize(std::ostream &stream) const {
+	const size_t words = serialized_words(_digits.data(), _digits.size());
+	const uint64_t header = (static_cast<uint64_t>(words) << 1) | (_sign ? 0 : 1);
+
+	unsigned char header_bytes[serialized_header_size];
+	for (size_t i = 0; i < serialized_header_size; ++i) {
+		header_bytes[i] = static_cast<unsigned char>(header >> (8 * i));
+	}
+	stream.write(reinterpret_cast<const char *>(header_bytes), serialized_header_size);
+
+	if constexpr (std::endian::native == std::endian::little) {
+		stream.write(reinterpret_cast<const char *>(_digits.data()),
+		             static_cast<std::streamsize>(words * serialized_word_size));
+	} else {
+		for (size_t i = 0; i < words; ++i) {
+			const value_type limb = _digits[i * serialized_word_size / sizeof(value_type)];
+			const uint32_t word =
+			    static_cast<uint32_t>(limb >> ((i * serialized_word_size % sizeof(value_type)) * 8));
+			unsigned char word_bytes[serialized_word_size];
+			for (size_t j = 0; j < serialized_word_size; ++j) {
+				word_bytes[j] = static_cast<unsigned char>(word >> (8 * j));
+			}
+			stream.write(reinterpret_cast<const char *>(word_bytes), serialized_word_size);
+		}
+	}
+}
+
+big_int big_int::deserialize(std::istream &stream, pp_allocator<value_type> allocator) {
+	unsigned char header_bytes[serialized_header_size];
+	if (!stream.read(reinterpret_cast<char *>(header_bytes), serialized_header_size)) {
+		throw std::runtime_error("Truncated big_int record");
+	}
+
+	uint64_t header = 0;
+	for (size_t i = 0; i < serialized_header_size; ++i) {
+		header |= static_cast<uint64_t>(header_bytes[i]) << (8 * i);
+	}
+
+	const size_t words = static_cast<size_t>(header >> 1);
+	const size_t limbs = (words * serialized_word_size + sizeof(value_type) - 1) / sizeof(value_type);
+
+	big_int result(allocator);
+	if (words == 0) return result;
+
+	result._digits.resize(limbs);
+	if (!stream.read(reinterpret_cast<char *>(result._digits.data()),
+	                 static_cast<std::streamsize>(words * serialized_word_size))) {
+		throw std::runtime_error("Truncated big_int record");
+	}
+
+	if constexpr (std::endian::native != std::endian::little) {
+		for (auto &limb : result._digits) {
+			limb = std::byteswap(limb);
+		}
+	}
+
+	result._sign = (header & 1) == 0;
+	result.remove_leading_zeros();
+	return result;
+}
+
+size_t big_int::serialize_size() const noexcept {
+	return serialized_header_size + serialized_words(_digits.data(), _digits.size()) * serialized_word_size;
+}
+
 bool big_int::operator==(const big_int &other) const noexcept {
 	return (*this <=> other) == std::strong_ordering::equal;
 }
@@ -535,7 +1394,7 @@ bool big_int::operator!=(const big_int &other) const noexcept {
 	return (*this <=> other) != std::strong_ordering::equal;
 }
 
-big_int::big_int(const std::vector<unsigned int, pp_allocator<unsigned int>> &digits, bool sign)
+big_int::big_int(const std::vector<value_type, pp_allocator<value_type>> &digits, bool sign)
     : _sign(sign), _digits(digits) {
 	while (!_digits.empty() && _digits.back() == 0) {
 		_digits.pop_back();
@@ -547,7 +1406,7 @@ big_int::big_int(const std::vector<unsigned int, pp_allocator<unsigned int>> &di
 	}
 }
 
-big_int::big_int(std::vector<unsigned int, pp_allocator<unsigned int>> &&digits, bool sign) noexcept
+big_int::big_int(std::vector<value_type, pp_allocator<value_type>> &&digits, bool sign) noexcept
     : _sign(sign), _digits(std::move(digits)) {
 	while (!_digits.empty() && _digits.back() == 0) {
 		_digits.pop_back();
@@ -559,7 +1418,7 @@ big_int::big_int(std::vector<unsigned int, pp_allocator<unsigned int>> &&digits,
 	}
 }
 
-big_int::big_int(const std::string &num, unsigned int radix, pp_allocator<unsigned int> alloc)
+big_int::big_int(const std::string &num, unsigned int radix, pp_allocator<value_type> alloc)
     : _sign(true), _digits(alloc) {
 	if (num.empty()) {
 		throw std::invalid_argument("Empty string");
@@ -578,18 +1437,34 @@ big_int::big_int(const std::string &num, unsigned int radix, pp_allocator<unsign
 		throw std::invalid_argument("Number string is too short.");
 	}
 	bool original_sign = (start_idx == 0);
-	big_int base(radix, alloc);
-	big_int value(0, alloc);
+
+	_digits.reserve((num.size() - start_idx) * 6 / __detail::limb_bits + 1);
+	_digits.push_back(0);
+
+	// Digits are gathered into a limb-sized chunk, then folded in with one in-place multiply-add
+	value_type chunk = 0, chunk_scale = 1;
+	auto flush = [this, &chunk, &chunk_scale]() {
+		value_type carry = chunk;
+		for (auto &limb : _digits) {
+			double_value_type cur = static_cast<double_value_type>(limb) * chunk_scale + carry;
+			limb = static_cast<value_type>(cur);
+			carry = static_cast<value_type>(cur >> __detail::limb_bits);
+		}
+		if (carry) _digits.push_back(carry);
+		chunk = 0;
+		chunk_scale = 1;
+	};
 
 	for (size_t i = start_idx; i < num.size(); ++i) {
 		char ch = std::toupper(static_cast<unsigned char>(num[i]));
 		unsigned int digit = (std::isdigit(ch) ? (ch - '0') : (ch - 'A' + 10));
 
-		value *= base;
-		value += big_int(digit, alloc);
+		if (chunk_scale > std::numeric_limits<value_type>::max() / radix) flush();
+		chunk = chunk * radix + digit;
+		chunk_scale *= radix;
 	}
+	flush();
 
-	_digits = std::move(value._digits);
 	_sign = (_digits.size() == 1 && _digits[0] == 0) ? true : original_sign;
 
 	if (_digits.size() == 1 && _digits[0] == 0) {
@@ -606,16 +1481,24 @@ big_int::big_int(const std::string &num, unsigned int radix, pp_allocator<unsign
 	remove_leading_zeros();
 }
 
-big_int::big_int(pp_allocator<unsigned int> alloc) : _sign(true), _digits({0}, alloc) {}
+big_int::big_int(pp_allocator<value_type> alloc) : _sign(true), _digits({0}, alloc) {}
 
 big_int &big_int::multiply_assign(const big_int &other, multiplication_rule rule) & {
     switch (rule) {
         case multiplication_rule::trivial:
-           *this = *this * other;
-           break;
-        case multiplication_rule::Karatsuba:
-            *this = *this * other;
+        case multiplication_rule::Karatsuba: {
+            if (!*this || !other) {
+                _digits.assign(1, 0);
+                _sign = true;
+                break;
+            }
+            std::vector<value_type, pp_allocator<value_type>> result(_digits.get_allocator());
+            multiply_magnitudes(result, *this, other, rule);
+            _sign = _sign == other._sign;
+            _digits.swap(result);
+            remove_leading_zeros();
             break;
+        }
         case multiplication_rule::SchonhageStrassen:
             throw not_implemented(
                 "big_int &big_int::multiply_assign(const big_int &other, big_int::multiplication_rule rule) &",
@@ -627,7 +1510,7 @@ big_int &big_int::multiply_assign(const big_int &other, multiplication_rule rule
 }
 
 big_int &big_int::divide_assign(const big_int &other, big_int::division_rule rule) & {
-	if (other == big_int(0)) {
+	if (!other) {
 		throw std::logic_error("Division by zero");
 	}
 
@@ -650,8 +1533,31 @@ big_int &big_int::divide_assign(const big_int &other, big_int::division_rule rul
 }
 
 big_int &big_int::modulo_assign(const big_int &other, big_int::division_rule rule) & {
-	throw not_implemented("big_int &big_int::modulo_assign(const big_int &other, big_int::division_rule rule) &",
-	                      "your code should be here...");
+	if (!other) {
+		throw std::logic_error("Modulo by zero");
+	}
+
+	switch (rule) {
+		case division_rule::trivial:
+			*this = *this % other;
+			break;
+		case division_rule::Newton:
+			throw not_implemented(
+			    "big_int &big_int::modulo_assign(const big_int &other, big_int::division_rule rule) &",
+			    "Newton division not implemented yet.");
+		case division_rule::BurnikelZiegler:
+			throw not_implemented(
+			    "big_int &big_int::modulo_assign(const big_int &other, big_int::division_rule rule) &",
+			    "Burnikel-Ziegler division not implemented yet.");
+		default:
+			throw std::invalid_argument("Unknown division rule.");
+	}
+	return *this;
+}
+
+big_int::multiplication_rule big_int::decide_mult(size_t rhs) const noexcept {
+	return std::min(_digits.size(), rhs) < __detail::karatsuba_threshold ? multiplication_rule::trivial
+	                                                                      : multiplication_rule::Karatsuba;
 }
 
-big_int operator""_bi(unsigned long long n) {}
\ No newline at end of file
+big_int::division_rule big_int::decide_div(size_t) const noexcept { return division_rule::trivial; }
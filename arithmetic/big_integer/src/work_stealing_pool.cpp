@@ -0,0 +1,124 @@
+#include "../include/work_stealing_pool.h"
+
+namespace __detail {
+
+namespace {
+// queue owned by the current thread when it is a worker of that pool
+thread_local const work_stealing_pool *current_pool = nullptr;
+thread_local size_t current_queue = 0;
+}  // namespace
+
+work_stealing_pool::task_group::task_group(work_stealing_pool &pool) noexcept : _pool(pool) {}
+
+work_stealing_pool::task_group::~task_group() noexcept {
+	while (_pending.load(std::memory_order_acquire) != 0) {
+		if (!_pool.try_run_one()) std::this_thread::yield();
+	}
+}
+
+void work_stealing_pool::task_group::run(std::function<void()> task) {
+	_pending.fetch_add(1, std::memory_order_relaxed);
+	_pool.push([this, task = std::move(task)] {
+		try {
+			task();
+		} catch (...) {
+			std::lock_guard lock(_error_mutex);
+			if (!_error) _error = std::current_exception();
+		}
+		_pending.fetch_sub(1, std::memory_order_release);
+	});
+}
+
+void work_stealing_pool::task_group::wait() {
+	while (_pending.load(std::memory_order_acquire) != 0) {
+		if (!_pool.try_run_one()) std::this_thread::yield();
+	}
+
+	std::lock_guard lock(_error_mutex);
+	if (_error) std::rethrow_exception(std::exchange(_error, nullptr));
+}
+
+work_stealing_pool::work_stealing_pool(size_t threads) {
+	if (threads == 0) threads = 1;
+
+	_queues.reserve(threads);
+	for (size_t i = 0; i < threads; ++i) {
+		_queues.push_back(std::make_unique<queue>());
+	}
+
+	_workers.reserve(threads);
+	for (size_t i = 0; i < threads; ++i) {
+		_workers.emplace_back([this, i] { worker_loop(i); });
+	}
+}
+
+work_stealing_pool::~work_stealing_pool() noexcept {
+	{
+		std::lock_guard lock(_sleep_mutex);
+		_stopping = true;
+	}
+	_wake.notify_all();
+
+	for (auto &worker : _workers) {
+		worker.join();
+	}
+}
+
+size_t work_stealing_pool::size() const noexcept { return _workers.size(); }
+
+void work_stealing_pool::push(std::function<void()> task) {
+	size_t index = current_pool == this ? current_queue
+	                                    : _next_queue.fetch_add(1, std::memory_order_relaxed) % _queues.size();
+	{
+		std::lock_guard lock(_queues[index]->mutex);
+		_queues[index]->tasks.push_back(std::move(task));
+	}
+
+	{
+		std::lock_guard lock(_sleep_mutex);
+		_queued.fetch_add(1, std::memory_order_relaxed);
+	}
+	_wake.notify_one();
+}
+
+bool work_stealing_pool::try_run_one() {
+	const size_t count = _queues.size();
+	const size_t home = current_pool == this ? current_queue : 0;
+	std::function<void()> task;
+
+	for (size_t i = 0; i < count && !task; ++i) {
+		queue &q = *_queues[(home + i) % count];
+		std::lock_guard lock(q.mutex);
+		if (q.tasks.empty()) continue;
+
+		// own deque is used as a stack for locality, the others are robbed of their oldest, largest tasks
+		if (i == 0 && current_pool == this) {
+			task = std::move(q.tasks.back());
+			q.tasks.pop_back();
+		} else {
+			task = std::move(q.tasks.front());
+			q.tasks.pop_front();
+		}
+	}
+
+	if (!task) return false;
+
+	_queued.fetch_sub(1, std::memory_order_relaxed);
+	task();
+	return true;
+}
+
+void work_stealing_pool::worker_loop(size_t index) {
+	current_pool = this;
+	current_queue = index;
+
+	while (true) {
+		if (try_run_one()) continue;
+
+		std::unique_lock lock(_sleep_mutex);
+		_wake.wait(lock, [this] { return _stopping || _queued.load(std::memory_order_relaxed) != 0; });
+		if (_stopping) return;
+	}
+}
+
+}  // namespace __detail
@@ -5,6 +5,8 @@
 #include <client_logger_builder.h>
 #include <operation_not_supported.h>
 
+#include <sstream>
+
 logger *create_logger(
     std::vector<std::pair<std::string, logger::severity>> const &output_file_streams_setup,
     bool use_console_stream = true,
@@ -231,6 +233,206 @@ TEST(positive_tests, test9)
     delete logger;
 }
 
+TEST(positive_tests, test10)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "bigint_logs.txt",
+                logger::severity::information
+            },
+        });
+    
+    big_int bigint_1("123");
+    big_int bigint_2("-5");
+    
+    bigint_1.plus_assign(big_int(1), 1);
+    EXPECT_TRUE(bigint_1 == (big_int(1) << (sizeof(big_int::value_type) * 8)) + big_int(123));
+    
+    bigint_1.minus_assign(bigint_2, 2);
+    EXPECT_TRUE(bigint_1 == (big_int(5) << (2 * sizeof(big_int::value_type) * 8)) + (big_int(1) << (sizeof(big_int::value_type) * 8)) + big_int(123));
+    
+    delete logger;
+}
+
+TEST(positive_tests, test11)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "bigint_logs.txt",
+                logger::severity::information
+            },
+        });
+    
+    big_int bigint_1("32850346459076457453464575686784654");
+    big_int bigint_2("423534596495087569087908753095322");
+    big_int accumulator_1("-1000");
+    big_int accumulator_2("7");
+    
+    accumulator_1.addmul(bigint_1, bigint_2);
+    accumulator_2.submul(bigint_1, bigint_2);
+    
+    EXPECT_EQ(accumulator_1.to_string(), "13913258232268776112784062165548206006840216231044633796292148787588");
+    EXPECT_EQ(accumulator_2.to_string(), "-13913258232268776112784062165548206006840216231044633796292148788581");
+    
+    delete logger;
+}
+
+TEST(positive_tests, test12)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "bigint_logs.txt",
+                logger::severity::information
+            },
+        });
+    
+    big_int bigint_1("32850346459076457453464575686784654");
+    big_int bigint_2("423534596495087569087908753095322");
+    big_int bigint_3("-1000");
+    
+    big_int result = bigint_1.lazy() * bigint_2 + bigint_3 - bigint_1;
+    EXPECT_EQ(result.to_string(), "13913258232268776112784062165548173156493757154587180331716462002934");
+    
+    bigint_3 = bigint_3.lazy() * bigint_3 - bigint_3;
+    EXPECT_EQ(bigint_3.to_string(), "1001000");
+    
+    delete logger;
+}
+
+TEST(positive_tests, test13)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "bigint_logs.txt",
+                logger::severity::information
+            },
+        });
+    
+    big_int bigint_1("471508840073091131783473196303761218200052779088977540677222249064715780096");
+    big_int bigint_2("-19081198930630386340460890345619513933485791647587252209348899892019305167978496");
+    
+    EXPECT_EQ(big_int::gcd(bigint_1, bigint_2).to_string(), "897077373028006866810763888558985969664");
+    EXPECT_EQ(big_int::gcd(bigint_2, big_int("0")).to_string(), "19081198930630386340460890345619513933485791647587252209348899892019305167978496");
+    EXPECT_EQ(big_int::gcd(big_int("0"), big_int("0")).to_string(), "0");
+    
+    delete logger;
+}
+
+TEST(positive_tests, test14)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "bigint_logs.txt",
+                logger::severity::information
+            },
+        });
+    
+    big_int bigint_1("-32850346459076457453464575686784654");
+    big_int odd_modulus("423534596495087569087908753095323");
+    big_int even_modulus("423534596495087569087908753095324");
+    
+    EXPECT_EQ(bigint_1.square().to_string(), "1079145262481357146352374208130797791005570763377403956937260969899716");
+    EXPECT_EQ(bigint_1.pow(7).to_string(), "-41283801357185233134806639092964816566614711092312616841205232297343743217874752598364166762016188051825533021015246881833482970489595244251555855751190940663299930816339889178848437205019366826918927972515055029743089880707213703525865741184");
+    EXPECT_EQ(bigint_1.powmod(big_int("65537"), odd_modulus).to_string(), "222805307715719807746442399459822");
+    EXPECT_EQ(bigint_1.powmod(big_int("65537"), even_modulus).to_string(), "300361947242142376949637478852216");
+    EXPECT_EQ(bigint_1.powmod(big_int("0"), odd_modulus).to_string(), "1");
+    
+    delete logger;
+}
+
+TEST(positive_tests, test15)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "bigint_logs.txt",
+                logger::severity::information
+            },
+        });
+    
+    big_int bigint_1("-32850346459076457453464575686784654");
+    big_int bigint_2("4294967296");
+    big_int bigint_3("0");
+    
+    std::stringstream stream;
+    bigint_1.serialize(stream);
+    bigint_2.serialize(stream);
+    bigint_3.serialize(stream);
+    
+    EXPECT_EQ(bigint_1.serialize_size(), 8u + 4u * 4u);
+    EXPECT_EQ(bigint_2.serialize_size(), 8u + 2u * 4u);
+    EXPECT_EQ(bigint_3.serialize_size(), 8u);
+    EXPECT_EQ(stream.str().size(), bigint_1.serialize_size() + bigint_2.serialize_size() + bigint_3.serialize_size());
+    EXPECT_EQ(stream.str().substr(24, 12), std::string("\x04\0\0\0\0\0\0\0\0\0\0\0", 12));
+    
+    EXPECT_EQ(big_int::deserialize(stream).to_string(), bigint_1.to_string());
+    EXPECT_EQ(big_int::deserialize(stream).to_string(), bigint_2.to_string());
+    EXPECT_EQ(big_int::deserialize(stream).to_string(), bigint_3.to_string());
+    EXPECT_THROW(big_int::deserialize(stream), std::runtime_error);
+    
+    delete logger;
+}
+
+TEST(positive_tests, test16)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "bigint_logs.txt",
+                logger::severity::information
+            },
+        });
+    
+    constexpr auto product = fixed_big_int<4>("-32850346459076457453", 10) * fixed_big_int<4>(1000000007);
+    static_assert(product < fixed_big_int<4>(0));
+    
+    EXPECT_EQ(big_int(product).to_string(), "-32850346689028882666535202171");
+    EXPECT_EQ((32850346459076457453464575686784654_bi).to_string(), "32850346459076457453464575686784654");
+    EXPECT_EQ((0xFFFFFFFFFFFFFFFFFFFF_bi).to_string(), "1208925819614629174706175");
+    EXPECT_EQ((0b1011_bi).to_string(), "11");
+    EXPECT_EQ((0_bi).to_string(), "0");
+    
+    delete logger;
+}
+
+TEST(positive_tests, test17)
+{
+    logger *logger = create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "bigint_logs.txt",
+                logger::severity::information
+            },
+        });
+    
+    big_int bigint_1("-32850346459076457453464575686784654");
+    big_int bigint_2("423534596495087569087908753095323");
+    
+    EXPECT_EQ((bigint_1 & bigint_2).to_string(), "86220072517531538560467777751058");
+    EXPECT_EQ((bigint_1 | bigint_2).to_string(), "-32513031935098901422937134711440389");
+    EXPECT_EQ((bigint_1 ^ bigint_2).to_string(), "-32599252007616432961497602489191447");
+    EXPECT_EQ((~bigint_1).to_string(), "32850346459076457453464575686784653");
+    
+    big_int shifted(bigint_2);
+    shifted <<= 100;
+    EXPECT_EQ(shifted.to_string(), "536893885464418701478050510608758359809178594578577295774056448");
+    shifted >>= 137;
+    EXPECT_EQ(shifted.to_string(), "3081619772238537327851");
+    EXPECT_EQ((bigint_1 >> 100).to_string(), "-25914");
+    
+    EXPECT_EQ(bigint_2.popcount(), 59u);
+    EXPECT_EQ(bigint_2.bit_length(), 109u);
+    EXPECT_EQ(bigint_1.trailing_zeros(), 1u);
+    EXPECT_EQ(big_int(0).bit_length(), 0u);
+    
+    delete logger;
+}
+
 int main(
     int argc,
     char **argv)
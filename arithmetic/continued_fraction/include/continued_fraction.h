@@ -1,6 +1,8 @@
 #ifndef MP_OS_CONTINUED_FRACTION_H
 #define MP_OS_CONTINUED_FRACTION_H
 
+#include <iterator>
+#include <ranges>
 #include <vector>
 
 #include <big_int.h>
@@ -13,6 +15,276 @@ private:
 
     continued_fraction() = default;
 
+    /** Builds a fraction from coprime parts without another gcd pass, only the sign is fixed up
+     */
+    static fraction make_reduced(big_int numerator, big_int denominator);
+
+    static big_int const &numerator_of(fraction const &value) noexcept;
+
+    static big_int const &denominator_of(fraction const &value) noexcept;
+
+public:
+
+    /** Partial quotients of a fraction, produced by one Euclid pass with O(1) state.
+     *  The first quotient is the floor of the value, the last one is at least 2 unless the value is an integer
+     */
+    class partial_quotients_range final
+    {
+
+    public:
+
+        class iterator final
+        {
+
+        public:
+
+            using value_type = big_int;
+            using difference_type = std::ptrdiff_t;
+            using iterator_concept = std::input_iterator_tag;
+
+        private:
+
+            friend class partial_quotients_range;
+
+            big_int _numerator;
+            big_int _denominator;
+            big_int _quotient;
+            bool _done = true;
+
+            iterator(big_int numerator, big_int denominator);
+
+            void step();
+
+        public:
+
+            iterator() = default;
+
+            big_int const &operator*() const noexcept;
+
+            iterator &operator++();
+
+            void operator++(int);
+
+            bool operator==(std::default_sentinel_t) const noexcept;
+
+        };
+
+    private:
+
+        big_int _numerator;
+        big_int _denominator;
+
+    public:
+
+        explicit partial_quotients_range(fraction const &value);
+
+        iterator begin() const;
+
+        std::default_sentinel_t end() const noexcept;
+
+    };
+
+    /** Convergents h_n / k_n of a range of partial quotients, computed by the h_n = a_n * h_n-1 + h_n-2
+     *  recurrences; only the last two numerators and denominators are kept
+     */
+    template<std::ranges::input_range R>
+    requires std::convertible_to<std::ranges::range_reference_t<R>, big_int const &>
+    class convergents_range final
+    {
+
+    public:
+
+        class iterator final
+        {
+
+        public:
+
+            using value_type = fraction;
+            using difference_type = std::ptrdiff_t;
+            using iterator_concept = std::input_iterator_tag;
+
+        private:
+
+            friend class convergents_range;
+
+            std::ranges::iterator_t<R> _current;
+            std::ranges::sentinel_t<R> _end;
+            big_int _numerator = big_int(1);
+            big_int _previous_numerator = big_int(0);
+            big_int _denominator = big_int(0);
+            big_int _previous_denominator = big_int(1);
+
+            iterator(std::ranges::iterator_t<R> current, std::ranges::sentinel_t<R> end)
+                : _current(std::move(current)), _end(std::move(end))
+            {
+                advance();
+            }
+
+            void advance()
+            {
+                if (_current == _end)
+                {
+                    return;
+                }
+
+                big_int const &quotient = *_current;
+                _previous_numerator.addmul(quotient, _numerator);
+                _previous_denominator.addmul(quotient, _denominator);
+                std::swap(_numerator, _previous_numerator);
+                std::swap(_denominator, _previous_denominator);
+            }
+
+        public:
+
+            iterator() = default;
+
+            fraction operator*() const
+            {
+                return make_reduced(_numerator, _denominator);
+            }
+
+            iterator &operator++()
+            {
+                ++_current;
+                advance();
+                return *this;
+            }
+
+            void operator++(int)
+            {
+                ++*this;
+            }
+
+            bool operator==(std::default_sentinel_t) const
+            {
+                return _current == _end;
+            }
+
+        };
+
+    private:
+
+        R _quotients;
+
+    public:
+
+        explicit convergents_range(R quotients)
+            : _quotients(std::move(quotients))
+        {}
+
+        iterator begin()
+        {
+            return iterator(std::ranges::begin(_quotients), std::ranges::end(_quotients));
+        }
+
+        std::default_sentinel_t end() const noexcept
+        {
+            return {};
+        }
+
+    };
+
+    /** One run of equal moves in a tree path
+     */
+    struct path_run
+    {
+        bool right;
+        big_int length;
+    };
+
+    /** Stern-Brocot path of a positive fraction as runs of equal moves: R^a0 L^a1 R^a2 ... with the last
+     *  run shortened by one, empty runs are skipped
+     */
+    class Stern_Brokot_path_range final
+    {
+
+    public:
+
+        class iterator final
+        {
+
+        public:
+
+            using value_type = path_run;
+            using difference_type = std::ptrdiff_t;
+            using iterator_concept = std::input_iterator_tag;
+
+        private:
+
+            friend class Stern_Brokot_path_range;
+
+            partial_quotients_range::iterator _next;
+            path_run _run{ false, big_int(0) };
+            bool _done = true;
+
+            explicit iterator(partial_quotients_range::iterator next);
+
+            void step();
+
+        public:
+
+            iterator() = default;
+
+            path_run const &operator*() const noexcept;
+
+            iterator &operator++();
+
+            void operator++(int);
+
+            bool operator==(std::default_sentinel_t) const noexcept;
+
+        };
+
+    private:
+
+        partial_quotients_range _quotients;
+
+    public:
+
+        explicit Stern_Brokot_path_range(fraction const &value);
+
+        iterator begin() const;
+
+        std::default_sentinel_t end() const noexcept;
+
+    };
+
+public:
+
+    static partial_quotients_range partial_quotients(
+        fraction const &value);
+
+    static convergents_range<partial_quotients_range> convergents(
+        fraction const &value);
+
+    template<std::ranges::viewable_range R>
+    static auto convergents(
+        R &&quotients)
+    {
+        return convergents_range<std::views::all_t<R>>(std::views::all(std::forward<R>(quotients)));
+    }
+
+    /** Closest fraction to value with a denominator not above max_denominator: the last convergent
+     *  within the bound or the best semiconvergent after it
+     */
+    static fraction best_rational_approximation(
+        fraction const &value,
+        big_int const &max_denominator);
+
+    static Stern_Brokot_path_range to_Stern_Brokot_tree_runs(
+        fraction const &value);
+
+    static fraction from_Stern_Brokot_tree_runs(
+        std::vector<path_run> const &runs);
+
+    /** Calkin-Wilf path of a positive fraction from the root, it is the Stern-Brocot path with the runs reversed
+     */
+    static std::vector<path_run> to_Calkin_Wilf_tree_runs(
+        fraction const &value);
+
+    static fraction from_Calkin_Wilf_tree_runs(
+        std::vector<path_run> const &runs);
+
 public:
 
     static std::vector<big_int> to_continued_fraction_representation(
@@ -41,4 +313,4 @@ public:
 
 };
 
-#endif //MP_OS_CONTINUED_FRACTION_H
\ No newline at end of file
+#endif //MP_OS_CONTINUED_FRACTION_H
@@ -1,51 +1,408 @@
 #include "../include/continued_fraction.h"
 
-#include <not_implemented.h>
+#include <algorithm>
+#include <stdexcept>
+
+fraction continued_fraction::make_reduced(
+    big_int numerator,
+    big_int denominator)
+{
+    if (!denominator)
+    {
+        throw std::invalid_argument("Denominator cannot be zero");
+    }
+
+    if (denominator < big_int(0))
+    {
+        numerator = big_int(0) - numerator;
+        denominator = big_int(0) - denominator;
+    }
+
+    fraction result;
+    result._numerator = std::move(numerator);
+    result._denominator = std::move(denominator);
+    return result;
+}
+
+big_int const &continued_fraction::numerator_of(
+    fraction const &value) noexcept
+{
+    return value._numerator;
+}
+
+big_int const &continued_fraction::denominator_of(
+    fraction const &value) noexcept
+{
+    return value._denominator;
+}
+
+continued_fraction::partial_quotients_range::iterator::iterator(
+    big_int numerator,
+    big_int denominator)
+    : _numerator(std::move(numerator)), _denominator(std::move(denominator)), _done(false)
+{
+    step();
+}
+
+void continued_fraction::partial_quotients_range::iterator::step()
+{
+    if (!_denominator)
+    {
+        _done = true;
+        return;
+    }
+
+    // floored division, only the first quotient can be negative
+    big_int remainder = _numerator % _denominator;
+    _quotient = _numerator / _denominator;
+    if (remainder < big_int(0))
+    {
+        _quotient -= big_int(1);
+        remainder += _denominator;
+    }
+
+    _numerator = std::move(_denominator);
+    _denominator = std::move(remainder);
+}
+
+big_int const &continued_fraction::partial_quotients_range::iterator::operator*() const noexcept
+{
+    return _quotient;
+}
+
+continued_fraction::partial_quotients_range::iterator &continued_fraction::partial_quotients_range::iterator::operator++()
+{
+    step();
+    return *this;
+}
+
+void continued_fraction::partial_quotients_range::iterator::operator++(int)
+{
+    step();
+}
+
+bool continued_fraction::partial_quotients_range::iterator::operator==(std::default_sentinel_t) const noexcept
+{
+    return _done;
+}
+
+continued_fraction::partial_quotients_range::partial_quotients_range(
+    fraction const &value)
+    : _numerator(numerator_of(value)), _denominator(denominator_of(value))
+{
+    if (_denominator < big_int(0))
+    {
+        _numerator = big_int(0) - _numerator;
+        _denominator = big_int(0) - _denominator;
+    }
+}
+
+continued_fraction::partial_quotients_range::iterator continued_fraction::partial_quotients_range::begin() const
+{
+    return iterator(_numerator, _denominator);
+}
+
+std::default_sentinel_t continued_fraction::partial_quotients_range::end() const noexcept
+{
+    return {};
+}
+
+continued_fraction::Stern_Brokot_path_range::iterator::iterator(
+    partial_quotients_range::iterator next)
+    : _next(std::move(next)), _run{ false, big_int(0) }, _done(false)
+{
+    step();
+}
+
+void continued_fraction::Stern_Brokot_path_range::iterator::step()
+{
+    do
+    {
+        if (_next == std::default_sentinel)
+        {
+            _done = true;
+            return;
+        }
+
+        // runs alternate starting with R, a run of zero length keeps the alternation
+        _run.right = !_run.right;
+        _run.length = *_next;
+        ++_next;
+        if (_next == std::default_sentinel)
+        {
+            _run.length -= big_int(1);
+        }
+    } while (!_run.length);
+}
+
+continued_fraction::path_run const &continued_fraction::Stern_Brokot_path_range::iterator::operator*() const noexcept
+{
+    return _run;
+}
+
+continued_fraction::Stern_Brokot_path_range::iterator &continued_fraction::Stern_Brokot_path_range::iterator::operator++()
+{
+    step();
+    return *this;
+}
+
+void continued_fraction::Stern_Brokot_path_range::iterator::operator++(int)
+{
+    step();
+}
+
+bool continued_fraction::Stern_Brokot_path_range::iterator::operator==(std::default_sentinel_t) const noexcept
+{
+    return _done;
+}
+
+continued_fraction::Stern_Brokot_path_range::Stern_Brokot_path_range(
+    fraction const &value)
+    : _quotients(value)
+{
+    if (numerator_of(value) <= big_int(0))
+    {
+        throw std::invalid_argument("Tree paths exist only for positive fractions");
+    }
+}
+
+continued_fraction::Stern_Brokot_path_range::iterator continued_fraction::Stern_Brokot_path_range::begin() const
+{
+    return iterator(_quotients.begin());
+}
+
+std::default_sentinel_t continued_fraction::Stern_Brokot_path_range::end() const noexcept
+{
+    return {};
+}
+
+continued_fraction::partial_quotients_range continued_fraction::partial_quotients(
+    fraction const &value)
+{
+    return partial_quotients_range(value);
+}
+
+continued_fraction::convergents_range<continued_fraction::partial_quotients_range> continued_fraction::convergents(
+    fraction const &value)
+{
+    return convergents_range<partial_quotients_range>(partial_quotients_range(value));
+}
+
+fraction continued_fraction::best_rational_approximation(
+    fraction const &value,
+    big_int const &max_denominator)
+{
+    if (max_denominator < big_int(1))
+    {
+        throw std::invalid_argument("Denominator bound must be positive");
+    }
+
+    if (denominator_of(value) <= max_denominator)
+    {
+        return value;
+    }
+
+    big_int numerator(1), previous_numerator(0);
+    big_int denominator(0), previous_denominator(1);
+
+    for (big_int const &quotient : partial_quotients(value))
+    {
+        big_int next_denominator = previous_denominator;
+        next_denominator.addmul(quotient, denominator);
+        if (next_denominator > max_denominator)
+        {
+            // best semiconvergent (h_n-2 + t * h_n-1) / (k_n-2 + t * k_n-1) with t as large as the bound allows
+            big_int t = (max_denominator - previous_denominator) / denominator;
+            previous_numerator.addmul(t, numerator);
+            previous_denominator.addmul(t, denominator);
+
+            fraction convergent = make_reduced(std::move(numerator), std::move(denominator));
+            fraction semiconvergent = make_reduced(std::move(previous_numerator), std::move(previous_denominator));
+            return (semiconvergent - value).abs() < (convergent - value).abs()
+                ? semiconvergent
+                : convergent;
+        }
+
+        previous_numerator.addmul(quotient, numerator);
+        std::swap(numerator, previous_numerator);
+        previous_denominator = std::move(denominator);
+        denominator = std::move(next_denominator);
+    }
+
+    return make_reduced(std::move(numerator), std::move(denominator));
+}
+
+continued_fraction::Stern_Brokot_path_range continued_fraction::to_Stern_Brokot_tree_runs(
+    fraction const &value)
+{
+    return Stern_Brokot_path_range(value);
+}
+
+fraction continued_fraction::from_Stern_Brokot_tree_runs(
+    std::vector<path_run> const &runs)
+{
+    // bounds a/b < node < c/d, the node is their mediant
+    big_int a(0), b(1), c(1), d(0);
+
+    for (auto const &run : runs)
+    {
+        if (run.right)
+        {
+            a.addmul(run.length, c);
+            b.addmul(run.length, d);
+        }
+        else
+        {
+            c.addmul(run.length, a);
+            d.addmul(run.length, b);
+        }
+    }
+
+    return make_reduced(a + c, b + d);
+}
+
+std::vector<continued_fraction::path_run> continued_fraction::to_Calkin_Wilf_tree_runs(
+    fraction const &value)
+{
+    std::vector<path_run> runs;
+    for (auto const &run : to_Stern_Brokot_tree_runs(value))
+    {
+        runs.push_back(run);
+    }
+    std::reverse(runs.begin(), runs.end());
+    return runs;
+}
+
+fraction continued_fraction::from_Calkin_Wilf_tree_runs(
+    std::vector<path_run> const &runs)
+{
+    // left child of a/b is a/(a + b), right child is (a + b)/b
+    big_int a(1), b(1);
+
+    for (auto const &run : runs)
+    {
+        if (run.right)
+        {
+            a.addmul(run.length, b);
+        }
+        else
+        {
+            b.addmul(run.length, a);
+        }
+    }
+
+    return make_reduced(std::move(a), std::move(b));
+}
+
+namespace
+{
+
+std::vector<bool> expand_runs(
+    std::ranges::input_range auto &&runs)
+{
+    std::vector<bool> path;
+    for (continued_fraction::path_run const &run : runs)
+    {
+        for (big_int i(0); i < run.length; i += big_int(1))
+        {
+            path.push_back(run.right);
+        }
+    }
+    return path;
+}
+
+std::vector<continued_fraction::path_run> compress_path(
+    std::vector<bool> const &path)
+{
+    std::vector<continued_fraction::path_run> runs;
+    for (bool step : path)
+    {
+        if (runs.empty() || runs.back().right != step)
+        {
+            runs.push_back({ step, big_int(0) });
+        }
+        runs.back().length += big_int(1);
+    }
+    return runs;
+}
+
+}
 
 std::vector<big_int> continued_fraction::to_continued_fraction_representation(
     fraction const &value)
 {
-    throw not_implemented("std::vector<big_integer> continued_fraction::to_continued_fraction_representation(fraction const &)", "your code should be here...");
+    std::vector<big_int> result;
+    for (big_int const &quotient : partial_quotients(value))
+    {
+        result.push_back(quotient);
+    }
+    return result;
 }
 
 fraction continued_fraction::from_continued_fraction_representation(
     std::vector<big_int> const &continued_fraction_representation)
 {
-    throw not_implemented("fraction continued_fraction::from_continued_fraction_representation(std::vector<big_integer> const &)", "your code should be here...");
+    if (continued_fraction_representation.empty())
+    {
+        throw std::invalid_argument("Continued fraction representation is empty");
+    }
+
+    // the last convergent is the value itself
+    big_int numerator(1), previous_numerator(0);
+    big_int denominator(0), previous_denominator(1);
+    for (big_int const &quotient : continued_fraction_representation)
+    {
+        previous_numerator.addmul(quotient, numerator);
+        previous_denominator.addmul(quotient, denominator);
+        std::swap(numerator, previous_numerator);
+        std::swap(denominator, previous_denominator);
+    }
+
+    return make_reduced(std::move(numerator), std::move(denominator));
 }
 
 std::vector<fraction> continued_fraction::to_convergents_series(
     fraction const &value)
 {
-    throw not_implemented("std::vector<fraction> continued_fraction::to_convergents_series(fraction const &)", "your code should be here...");
+    std::vector<fraction> result;
+    for (auto &&convergent : convergents(value))
+    {
+        result.push_back(std::move(convergent));
+    }
+    return result;
 }
 
 std::vector<fraction> continued_fraction::to_convergents_series(
     std::vector<big_int> const &continued_fraction_representation)
 {
-    throw not_implemented("std::vector<fraction> continued_fraction::to_convergents_series(std::vector<big_integer> const &)", "your code should be here...");
+    std::vector<fraction> result;
+    for (auto &&convergent : convergents(continued_fraction_representation))
+    {
+        result.push_back(std::move(convergent));
+    }
+    return result;
 }
 
 std::vector<bool> continued_fraction::to_Stern_Brokot_tree_path(
     fraction const &value)
 {
-    throw not_implemented("std::vector<bool> continued_fraction::to_Stern_Brokot_tree_path(fraction const &)", "your code should be here...");
+    return expand_runs(to_Stern_Brokot_tree_runs(value));
 }
 
 fraction continued_fraction::from_Stern_Brokot_tree_path(
     std::vector<bool> const &path)
 {
-    throw not_implemented("fraction continued_fraction::from_Stern_Brokot_tree_path(std::vector<bool> const &)", "your code should be here...");
+    return from_Stern_Brokot_tree_runs(compress_path(path));
 }
 
 std::vector<bool> continued_fraction::to_Calkin_Wilf_tree_path(
     fraction const &value)
 {
-    throw not_implemented("std::vector<bool> continued_fraction::to_Calkin_Wilf_tree_path(fraction const &)", "your code should be here...");
+    return expand_runs(to_Calkin_Wilf_tree_runs(value));
 }
 
 fraction continued_fraction::from_Calkin_Wilf_tree_path(
     std::vector<bool> const &path)
 {
-    throw not_implemented("fraction continued_fraction::from_Calkin_Wilf_tree_path(std::vector<bool> const &)", "your code should be here...");
-}
\ No newline at end of file
+    return from_Calkin_Wilf_tree_runs(compress_path(path));
+}
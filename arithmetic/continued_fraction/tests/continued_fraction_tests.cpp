@@ -0,0 +1,164 @@
+#include <gtest/gtest.h>
+
+#include <continued_fraction.h>
+
+#include <string>
+#include <vector>
+
+namespace
+{
+
+std::vector<std::string> quotients_of(
+    fraction const &value)
+{
+    std::vector<std::string> result;
+    for (big_int const &quotient : continued_fraction::partial_quotients(value))
+    {
+        result.push_back(quotient.to_string());
+    }
+    return result;
+}
+
+std::vector<std::string> convergents_of(
+    fraction const &value)
+{
+    std::vector<std::string> result;
+    for (fraction const &convergent : continued_fraction::convergents(value))
+    {
+        result.push_back(convergent.to_string());
+    }
+    return result;
+}
+
+std::vector<std::string> runs_as_strings(
+    std::vector<continued_fraction::path_run> const &runs)
+{
+    std::vector<std::string> result;
+    for (auto const &run : runs)
+    {
+        result.push_back((run.right ? "R" : "L") + run.length.to_string());
+    }
+    return result;
+}
+
+std::vector<continued_fraction::path_run> Stern_Brokot_runs_of(
+    fraction const &value)
+{
+    std::vector<continued_fraction::path_run> runs;
+    for (auto const &run : continued_fraction::to_Stern_Brokot_tree_runs(value))
+    {
+        runs.push_back(run);
+    }
+    return runs;
+}
+
+// close to pi, its expansion starts 3; 7, 15, 1, 292
+fraction const pi_like(big_int("3141592653589793"), big_int("1000000000000000"));
+
+}
+
+TEST(positive_tests, test1)
+{
+    using strings = std::vector<std::string>;
+
+    EXPECT_EQ(quotients_of(fraction(415, 93)), (strings{ "4", "2", "6", "7" }));
+    EXPECT_EQ(convergents_of(fraction(415, 93)), (strings{ "4/1", "9/2", "58/13", "415/93" }));
+
+    EXPECT_EQ(quotients_of(fraction(5, 1)), (strings{ "5" }));
+    EXPECT_EQ(convergents_of(fraction(5, 1)), (strings{ "5/1" }));
+
+    EXPECT_EQ(quotients_of(fraction(3, 7)), (strings{ "0", "2", "3" }));
+    EXPECT_EQ(convergents_of(fraction(3, 7)), (strings{ "0/1", "1/2", "3/7" }));
+
+    std::vector<std::string> pi_quotients = quotients_of(pi_like);
+    pi_quotients.resize(5);
+    EXPECT_EQ(pi_quotients, (strings{ "3", "7", "15", "1", "292" }));
+}
+
+TEST(positive_tests, test2)
+{
+    using strings = std::vector<std::string>;
+
+    // the first quotient is the floor, every later one stays positive
+    EXPECT_EQ(quotients_of(fraction(-415, 93)), (strings{ "-5", "1", "1", "6", "7" }));
+    EXPECT_EQ(convergents_of(fraction(-415, 93)), (strings{ "-5/1", "-4/1", "-9/2", "-58/13", "-415/93" }));
+
+    EXPECT_EQ(quotients_of(fraction(-1, 2)), (strings{ "-1", "2" }));
+    EXPECT_EQ(quotients_of(fraction(-3, 1)), (strings{ "-3" }));
+}
+
+TEST(positive_tests, test3)
+{
+    EXPECT_EQ(continued_fraction::best_rational_approximation(pi_like, big_int(113)), fraction(355, 113));
+    EXPECT_EQ(continued_fraction::best_rational_approximation(pi_like, big_int(112)), fraction(333, 106));
+
+    // between convergents the best semiconvergent can beat the last convergent
+    EXPECT_EQ(continued_fraction::best_rational_approximation(pi_like, big_int(57)), fraction(179, 57));
+    EXPECT_EQ(continued_fraction::best_rational_approximation(pi_like, big_int(7)), fraction(22, 7));
+    EXPECT_EQ(continued_fraction::best_rational_approximation(pi_like, big_int(1)), fraction(3, 1));
+
+    EXPECT_EQ(continued_fraction::best_rational_approximation(fraction(-10, 3), big_int(1)), fraction(-3, 1));
+    EXPECT_EQ(continued_fraction::best_rational_approximation(fraction(415, 93), big_int(93)), fraction(415, 93));
+    EXPECT_EQ(continued_fraction::best_rational_approximation(fraction(415, 93), big_int(1000)), fraction(415, 93));
+
+    EXPECT_THROW(continued_fraction::best_rational_approximation(pi_like, big_int(0)), std::invalid_argument);
+}
+
+TEST(positive_tests, test4)
+{
+    using strings = std::vector<std::string>;
+
+    fraction value(415, 93);
+    fraction inverse(93, 415);
+
+    EXPECT_EQ(runs_as_strings(Stern_Brokot_runs_of(value)), (strings{ "R4", "L2", "R6", "L6" }));
+    EXPECT_EQ(runs_as_strings(Stern_Brokot_runs_of(inverse)), (strings{ "L4", "R2", "L6", "R6" }));
+
+    EXPECT_EQ(runs_as_strings(continued_fraction::to_Calkin_Wilf_tree_runs(value)), (strings{ "L6", "R6", "L2", "R4" }));
+    EXPECT_EQ(runs_as_strings(continued_fraction::to_Calkin_Wilf_tree_runs(inverse)), (strings{ "R6", "L6", "R2", "L4" }));
+
+    EXPECT_EQ(continued_fraction::from_Stern_Brokot_tree_runs(Stern_Brokot_runs_of(value)), value);
+    EXPECT_EQ(continued_fraction::from_Stern_Brokot_tree_runs(Stern_Brokot_runs_of(inverse)), inverse);
+    EXPECT_EQ(continued_fraction::from_Calkin_Wilf_tree_runs(continued_fraction::to_Calkin_Wilf_tree_runs(value)), value);
+    EXPECT_EQ(continued_fraction::from_Calkin_Wilf_tree_runs(continued_fraction::to_Calkin_Wilf_tree_runs(inverse)), inverse);
+
+    // 3/2 is reached by R L in the Stern-Brocot tree and by L R in the Calkin-Wilf tree
+    EXPECT_EQ(continued_fraction::to_Stern_Brokot_tree_path(fraction(3, 2)), (std::vector<bool>{ true, false }));
+    EXPECT_EQ(continued_fraction::to_Calkin_Wilf_tree_path(fraction(3, 2)), (std::vector<bool>{ false, true }));
+    EXPECT_TRUE(continued_fraction::to_Stern_Brokot_tree_path(fraction(1, 1)).empty());
+    EXPECT_EQ(continued_fraction::from_Stern_Brokot_tree_path({ false, true }), fraction(2, 3));
+    EXPECT_EQ(continued_fraction::from_Calkin_Wilf_tree_path({ true, false }), fraction(2, 3));
+
+    EXPECT_THROW(continued_fraction::to_Stern_Brokot_tree_runs(fraction(-1, 2)), std::invalid_argument);
+}
+
+TEST(positive_tests, test5)
+{
+    for (fraction const &value : { fraction(415, 93), fraction(-415, 93), fraction(0, 1), fraction(7, 1), pi_like })
+    {
+        EXPECT_EQ(continued_fraction::from_continued_fraction_representation(
+                      continued_fraction::to_continued_fraction_representation(value)), value);
+    }
+
+    std::vector<big_int> pi_quotients{ big_int(3), big_int(7), big_int(15), big_int(1) };
+    EXPECT_EQ(continued_fraction::from_continued_fraction_representation(pi_quotients), fraction(355, 113));
+
+    std::vector<fraction> pi_convergents = continued_fraction::to_convergents_series(pi_quotients);
+    ASSERT_EQ(pi_convergents.size(), 4u);
+    EXPECT_EQ(pi_convergents[1], fraction(22, 7));
+    EXPECT_EQ(pi_convergents[2], fraction(333, 106));
+
+    // a last quotient of 1 is the other expansion of the same value
+    EXPECT_EQ(continued_fraction::from_continued_fraction_representation({ big_int(2), big_int(1) }), fraction(3, 1));
+
+    EXPECT_THROW(continued_fraction::from_continued_fraction_representation({}), std::invalid_argument);
+}
+
+int main(
+    int argc,
+    char **argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+
+    return RUN_ALL_TESTS();
+}
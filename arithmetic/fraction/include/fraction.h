@@ -4,18 +4,86 @@
 #include <big_int.h>
 #include <not_implemented.h>
 #include <concepts>
+#include <utility>
+
+namespace __detail
+{
+    struct fraction_expression_tag {};
+
+    template<class E>
+    concept fraction_expression = std::derived_from<std::remove_cvref_t<E>, fraction_expression_tag>;
+
+    struct fraction_ref;
+}
 
 class fraction final
 {
 
+    friend struct __detail::fraction_ref;
+    friend class continued_fraction;
+
 private:
 
     big_int _numerator;
     big_int _denominator;
 
+    // 0 - every result is reduced, otherwise reduction waits until a part outgrows this many limbs
+    size_t _normalisation_threshold = 0;
+
     void optimise(); //сокращает дробь
     big_int gcd(big_int a, big_int b) const;
 
+    bool is_eager() const noexcept;
+
+    static double log2_of_epsilon(fraction const &epsilon);
+
+    /** Nearest fraction with denominator 2^bits
+     */
+    fraction rounded(size_t bits) const;
+
+    /** Smallest k with 2^-k <= 2^log2_epsilon
+     */
+    static size_t precision_bits(double log2_epsilon) noexcept;
+
+    enum class math_constant
+    {
+        ln_2,
+        ln_10,
+        pi
+    };
+
+    /** Process-wide thread-safe cache: keeps the most precise value computed so far for each constant
+     *  and answers coarser requests by rounding it
+     */
+    static fraction cached_constant(math_constant which, double log2_epsilon);
+
+    /** sin and cos fine enough that dividing by one of them and rounding stays within epsilon: the divisor's
+     *  magnitude is taken from coarse passes, each twice as precise, until it is clear of zero
+     */
+    std::pair<fraction, fraction> sincos_for_division(fraction const &epsilon, bool divide_by_sin) const;
+
+    /** ln(x) / ln(base) within epsilon, ln(base) is taken finer the larger the result is
+     */
+    fraction log_in_base(math_constant base, fraction const &epsilon) const;
+
+    /** 1/1000000, built once instead of on every call that relies on the default argument
+     */
+    static fraction const &default_epsilon();
+
+    /** Keeps the denominator positive and reduces the fraction if the current mode asks for it
+     */
+    void settle();
+
+    /** this = a/b * c/d for reduced operands with positive b and d, cancels gcd(a, d) and gcd(c, b)
+     *  instead of reducing the full product
+     */
+    void assign_reduced_product(big_int const &a, big_int const &b, big_int const &c, big_int const &d);
+
+    /** this = a/b +- c/d for reduced operands with positive b and d, only gcds of denominator-sized
+     *  values are taken (Knuth 4.5.1)
+     */
+    void assign_reduced_sum(big_int const &a, big_int const &b, big_int const &c, big_int const &d, bool negate);
+
 public:
 
     /** Perfect forwarding ctor
@@ -25,6 +93,24 @@ public:
 
     fraction(pp_allocator<big_int::value_type> = pp_allocator<big_int::value_type>());
 
+public:
+    /** Switches this value to deferred normalisation: gcd reduction runs only when the numerator or the
+     *  denominator grows beyond threshold_limbs, on output or on normalise(). 0 restores eager mode.
+     *  Results of binary operators take the mode of the left operand
+     */
+    fraction &defer_normalisation(size_t threshold_limbs = 64) &;
+
+    /** Threshold set by defer_normalisation, 0 in eager mode. Negation, abs and copies keep it
+     */
+    size_t normalisation_threshold() const noexcept;
+
+    fraction &normalise() &;
+
+    /** Nearest fraction with a power of two denominator no larger than needed to stay within epsilon / 2.
+     *  Bounds the size of intermediates in long iterations; sin, cos, arctg, ln and root return values on such a grid
+     */
+    fraction round_to(fraction const &epsilon) const;
+
 public:
     fraction abs() const;
 
@@ -60,31 +146,49 @@ public:
 
     std::string to_string() const;
 
+    /** Numerator then denominator as big_int records, always in lowest terms with a positive denominator
+     */
+    void serialize(std::ostream &stream) const;
+
+    /** Trusts the record to be reduced, only the sign of the denominator is checked.
+     *  Throws std::runtime_error on a truncated record or a non-positive denominator
+     */
+    static fraction deserialize(
+        std::istream &stream,
+        pp_allocator<big_int::value_type> allocator = pp_allocator<big_int::value_type>());
+
+    size_t serialize_size() const;
+
 public:
 
-    fraction sin(fraction const &epsilon = fraction(1_bi, 1000000_bi)) const;
+    /** sin and cos from one evaluation: the argument is reduced modulo pi / 2 with a cached pi, halved a few times
+     *  for the series and doubled back
+     */
+    std::pair<fraction, fraction> sincos(fraction const &epsilon = default_epsilon()) const;
+
+    fraction sin(fraction const &epsilon = default_epsilon()) const;
 
-    fraction cos(fraction const &epsilon = fraction(1_bi, 1000000_bi)) const;
+    fraction cos(fraction const &epsilon = default_epsilon()) const;
 
-    fraction tg(fraction const &epsilon = fraction(1_bi, 1000000_bi)) const;
+    fraction tg(fraction const &epsilon = default_epsilon()) const;
 
-    fraction ctg(fraction const &epsilon = fraction(1_bi, 1000000_bi)) const;
+    fraction ctg(fraction const &epsilon = default_epsilon()) const;
 
-    fraction sec(fraction const &epsilon = fraction(1_bi, 1000000_bi)) const;
+    fraction sec(fraction const &epsilon = default_epsilon()) const;
 
-    fraction cosec(fraction const &epsilon = fraction(1_bi, 1000000_bi)) const;
+    fraction cosec(fraction const &epsilon = default_epsilon()) const;
 
-    fraction arcsin(fraction const &epsilon = fraction(1_bi, 1000000_bi)) const;
+    fraction arcsin(fraction const &epsilon = default_epsilon()) const;
 
-    fraction arccos(fraction const &epsilon = fraction(1_bi, 1000000_bi)) const;
+    fraction arccos(fraction const &epsilon = default_epsilon()) const;
 
-    fraction arctg(fraction const &epsilon = fraction(1_bi, 1000000_bi)) const;
+    fraction arctg(fraction const &epsilon = default_epsilon()) const;
 
-    fraction arcctg(fraction const &epsilon = fraction(1_bi, 1000000_bi)) const;
+    fraction arcctg(fraction const &epsilon = default_epsilon()) const;
 
-    fraction arcsec(fraction const &epsilon = fraction(1_bi, 1000000_bi)) const;
+    fraction arcsec(fraction const &epsilon = default_epsilon()) const;
 
-    fraction arccosec(fraction const &epsilon = fraction(1_bi, 1000000_bi)) const;
+    fraction arccosec(fraction const &epsilon = default_epsilon()) const;
 
 public:
 
@@ -92,20 +196,236 @@ public:
 
 public:
 
-    fraction root(size_t degree, fraction const &epsilon = fraction(1_bi, 1000000_bi)) const;
+    fraction root(size_t degree, fraction const &epsilon = default_epsilon()) const;
 
 public:
 
-    fraction log2(fraction const &epsilon = fraction(1_bi, 1000000_bi)) const;
+    fraction log2(fraction const &epsilon = default_epsilon()) const;
 
-    fraction ln(fraction const &epsilon = fraction(1_bi, 1000000_bi)) const;
+    fraction ln(fraction const &epsilon = default_epsilon()) const;
 
-    fraction lg(fraction const &epsilon = fraction(1_bi, 1000000_bi)) const;
+    fraction lg(fraction const &epsilon = default_epsilon()) const;
 
     fraction ln_of_2(fraction const &epsilon) const;
 
     fraction ln_of_10(fraction const &epsilon) const;
 
+public:
+
+    /** Starts a lazily evaluated expression: term.lazy() * x * x / y is evaluated as one numerator
+     *  and one denominator product with a single optimise() at the end instead of one per operator.
+     *  Expressions hold references to their operands and must be consumed within the full-expression
+     */
+    __detail::fraction_ref lazy() const noexcept;
+
+    template<__detail::fraction_expression E>
+    fraction(E const &expression);
+
+    template<__detail::fraction_expression E>
+    fraction &operator=(E const &expression) &;
+
 };
 
+namespace __detail
+{
+    /** num/den (+ or -)= rn/rd without normalisation
+     */
+    void fraction_add_parts(big_int &num, big_int &den, big_int const &rn, big_int const &rd, bool negate);
+
+    /** num/den *= rn/rd without normalisation
+     */
+    void fraction_multiply_parts(big_int &num, big_int &den, big_int const &rn, big_int const &rd);
+
+    /** num/den /= rn/rd without normalisation
+     */
+    void fraction_divide_parts(big_int &num, big_int &den, big_int const &rn, big_int const &rd);
+
+    /** Leaf of a lazy expression, refers to an existing fraction
+     */
+    struct fraction_ref : fraction_expression_tag
+    {
+        fraction const *value;
+
+        explicit fraction_ref(fraction const &v) noexcept : value(&v) {}
+
+        bool references(fraction const *p) const noexcept { return value == p; }
+
+        big_int const &numerator() const noexcept { return value->_numerator; }
+
+        big_int const &denominator() const noexcept { return value->_denominator; }
+
+        void evaluate(big_int &num, big_int &den) const
+        {
+            num = value->_numerator;
+            den = value->_denominator;
+        }
+    };
+
+    /** Calls f with numerator and denominator of e, leaves are passed through without a copy
+     */
+    template<class E, class F>
+    void with_parts(E const &e, F &&f)
+    {
+        if constexpr (std::is_same_v<E, fraction_ref>)
+        {
+            f(e.numerator(), e.denominator());
+        }
+        else
+        {
+            big_int num, den;
+            e.evaluate(num, den);
+            f(num, den);
+        }
+    }
+
+    template<class L, class R>
+    struct fraction_binary_expression : fraction_expression_tag
+    {
+        L lhs;
+        R rhs;
+
+        fraction_binary_expression(L const &l, R const &r) : lhs(l), rhs(r) {}
+
+        bool references(fraction const *p) const noexcept { return lhs.references(p) || rhs.references(p); }
+    };
+
+    template<class L, class R>
+    struct fraction_sum : fraction_binary_expression<L, R>
+    {
+        using fraction_binary_expression<L, R>::fraction_binary_expression;
+
+        void evaluate(big_int &num, big_int &den) const
+        {
+            with_parts(this->rhs, [&](big_int const &rn, big_int const &rd)
+            {
+                this->lhs.evaluate(num, den);
+                fraction_add_parts(num, den, rn, rd, false);
+            });
+        }
+    };
+
+    template<class L, class R>
+    struct fraction_difference : fraction_binary_expression<L, R>
+    {
+        using fraction_binary_expression<L, R>::fraction_binary_expression;
+
+        void evaluate(big_int &num, big_int &den) const
+        {
+            with_parts(this->rhs, [&](big_int const &rn, big_int const &rd)
+            {
+                this->lhs.evaluate(num, den);
+                fraction_add_parts(num, den, rn, rd, true);
+            });
+        }
+    };
+
+    template<class L, class R>
+    struct fraction_product : fraction_binary_expression<L, R>
+    {
+        using fraction_binary_expression<L, R>::fraction_binary_expression;
+
+        void evaluate(big_int &num, big_int &den) const
+        {
+            with_parts(this->rhs, [&](big_int const &rn, big_int const &rd)
+            {
+                this->lhs.evaluate(num, den);
+                fraction_multiply_parts(num, den, rn, rd);
+            });
+        }
+    };
+
+    template<class L, class R>
+    struct fraction_quotient : fraction_binary_expression<L, R>
+    {
+        using fraction_binary_expression<L, R>::fraction_binary_expression;
+
+        void evaluate(big_int &num, big_int &den) const
+        {
+            with_parts(this->rhs, [&](big_int const &rn, big_int const &rd)
+            {
+                this->lhs.evaluate(num, den);
+                fraction_divide_parts(num, den, rn, rd);
+            });
+        }
+    };
+
+    template<class E>
+    using fraction_operand = std::conditional_t<fraction_expression<E>, std::remove_cvref_t<E>, fraction_ref>;
+
+    template<class E>
+    concept fraction_operand_like = fraction_expression<E> || std::same_as<std::remove_cvref_t<E>, fraction>;
+
+    template<class E>
+    fraction_operand<E> make_fraction_operand(E const &e)
+    {
+        if constexpr (fraction_expression<E>)
+        {
+            return e;
+        }
+        else
+        {
+            return fraction_ref(e);
+        }
+    }
+}
+
+template<__detail::fraction_operand_like L, __detail::fraction_operand_like R>
+    requires (__detail::fraction_expression<L> || __detail::fraction_expression<R>)
+auto operator+(L const &lhs, R const &rhs)
+{
+    return __detail::fraction_sum<__detail::fraction_operand<L>, __detail::fraction_operand<R>>(
+        __detail::make_fraction_operand(lhs), __detail::make_fraction_operand(rhs));
+}
+
+template<__detail::fraction_operand_like L, __detail::fraction_operand_like R>
+    requires (__detail::fraction_expression<L> || __detail::fraction_expression<R>)
+auto operator-(L const &lhs, R const &rhs)
+{
+    return __detail::fraction_difference<__detail::fraction_operand<L>, __detail::fraction_operand<R>>(
+        __detail::make_fraction_operand(lhs), __detail::make_fraction_operand(rhs));
+}
+
+template<__detail::fraction_operand_like L, __detail::fraction_operand_like R>
+    requires (__detail::fraction_expression<L> || __detail::fraction_expression<R>)
+auto operator*(L const &lhs, R const &rhs)
+{
+    return __detail::fraction_product<__detail::fraction_operand<L>, __detail::fraction_operand<R>>(
+        __detail::make_fraction_operand(lhs), __detail::make_fraction_operand(rhs));
+}
+
+template<__detail::fraction_operand_like L, __detail::fraction_operand_like R>
+    requires (__detail::fraction_expression<L> || __detail::fraction_expression<R>)
+auto operator/(L const &lhs, R const &rhs)
+{
+    return __detail::fraction_quotient<__detail::fraction_operand<L>, __detail::fraction_operand<R>>(
+        __detail::make_fraction_operand(lhs), __detail::make_fraction_operand(rhs));
+}
+
+inline __detail::fraction_ref fraction::lazy() const noexcept
+{
+    return __detail::fraction_ref(*this);
+}
+
+template<__detail::fraction_expression E>
+fraction::fraction(E const &expression)
+{
+    expression.evaluate(_numerator, _denominator);
+    optimise();
+}
+
+template<__detail::fraction_expression E>
+fraction &fraction::operator=(E const &expression) &
+{
+    if (expression.references(this))
+    {
+        fraction value(expression);
+        _numerator = std::move(value._numerator);
+        _denominator = std::move(value._denominator);
+        return *this;
+    }
+    expression.evaluate(_numerator, _denominator);
+    settle();
+    return *this;
+}
+
 #endif //MP_OS_FRACTION_H
\ No newline at end of file
@@ -1,8 +1,12 @@
 #include "../include/fraction.h"
 #include <algorithm>
+#include <array>
 #include <cmath>
+#include <limits>
+#include <mutex>
 #include <stdexcept>
 #include <numeric>
+#include <string>
 
 void fraction::optimise()
 {
@@ -11,9 +15,12 @@ void fraction::optimise()
         throw std::invalid_argument("Denominator cannot be zero");
     }
 
-    big_int gcd_val = gcd(_numerator.abs(), _denominator.abs());
-    _numerator /= gcd_val;
-    _denominator /= gcd_val;
+    big_int gcd_val = gcd(_numerator, _denominator);
+    if (gcd_val != big_int(1))
+    {
+        _numerator /= gcd_val;
+        _denominator /= gcd_val;
+    }
 
     if (_denominator < big_int(0))
     {
@@ -24,22 +31,135 @@ void fraction::optimise()
 
 big_int fraction::gcd(big_int a, big_int b) const
 {
-    if (a == 0)
-        return b;
-    if (b == 0)
-        return a;
+    return big_int::gcd(std::move(a), std::move(b));
+}
+
+fraction const &fraction::default_epsilon()
+{
+    static fraction const epsilon(1_bi, 1000000_bi);
+    return epsilon;
+}
+
+bool fraction::is_eager() const noexcept
+{
+    return _normalisation_threshold == 0;
+}
+
+void fraction::settle()
+{
+    if (is_eager() || _numerator.limbs_count() > _normalisation_threshold
+        || _denominator.limbs_count() > _normalisation_threshold)
+    {
+        optimise();
+        return;
+    }
+
+    if (_denominator < big_int(0))
+    {
+        _numerator = big_int(0) - _numerator;
+        _denominator = big_int(0) - _denominator;
+    }
+}
+
+void fraction::assign_reduced_product(big_int const &a, big_int const &b, big_int const &c, big_int const &d)
+{
+    big_int g1 = gcd(a, d);
+    big_int g2 = gcd(c, b);
+    bool trivial_1 = g1 == big_int(1), trivial_2 = g2 == big_int(1);
+
+    big_int numerator = trivial_1 ? a : a / g1;
+    numerator *= trivial_2 ? c : c / g2;
+    big_int denominator = trivial_2 ? b : b / g2;
+    denominator *= trivial_1 ? d : d / g1;
+
+    _numerator = std::move(numerator);
+    _denominator = std::move(denominator);
+    if (!_numerator)
+    {
+        _denominator = big_int(1);
+    }
+}
+
+void fraction::assign_reduced_sum(big_int const &a, big_int const &b, big_int const &c, big_int const &d, bool negate)
+{
+    big_int g = gcd(b, d);
+
+    if (g == big_int(1))
+    {
+        big_int numerator = a * d;
+        negate ? numerator.submul(b, c) : numerator.addmul(b, c);
+        _denominator = b * d;
+        _numerator = std::move(numerator);
+    }
+    else
+    {
+        big_int b_over_g = b / g;
+        big_int t = a * (d / g);
+        negate ? t.submul(c, b_over_g) : t.addmul(c, b_over_g);
+
+        big_int g2 = gcd(t, g);
+        if (g2 != big_int(1))
+        {
+            t /= g2;
+        }
+        _denominator = b_over_g * (g2 == big_int(1) ? d : d / g2);
+        _numerator = std::move(t);
+    }
+
+    if (!_numerator)
+    {
+        _denominator = big_int(1);
+    }
+}
+
+fraction &fraction::defer_normalisation(size_t threshold_limbs) &
+{
+    _normalisation_threshold = threshold_limbs;
+    if (is_eager())
+    {
+        optimise();
+    }
+    return *this;
+}
+
+size_t fraction::normalisation_threshold() const noexcept
+{
+    return _normalisation_threshold;
+}
 
-    a = a.abs();
-    b = b.abs();
+fraction &fraction::normalise() &
+{
+    optimise();
+    return *this;
+}
 
-    while (b != 0)
+void __detail::fraction_add_parts(big_int &num, big_int &den, big_int const &rn, big_int const &rd, bool negate)
+{
+    if (den == rd)
     {
-        big_int temp = b;
-        b = a % b;
-        a = temp;
+        negate ? num.minus_assign(rn) : num.plus_assign(rn);
+        return;
     }
 
-    return a;
+    num *= rd;
+    negate ? num.submul(rn, den) : num.addmul(rn, den);
+    den *= rd;
+}
+
+void __detail::fraction_multiply_parts(big_int &num, big_int &den, big_int const &rn, big_int const &rd)
+{
+    num *= rn;
+    den *= rd;
+}
+
+void __detail::fraction_divide_parts(big_int &num, big_int &den, big_int const &rn, big_int const &rd)
+{
+    if (!rn)
+    {
+        throw std::invalid_argument("Division by zero");
+    }
+    num *= rd;
+    den *= rn;
 }
 
 template<std::convertible_to<big_int> f, std::convertible_to<big_int> s>
@@ -59,19 +179,36 @@ fraction::fraction(pp_allocator<big_int::value_type> alloc)
 
 fraction fraction::operator-() const
 {
-    return fraction(big_int(0) - _numerator, _denominator);
+    // a copy keeps the normalisation mode, and a change of sign leaves the terms as reduced as they were
+    fraction result(*this);
+    result._numerator = big_int(0) - result._numerator;
+    return result;
 }
 
 fraction fraction::abs() const
 {
-    return fraction(_numerator.abs(), _denominator.abs());
+    fraction result(*this);
+    if (result._numerator < big_int(0))
+    {
+        result._numerator = result._numerator.abs();
+    }
+    return result;
 }
 
 fraction &fraction::operator+=(fraction const &other) &
 {
-    _numerator = _numerator * other._denominator + other._numerator * _denominator;
-    _denominator *= other._denominator;
-    optimise();
+    if (is_eager() && other.is_eager())
+    {
+        assign_reduced_sum(_numerator, _denominator, other._numerator, other._denominator, false);
+        return *this;
+    }
+
+    if (this == &other)
+    {
+        return *this += fraction(other);
+    }
+    __detail::fraction_add_parts(_numerator, _denominator, other._numerator, other._denominator, false);
+    settle();
     return *this;
 }
 
@@ -83,9 +220,20 @@ fraction fraction::operator+(fraction const &other) const
 
 fraction &fraction::operator-=(fraction const &other) &
 {
-    _numerator = _numerator * other._denominator - other._numerator * _denominator;
-    _denominator *= other._denominator;
-    optimise();
+    if (is_eager() && other.is_eager())
+    {
+        assign_reduced_sum(_numerator, _denominator, other._numerator, other._denominator, true);
+        return *this;
+    }
+
+    if (this == &other)
+    {
+        _numerator = big_int(0);
+        _denominator = big_int(1);
+        return *this;
+    }
+    __detail::fraction_add_parts(_numerator, _denominator, other._numerator, other._denominator, true);
+    settle();
     return *this;
 }
 
@@ -97,9 +245,18 @@ fraction fraction::operator-(fraction const &other) const
 
 fraction &fraction::operator*=(fraction const &other) &
 {
-    _numerator *= other._numerator;
-    _denominator *= other._denominator;
-    optimise();
+    if (is_eager() && other.is_eager())
+    {
+        assign_reduced_product(_numerator, _denominator, other._numerator, other._denominator);
+        return *this;
+    }
+
+    if (this == &other)
+    {
+        return *this *= fraction(other);
+    }
+    __detail::fraction_multiply_parts(_numerator, _denominator, other._numerator, other._denominator);
+    settle();
     return *this;
 }
 
@@ -115,9 +272,26 @@ fraction &fraction::operator/=(fraction const &other) &
     {
         throw std::invalid_argument("Division by zero");
     }
-    _numerator *= other._denominator;
-    _denominator *= other._numerator;
-    optimise();
+
+    if (is_eager() && other.is_eager())
+    {
+        if (other._numerator < big_int(0))
+        {
+            assign_reduced_product(_numerator, _denominator, big_int(0) - other._denominator, other._numerator.abs());
+        }
+        else
+        {
+            assign_reduced_product(_numerator, _denominator, other._denominator, other._numerator);
+        }
+        return *this;
+    }
+
+    if (this == &other)
+    {
+        return *this /= fraction(other);
+    }
+    __detail::fraction_divide_parts(_numerator, _denominator, other._numerator, other._denominator);
+    settle();
     return *this;
 }
 
@@ -129,7 +303,11 @@ fraction fraction::operator/(fraction const &other) const
 
 bool fraction::operator==(fraction const &other) const noexcept
 {
-    return _numerator == other._numerator && _denominator == other._denominator;
+    if (is_eager() && other.is_eager())
+    {
+        return _numerator == other._numerator && _denominator == other._denominator;
+    }
+    return _numerator * other._denominator == other._numerator * _denominator;
 }
 
 std::partial_ordering fraction::operator<=>(const fraction& other) const noexcept
@@ -141,7 +319,7 @@ std::partial_ordering fraction::operator<=>(const fraction& other) const noexcep
 
 std::ostream &operator<<(std::ostream &stream, fraction const &obj)
 {
-    stream << obj._numerator << "/" << obj._denominator.abs();
+    stream << obj.to_string();
     return stream;
 }
 
@@ -184,106 +362,498 @@ std::istream &operator>>(std::istream &stream, fraction &obj)
 
 std::string fraction::to_string() const
 {
+    if (!is_eager())
+    {
+        fraction reduced(*this);
+        reduced.optimise();
+        return reduced._numerator.to_string() + "/" + reduced._denominator.to_string();
+    }
     return _numerator.to_string() + "/" + _denominator.abs().to_string();
 }
 
-fraction fraction::sin(fraction const &epsilon) const
+void fraction::serialize(std::ostream &stream) const
 {
-    fraction term = *this;
-    fraction sum = term;
-    fraction prev_sum;
-    big_int n(1);
-    
-    do {
-        prev_sum = sum;
-        term = (term * (*this) * (*this)) / fraction((n + big_int(1)) * (n + big_int(2)), 1);
-        term = -term;
-        sum += term;
-        n += big_int(2);
-    } while ((sum - prev_sum).abs() > epsilon);
-    
-    return sum;
+    if (!is_eager() || _denominator < big_int(0))
+    {
+        fraction reduced(*this);
+        reduced.optimise();
+        reduced._numerator.serialize(stream);
+        reduced._denominator.serialize(stream);
+        return;
+    }
+    _numerator.serialize(stream);
+    _denominator.serialize(stream);
+}
+
+fraction fraction::deserialize(
+    std::istream &stream,
+    pp_allocator<big_int::value_type> allocator)
+{
+    fraction result(allocator);
+    result._numerator = big_int::deserialize(stream, allocator);
+    result._denominator = big_int::deserialize(stream, allocator);
+    if (result._denominator <= big_int(0))
+    {
+        throw std::runtime_error("Fraction record has a non-positive denominator");
+    }
+    return result;
+}
+
+size_t fraction::serialize_size() const
+{
+    if (!is_eager())
+    {
+        fraction reduced(*this);
+        reduced.optimise();
+        return reduced._numerator.serialize_size() + reduced._denominator.serialize_size();
+    }
+    return _numerator.serialize_size() + _denominator.serialize_size();
+}
+
+namespace
+{
+
+/** One term of a hypergeometric series: term_n = a(n) / b(n) * p(0)...p(n) / (q(0)...q(n))
+ */
+struct series_term
+{
+    big_int p;
+    big_int q;
+    big_int a;
+    big_int b;
+};
+
+/** Products of p, q and b over [from, to) and the partial sum scaled to T / (B * Q)
+ */
+struct series_split
+{
+    big_int p;
+    big_int q;
+    big_int b;
+    big_int t;
+};
+
+template<typename TermF>
+series_split binary_split(size_t from, size_t to, TermF const &term)
+{
+    if (to - from == 1)
+    {
+        series_term leaf = term(from);
+        big_int t = leaf.a * leaf.p;
+        return { std::move(leaf.p), std::move(leaf.q), std::move(leaf.b), std::move(t) };
+    }
+
+    size_t middle = from + (to - from) / 2;
+    series_split left = binary_split(from, middle, term);
+    series_split right = binary_split(middle, to, term);
+
+    // T = B_r * Q_r * T_l + B_l * P_l * T_r
+    big_int t = right.b * right.q;
+    t *= left.t;
+    t.addmul(left.b * left.p, right.t);
+
+    return { left.p * right.p, left.q * right.q, left.b * right.b, std::move(t) };
 }
 
+/** Smallest count of terms whose tail is below 2^log2_epsilon. log2_ratio(n) estimates log2 |term_n / term_n-1|,
+ *  limit_log2_ratio bounds every later ratio for series whose ratios grow towards a limit
+ */
+template<typename RatioF>
+size_t terms_needed(double log2_first, RatioF const &log2_ratio, double limit_log2_ratio, double log2_epsilon)
+{
+    double log2_term = log2_first;
+    for (size_t n = 1;; ++n)
+    {
+        double ratio = log2_ratio(n);
+        double rho = std::max(ratio, limit_log2_ratio);
+        // doubles are only estimates here, two spare bits cover their error
+        if (rho < 0 && log2_term + rho - std::log2(1 - std::exp2(rho)) < log2_epsilon - 2)
+        {
+            return n;
+        }
+        log2_term += ratio;
+    }
+}
+
+template<typename TermF>
+fraction sum_series(size_t terms, TermF const &term)
+{
+    series_split sum = binary_split(0, terms, term);
+    sum.b *= sum.q;
+    return fraction(std::move(sum.t), std::move(sum.b));
+}
+
+double approximate_log2(big_int const &value)
+{
+    std::string digits = value.abs().to_string();
+    constexpr size_t significant = 17;
+    if (digits.size() <= significant)
+    {
+        return std::log2(std::stod(digits));
+    }
+    return std::log2(std::stod(digits.substr(0, significant)))
+        + static_cast<double>(digits.size() - significant) * std::log2(10.0);
+}
+
+/** sin(u / v), the series is meant for small arguments
+ */
+fraction sin_series(big_int const &u, big_int const &v, double log2_epsilon)
+{
+    double log2_x = approximate_log2(u) - approximate_log2(v);
+    big_int minus_u_squared = big_int(0) - u * u;
+    big_int v_squared = v * v;
+
+    size_t terms = terms_needed(log2_x, [&](size_t n)
+    {
+        return 2 * log2_x - std::log2(2.0 * n) - std::log2(2.0 * n + 1);
+    }, -std::numeric_limits<double>::infinity(), log2_epsilon);
+
+    return sum_series(terms, [&](size_t n)
+    {
+        if (n == 0)
+        {
+            return series_term{ u, v, big_int(1), big_int(1) };
+        }
+        return series_term{ minus_u_squared, v_squared * big_int(2 * n * (2 * n + 1)), big_int(1), big_int(1) };
+    });
+}
+
+/** cos(u / v), the series is meant for small arguments
+ */
+fraction cos_series(big_int const &u, big_int const &v, double log2_epsilon)
+{
+    double log2_x = approximate_log2(u) - approximate_log2(v);
+    big_int minus_u_squared = big_int(0) - u * u;
+    big_int v_squared = v * v;
+
+    size_t terms = terms_needed(0, [&](size_t n)
+    {
+        return 2 * log2_x - std::log2(2.0 * n - 1) - std::log2(2.0 * n);
+    }, -std::numeric_limits<double>::infinity(), log2_epsilon);
+
+    return sum_series(terms, [&](size_t n)
+    {
+        if (n == 0)
+        {
+            return series_term{ big_int(1), big_int(1), big_int(1), big_int(1) };
+        }
+        return series_term{ minus_u_squared, v_squared * big_int((2 * n - 1) * (2 * n)), big_int(1), big_int(1) };
+    });
+}
+
+/** atanh(u / v) for |u / v| < 1
+ */
+fraction atanh_series(big_int const &u, big_int const &v, double log2_epsilon)
+{
+    double log2_u = approximate_log2(u), log2_v = approximate_log2(v);
+    big_int u_squared = u * u, v_squared = v * v;
+
+    size_t terms = terms_needed(log2_u - log2_v, [&](size_t n)
+    {
+        return 2 * (log2_u - log2_v) + std::log2(2.0 * n - 1) - std::log2(2.0 * n + 1);
+    }, 2 * (log2_u - log2_v), log2_epsilon);
+
+    return sum_series(terms, [&](size_t n)
+    {
+        if (n == 0)
+        {
+            return series_term{ u, v, big_int(1), big_int(1) };
+        }
+        return series_term{ u_squared, v_squared, big_int(1), big_int(2 * n + 1) };
+    });
+}
+
+/** arctg(u / v) for |u / v| <= 1 by Euler's series
+ *  sum 2^2n (n!)^2 / (2n + 1)! * x^(2n + 1) / (1 + x^2)^(n + 1), its ratios stay below 1/2
+ */
+fraction arctg_series(big_int const &u, big_int const &v, double log2_epsilon)
+{
+    big_int u_squared = u * u;
+    big_int s = u_squared + v * v;
+    double log2_u = approximate_log2(u), log2_v = approximate_log2(v), log2_s = approximate_log2(s);
+
+    size_t terms = terms_needed(log2_u + log2_v - log2_s, [&](size_t n)
+    {
+        return 2 * log2_u - log2_s + std::log2(2.0 * n) - std::log2(2.0 * n + 1);
+    }, 2 * log2_u - log2_s, log2_epsilon);
+
+    return sum_series(terms, [&](size_t n)
+    {
+        if (n == 0)
+        {
+            return series_term{ u * v, s, big_int(1), big_int(1) };
+        }
+        return series_term{ u_squared * big_int(2 * n), s * big_int(2 * n + 1), big_int(1), big_int(1) };
+    });
+}
+
+/** pi = 16 arctg(1/5) - 4 arctg(1/239)
+ */
+fraction pi_value(double log2_epsilon)
+{
+    return fraction(16, 1) * arctg_series(big_int(1), big_int(5), log2_epsilon - 5)
+        - fraction(4, 1) * arctg_series(big_int(1), big_int(239), log2_epsilon - 3);
+}
+
+/** ln 2 = 2 atanh(1/3)
+ */
+fraction ln_of_2_value(double log2_epsilon)
+{
+    return fraction(2, 1) * atanh_series(big_int(1), big_int(3), log2_epsilon - 1);
+}
+
+/** ln 10 = 3 ln 2 + ln(5/4) = 6 atanh(1/3) + 2 atanh(1/9)
+ */
+fraction ln_of_10_value(double log2_epsilon)
+{
+    return fraction(6, 1) * atanh_series(big_int(1), big_int(3), log2_epsilon - 4)
+        + fraction(2, 1) * atanh_series(big_int(1), big_int(9), log2_epsilon - 2);
+}
+
+}
+
+fraction fraction::rounded(size_t bits) const
+{
+    big_int scaled = (_numerator.abs() << (bits + 1)) / _denominator.abs();
+    scaled += big_int(1);
+    scaled >>= 1;
+    if ((_numerator < big_int(0)) != (_denominator < big_int(0)))
+    {
+        scaled = big_int(0) - scaled;
+    }
+    return fraction(std::move(scaled), big_int(1) << bits);
+}
+
+size_t fraction::precision_bits(double log2_epsilon) noexcept
+{
+    return static_cast<size_t>(std::max(0.0, std::ceil(-log2_epsilon)));
+}
+
+fraction fraction::round_to(fraction const &epsilon) const
+{
+    return rounded(precision_bits(log2_of_epsilon(epsilon)) + 1);
+}
+
+fraction fraction::cached_constant(math_constant which, double log2_epsilon)
+{
+    struct entry
+    {
+        size_t bits = 0;
+        fraction value;
+    };
+
+    static std::mutex mutex;
+    static std::array<entry, 3> cache;
+
+    // 2^-bits <= epsilon / 2, a cached value at least one bit finer stays within epsilon after rounding
+    size_t bits = precision_bits(log2_epsilon) + 1;
+    entry &cached = cache[static_cast<size_t>(which)];
+
+    {
+        std::lock_guard lock(mutex);
+        if (cached.bits == bits + 1)
+        {
+            return cached.value;
+        }
+        if (cached.bits > bits + 1)
+        {
+            return cached.value.rounded(bits + 1);
+        }
+    }
+
+    double target = -static_cast<double>(bits + 1);
+    fraction value;
+    switch (which)
+    {
+        case math_constant::ln_2:
+            value = ln_of_2_value(target);
+            break;
+        case math_constant::ln_10:
+            value = ln_of_10_value(target);
+            break;
+        case math_constant::pi:
+            value = pi_value(target);
+            break;
+    }
+
+    std::lock_guard lock(mutex);
+    if (cached.bits < bits + 1)
+    {
+        cached.bits = bits + 1;
+        cached.value = value;
+    }
+    return value;
+}
+
+double fraction::log2_of_epsilon(fraction const &epsilon)
+{
+    if (epsilon._numerator <= big_int(0))
+    {
+        throw std::invalid_argument("Epsilon must be positive");
+    }
+    return approximate_log2(epsilon._numerator) - approximate_log2(epsilon._denominator);
+}
+
+std::pair<fraction, fraction> fraction::sincos(fraction const &epsilon) const
+{
+    double log2_epsilon = log2_of_epsilon(epsilon);
+    size_t bits = precision_bits(log2_epsilon);
+    size_t halvings = static_cast<size_t>(std::sqrt(static_cast<double>(bits))) / 2;
+    // each doubling step may quadruple the error of the pair
+    size_t work_bits = bits + 2 * halvings + 8;
+
+    // x = k * pi / 2 + r, |r| <= pi / 4 up to the rounding of k
+    big_int k(0);
+    fraction r = *this;
+    if (abs() > fraction(3, 4))
+    {
+        double log2_x = approximate_log2(_numerator) - approximate_log2(_denominator);
+        fraction quotient = *this / cached_constant(math_constant::pi, -log2_x - 8) * fraction(2, 1);
+        quotient += fraction(1, 2);
+        k = quotient._numerator / quotient._denominator;
+        if (quotient._numerator < big_int(0) && k * quotient._denominator != quotient._numerator)
+        {
+            k -= big_int(1);
+        }
+
+        if (k != big_int(0))
+        {
+            double log2_pi_epsilon = -static_cast<double>(work_bits) - approximate_log2(k) - 2;
+            fraction half_pi = cached_constant(math_constant::pi, log2_pi_epsilon) / fraction(2, 1);
+            r = (*this - fraction(k, 1) * half_pi).rounded(work_bits);
+        }
+    }
+
+    // sin and cos of r / 2^halvings, then doubled back
+    fraction t = r / fraction(big_int(1) << halvings, 1);
+    fraction sin_val = sin_series(t._numerator, t._denominator, -static_cast<double>(work_bits)).rounded(work_bits);
+    fraction cos_val = cos_series(t._numerator, t._denominator, -static_cast<double>(work_bits)).rounded(work_bits);
+
+    for (size_t i = 0; i < halvings; ++i)
+    {
+        fraction doubled_sin = (fraction(2, 1) * sin_val * cos_val).rounded(work_bits);
+        cos_val = (fraction(1, 1) - fraction(2, 1) * sin_val * sin_val).rounded(work_bits);
+        sin_val = std::move(doubled_sin);
+    }
+
+    big_int quadrant = k.abs() % big_int(4);
+    if (k < big_int(0) && quadrant != big_int(0))
+    {
+        quadrant = big_int(4) - quadrant;
+    }
+
+    // sin(x + pi / 2) = cos(x), cos(x + pi / 2) = -sin(x)
+    if (quadrant == big_int(1) || quadrant == big_int(3))
+    {
+        std::swap(sin_val, cos_val);
+        cos_val = -cos_val;
+    }
+    if (quadrant == big_int(2) || quadrant == big_int(3))
+    {
+        sin_val = -sin_val;
+        cos_val = -cos_val;
+    }
+
+    return { sin_val.rounded(bits + 2), cos_val.rounded(bits + 2) };
+}
+
+fraction fraction::sin(fraction const &epsilon) const
+{
+    return sincos(epsilon).first;
+}
 
 fraction fraction::cos(fraction const &epsilon) const
 {
-    fraction term(1, 1);
-    fraction sum = term;
-    fraction prev_sum;
-    big_int n(0);
-    
-    do {
-        prev_sum = sum;
-        term = (term * (*this) * (*this)) / fraction((n + big_int(1)) * (n + big_int(2)), 1);
-        term = -term;
-        sum += term;
-        n += big_int(2);
-    } while ((sum - prev_sum).abs() > epsilon);
-    
-    return sum;
+    return sincos(epsilon).second;
 }
 
-fraction fraction::tg(fraction const &epsilon) const
+fraction fraction::arctg(fraction const &epsilon) const
 {
-    fraction cos_val = cos(epsilon);
-    if (cos_val == fraction(0))
+    double log2_epsilon = log2_of_epsilon(epsilon);
+
+    size_t bits = precision_bits(log2_epsilon) + 2;
+
+    if (_numerator.abs() <= _denominator)
+    {
+        return arctg_series(_numerator, _denominator, log2_epsilon - 1).rounded(bits);
+    }
+
+    // arctg(x) = sign(x) * pi / 2 - arctg(1 / x)
+    fraction half_pi = cached_constant(math_constant::pi, log2_epsilon - 1) / fraction(2, 1);
+    if (_numerator < big_int(0))
     {
-        throw std::domain_error("Tangent is undefined for this angle");
+        return (-half_pi - arctg_series(big_int(0) - _denominator, _numerator.abs(), log2_epsilon - 2)).rounded(bits);
     }
-    return sin(epsilon) / cos_val;
+    return (half_pi - arctg_series(_denominator, _numerator, log2_epsilon - 2)).rounded(bits);
+}
+
+std::pair<fraction, fraction> fraction::sincos_for_division(fraction const &epsilon, bool divide_by_sin) const
+{
+    double log2_epsilon = log2_of_epsilon(epsilon);
+
+    // a coarse divisor within 2^-coarse_bits and at least twice that in magnitude is at most twice the true one
+    size_t coarse_bits = 16;
+    fraction divisor;
+    while (true)
+    {
+        auto [sin_val, cos_val] = sincos(fraction(big_int(1), big_int(1) << coarse_bits));
+        divisor = divide_by_sin ? sin_val.abs() : cos_val.abs();
+        if (divisor >= fraction(big_int(2), big_int(1) << coarse_bits))
+        {
+            break;
+        }
+        coarse_bits *= 2;
+    }
+
+    // with both parts within delta the quotient is within 3 * delta / divisor^2, delta = epsilon * divisor^2 / 16
+    // leaves room for the final rounding; a spare bit covers the estimate of the logarithm
+    double log2_divisor = approximate_log2(divisor._numerator) - approximate_log2(divisor._denominator) - 1;
+    size_t bits = precision_bits(log2_epsilon - 4 + 2 * log2_divisor);
+    return sincos(fraction(big_int(1), big_int(1) << bits));
+}
+
+fraction fraction::tg(fraction const &epsilon) const
+{
+    auto [sin_val, cos_val] = sincos_for_division(epsilon, false);
+    return (sin_val / cos_val).round_to(epsilon);
 }
 
 fraction fraction::ctg(fraction const &epsilon) const
 {
-    fraction sin_val = sin(epsilon);
-    if (sin_val == fraction(0))
+    if (!_numerator)
     {
         throw std::domain_error("Cotangent is undefined for this angle");
     }
-    return cos(epsilon) / sin_val;
+    auto [sin_val, cos_val] = sincos_for_division(epsilon, true);
+    return (cos_val / sin_val).round_to(epsilon);
 }
 
 fraction fraction::sec(fraction const &epsilon) const
 {
-    fraction cos_val = cos(epsilon);
-    if (cos_val == fraction(0))
-    {
-        throw std::domain_error("Secant is undefined for this angle");
-    }
-    return fraction(1, 1) / cos_val;
+    auto [sin_val, cos_val] = sincos_for_division(epsilon, false);
+    return (fraction(1, 1) / cos_val).round_to(epsilon);
 }
 
 fraction fraction::cosec(fraction const &epsilon) const
 {
-    fraction sin_val = sin(epsilon);
-    if (sin_val == fraction(0))
+    if (!_numerator)
     {
         throw std::domain_error("Cosecant is undefined for this angle");
     }
-    return fraction(1, 1) / sin_val;
+    auto [sin_val, cos_val] = sincos_for_division(epsilon, true);
+    return (fraction(1, 1) / sin_val).round_to(epsilon);
 }
 
 fraction fraction::pow(size_t degree) const
 {
-    if (degree == 0)
-    {
-        return fraction(1, 1);
-    }
-    
-    fraction result(1, 1);
-    fraction base(*this);
-    
-    while (degree > 0)
+    // powers of coprime parts stay coprime, only a deferred value needs reducing
+    fraction result(*this);
+    result._numerator = _numerator.pow(degree);
+    result._denominator = _denominator.pow(degree);
+    if (!is_eager())
     {
-        if (degree % 2 == 1)
-        {
-            result *= base;
-        }
-        base *= base;
-        degree /= 2;
+        result.settle();
     }
-    
     return result;
 }
 
@@ -298,20 +868,51 @@ fraction fraction::root(size_t degree, fraction const &epsilon) const
     {
         throw std::domain_error("Even root of negative number");
     }
-    
-    fraction guess = (*this).abs();
-    fraction prev_guess;
-    fraction power;
-    
-    do
+
+    if (degree == 1 || !_numerator)
     {
-        prev_guess = guess;
-        power = guess.pow(degree - 1);
-        guess = fraction(degree - 1, 1) * guess + (*this) / power;
-        guess /= fraction(degree, 1);
-    } while ((guess - prev_guess).abs() > epsilon);
-    
-    return guess;
+        return *this;
+    }
+
+    if (_numerator < big_int(0))
+    {
+        return -(-*this).root(degree, epsilon);
+    }
+
+    // Newton steps run on a 2^-bits grid, so every guess stays bounded in size; the grid is refined
+    // only if the guess fails the final epsilon check
+    size_t bits = precision_bits(log2_of_epsilon(epsilon)) + 2;
+
+    // start above the root: Newton iterations for y^degree - x then decrease monotonically
+    double log2_x = approximate_log2(_numerator) - approximate_log2(_denominator);
+    long long exponent = static_cast<long long>(std::ceil(log2_x / static_cast<double>(degree))) + 1;
+    fraction guess = exponent >= 0
+        ? fraction(big_int(1) << static_cast<size_t>(exponent), big_int(1))
+        : fraction(big_int(1), big_int(1) << static_cast<size_t>(-exponent));
+
+    fraction const degree_fraction(degree, 1);
+    fraction const degree_minus_one(degree - 1, 1);
+
+    while (true)
+    {
+        fraction step_limit(big_int(1), big_int(1) << (bits - 1));
+        fraction prev_guess;
+
+        do
+        {
+            prev_guess = guess;
+            guess = fraction((degree_minus_one.lazy() * guess + *this / guess.pow(degree - 1)) / degree_fraction).rounded(bits);
+        } while ((guess - prev_guess).abs() > step_limit);
+
+        fraction low = guess - epsilon;
+        fraction high = guess + epsilon;
+        if (low.pow(degree) <= *this && *this <= high.pow(degree))
+        {
+            return guess;
+        }
+
+        bits *= 2;
+    }
 }
 
 fraction fraction::ln(fraction const &epsilon) const
@@ -321,93 +922,72 @@ fraction fraction::ln(fraction const &epsilon) const
         throw std::domain_error("Natural logarithm of non-positive number");
     }
 
-    fraction x = *this;
-    fraction result(0, 1);
-    big_int power_shift(0);
+    double log2_epsilon = log2_of_epsilon(epsilon);
 
-    while (x > fraction(2, 1))
+    // x = 2^power_shift * r, r in [1/2, 2]
+    long long power_shift = std::llround(approximate_log2(_numerator) - approximate_log2(_denominator));
+    big_int numerator = _numerator, denominator = _denominator;
+    if (power_shift > 0)
     {
-        x /= fraction(2, 1);
-        power_shift += big_int(1);
+        denominator <<= static_cast<size_t>(power_shift);
+    }
+    else if (power_shift < 0)
+    {
+        numerator <<= static_cast<size_t>(-power_shift);
     }
 
-    while (x < fraction(1, 2))
+    while (numerator > denominator * big_int(2))
     {
-        x *= fraction(2, 1);
-        power_shift -= big_int(1);
+        denominator *= big_int(2);
+        ++power_shift;
     }
 
-    fraction y = (x - fraction(1, 1)) / (x + fraction(1, 1));
-    fraction y_squared = y * y;
-    fraction term = y;
-    fraction sum = term;
-    big_int n(1);
-    fraction prev_sum;
-    int max_iterations = 1000;
-    int iterations = 0;
+    while (numerator * big_int(2) < denominator)
+    {
+        numerator *= big_int(2);
+        --power_shift;
+    }
 
-    do {
-        prev_sum = sum;
-        term = (term * y_squared * fraction(big_int(2) * n - 1, 1)) / fraction(big_int(2) * n + 1, 1);
-        sum += term;
-        n += big_int(1);
-        iterations++;
-        
-        if (iterations > 1 && (sum - prev_sum).abs() <= epsilon) {
-            break;
-        }
-    } while (iterations < max_iterations && term.abs() > epsilon);
+    // ln(r) = 2 atanh((r - 1) / (r + 1))
+    fraction result = fraction(2, 1) * atanh_series(numerator - denominator, numerator + denominator, log2_epsilon - 3);
+    if (power_shift != 0)
+    {
+        double log2_shift = std::log2(static_cast<double>(power_shift < 0 ? -power_shift : power_shift));
+        result += fraction(power_shift, 1) * cached_constant(math_constant::ln_2, log2_epsilon - 2 - log2_shift);
+    }
 
-    fraction ln2 = ln_of_2(epsilon);
-    
-    return fraction(2, 1) * sum + fraction(power_shift, 1) * ln2;
+    return result.rounded(precision_bits(log2_epsilon) + 2);
+}
+
+fraction fraction::log_in_base(math_constant base, fraction const &epsilon) const
+{
+    double log2_epsilon = log2_of_epsilon(epsilon);
+
+    // ln(x) within delta_x and ln(base) within delta_b give a quotient within (delta_x + |result| * delta_b) / ln(base),
+    // ln(base) > 1/2 here, so epsilon / 8 for each term leaves room for the final rounding
+    fraction ln_value = ln(fraction(big_int(1), big_int(1) << precision_bits(log2_epsilon - 3)));
+    double log2_result = std::log2(std::abs(approximate_log2(_numerator) - approximate_log2(_denominator)) + 2);
+    fraction ln_base = cached_constant(base, log2_epsilon - 3 - log2_result);
+
+    return (ln_value / ln_base).round_to(epsilon);
 }
 
 fraction fraction::lg(fraction const &epsilon) const
 {
-    return ln(epsilon) / ln_of_10(epsilon);
+    return log_in_base(math_constant::ln_10, epsilon);
 }
 
 fraction fraction::log2(fraction const &epsilon) const
 {
-    return ln(epsilon) / ln_of_2(epsilon);
+    return log_in_base(math_constant::ln_2, epsilon);
 }
 
 fraction fraction::ln_of_2(fraction const &epsilon) const
 {
-    fraction sum(0);
-    fraction term(1, 1);
-    big_int n(1);
-    int max_iterations = 10000;
-    int iterations = 0;
-    
-    fraction x(1, 2);
-    fraction x_power = x;
-    
-    do {
-        term = x_power / fraction(n, 1);
-        sum += term;
-        x_power *= x;
-        n += big_int(1);
-        iterations++;
-    } while (iterations < max_iterations && term.abs() > epsilon);
-    
-    return sum;
+    return cached_constant(math_constant::ln_2, log2_of_epsilon(epsilon));
 }
 
 fraction fraction::ln_of_10(fraction const &epsilon) const
 {
-    fraction y = fraction(9, 1) / fraction(11, 1);
-    fraction y_squared = y * y;
-    fraction term = y;
-    fraction sum = term;
-    big_int n(1);
-
-    do {
-        term = (term * y_squared * fraction(big_int(2) * n - 1, 1)) / fraction(big_int(2) * n + 1, 1);
-        sum += term;
-        n += big_int(1);
-    } while (term.abs() > epsilon);
-
-    return fraction(2, 1) * sum;
-}
\ No newline at end of file
+    return cached_constant(math_constant::ln_10, log2_of_epsilon(epsilon));
+}
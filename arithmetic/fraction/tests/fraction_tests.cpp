@@ -72,6 +72,10 @@ void test_io_operations() {
     std::cout << "I/O tests passed!\n\n";
 }
 
+bool within(fraction const &value, fraction const &reference, fraction const &epsilon) {
+    return (value - reference).abs() <= epsilon;
+}
+
 void test_trigonometric() {
     std::cout << "Testing trigonometric functions...\n";
     
@@ -87,6 +91,53 @@ void test_trigonometric() {
     fraction tan_pi_4 = pi_4.tg(epsilon);
     assert(tan_pi_4 > fraction(9999, 10000) && tan_pi_4 < fraction(10001, 10000));
     
+    auto [sin_1000, cos_1000] = fraction(1000, 1).sincos(epsilon);
+    assert(sin_1000 > fraction(826878, 1000000) && sin_1000 < fraction(826881, 1000000));
+    assert(cos_1000 > fraction(562378, 1000000) && cos_1000 < fraction(562380, 1000000));
+    
+    fraction atan_1 = fraction(1, 1).arctg(epsilon);
+    assert(atan_1 > fraction(785397, 1000000) && atan_1 < fraction(785399, 1000000));
+    
+    fraction atan_minus_4 = fraction(-4, 1).arctg(epsilon);
+    assert(atan_minus_4 > fraction(-1325819, 1000000) && atan_minus_4 < fraction(-1325817, 1000000));
+    
+    // quotients of sin and cos stay within epsilon, also close to a zero of the divisor
+    fraction fine(big_int(1), big_int(1) << 300);
+    fraction epsilon_10(big_int(1), big_int(1) << 10);
+    fraction epsilon_20(big_int(1), big_int(1) << 20);
+    fraction epsilon_64(big_int(1), big_int(1) << 64);
+
+    auto [sin_3, cos_3] = fraction(3, 1).sincos(fine);
+    assert(within(fraction(3, 1).cosec(epsilon_20), fraction(1, 1) / sin_3, epsilon_20));
+    assert(within(fraction(3, 1).ctg(epsilon_64), cos_3 / sin_3, epsilon_64));
+
+    fraction near_half_pi(89078, 52423);
+    auto [sin_near, cos_near] = near_half_pi.sincos(fine);
+    assert(within(near_half_pi.tg(epsilon_10), sin_near / cos_near, epsilon_10));
+
+    fraction small_negative(-47791, 314929);
+    auto [sin_small, cos_small] = small_negative.sincos(fine);
+    assert(within(small_negative.ctg(epsilon_64), cos_small / sin_small, epsilon_64));
+    assert(within(small_negative.cosec(epsilon_64), fraction(1, 1) / sin_small, epsilon_64));
+
+    fraction large(2797136, 609419);
+    auto [sin_large, cos_large] = large.sincos(fine);
+    assert(within(large.sec(epsilon_64), fraction(1, 1) / cos_large, epsilon_64));
+    assert(within(large.tg(epsilon_64), sin_large / cos_large, epsilon_64));
+
+    fraction pi_approximation(355, 226);
+    auto [sin_pi, cos_pi] = pi_approximation.sincos(fine);
+    assert(within(pi_approximation.sec(epsilon_20), fraction(1, 1) / cos_pi, epsilon_20));
+    assert(within(pi_approximation.tg(epsilon_20), sin_pi / cos_pi, epsilon_20));
+
+    bool thrown = false;
+    try {
+        fraction(0, 1).ctg(epsilon);
+    } catch (const std::domain_error&) {
+        thrown = true;
+    }
+    assert(thrown);
+
     std::cout << "Trigonometric tests passed!\n\n";
 }
 
@@ -105,9 +156,118 @@ void test_exponential() {
     assert(log10_100 > fraction(1999999, 1000000) && log10_100 < fraction(2000001, 1000000));
     std::cout << "passed\n";
     
+    fraction sqrt_2 = fraction(2, 1).root(2, epsilon);
+    assert(sqrt_2 > fraction(1414212, 1000000) && sqrt_2 < fraction(1414215, 1000000));
+    assert(fraction(1, 3).round_to(fraction(1, 1000)) == fraction(683, 2048));
+    std::cout << "passed\n";
+
+    // ln is divided by a constant below one for log2, its error must not grow past epsilon
+    fraction fine(big_int(1), big_int(1) << 300);
+    fraction epsilon_50(big_int(1), big_int(1) << 50);
+    assert(within(fraction(1024, 1).log2(epsilon_50), fraction(10, 1), epsilon_50));
+    assert(within(fraction(1, 3).log2(epsilon_50), fraction(1, 3).ln(fine) / fraction(1, 1).ln_of_2(fine), epsilon_50));
+
+    fraction huge(big_int(1) << 3000, big_int(3));
+    assert(within(huge.log2(epsilon_50), huge.ln(fine) / huge.ln_of_2(fine), epsilon_50));
+    assert(within(huge.lg(epsilon_50), huge.ln(fine) / huge.ln_of_10(fine), epsilon_50));
+    std::cout << "passed\n";
+    
     std::cout << "Exponential tests passed!\n\n";
 }
 
+void test_lazy_expressions() {
+    std::cout << "Testing lazy expressions...\n";
+    
+    fraction f1(1, 2);
+    fraction f2(1, 3);
+    fraction f3(1, 6);
+    
+    fraction r1 = f1.lazy() * f2 + f3;
+    assert(r1 == fraction(1, 3));
+    
+    fraction r2 = f1.lazy() / f2 - f3 * f1;
+    assert(r2 == fraction(17, 12));
+    
+    f1 = f1.lazy() * f1 - f2;
+    assert(f1 == fraction(-1, 12));
+    
+    try {
+        fraction r3 = f2.lazy() / fraction(0, 1);
+        assert(false && "Expected division by zero exception");
+    } catch (const std::invalid_argument&) {}
+    
+    std::cout << "Lazy expression tests passed!\n\n";
+}
+
+void test_deferred_normalisation() {
+    std::cout << "Testing deferred normalisation...\n";
+    
+    fraction sum(0, 1);
+    sum.defer_normalisation(4);
+    for (int i = 1; i <= 30; ++i) {
+        sum += fraction(1, i * (i + 1));
+    }
+    assert(sum == fraction(30, 31));
+    assert(sum.to_string() == "30/31");
+    
+    fraction product(3, 4);
+    product.defer_normalisation();
+    product *= fraction(-8, 9);
+    product /= fraction(-2, 3);
+    assert(product.normalise().to_string() == "1/1");
+    
+    fraction eager(5, 6);
+    eager -= fraction(1, 3);
+    eager *= fraction(4, 15);
+    eager /= fraction(-2, 5);
+    assert(eager.to_string() == "-1/3");
+    
+    fraction deferred(7, 12);
+    deferred.defer_normalisation(8);
+    fraction negated = -deferred;
+    assert(negated.normalisation_threshold() == 8);
+    assert(negated == fraction(-7, 12));
+    fraction absolute = negated.abs();
+    assert(absolute.normalisation_threshold() == 8);
+    assert(absolute == deferred);
+    negated -= negated;
+    assert(negated.normalisation_threshold() == 8);
+    assert(negated.to_string() == "0/1");
+    assert(fraction(1, 2).normalisation_threshold() == 0);
+    
+    std::cout << "Deferred normalisation tests passed!\n\n";
+}
+
+void test_binary_serialization() {
+    std::cout << "Testing binary serialization...\n";
+    
+    fraction f1(-6, 8);
+    fraction f2(big_int("123456789012345678901234567890"), big_int("7"));
+    fraction deferred(1, 2);
+    deferred.defer_normalisation();
+    deferred *= fraction(2, 3);
+    
+    std::stringstream stream;
+    f1.serialize(stream);
+    f2.serialize(stream);
+    deferred.serialize(stream);
+    assert(stream.str().size() == f1.serialize_size() + f2.serialize_size() + deferred.serialize_size());
+    
+    assert(fraction::deserialize(stream) == fraction(-3, 4));
+    assert(fraction::deserialize(stream) == f2);
+    assert(fraction::deserialize(stream).to_string() == "1/3");
+    
+    std::stringstream broken;
+    big_int(1).serialize(broken);
+    big_int(0).serialize(broken);
+    try {
+        fraction::deserialize(broken);
+        assert(false);
+    } catch (const std::runtime_error&) {}
+    
+    std::cout << "Binary serialization tests passed!\n\n";
+}
+
 int main() {
     try {
         test_arithmetic();
@@ -115,6 +275,9 @@ int main() {
         test_io_operations();
         test_trigonometric();
         test_exponential();
+        test_lazy_expressions();
+        test_deferred_normalisation();
+        test_binary_serialization();
         
         std::cout << "All fraction tests passed successfully!\n";
         return 0;
@@ -0,0 +1,177 @@
+#include <AVL_tree.h>
+#include <concurrent_AVL_tree.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+constexpr int key_range = 1 << 20;
+constexpr int initial_size = key_range / 2;
+
+// each thread count runs the mix for this long
+constexpr auto run_time = std::chrono::milliseconds(500);
+
+// lookup results end up here so that the lookups cannot be optimized away
+std::atomic<size_t> found_sink = 0;
+
+/** The baseline: an ordinary AVL tree where every operation, read or write, takes one mutex
+ */
+class mutex_wrapped_tree
+{
+    AVL_tree<int, int> _tree;
+    mutable std::mutex _mutex;
+
+public:
+
+    bool contains(int key) const
+    {
+        std::lock_guard lock(_mutex);
+        return _tree.contains(key);
+    }
+
+    void insert(int key)
+    {
+        std::lock_guard lock(_mutex);
+        _tree.emplace(key, key);
+    }
+
+    void erase(int key)
+    {
+        std::lock_guard lock(_mutex);
+        _tree.erase(key);
+    }
+};
+
+class lock_free_reads_tree
+{
+    concurrent_AVL_tree<int, int> _tree;
+
+public:
+
+    bool contains(int key) const
+    {
+        return _tree.contains(key);
+    }
+
+    void insert(int key)
+    {
+        _tree.emplace(key, key);
+    }
+
+    void erase(int key)
+    {
+        _tree.erase(key);
+    }
+};
+
+/** Millions of operations per second over all threads, 95% lookups and 5% writes split between insert and erase
+ */
+template<typename tree_type>
+double run_mix(tree_type &tree, size_t threads)
+{
+    std::atomic<bool> stop = false;
+    std::atomic<size_t> total = 0;
+    std::vector<std::thread> workers;
+
+    for (size_t i = 0; i < threads; ++i)
+    {
+        workers.emplace_back([&, i]
+        {
+            std::mt19937 gen(static_cast<unsigned>(i + 1));
+            size_t operations = 0;
+            size_t found = 0;
+            while (!stop.load(std::memory_order_relaxed))
+            {
+                for (int batch = 0; batch < 64; ++batch, ++operations)
+                {
+                    unsigned roll = gen() % 100;
+                    int key = static_cast<int>(gen() % key_range);
+                    if (roll < 95)
+                    {
+                        found += tree.contains(key);
+                    }
+                    else if (roll < 98)
+                    {
+                        tree.insert(key);
+                    }
+                    else
+                    {
+                        tree.erase(key);
+                    }
+                }
+            }
+            total += operations;
+            found_sink += found;
+        });
+    }
+
+    std::this_thread::sleep_for(run_time);
+    stop = true;
+    for (auto &worker : workers)
+    {
+        worker.join();
+    }
+
+    return static_cast<double>(total) / std::chrono::duration<double, std::micro>(run_time).count();
+}
+
+template<typename tree_type>
+void fill(tree_type &tree)
+{
+    std::mt19937 gen(42);
+    for (int i = 0; i < initial_size; ++i)
+    {
+        tree.insert(static_cast<int>(gen() % key_range));
+    }
+}
+
+}
+
+int main()
+{
+    size_t max_threads = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<size_t> thread_counts;
+    for (size_t threads = 1; threads < max_threads; threads *= 2)
+    {
+        thread_counts.push_back(threads);
+    }
+    thread_counts.push_back(max_threads);
+
+    mutex_wrapped_tree locked;
+    lock_free_reads_tree concurrent;
+    fill(locked);
+    fill(concurrent);
+
+    std::cout << "95% contains / 5% insert or erase over " << key_range << " keys, Mops/s" << std::endl;
+    std::cout << std::setw(10) << "threads" << std::setw(14) << "mutex" << std::setw(10) << "scaling"
+              << std::setw(14) << "concurrent" << std::setw(10) << "scaling" << std::endl;
+
+    double locked_serial = 0;
+    double concurrent_serial = 0;
+    for (size_t threads : thread_counts)
+    {
+        double locked_rate = run_mix(locked, threads);
+        double concurrent_rate = run_mix(concurrent, threads);
+        if (threads == 1)
+        {
+            locked_serial = locked_rate;
+            concurrent_serial = concurrent_rate;
+        }
+
+        std::cout << std::setw(10) << threads << std::fixed << std::setprecision(2)
+                  << std::setw(14) << locked_rate << std::setw(10) << locked_rate / locked_serial
+                  << std::setw(14) << concurrent_rate << std::setw(10) << concurrent_rate / concurrent_serial
+                  << std::endl;
+    }
+
+    return 0;
+}
@@ -7,39 +7,74 @@ namespace __detail
 {
     class AVL_TAG;
 
-    template<typename tkey, typename tvalue, typename compare>
-    class bst_impl<tkey, tvalue, compare, AVL_TAG>
+    template<typename tkey, typename tvalue, typename compare, typename augment>
+    class bst_impl<tkey, tvalue, compare, AVL_TAG, augment>
     {
-        friend class binary_search_tree<tkey, tvalue, compare, AVL_TAG>;
+        friend class binary_search_tree<tkey, tvalue, compare, AVL_TAG, augment>;
         template<class ...Args>
-        static binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node* create_node(binary_search_tree<tkey, tvalue, compare, AVL_TAG>& cont, Args&& ...args);
+        static binary_search_tree<tkey, tvalue, compare, AVL_TAG, augment>::node* create_node(binary_search_tree<tkey, tvalue, compare, AVL_TAG, augment>& cont, Args&& ...args);
 
-        static void delete_node(binary_search_tree<tkey, tvalue, compare, AVL_TAG>& cont, binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node**);
+        static void delete_node(binary_search_tree<tkey, tvalue, compare, AVL_TAG, augment>& cont, binary_search_tree<tkey, tvalue, compare, AVL_TAG, augment>::node*);
 
-        //Does not invalidate node*, needed for splay tree
-        static void post_search(binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node**){}
+        //Lookup behind the non-const find and at, a splay tree restructures around the path it took
+        template<typename key_type>
+        static binary_search_tree<tkey, tvalue, compare, AVL_TAG, augment>::node* search(binary_search_tree<tkey, tvalue, compare, AVL_TAG, augment>& cont, const key_type& key)
+        {
+            return cont.find_node(key);
+        }
 
         //Does not invalidate node*
-        static void post_insert(binary_search_tree<tkey, tvalue, compare, AVL_TAG>& cont, binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node**);
+        static void post_insert(binary_search_tree<tkey, tvalue, compare, AVL_TAG, augment>& cont, binary_search_tree<tkey, tvalue, compare, AVL_TAG, augment>::node**);
+
+        static void post_build(binary_search_tree<tkey, tvalue, compare, AVL_TAG, augment>& cont, binary_search_tree<tkey, tvalue, compare, AVL_TAG, augment>::node* built,
+                               size_t subtree_size, bool on_last_level);
+
+        static void erase(binary_search_tree<tkey, tvalue, compare, AVL_TAG, augment>& cont, binary_search_tree<tkey, tvalue, compare, AVL_TAG, augment>::node**);
+
+        static void swap(binary_search_tree<tkey, tvalue, compare, AVL_TAG, augment>& lhs, binary_search_tree<tkey, tvalue, compare, AVL_TAG, augment>& rhs) noexcept;
+
+        //Exact height, the tags only hold it modulo 8
+        static size_t subtree_rank(binary_search_tree<tkey, tvalue, compare, AVL_TAG, augment>::node*) noexcept;
 
-        static void erase(binary_search_tree<tkey, tvalue, compare, AVL_TAG>& cont, binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node**);
+        static size_t child_rank(binary_search_tree<tkey, tvalue, compare, AVL_TAG, augment>::node*, size_t parent_rank, bool right_child) noexcept;
 
-        static void swap(binary_search_tree<tkey, tvalue, compare, AVL_TAG>& lhs, binary_search_tree<tkey, tvalue, compare, AVL_TAG>& rhs) noexcept;
+        static binary_search_tree<tkey, tvalue, compare, AVL_TAG, augment>::ranked_subtree join(
+                binary_search_tree<tkey, tvalue, compare, AVL_TAG, augment>::ranked_subtree left,
+                binary_search_tree<tkey, tvalue, compare, AVL_TAG, augment>::node* middle,
+                binary_search_tree<tkey, tvalue, compare, AVL_TAG, augment>::ranked_subtree right) noexcept;
+
+        //Descends the spine of the taller side until heights are within one, then rotates on the way back up
+        static binary_search_tree<tkey, tvalue, compare, AVL_TAG, augment>::ranked_subtree join_right(
+                binary_search_tree<tkey, tvalue, compare, AVL_TAG, augment>::ranked_subtree left,
+                binary_search_tree<tkey, tvalue, compare, AVL_TAG, augment>::node* middle,
+                binary_search_tree<tkey, tvalue, compare, AVL_TAG, augment>::ranked_subtree right) noexcept;
+
+        static binary_search_tree<tkey, tvalue, compare, AVL_TAG, augment>::ranked_subtree join_left(
+                binary_search_tree<tkey, tvalue, compare, AVL_TAG, augment>::ranked_subtree left,
+                binary_search_tree<tkey, tvalue, compare, AVL_TAG, augment>::node* middle,
+                binary_search_tree<tkey, tvalue, compare, AVL_TAG, augment>::ranked_subtree right) noexcept;
+
+        //Links subtrees whose heights differ by at most one
+        static binary_search_tree<tkey, tvalue, compare, AVL_TAG, augment>::ranked_subtree link(
+                binary_search_tree<tkey, tvalue, compare, AVL_TAG, augment>::ranked_subtree left,
+                binary_search_tree<tkey, tvalue, compare, AVL_TAG, augment>::node* middle,
+                binary_search_tree<tkey, tvalue, compare, AVL_TAG, augment>::ranked_subtree right) noexcept;
     };
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare = std::less<tkey>>
+template<typename tkey, typename tvalue, compator<tkey> compare = std::less<tkey>, typename augment = no_augmentation>
 class AVL_tree final:
-        public binary_search_tree<tkey, tvalue, compare, __detail::AVL_TAG>
+        public binary_search_tree<tkey, tvalue, compare, __detail::AVL_TAG, augment>
 {
-    using parent = binary_search_tree<tkey, tvalue, compare, __detail::AVL_TAG>;
-    friend class __detail::bst_impl<tkey, tvalue, compare, __detail::AVL_TAG>;
+    using parent = binary_search_tree<tkey, tvalue, compare, __detail::AVL_TAG, augment>;
+    friend class __detail::bst_impl<tkey, tvalue, compare, __detail::AVL_TAG, augment>;
 private:
 
+    /** Height is kept modulo 8 in the tag bits of the parent link. Sibling heights never differ by more
+     *  than 2, so their difference, and with it the taller child, is still known exactly
+     */
     struct node final: public parent::node
     {
-        size_t height;
-
         void recalculate_height() noexcept;
 
         /*
@@ -47,10 +82,12 @@ private:
          */
         short get_balance() const noexcept;
 
+        /** Exact height, found by descending along the taller children
+         */
+        size_t get_height() const noexcept;
+
         template<class ...Args>
         node(parent::node* par, Args&&... args);
-
-        ~node() noexcept override =default;
     };
 
 public:
@@ -171,8 +208,8 @@ public:
 
     class infix_iterator : public parent::infix_iterator
     {
-        friend binary_search_tree<tkey, tvalue, compare, __detail::AVL_TAG>;
-        friend class __detail::bst_impl<tkey, tvalue, compare, __detail::AVL_TAG>;
+        friend binary_search_tree<tkey, tvalue, compare, __detail::AVL_TAG, augment>;
+        friend class __detail::bst_impl<tkey, tvalue, compare, __detail::AVL_TAG, augment>;
     public:
 
         using value_type = parent::infix_iterator::value_type;
@@ -560,6 +597,9 @@ public:
     infix_iterator upper_bound(const tkey&);
     infix_const_iterator upper_bound(const tkey&) const;
 
+    infix_iterator select(size_t index) requires counts_subtrees<augment>;
+    infix_const_iterator select(size_t index) const requires counts_subtrees<augment>;
+
     infix_iterator erase(infix_iterator pos);
     infix_iterator erase(infix_const_iterator pos);
 
@@ -592,104 +632,114 @@ AVL_tree(std::initializer_list<std::pair<tkey, tvalue>> data, const compare& cmp
 
 namespace __detail
 {
-    template<typename tkey, typename tvalue, typename compare>
+    template<typename tkey, typename tvalue, typename compare, typename augment>
     template<class ...Args>
-    typename binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node *bst_impl<tkey, tvalue, compare, AVL_TAG>::create_node(
-            binary_search_tree <tkey, tvalue, compare, AVL_TAG> &cont, Args &&...args)
+    typename binary_search_tree<tkey, tvalue, compare, AVL_TAG, augment>::node *bst_impl<tkey, tvalue, compare, AVL_TAG, augment>::create_node(
+            binary_search_tree <tkey, tvalue, compare, AVL_TAG, augment> &cont, Args &&...args)
     {
-        using node_type = typename AVL_tree<tkey, tvalue, compare>::node;
+        using node_type = typename AVL_tree<tkey, tvalue, compare, augment>::node;
         auto *new_node = cont._allocator.template new_object<node_type>(std::forward<Args>(args)...);
         return new_node;
     }
 
-    template<typename tkey, typename tvalue, typename compare>
-    void bst_impl<tkey, tvalue, compare, AVL_TAG>::delete_node(
-            binary_search_tree <tkey, tvalue, compare, AVL_TAG> &cont, binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node** node)
+    template<typename tkey, typename tvalue, typename compare, typename augment>
+    void bst_impl<tkey, tvalue, compare, AVL_TAG, augment>::delete_node(
+            binary_search_tree <tkey, tvalue, compare, AVL_TAG, augment> &cont, binary_search_tree<tkey, tvalue, compare, AVL_TAG, augment>::node* node)
     {
-        using node_type = typename binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node;
-        if (node && *node)
+        using node_type = typename AVL_tree<tkey, tvalue, compare, augment>::node;
+        if (node)
         {
-            cont._allocator.template delete_object<node_type>(*node);
-            *node = nullptr;
+            cont._allocator.template delete_object<node_type>(static_cast<node_type*>(node));
         }
     }
 
-    template<typename tkey, typename tvalue, typename compare>
-    void bst_impl<tkey, tvalue, compare, AVL_TAG>::post_insert(
-            binary_search_tree<tkey, tvalue, compare, AVL_TAG>& cont,
-            typename binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node** node) {
+    template<typename tkey, typename tvalue, typename compare, typename augment>
+    void bst_impl<tkey, tvalue, compare, AVL_TAG, augment>::post_build(
+            binary_search_tree<tkey, tvalue, compare, AVL_TAG, augment>&,
+            typename binary_search_tree<tkey, tvalue, compare, AVL_TAG, augment>::node* built,
+            size_t subtree_size,
+            bool)
+    {
+        // a balanced subtree of n nodes is bit_width(n) high, the tag keeps it modulo 8
+        built->set_tag(static_cast<unsigned char>(std::bit_width(subtree_size)));
+    }
+
+    template<typename tkey, typename tvalue, typename compare, typename augment>
+    void bst_impl<tkey, tvalue, compare, AVL_TAG, augment>::post_insert(
+            binary_search_tree<tkey, tvalue, compare, AVL_TAG, augment>& cont,
+            typename binary_search_tree<tkey, tvalue, compare, AVL_TAG, augment>::node** node) {
         if (node == nullptr || *node == nullptr)
             return;
 
-        using avl_node = typename AVL_tree<tkey, tvalue, compare>::node;
-        using node_type = typename binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node;
+        using avl_node = typename AVL_tree<tkey, tvalue, compare, augment>::node;
+        using node_type = typename binary_search_tree<tkey, tvalue, compare, AVL_TAG, augment>::node;
 
-        auto* current = static_cast<avl_node*>((*node)->parent);  // Кастим на avl_node
+        auto* current = static_cast<avl_node*>((*node)->get_parent());  // Кастим на avl_node
 
         while (current != nullptr) {
             current->recalculate_height();
             short balance = current->get_balance();
 
-            node_type *&subtree_ref = (current->parent == nullptr)
+            node_type *&subtree_ref = (current->get_parent() == nullptr)
                                       ? cont._root
-                                      : (current->parent->left_subtree == current
-                                         ? current->parent->left_subtree
-                                         : current->parent->right_subtree);
+                                      : (current->get_parent()->left_subtree == current
+                                         ? current->get_parent()->left_subtree
+                                         : current->get_parent()->right_subtree);
 
             if (balance > 1) { // Right-heavy
                 auto *right = static_cast<avl_node *>(current->right_subtree);
                 if (right && right->get_balance() < 0) { // Right-Left case
-                    node_type *&right_ref = (right->parent->left_subtree == right)
-                                            ? right->parent->left_subtree
-                                            : right->parent->right_subtree;
+                    node_type *&right_ref = (right->get_parent()->left_subtree == right)
+                                            ? right->get_parent()->left_subtree
+                                            : right->get_parent()->right_subtree;
                     cont.small_right_rotation(right_ref);
                     right->recalculate_height();
                 }
 
                 cont.small_left_rotation(subtree_ref);
                 static_cast<avl_node *>(current)->recalculate_height();
-                if (current->parent) {
-                    static_cast<avl_node *>(current->parent)->recalculate_height();
+                if (current->get_parent()) {
+                    static_cast<avl_node *>(current->get_parent())->recalculate_height();
                 }
 
                 current = static_cast<avl_node *>(subtree_ref);
             } else if (balance < -1) { // Left-heavy
                 auto *left = static_cast<avl_node *>(current->left_subtree);
                 if (left && left->get_balance() > 0) { // Left-Right case
-                    node_type *&left_ref = (left->parent->left_subtree == left)
-                                           ? left->parent->left_subtree
-                                           : left->parent->right_subtree;
+                    node_type *&left_ref = (left->get_parent()->left_subtree == left)
+                                           ? left->get_parent()->left_subtree
+                                           : left->get_parent()->right_subtree;
                     cont.small_left_rotation(left_ref);
                     left->recalculate_height();
                 }
 
                 cont.small_right_rotation(subtree_ref);
                 static_cast<avl_node *>(current)->recalculate_height();
-                if (current->parent) {
-                    static_cast<avl_node *>(current->parent)->recalculate_height();
+                if (current->get_parent()) {
+                    static_cast<avl_node *>(current->get_parent())->recalculate_height();
                 }
 
                 current = static_cast<avl_node *>(subtree_ref);
             }
 
-            current = static_cast<avl_node *>(current->parent);
+            current = static_cast<avl_node *>(current->get_parent());
         }
     }
 
 
-    template<typename tkey, typename tvalue, typename compare>
-    void bst_impl<tkey, tvalue, compare, AVL_TAG>::erase(
-            binary_search_tree<tkey, tvalue, compare, AVL_TAG> &cont,
-            typename binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node **node_ptr)
+    template<typename tkey, typename tvalue, typename compare, typename augment>
+    void bst_impl<tkey, tvalue, compare, AVL_TAG, augment>::erase(
+            binary_search_tree<tkey, tvalue, compare, AVL_TAG, augment> &cont,
+            typename binary_search_tree<tkey, tvalue, compare, AVL_TAG, augment>::node **node_ptr)
     {
 
-        using node_type = typename binary_search_tree<tkey, tvalue, compare, AVL_TAG>::node;
-        using avl_node = typename AVL_tree<tkey, tvalue, compare>::node;
+        using node_type = typename binary_search_tree<tkey, tvalue, compare, AVL_TAG, augment>::node;
+        using avl_node = typename AVL_tree<tkey, tvalue, compare, augment>::node;
 
         if (node_ptr == nullptr || *node_ptr == nullptr) return;
 
         node_type *node = *node_ptr;
-        node_type *parent = node->parent;
+        node_type *parent = node->get_parent();
         node_type *balance_start = parent;
         //no children???
         if (node->left_subtree == nullptr && node->right_subtree == nullptr) {
@@ -699,12 +749,13 @@ namespace __detail
             } else {
                 cont._root = nullptr;
             }
-            delete_node(cont, node_ptr);
+            delete_node(cont, node);
+            *node_ptr = nullptr;
         }
         //the son
         else if (node->left_subtree == nullptr || node->right_subtree == nullptr) {
             node_type *child = node->left_subtree ? node->left_subtree : node->right_subtree;
-            child->parent = parent;
+            child->set_parent(parent);
 
             if (parent) {
                 if (parent->left_subtree == node) parent->left_subtree = child;
@@ -713,7 +764,8 @@ namespace __detail
                 cont._root = child;
             }
             balance_start = child;
-            delete_node(cont, node_ptr);
+            delete_node(cont, node);
+            *node_ptr = nullptr;
         }
         //son and daughter
         else {
@@ -724,38 +776,39 @@ namespace __detail
 
             balance_start = predecessor;
 
-            if (predecessor->parent != node) {
-                predecessor->parent->right_subtree = predecessor->left_subtree;
+            if (predecessor->get_parent() != node) {
+                predecessor->get_parent()->right_subtree = predecessor->left_subtree;
                 if (predecessor->left_subtree) {
-                    predecessor->left_subtree->parent = predecessor->parent;
+                    predecessor->left_subtree->set_parent(predecessor->get_parent());
                 }
-                balance_start = predecessor->parent;
+                balance_start = predecessor->get_parent();
             }
 
             predecessor->left_subtree = (node->left_subtree == predecessor) ?
                                         predecessor->left_subtree : node->left_subtree;
             if (predecessor->left_subtree) {
-                predecessor->left_subtree->parent = predecessor;
+                predecessor->left_subtree->set_parent(predecessor);
             }
 
             predecessor->right_subtree = node->right_subtree;
             if (predecessor->right_subtree) {
-                predecessor->right_subtree->parent = predecessor;
+                predecessor->right_subtree->set_parent(predecessor);
             }
 
-            predecessor->parent = node->parent;
+            predecessor->set_parent(node->get_parent());
 
-            if (node->parent) {
-                if (node->parent->left_subtree == node) {
-                    node->parent->left_subtree = predecessor;
+            if (node->get_parent()) {
+                if (node->get_parent()->left_subtree == node) {
+                    node->get_parent()->left_subtree = predecessor;
                 } else {
-                    node->parent->right_subtree = predecessor;
+                    node->get_parent()->right_subtree = predecessor;
                 }
             } else {
                 cont._root = predecessor;
             }
 
-            delete_node(cont, node_ptr);
+            delete_node(cont, node);
+            *node_ptr = nullptr;
         }
 
         --cont._size;
@@ -766,59 +819,185 @@ namespace __detail
                 current->recalculate_height();
                 short balance = current->get_balance();
 
-                node_type *&subtree_ref = (current->parent == nullptr)
+                node_type *&subtree_ref = (current->get_parent() == nullptr)
                                           ? cont._root
-                                          : (current->parent->left_subtree == current
-                                             ? current->parent->left_subtree
-                                             : current->parent->right_subtree);
+                                          : (current->get_parent()->left_subtree == current
+                                             ? current->get_parent()->left_subtree
+                                             : current->get_parent()->right_subtree);
 
                 if (balance > 1) { // Right-heavy
                     auto *right = static_cast<avl_node *>(current->right_subtree);
                     if (right && right->get_balance() < 0) { // Right-Left case
-                        node_type *&right_ref = (right->parent->left_subtree == right)
-                                                ? right->parent->left_subtree
-                                                : right->parent->right_subtree;
+                        node_type *&right_ref = (right->get_parent()->left_subtree == right)
+                                                ? right->get_parent()->left_subtree
+                                                : right->get_parent()->right_subtree;
                         cont.small_right_rotation(right_ref);
                         right->recalculate_height();
                     }
 
                     cont.small_left_rotation(subtree_ref);
                     static_cast<avl_node *>(current)->recalculate_height();
-                    if (current->parent) {
-                        static_cast<avl_node *>(current->parent)->recalculate_height();
+                    if (current->get_parent()) {
+                        static_cast<avl_node *>(current->get_parent())->recalculate_height();
                     }
 
                     current = static_cast<avl_node *>(subtree_ref);
                 } else if (balance < -1) { // Left-heavy
                     auto *left = static_cast<avl_node *>(current->left_subtree);
                     if (left && left->get_balance() > 0) { // Left-Right case
-                        node_type *&left_ref = (left->parent->left_subtree == left)
-                                               ? left->parent->left_subtree
-                                               : left->parent->right_subtree;
+                        node_type *&left_ref = (left->get_parent()->left_subtree == left)
+                                               ? left->get_parent()->left_subtree
+                                               : left->get_parent()->right_subtree;
                         cont.small_left_rotation(left_ref);
                         left->recalculate_height();
                     }
 
                     cont.small_right_rotation(subtree_ref);
                     static_cast<avl_node *>(current)->recalculate_height();
-                    if (current->parent) {
-                        static_cast<avl_node *>(current->parent)->recalculate_height();
+                    if (current->get_parent()) {
+                        static_cast<avl_node *>(current->get_parent())->recalculate_height();
                     }
 
                     current = static_cast<avl_node *>(subtree_ref);
                 }
 
-                current = static_cast<avl_node *>(current->parent);
+                current = static_cast<avl_node *>(current->get_parent());
+            }
+        }
+    }
+
+
+}
+
+namespace __detail
+{
+    template<typename tkey, typename tvalue, typename compare, typename augment>
+    size_t bst_impl<tkey, tvalue, compare, AVL_TAG, augment>::subtree_rank(
+            typename binary_search_tree<tkey, tvalue, compare, AVL_TAG, augment>::node* subtree_root) noexcept
+    {
+        using avl_node = typename AVL_tree<tkey, tvalue, compare, augment>::node;
+        return subtree_root ? static_cast<avl_node*>(subtree_root)->get_height() : 0;
+    }
+
+    template<typename tkey, typename tvalue, typename compare, typename augment>
+    size_t bst_impl<tkey, tvalue, compare, AVL_TAG, augment>::child_rank(
+            typename binary_search_tree<tkey, tvalue, compare, AVL_TAG, augment>::node* parent,
+            size_t parent_rank,
+            bool right_child) noexcept
+    {
+        using avl_node = typename AVL_tree<tkey, tvalue, compare, augment>::node;
+        short balance = static_cast<avl_node*>(parent)->get_balance();
+        // the taller child is one lower than the parent, the other one is two lower unless they are even
+        return parent_rank - 1 - ((right_child ? balance < 0 : balance > 0) ? 1 : 0);
+    }
+
+    template<typename tkey, typename tvalue, typename compare, typename augment>
+    typename binary_search_tree<tkey, tvalue, compare, AVL_TAG, augment>::ranked_subtree bst_impl<tkey, tvalue, compare, AVL_TAG, augment>::link(
+            typename binary_search_tree<tkey, tvalue, compare, AVL_TAG, augment>::ranked_subtree left,
+            typename binary_search_tree<tkey, tvalue, compare, AVL_TAG, augment>::node* middle,
+            typename binary_search_tree<tkey, tvalue, compare, AVL_TAG, augment>::ranked_subtree right) noexcept
+    {
+        middle->set_parent(nullptr);
+        middle->left_subtree = left.root;
+        middle->right_subtree = right.root;
+        if (left.root)
+        {
+            left.root->set_parent(middle);
+        }
+        if (right.root)
+        {
+            right.root->set_parent(middle);
+        }
+
+        size_t height = std::max(left.rank, right.rank) + 1;
+        middle->set_tag(static_cast<unsigned char>(height));
+        binary_search_tree<tkey, tvalue, compare, AVL_TAG, augment>::update_augmentation(middle);
+        return { middle, height };
+    }
+
+    template<typename tkey, typename tvalue, typename compare, typename augment>
+    typename binary_search_tree<tkey, tvalue, compare, AVL_TAG, augment>::ranked_subtree bst_impl<tkey, tvalue, compare, AVL_TAG, augment>::join_right(
+            typename binary_search_tree<tkey, tvalue, compare, AVL_TAG, augment>::ranked_subtree left,
+            typename binary_search_tree<tkey, tvalue, compare, AVL_TAG, augment>::node* middle,
+            typename binary_search_tree<tkey, tvalue, compare, AVL_TAG, augment>::ranked_subtree right) noexcept
+    {
+        using tree = binary_search_tree<tkey, tvalue, compare, AVL_TAG, augment>;
+        auto [outer, pivot, inner] = tree::expose(left);
+
+        if (inner.rank <= right.rank + 1)
+        {
+            if (std::max(inner.rank, right.rank) + 1 <= outer.rank + 1)
+            {
+                return link(outer, pivot, link(inner, middle, right));
             }
+
+            // inner is the taller side by one: its root rises above pivot and middle
+            auto [inner_left, lifted, inner_right] = tree::expose(inner);
+            return link(link(outer, pivot, inner_left), lifted, link(inner_right, middle, right));
         }
+
+        auto joined = join_right(inner, middle, right);
+        if (joined.rank <= outer.rank + 1)
+        {
+            return link(outer, pivot, joined);
+        }
+
+        auto [joined_left, lifted, joined_right] = tree::expose(joined);
+        return link(link(outer, pivot, joined_left), lifted, joined_right);
     }
 
+    template<typename tkey, typename tvalue, typename compare, typename augment>
+    typename binary_search_tree<tkey, tvalue, compare, AVL_TAG, augment>::ranked_subtree bst_impl<tkey, tvalue, compare, AVL_TAG, augment>::join_left(
+            typename binary_search_tree<tkey, tvalue, compare, AVL_TAG, augment>::ranked_subtree left,
+            typename binary_search_tree<tkey, tvalue, compare, AVL_TAG, augment>::node* middle,
+            typename binary_search_tree<tkey, tvalue, compare, AVL_TAG, augment>::ranked_subtree right) noexcept
+    {
+        using tree = binary_search_tree<tkey, tvalue, compare, AVL_TAG, augment>;
+        auto [inner, pivot, outer] = tree::expose(right);
 
+        if (inner.rank <= left.rank + 1)
+        {
+            if (std::max(inner.rank, left.rank) + 1 <= outer.rank + 1)
+            {
+                return link(link(left, middle, inner), pivot, outer);
+            }
+
+            auto [inner_left, lifted, inner_right] = tree::expose(inner);
+            return link(link(left, middle, inner_left), lifted, link(inner_right, pivot, outer));
+        }
+
+        auto joined = join_left(left, middle, inner);
+        if (joined.rank <= outer.rank + 1)
+        {
+            return link(joined, pivot, outer);
+        }
+
+        auto [joined_left, lifted, joined_right] = tree::expose(joined);
+        return link(joined_left, lifted, link(joined_right, pivot, outer));
+    }
+
+    template<typename tkey, typename tvalue, typename compare, typename augment>
+    typename binary_search_tree<tkey, tvalue, compare, AVL_TAG, augment>::ranked_subtree bst_impl<tkey, tvalue, compare, AVL_TAG, augment>::join(
+            typename binary_search_tree<tkey, tvalue, compare, AVL_TAG, augment>::ranked_subtree left,
+            typename binary_search_tree<tkey, tvalue, compare, AVL_TAG, augment>::node* middle,
+            typename binary_search_tree<tkey, tvalue, compare, AVL_TAG, augment>::ranked_subtree right) noexcept
+    {
+        // O(|left.rank - right.rank| + 1)
+        if (left.rank > right.rank + 1)
+        {
+            return join_right(left, middle, right);
+        }
+        if (right.rank > left.rank + 1)
+        {
+            return join_left(left, middle, right);
+        }
+        return link(left, middle, right);
+    }
 }
 
-template<typename tkey, typename tvalue, typename compare>
-void __detail::bst_impl<tkey, tvalue, compare, __detail::AVL_TAG>::swap(binary_search_tree<tkey, tvalue, compare, AVL_TAG> &lhs,
-                                                                        binary_search_tree<tkey, tvalue, compare, AVL_TAG> &rhs) noexcept
+template<typename tkey, typename tvalue, typename compare, typename augment>
+void __detail::bst_impl<tkey, tvalue, compare, __detail::AVL_TAG, augment>::swap(binary_search_tree<tkey, tvalue, compare, AVL_TAG, augment> &lhs,
+                                                                        binary_search_tree<tkey, tvalue, compare, AVL_TAG, augment> &rhs) noexcept
 {
     using std::swap;
     swap(lhs.root, rhs.root);
@@ -829,51 +1008,65 @@ void __detail::bst_impl<tkey, tvalue, compare, __detail::AVL_TAG>::swap(binary_s
 
 // region node implementation
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-void AVL_tree<tkey, tvalue, compare>::node::recalculate_height() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+void AVL_tree<tkey, tvalue, compare, augment>::node::recalculate_height() noexcept
 {
-    const size_t left_height = this->left_subtree ? static_cast<node*>(this->left_subtree)->height : 0;
-    const size_t right_height = this->right_subtree ? static_cast<node*>(this->right_subtree)->height : 0;
-    this->height = 1 + std::max(left_height, right_height);
+    const unsigned char left_height = this->left_subtree ? this->left_subtree->get_tag() : 0;
+    const unsigned char right_height = this->right_subtree ? this->right_subtree->get_tag() : 0;
+    this->set_tag(1 + (get_balance() > 0 ? right_height : left_height));
+    parent::update_augmentation(this);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-short AVL_tree<tkey, tvalue, compare>::node::get_balance() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+short AVL_tree<tkey, tvalue, compare, augment>::node::get_balance() const noexcept
 {
-    const size_t left_height = this->left_subtree ? static_cast<node *>(this->left_subtree)->height : 0;
-    const size_t right_height = this->right_subtree ? static_cast<node *>(this->right_subtree)->height : 0;
-    return static_cast<short>(right_height - left_height);
+    const unsigned char left_height = this->left_subtree ? this->left_subtree->get_tag() : 0;
+    const unsigned char right_height = this->right_subtree ? this->right_subtree->get_tag() : 0;
+    // difference modulo 8 read back as a signed value in [-4, 3]
+    return static_cast<short>(((right_height - left_height) & parent::node::tag_mask) ^ 4) - 4;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+size_t AVL_tree<tkey, tvalue, compare, augment>::node::get_height() const noexcept
+{
+    size_t height = 0;
+    for (node const* current = this; current; ++height)
+    {
+        current = static_cast<node const*>(current->get_balance() > 0 ? current->right_subtree : current->left_subtree);
+    }
+    return height;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
 template<class ...Args>
-AVL_tree<tkey, tvalue, compare>::node::node(parent::node* par, Args&&... args)
-        : parent::node(par, std::forward<Args>(args)...), height(1)
+AVL_tree<tkey, tvalue, compare, augment>::node::node(parent::node* par, Args&&... args)
+        : parent::node(par, std::forward<Args>(args)...)
 {
+    this->set_tag(1);
 }
 
 // endregion node implementation
 
 // region prefix_iterator implementation
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::prefix_iterator::prefix_iterator(parent::node* n) noexcept : parent::prefix_iterator(n)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>::prefix_iterator::prefix_iterator(parent::node* n) noexcept : parent::prefix_iterator(n)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::prefix_iterator::prefix_iterator(parent::prefix_iterator it) noexcept : parent::prefix_iterator(it)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>::prefix_iterator::prefix_iterator(parent::prefix_iterator it) noexcept : parent::prefix_iterator(it)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-size_t AVL_tree<tkey, tvalue, compare>::prefix_iterator::get_height() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+size_t AVL_tree<tkey, tvalue, compare, augment>::prefix_iterator::get_height() const noexcept
 {
-    return static_cast<node*>(this->_data)->height;
+    return static_cast<node*>(this->_data)->get_height();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-size_t AVL_tree<tkey, tvalue, compare>::prefix_iterator::get_balance() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+size_t AVL_tree<tkey, tvalue, compare, augment>::prefix_iterator::get_balance() const noexcept
 {
     return static_cast<node*>(this->_data)->get_balance();
 }
@@ -882,29 +1075,29 @@ size_t AVL_tree<tkey, tvalue, compare>::prefix_iterator::get_balance() const noe
 
 // region prefix_const_iterator implementation
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::prefix_const_iterator::prefix_const_iterator(parent::node* n) noexcept : parent::prefix_const_iterator(n)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>::prefix_const_iterator::prefix_const_iterator(parent::node* n) noexcept : parent::prefix_const_iterator(n)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::prefix_const_iterator::prefix_const_iterator(parent::prefix_const_iterator it) noexcept : parent::prefix_const_iterator(it)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>::prefix_const_iterator::prefix_const_iterator(parent::prefix_const_iterator it) noexcept : parent::prefix_const_iterator(it)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::prefix_const_iterator::prefix_const_iterator(prefix_iterator it) noexcept : parent::prefix_const_iterator(it)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>::prefix_const_iterator::prefix_const_iterator(prefix_iterator it) noexcept : parent::prefix_const_iterator(it)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-size_t AVL_tree<tkey, tvalue, compare>::prefix_const_iterator::get_height() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+size_t AVL_tree<tkey, tvalue, compare, augment>::prefix_const_iterator::get_height() const noexcept
 {
     return prefix_iterator(this->_base).get_height();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-size_t AVL_tree<tkey, tvalue, compare>::prefix_const_iterator::get_balance() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+size_t AVL_tree<tkey, tvalue, compare, augment>::prefix_const_iterator::get_balance() const noexcept
 {
     return prefix_iterator(this->_base)->get_balance();
 }
@@ -913,42 +1106,42 @@ size_t AVL_tree<tkey, tvalue, compare>::prefix_const_iterator::get_balance() con
 
 // region prefix_reverse_iterator implementation
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::prefix_reverse_iterator::prefix_reverse_iterator(parent::node* n) noexcept : parent::prefix_reverse_iterator(n)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>::prefix_reverse_iterator::prefix_reverse_iterator(parent::node* n) noexcept : parent::prefix_reverse_iterator(n)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::prefix_reverse_iterator::prefix_reverse_iterator(parent::prefix_reverse_iterator it) noexcept : parent::prefix_reverse_iterator(it)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>::prefix_reverse_iterator::prefix_reverse_iterator(parent::prefix_reverse_iterator it) noexcept : parent::prefix_reverse_iterator(it)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-size_t AVL_tree<tkey, tvalue, compare>::prefix_reverse_iterator::get_height() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+size_t AVL_tree<tkey, tvalue, compare, augment>::prefix_reverse_iterator::get_height() const noexcept
 {
-    return prefix_iterator(this->_base)->height;
+    return prefix_iterator(this->_base).get_height();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-size_t AVL_tree<tkey, tvalue, compare>::prefix_reverse_iterator::get_balance() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+size_t AVL_tree<tkey, tvalue, compare, augment>::prefix_reverse_iterator::get_balance() const noexcept
 {
     return prefix_iterator(this->_base)->get_balance();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::prefix_reverse_iterator::prefix_reverse_iterator(prefix_iterator it) noexcept : parent::prefix_reverse_iterator(it)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>::prefix_reverse_iterator::prefix_reverse_iterator(prefix_iterator it) noexcept : parent::prefix_reverse_iterator(it)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::prefix_reverse_iterator::operator AVL_tree<tkey, tvalue, compare>::prefix_iterator() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>::prefix_reverse_iterator::operator AVL_tree<tkey, tvalue, compare, augment>::prefix_iterator() const noexcept
 {
     return parent::prefix_reverse_iterator::operator prefix_iterator();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::prefix_iterator
-AVL_tree<tkey, tvalue, compare>::prefix_reverse_iterator::base() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::prefix_iterator
+AVL_tree<tkey, tvalue, compare, augment>::prefix_reverse_iterator::base() const noexcept
 {
     return parent::prefix_reverse_iterator::base();
 }
@@ -957,42 +1150,42 @@ AVL_tree<tkey, tvalue, compare>::prefix_reverse_iterator::base() const noexcept
 
 // region prefix_const_reverse_iterator implementation
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::prefix_const_reverse_iterator::prefix_const_reverse_iterator(parent::node* n) noexcept : parent::prefix_const_reverse_iterator(n)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>::prefix_const_reverse_iterator::prefix_const_reverse_iterator(parent::node* n) noexcept : parent::prefix_const_reverse_iterator(n)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::prefix_const_reverse_iterator::prefix_const_reverse_iterator(parent::prefix_const_reverse_iterator it) noexcept : parent::prefix_const_reverse_iterator(it)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>::prefix_const_reverse_iterator::prefix_const_reverse_iterator(parent::prefix_const_reverse_iterator it) noexcept : parent::prefix_const_reverse_iterator(it)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-size_t AVL_tree<tkey, tvalue, compare>::prefix_const_reverse_iterator::get_height() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+size_t AVL_tree<tkey, tvalue, compare, augment>::prefix_const_reverse_iterator::get_height() const noexcept
 {
-    return prefix_iterator(this->_base)->height;
+    return prefix_iterator(this->_base).get_height();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-size_t AVL_tree<tkey, tvalue, compare>::prefix_const_reverse_iterator::get_balance() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+size_t AVL_tree<tkey, tvalue, compare, augment>::prefix_const_reverse_iterator::get_balance() const noexcept
 {
     return prefix_iterator(this->_base)->get_balance();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::prefix_const_reverse_iterator::prefix_const_reverse_iterator(prefix_const_iterator it) noexcept : parent::prefix_const_reverse_iterator(it)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>::prefix_const_reverse_iterator::prefix_const_reverse_iterator(prefix_const_iterator it) noexcept : parent::prefix_const_reverse_iterator(it)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::prefix_const_reverse_iterator::operator AVL_tree<tkey, tvalue, compare>::prefix_const_iterator() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>::prefix_const_reverse_iterator::operator AVL_tree<tkey, tvalue, compare, augment>::prefix_const_iterator() const noexcept
 {
     return parent::prefix_const_reverse_iterator::operator prefix_const_iterator();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::prefix_const_iterator
-AVL_tree<tkey, tvalue, compare>::prefix_const_reverse_iterator::base() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::prefix_const_iterator
+AVL_tree<tkey, tvalue, compare, augment>::prefix_const_reverse_iterator::base() const noexcept
 {
     return parent::prefix_const_reverse_iterator::base();
 }
@@ -1001,24 +1194,24 @@ AVL_tree<tkey, tvalue, compare>::prefix_const_reverse_iterator::base() const noe
 
 // region infix_iterator implementation
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::infix_iterator::infix_iterator(parent::node* n) noexcept : parent::infix_iterator(n)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>::infix_iterator::infix_iterator(parent::node* n) noexcept : parent::infix_iterator(n)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::infix_iterator::infix_iterator(parent::infix_iterator it) noexcept : parent::infix_iterator(it)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>::infix_iterator::infix_iterator(parent::infix_iterator it) noexcept : parent::infix_iterator(it)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-size_t AVL_tree<tkey, tvalue, compare>::infix_iterator::get_height() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+size_t AVL_tree<tkey, tvalue, compare, augment>::infix_iterator::get_height() const noexcept
 {
-    return static_cast<node*>(this->_data)->height;
+    return static_cast<node*>(this->_data)->get_height();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-size_t AVL_tree<tkey, tvalue, compare>::infix_iterator::get_balance() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+size_t AVL_tree<tkey, tvalue, compare, augment>::infix_iterator::get_balance() const noexcept
 {
     return static_cast<node*>(this->_data)->get_balance();
 }
@@ -1027,30 +1220,30 @@ size_t AVL_tree<tkey, tvalue, compare>::infix_iterator::get_balance() const noex
 
 // region infix_const_iterator implementation
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::infix_const_iterator::infix_const_iterator(parent::node* n) noexcept : parent::infix_const_iterator(n)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>::infix_const_iterator::infix_const_iterator(parent::node* n) noexcept : parent::infix_const_iterator(n)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::infix_const_iterator::infix_const_iterator(parent::infix_const_iterator it) noexcept : parent::infix_const_iterator(it)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>::infix_const_iterator::infix_const_iterator(parent::infix_const_iterator it) noexcept : parent::infix_const_iterator(it)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-size_t AVL_tree<tkey, tvalue, compare>::infix_const_iterator::get_height() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+size_t AVL_tree<tkey, tvalue, compare, augment>::infix_const_iterator::get_height() const noexcept
 {
     return infix_iterator(this->_base).get_height();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-size_t AVL_tree<tkey, tvalue, compare>::infix_const_iterator::get_balance() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+size_t AVL_tree<tkey, tvalue, compare, augment>::infix_const_iterator::get_balance() const noexcept
 {
     return infix_iterator(this->_base)->get_balance();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::infix_const_iterator::infix_const_iterator(infix_iterator it) noexcept : parent::infix_const_iterator(it)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>::infix_const_iterator::infix_const_iterator(infix_iterator it) noexcept : parent::infix_const_iterator(it)
 {
 }
 
@@ -1058,41 +1251,41 @@ AVL_tree<tkey, tvalue, compare>::infix_const_iterator::infix_const_iterator(infi
 
 // region infix_reverse_iterator implementation
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::infix_reverse_iterator::infix_reverse_iterator(parent::node* n) noexcept : parent::infix_reverse_iterator(n)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>::infix_reverse_iterator::infix_reverse_iterator(parent::node* n) noexcept : parent::infix_reverse_iterator(n)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::infix_reverse_iterator::infix_reverse_iterator(parent::infix_reverse_iterator it) noexcept : parent::infix_reverse_iterator(it)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>::infix_reverse_iterator::infix_reverse_iterator(parent::infix_reverse_iterator it) noexcept : parent::infix_reverse_iterator(it)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-size_t AVL_tree<tkey, tvalue, compare>::infix_reverse_iterator::get_height() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+size_t AVL_tree<tkey, tvalue, compare, augment>::infix_reverse_iterator::get_height() const noexcept
 {
-    return infix_iterator(this->_base)->get_height();
+    return infix_iterator(this->_base).get_height();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-size_t AVL_tree<tkey, tvalue, compare>::infix_reverse_iterator::get_balance() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+size_t AVL_tree<tkey, tvalue, compare, augment>::infix_reverse_iterator::get_balance() const noexcept
 {
     return infix_iterator(this->_base)->get_balance();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::infix_reverse_iterator::infix_reverse_iterator(infix_iterator it) noexcept : parent::infix_reverse_iterator(it)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>::infix_reverse_iterator::infix_reverse_iterator(infix_iterator it) noexcept : parent::infix_reverse_iterator(it)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::infix_reverse_iterator::operator AVL_tree<tkey, tvalue, compare>::infix_iterator() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>::infix_reverse_iterator::operator AVL_tree<tkey, tvalue, compare, augment>::infix_iterator() const noexcept
 {
     return parent::infix_reverse_iterator::operator infix_iterator();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_iterator AVL_tree<tkey, tvalue, compare>::infix_reverse_iterator::base() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::infix_iterator AVL_tree<tkey, tvalue, compare, augment>::infix_reverse_iterator::base() const noexcept
 {
     return parent::infix_reverse_iterator::base();
 }
@@ -1101,41 +1294,41 @@ typename AVL_tree<tkey, tvalue, compare>::infix_iterator AVL_tree<tkey, tvalue,
 
 // region infix_const_reverse_iterator implementation
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::infix_const_reverse_iterator::infix_const_reverse_iterator(parent::node* n) noexcept : parent::infix_const_reverse_iterator(n)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>::infix_const_reverse_iterator::infix_const_reverse_iterator(parent::node* n) noexcept : parent::infix_const_reverse_iterator(n)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::infix_const_reverse_iterator::infix_const_reverse_iterator(parent::infix_const_reverse_iterator it) noexcept : parent::infix_const_reverse_iterator(it)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>::infix_const_reverse_iterator::infix_const_reverse_iterator(parent::infix_const_reverse_iterator it) noexcept : parent::infix_const_reverse_iterator(it)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-size_t AVL_tree<tkey, tvalue, compare>::infix_const_reverse_iterator::get_height() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+size_t AVL_tree<tkey, tvalue, compare, augment>::infix_const_reverse_iterator::get_height() const noexcept
 {
-    return infix_iterator(this->_base)->get_height();
+    return infix_iterator(this->_base).get_height();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-size_t AVL_tree<tkey, tvalue, compare>::infix_const_reverse_iterator::get_balance() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+size_t AVL_tree<tkey, tvalue, compare, augment>::infix_const_reverse_iterator::get_balance() const noexcept
 {
     return infix_iterator(this->_base)->get_balance();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::infix_const_reverse_iterator::infix_const_reverse_iterator(infix_const_iterator it) noexcept : parent::infix_const_reverse_iterator(it)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>::infix_const_reverse_iterator::infix_const_reverse_iterator(infix_const_iterator it) noexcept : parent::infix_const_reverse_iterator(it)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::infix_const_reverse_iterator::operator AVL_tree<tkey, tvalue, compare>::infix_const_iterator() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>::infix_const_reverse_iterator::operator AVL_tree<tkey, tvalue, compare, augment>::infix_const_iterator() const noexcept
 {
     return parent::infix_const_reverse_iterator::operator infix_const_iterator();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_const_iterator AVL_tree<tkey, tvalue, compare>::infix_const_reverse_iterator::base() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::infix_const_iterator AVL_tree<tkey, tvalue, compare, augment>::infix_const_reverse_iterator::base() const noexcept
 {
     return parent::infix_const_reverse_iterator::base();
 }
@@ -1144,24 +1337,24 @@ typename AVL_tree<tkey, tvalue, compare>::infix_const_iterator AVL_tree<tkey, tv
 
 // region postfix_iterator implementation
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::postfix_iterator::postfix_iterator(parent::node* n) noexcept : parent::postfix_iterator(n)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>::postfix_iterator::postfix_iterator(parent::node* n) noexcept : parent::postfix_iterator(n)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::postfix_iterator::postfix_iterator(parent::postfix_iterator it) noexcept : parent::postfix_iterator(it)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>::postfix_iterator::postfix_iterator(parent::postfix_iterator it) noexcept : parent::postfix_iterator(it)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-size_t AVL_tree<tkey, tvalue, compare>::postfix_iterator::get_height() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+size_t AVL_tree<tkey, tvalue, compare, augment>::postfix_iterator::get_height() const noexcept
 {
-    return static_cast<node*>(this->_data)->height;
+    return static_cast<node*>(this->_data)->get_height();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-size_t AVL_tree<tkey, tvalue, compare>::postfix_iterator::get_balance() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+size_t AVL_tree<tkey, tvalue, compare, augment>::postfix_iterator::get_balance() const noexcept
 {
     return static_cast<node*>(this->_data)->get_balance();
 }
@@ -1170,30 +1363,30 @@ size_t AVL_tree<tkey, tvalue, compare>::postfix_iterator::get_balance() const no
 
 // region postfix_const_iterator implementation
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::postfix_const_iterator::postfix_const_iterator(parent::node* n) noexcept : parent::postfix_const_iterator(n)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>::postfix_const_iterator::postfix_const_iterator(parent::node* n) noexcept : parent::postfix_const_iterator(n)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::postfix_const_iterator::postfix_const_iterator(parent::postfix_const_iterator it) noexcept : parent::postfix_const_iterator(it)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>::postfix_const_iterator::postfix_const_iterator(parent::postfix_const_iterator it) noexcept : parent::postfix_const_iterator(it)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-size_t AVL_tree<tkey, tvalue, compare>::postfix_const_iterator::get_height() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+size_t AVL_tree<tkey, tvalue, compare, augment>::postfix_const_iterator::get_height() const noexcept
 {
     return postfix_iterator(this->_base).get_height();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-size_t AVL_tree<tkey, tvalue, compare>::postfix_const_iterator::get_balance() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+size_t AVL_tree<tkey, tvalue, compare, augment>::postfix_const_iterator::get_balance() const noexcept
 {
     return postfix_iterator(this->_base)->get_balance();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::postfix_const_iterator::postfix_const_iterator(postfix_iterator it) noexcept : parent::postfix_const_iterator(it)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>::postfix_const_iterator::postfix_const_iterator(postfix_iterator it) noexcept : parent::postfix_const_iterator(it)
 {
 }
 
@@ -1201,41 +1394,41 @@ AVL_tree<tkey, tvalue, compare>::postfix_const_iterator::postfix_const_iterator(
 
 // region postfix_reverse_iterator implementation
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::postfix_reverse_iterator::postfix_reverse_iterator(parent::node* n) noexcept : parent::postfix_reverse_iterator(n)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>::postfix_reverse_iterator::postfix_reverse_iterator(parent::node* n) noexcept : parent::postfix_reverse_iterator(n)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::postfix_reverse_iterator::postfix_reverse_iterator(parent::postfix_reverse_iterator it) noexcept : parent::postfix_reverse_iterator(it)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>::postfix_reverse_iterator::postfix_reverse_iterator(parent::postfix_reverse_iterator it) noexcept : parent::postfix_reverse_iterator(it)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-size_t AVL_tree<tkey, tvalue, compare>::postfix_reverse_iterator::get_height() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+size_t AVL_tree<tkey, tvalue, compare, augment>::postfix_reverse_iterator::get_height() const noexcept
 {
     return postfix_iterator(this->_base).get_height();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-size_t AVL_tree<tkey, tvalue, compare>::postfix_reverse_iterator::get_balance() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+size_t AVL_tree<tkey, tvalue, compare, augment>::postfix_reverse_iterator::get_balance() const noexcept
 {
     return postfix_iterator(this->_base).get_balance();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::postfix_reverse_iterator::postfix_reverse_iterator(postfix_iterator it) noexcept : parent::postfix_reverse_iterator(it)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>::postfix_reverse_iterator::postfix_reverse_iterator(postfix_iterator it) noexcept : parent::postfix_reverse_iterator(it)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::postfix_reverse_iterator::operator AVL_tree<tkey, tvalue, compare>::postfix_iterator() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>::postfix_reverse_iterator::operator AVL_tree<tkey, tvalue, compare, augment>::postfix_iterator() const noexcept
 {
     return parent::postfix_reverse_iterator::operator postfix_iterator();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::postfix_iterator AVL_tree<tkey, tvalue, compare>::postfix_reverse_iterator::base() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::postfix_iterator AVL_tree<tkey, tvalue, compare, augment>::postfix_reverse_iterator::base() const noexcept
 {
     return parent::postfix_reverse_iterator::base();
 }
@@ -1244,41 +1437,41 @@ typename AVL_tree<tkey, tvalue, compare>::postfix_iterator AVL_tree<tkey, tvalue
 
 // region postfix_const_reverse_iterator implementation
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::postfix_const_reverse_iterator::postfix_const_reverse_iterator(parent::node* n) noexcept : parent::postfix_reverse_iterator(n)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>::postfix_const_reverse_iterator::postfix_const_reverse_iterator(parent::node* n) noexcept : parent::postfix_reverse_iterator(n)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::postfix_const_reverse_iterator::postfix_const_reverse_iterator(parent::postfix_const_reverse_iterator it) noexcept : parent::postfix_reverse_iterator(it)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>::postfix_const_reverse_iterator::postfix_const_reverse_iterator(parent::postfix_const_reverse_iterator it) noexcept : parent::postfix_reverse_iterator(it)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-size_t AVL_tree<tkey, tvalue, compare>::postfix_const_reverse_iterator::get_height() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+size_t AVL_tree<tkey, tvalue, compare, augment>::postfix_const_reverse_iterator::get_height() const noexcept
 {
     return postfix_iterator(this->_base).get_height();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-size_t AVL_tree<tkey, tvalue, compare>::postfix_const_reverse_iterator::get_balance() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+size_t AVL_tree<tkey, tvalue, compare, augment>::postfix_const_reverse_iterator::get_balance() const noexcept
 {
     return postfix_iterator(this->_base).get_balance();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::postfix_const_reverse_iterator::postfix_const_reverse_iterator(postfix_const_iterator it) noexcept : parent::postfix_const_reverse_iterator(it)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>::postfix_const_reverse_iterator::postfix_const_reverse_iterator(postfix_const_iterator it) noexcept : parent::postfix_const_reverse_iterator(it)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::postfix_const_reverse_iterator::operator AVL_tree<tkey, tvalue, compare>::postfix_const_iterator() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>::postfix_const_reverse_iterator::operator AVL_tree<tkey, tvalue, compare, augment>::postfix_const_iterator() const noexcept
 {
     return parent::postfix_const_reverse_iterator::operator postfix_const_iterator();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::postfix_const_iterator AVL_tree<tkey, tvalue, compare>::postfix_const_reverse_iterator::base() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::postfix_const_iterator AVL_tree<tkey, tvalue, compare, augment>::postfix_const_reverse_iterator::base() const noexcept
 {
     return parent::postfix_const_reverse_iterator::base();
 }
@@ -1288,294 +1481,294 @@ typename AVL_tree<tkey, tvalue, compare>::postfix_const_iterator AVL_tree<tkey,
 // region iterator requests implementation
 
 // Infix iterators
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_iterator AVL_tree<tkey, tvalue, compare>::begin() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::infix_iterator AVL_tree<tkey, tvalue, compare, augment>::begin() noexcept
 {
     return parent::begin();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_iterator AVL_tree<tkey, tvalue, compare>::end() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::infix_iterator AVL_tree<tkey, tvalue, compare, augment>::end() noexcept
 {
     return parent::end();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_const_iterator AVL_tree<tkey, tvalue, compare>::begin() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::infix_const_iterator AVL_tree<tkey, tvalue, compare, augment>::begin() const noexcept
 {
     return parent::begin();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_const_iterator AVL_tree<tkey, tvalue, compare>::end() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::infix_const_iterator AVL_tree<tkey, tvalue, compare, augment>::end() const noexcept
 {
     return parent::end();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_const_iterator AVL_tree<tkey, tvalue, compare>::cbegin() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::infix_const_iterator AVL_tree<tkey, tvalue, compare, augment>::cbegin() const noexcept
 {
     return parent::cbegin();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_const_iterator AVL_tree<tkey, tvalue, compare>::cend() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::infix_const_iterator AVL_tree<tkey, tvalue, compare, augment>::cend() const noexcept
 {
     return parent::cend();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_reverse_iterator AVL_tree<tkey, tvalue, compare>::rbegin() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::infix_reverse_iterator AVL_tree<tkey, tvalue, compare, augment>::rbegin() noexcept
 {
     return parent::rbegin();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_reverse_iterator AVL_tree<tkey, tvalue, compare>::rend() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::infix_reverse_iterator AVL_tree<tkey, tvalue, compare, augment>::rend() noexcept
 {
     return parent::rend();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_const_reverse_iterator AVL_tree<tkey, tvalue, compare>::rbegin() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::infix_const_reverse_iterator AVL_tree<tkey, tvalue, compare, augment>::rbegin() const noexcept
 {
     return parent::rbegin();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_const_reverse_iterator AVL_tree<tkey, tvalue, compare>::rend() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::infix_const_reverse_iterator AVL_tree<tkey, tvalue, compare, augment>::rend() const noexcept
 {
     return parent::rend();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_const_reverse_iterator AVL_tree<tkey, tvalue, compare>::crbegin() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::infix_const_reverse_iterator AVL_tree<tkey, tvalue, compare, augment>::crbegin() const noexcept
 {
     return parent::crbegin();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_const_reverse_iterator AVL_tree<tkey, tvalue, compare>::crend() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::infix_const_reverse_iterator AVL_tree<tkey, tvalue, compare, augment>::crend() const noexcept
 {
     return parent::crend();
 }
 
 // region prefix iterators
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::prefix_iterator AVL_tree<tkey, tvalue, compare>::begin_prefix() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::prefix_iterator AVL_tree<tkey, tvalue, compare, augment>::begin_prefix() noexcept
 {
     return parent::begin_prefix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::prefix_iterator AVL_tree<tkey, tvalue, compare>::end_prefix() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::prefix_iterator AVL_tree<tkey, tvalue, compare, augment>::end_prefix() noexcept
 {
     return parent::end_prefix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::prefix_const_iterator AVL_tree<tkey, tvalue, compare>::begin_prefix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::prefix_const_iterator AVL_tree<tkey, tvalue, compare, augment>::begin_prefix() const noexcept
 {
     return parent::begin_prefix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::prefix_const_iterator AVL_tree<tkey, tvalue, compare>::end_prefix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::prefix_const_iterator AVL_tree<tkey, tvalue, compare, augment>::end_prefix() const noexcept
 {
     return parent::end_prefix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::prefix_const_iterator AVL_tree<tkey, tvalue, compare>::cbegin_prefix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::prefix_const_iterator AVL_tree<tkey, tvalue, compare, augment>::cbegin_prefix() const noexcept
 {
     return parent::cbegin_prefix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::prefix_const_iterator AVL_tree<tkey, tvalue, compare>::cend_prefix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::prefix_const_iterator AVL_tree<tkey, tvalue, compare, augment>::cend_prefix() const noexcept
 {
     return parent::cend_prefix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::prefix_reverse_iterator AVL_tree<tkey, tvalue, compare>::rbegin_prefix() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::prefix_reverse_iterator AVL_tree<tkey, tvalue, compare, augment>::rbegin_prefix() noexcept
 {
     return parent::rbegin_prefix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::prefix_reverse_iterator AVL_tree<tkey, tvalue, compare>::rend_prefix() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::prefix_reverse_iterator AVL_tree<tkey, tvalue, compare, augment>::rend_prefix() noexcept
 {
     return parent::rend_prefix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::prefix_const_reverse_iterator AVL_tree<tkey, tvalue, compare>::rbegin_prefix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::prefix_const_reverse_iterator AVL_tree<tkey, tvalue, compare, augment>::rbegin_prefix() const noexcept
 {
     return parent::rbegin_prefix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::prefix_const_reverse_iterator AVL_tree<tkey, tvalue, compare>::rend_prefix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::prefix_const_reverse_iterator AVL_tree<tkey, tvalue, compare, augment>::rend_prefix() const noexcept
 {
     return parent::rend_prefix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::prefix_const_reverse_iterator AVL_tree<tkey, tvalue, compare>::crbegin_prefix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::prefix_const_reverse_iterator AVL_tree<tkey, tvalue, compare, augment>::crbegin_prefix() const noexcept
 {
     return parent::crbegin_prefix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::prefix_const_reverse_iterator AVL_tree<tkey, tvalue, compare>::crend_prefix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::prefix_const_reverse_iterator AVL_tree<tkey, tvalue, compare, augment>::crend_prefix() const noexcept
 {
     return parent::crend_prefix();
 }
 
 // region infix iterators
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_iterator AVL_tree<tkey, tvalue, compare>::begin_infix() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::infix_iterator AVL_tree<tkey, tvalue, compare, augment>::begin_infix() noexcept
 {
     return parent::begin_infix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_iterator AVL_tree<tkey, tvalue, compare>::end_infix() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::infix_iterator AVL_tree<tkey, tvalue, compare, augment>::end_infix() noexcept
 {
     return parent::end_infix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_const_iterator AVL_tree<tkey, tvalue, compare>::begin_infix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::infix_const_iterator AVL_tree<tkey, tvalue, compare, augment>::begin_infix() const noexcept
 {
     return parent::begin_infix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_const_iterator AVL_tree<tkey, tvalue, compare>::end_infix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::infix_const_iterator AVL_tree<tkey, tvalue, compare, augment>::end_infix() const noexcept
 {
     return parent::end_infix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_const_iterator AVL_tree<tkey, tvalue, compare>::cbegin_infix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::infix_const_iterator AVL_tree<tkey, tvalue, compare, augment>::cbegin_infix() const noexcept
 {
     return parent::cbegin_infix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_const_iterator AVL_tree<tkey, tvalue, compare>::cend_infix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::infix_const_iterator AVL_tree<tkey, tvalue, compare, augment>::cend_infix() const noexcept
 {
     return parent::cend_infix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_reverse_iterator AVL_tree<tkey, tvalue, compare>::rbegin_infix() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::infix_reverse_iterator AVL_tree<tkey, tvalue, compare, augment>::rbegin_infix() noexcept
 {
     return parent::rbegin_infix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_reverse_iterator AVL_tree<tkey, tvalue, compare>::rend_infix() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::infix_reverse_iterator AVL_tree<tkey, tvalue, compare, augment>::rend_infix() noexcept
 {
     return parent::rend_infix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_const_reverse_iterator AVL_tree<tkey, tvalue, compare>::rbegin_infix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::infix_const_reverse_iterator AVL_tree<tkey, tvalue, compare, augment>::rbegin_infix() const noexcept
 {
     return parent::rbegin_infix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_const_reverse_iterator AVL_tree<tkey, tvalue, compare>::rend_infix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::infix_const_reverse_iterator AVL_tree<tkey, tvalue, compare, augment>::rend_infix() const noexcept
 {
     return parent::rend_infix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_const_reverse_iterator AVL_tree<tkey, tvalue, compare>::crbegin_infix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::infix_const_reverse_iterator AVL_tree<tkey, tvalue, compare, augment>::crbegin_infix() const noexcept
 {
     return parent::crbegin_infix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_const_reverse_iterator AVL_tree<tkey, tvalue, compare>::crend_infix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::infix_const_reverse_iterator AVL_tree<tkey, tvalue, compare, augment>::crend_infix() const noexcept
 {
     return parent::crend_infix();
 }
 
 // region postfix iterators
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::postfix_iterator AVL_tree<tkey, tvalue, compare>::begin_postfix() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::postfix_iterator AVL_tree<tkey, tvalue, compare, augment>::begin_postfix() noexcept
 {
     return parent::begin_postfix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::postfix_iterator AVL_tree<tkey, tvalue, compare>::end_postfix() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::postfix_iterator AVL_tree<tkey, tvalue, compare, augment>::end_postfix() noexcept
 {
     return parent::end_postfix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::postfix_const_iterator AVL_tree<tkey, tvalue, compare>::begin_postfix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::postfix_const_iterator AVL_tree<tkey, tvalue, compare, augment>::begin_postfix() const noexcept
 {
     return parent::begin_postfix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::postfix_const_iterator AVL_tree<tkey, tvalue, compare>::end_postfix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::postfix_const_iterator AVL_tree<tkey, tvalue, compare, augment>::end_postfix() const noexcept
 {
     return parent::end_postfix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::postfix_const_iterator AVL_tree<tkey, tvalue, compare>::cbegin_postfix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::postfix_const_iterator AVL_tree<tkey, tvalue, compare, augment>::cbegin_postfix() const noexcept
 {
     return parent::cbegin_postfix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::postfix_const_iterator AVL_tree<tkey, tvalue, compare>::cend_postfix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::postfix_const_iterator AVL_tree<tkey, tvalue, compare, augment>::cend_postfix() const noexcept
 {
     return parent::cend_postfix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::postfix_reverse_iterator AVL_tree<tkey, tvalue, compare>::rbegin_postfix() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::postfix_reverse_iterator AVL_tree<tkey, tvalue, compare, augment>::rbegin_postfix() noexcept
 {
     return parent::rbegin_postfix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::postfix_reverse_iterator AVL_tree<tkey, tvalue, compare>::rend_postfix() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::postfix_reverse_iterator AVL_tree<tkey, tvalue, compare, augment>::rend_postfix() noexcept
 {
     return parent::rend_postfix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::postfix_const_reverse_iterator AVL_tree<tkey, tvalue, compare>::rbegin_postfix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::postfix_const_reverse_iterator AVL_tree<tkey, tvalue, compare, augment>::rbegin_postfix() const noexcept
 {
     return parent::rbegin_postfix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::postfix_const_reverse_iterator AVL_tree<tkey, tvalue, compare>::rend_postfix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::postfix_const_reverse_iterator AVL_tree<tkey, tvalue, compare, augment>::rend_postfix() const noexcept
 {
     return parent::rend_postfix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::postfix_const_reverse_iterator AVL_tree<tkey, tvalue, compare>::crbegin_postfix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::postfix_const_reverse_iterator AVL_tree<tkey, tvalue, compare, augment>::crbegin_postfix() const noexcept
 {
     return parent::crbegin_postfix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::postfix_const_reverse_iterator AVL_tree<tkey, tvalue, compare>::crend_postfix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::postfix_const_reverse_iterator AVL_tree<tkey, tvalue, compare, augment>::crend_postfix() const noexcept
 {
     return parent::crend_postfix();
 }
@@ -1585,25 +1778,25 @@ typename AVL_tree<tkey, tvalue, compare>::postfix_const_reverse_iterator AVL_tre
 // region AVL_tree constructors
 
 // Constructors
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::AVL_tree(
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>::AVL_tree(
         const compare& comp,
         pp_allocator<value_type> alloc,
         logger* logger) : parent(comp, alloc, logger)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::AVL_tree(
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>::AVL_tree(
         pp_allocator<value_type> alloc,
         const compare& comp,
         logger* logger) : parent(comp, alloc, logger)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
 template<input_iterator_for_pair<tkey, tvalue> iterator>
-AVL_tree<tkey, tvalue, compare>::AVL_tree(
+AVL_tree<tkey, tvalue, compare, augment>::AVL_tree(
         iterator begin, iterator end,
         const compare& cmp,
         pp_allocator<value_type> alloc,
@@ -1615,9 +1808,9 @@ AVL_tree<tkey, tvalue, compare>::AVL_tree(
     }
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
 template<std::ranges::input_range Range>
-AVL_tree<tkey, tvalue, compare>::AVL_tree(
+AVL_tree<tkey, tvalue, compare, augment>::AVL_tree(
         Range&& range,
         const compare& cmp,
         pp_allocator<value_type> alloc,
@@ -1629,8 +1822,8 @@ AVL_tree<tkey, tvalue, compare>::AVL_tree(
     }
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::AVL_tree(std::initializer_list<std::pair<tkey, tvalue>> data,
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>::AVL_tree(std::initializer_list<std::pair<tkey, tvalue>> data,
                                           const compare& cmp, pp_allocator<value_type> alloc,
                                           logger* logger) : parent(cmp, alloc, logger)
 {
@@ -1640,13 +1833,13 @@ AVL_tree<tkey, tvalue, compare>::AVL_tree(std::initializer_list<std::pair<tkey,
     }
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>::AVL_tree(const AVL_tree& other) : parent(other)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>::AVL_tree(const AVL_tree& other) : parent(other)
 {
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-AVL_tree<tkey, tvalue, compare>& AVL_tree<tkey, tvalue, compare>::operator=(const AVL_tree& other)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+AVL_tree<tkey, tvalue, compare, augment>& AVL_tree<tkey, tvalue, compare, augment>::operator=(const AVL_tree& other)
 {
     if (this != &other) {
         parent::operator=(other);
@@ -1654,8 +1847,8 @@ AVL_tree<tkey, tvalue, compare>& AVL_tree<tkey, tvalue, compare>::operator=(cons
     return *this;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-void AVL_tree<tkey, tvalue, compare>::swap(parent& other) noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+void AVL_tree<tkey, tvalue, compare, augment>::swap(parent& other) noexcept
 {
     if (this != &other)
     {
@@ -1667,121 +1860,137 @@ void AVL_tree<tkey, tvalue, compare>::swap(parent& other) noexcept
 
 // region AVL_tree methods
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-std::pair<typename AVL_tree<tkey, tvalue, compare>::infix_iterator, bool>
-AVL_tree<tkey, tvalue, compare>::insert(const value_type& value)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+std::pair<typename AVL_tree<tkey, tvalue, compare, augment>::infix_iterator, bool>
+AVL_tree<tkey, tvalue, compare, augment>::insert(const value_type& value)
 {
     auto result = parent::insert(value);
     return result;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-std::pair<typename AVL_tree<tkey, tvalue, compare>::infix_iterator, bool>
-AVL_tree<tkey, tvalue, compare>::insert(value_type&& value)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+std::pair<typename AVL_tree<tkey, tvalue, compare, augment>::infix_iterator, bool>
+AVL_tree<tkey, tvalue, compare, augment>::insert(value_type&& value)
 {
     auto result = parent::insert(std::move(value));
     return result;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
 template<class ...Args>
-std::pair<typename AVL_tree<tkey, tvalue, compare>::infix_iterator, bool>
-AVL_tree<tkey, tvalue, compare>::emplace(Args&&... args)
+std::pair<typename AVL_tree<tkey, tvalue, compare, augment>::infix_iterator, bool>
+AVL_tree<tkey, tvalue, compare, augment>::emplace(Args&&... args)
 {
     return parent::emplace(std::forward<Args>(args)...);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_iterator
-AVL_tree<tkey, tvalue, compare>::insert_or_assign(const value_type& value)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::infix_iterator
+AVL_tree<tkey, tvalue, compare, augment>::insert_or_assign(const value_type& value)
 {
     auto result = parent::insert_or_assign(value);
     return result;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_iterator
-AVL_tree<tkey, tvalue, compare>::insert_or_assign(value_type&& value)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::infix_iterator
+AVL_tree<tkey, tvalue, compare, augment>::insert_or_assign(value_type&& value)
 {
     auto result = parent::insert_or_assign(std::move(value));
     return result;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
 template<class ...Args>
-typename AVL_tree<tkey, tvalue, compare>::infix_iterator
-AVL_tree<tkey, tvalue, compare>::emplace_or_assign(Args&&... args)
+typename AVL_tree<tkey, tvalue, compare, augment>::infix_iterator
+AVL_tree<tkey, tvalue, compare, augment>::emplace_or_assign(Args&&... args)
 {
-    auto it = binary_search_tree<tkey, tvalue, compare, __detail::AVL_TAG>::emplace_or_assign(std::forward<Args>(args)...);
+    auto it = binary_search_tree<tkey, tvalue, compare, __detail::AVL_TAG, augment>::emplace_or_assign(std::forward<Args>(args)...);
     return it;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_iterator
-AVL_tree<tkey, tvalue, compare>::find(const tkey& key)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::infix_iterator
+AVL_tree<tkey, tvalue, compare, augment>::find(const tkey& key)
 {
     return parent::find(key);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_const_iterator
-AVL_tree<tkey, tvalue, compare>::find(const tkey& key) const
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::infix_const_iterator
+AVL_tree<tkey, tvalue, compare, augment>::find(const tkey& key) const
 {
     return parent::find(key);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_iterator
-AVL_tree<tkey, tvalue, compare>::lower_bound(const tkey& key)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::infix_iterator
+AVL_tree<tkey, tvalue, compare, augment>::select(size_t index)
+    requires counts_subtrees<augment>
+{
+    return parent::select(index);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::infix_const_iterator
+AVL_tree<tkey, tvalue, compare, augment>::select(size_t index) const
+    requires counts_subtrees<augment>
+{
+    return parent::select(index);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::infix_iterator
+AVL_tree<tkey, tvalue, compare, augment>::lower_bound(const tkey& key)
 {
     return parent::lower_bound(key);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_const_iterator
-AVL_tree<tkey, tvalue, compare>::lower_bound(const tkey& key) const
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::infix_const_iterator
+AVL_tree<tkey, tvalue, compare, augment>::lower_bound(const tkey& key) const
 {
     return parent::lower_bound(key);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_iterator
-AVL_tree<tkey, tvalue, compare>::upper_bound(const tkey& key)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::infix_iterator
+AVL_tree<tkey, tvalue, compare, augment>::upper_bound(const tkey& key)
 {
     return parent::upper_bound(key);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_const_iterator
-AVL_tree<tkey, tvalue, compare>::upper_bound(const tkey& key) const
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::infix_const_iterator
+AVL_tree<tkey, tvalue, compare, augment>::upper_bound(const tkey& key) const
 {
     return parent::upper_bound(key);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_iterator
-AVL_tree<tkey, tvalue, compare>::erase(infix_iterator pos)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::infix_iterator
+AVL_tree<tkey, tvalue, compare, augment>::erase(infix_iterator pos)
 {
     return parent::erase(pos);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_iterator
-AVL_tree<tkey, tvalue, compare>::erase(infix_const_iterator pos)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::infix_iterator
+AVL_tree<tkey, tvalue, compare, augment>::erase(infix_const_iterator pos)
 {
     return parent::erase(pos);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_iterator
-AVL_tree<tkey, tvalue, compare>::erase(infix_iterator first, infix_iterator last)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::infix_iterator
+AVL_tree<tkey, tvalue, compare, augment>::erase(infix_iterator first, infix_iterator last)
 {
     return parent::erase(first, last);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare>
-typename AVL_tree<tkey, tvalue, compare>::infix_iterator
-AVL_tree<tkey, tvalue, compare>::erase(infix_const_iterator first, infix_const_iterator last)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename augment>
+typename AVL_tree<tkey, tvalue, compare, augment>::infix_iterator
+AVL_tree<tkey, tvalue, compare, augment>::erase(infix_const_iterator first, infix_const_iterator last)
 {
     return parent::erase(first, last);
 }
@@ -0,0 +1,991 @@
+#ifndef MATH_PRACTICE_AND_OPERATING_SYSTEMS_CONCURRENT_AVL_TREE_H
+#define MATH_PRACTICE_AND_OPERATING_SYSTEMS_CONCURRENT_AVL_TREE_H
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <search_tree.h>
+#include <pp_allocator.h>
+
+namespace __detail
+{
+    /** Slot a reading thread counts itself in. Threads are dealt slots round-robin, so up to the slot count
+     *  of them never share a counter's cache line
+     */
+    inline size_t reader_slot_hint() noexcept
+    {
+        static std::atomic<size_t> next_slot{0};
+        thread_local const size_t slot = next_slot.fetch_add(1, std::memory_order_relaxed);
+        return slot;
+    }
+}
+
+/** AVL map for read-mostly concurrent use. Nodes are never changed once reachable: a writer copies the path
+ *  it changes and publishes the new root with one atomic store, so every reader works on a consistent
+ *  version without taking a lock. Writers are serialized among themselves.
+ *
+ *  Replaced nodes are freed once no reader can still hold them. A reader counts itself in a per-thread slot
+ *  under the parity of the epoch it entered, a writer advances the epoch only when the readers of the
+ *  previous epoch have all left, and then frees what was retired during that epoch. A long-lived snapshot
+ *  therefore holds back reclamation, never writers
+ */
+template<typename tkey, typename tvalue, compator<tkey> compare = std::less<tkey>>
+class concurrent_AVL_tree final : private compare
+{
+public:
+
+    using value_type = std::pair<const tkey, tvalue>;
+
+private:
+
+    struct node final
+    {
+        value_type data;
+        node* left_subtree;
+        node* right_subtree;
+        unsigned char height;
+
+        // built by the running write and not published yet, so it can still be changed in place
+        bool fresh;
+
+        template<class ...Args>
+        node(node* left, node* right, Args&&... args);
+    };
+
+    /** 64 bytes apart so that readers of different slots do not invalidate each other's counters
+     */
+    struct alignas(64) reader_slot
+    {
+        std::atomic<size_t> readers[2];
+    };
+
+    std::atomic<node*> _root;
+    std::atomic<size_t> _size;
+    std::atomic<size_t> _epoch;
+
+    size_t _slots_count;
+    std::unique_ptr<reader_slot[]> _slots;
+
+    std::mutex _writer;
+    pp_allocator<value_type> _allocator;
+
+    // region writer state
+
+    // replaced nodes by the parity of the epoch they were retired in
+    std::vector<node*> _retired[2];
+
+    // nodes the running write has built and nodes it has replaced, kept apart until it commits.
+    // A write that throws frees what it built and forgets what it replaced
+    std::vector<node*> _fresh;
+    std::vector<node*> _replaced;
+
+    // endregion writer state
+
+public:
+
+    // region snapshot definition
+
+    /** Read section over the version that was current when it was taken, later writes are not seen.
+     *  Everything it returns stays valid until it is destroyed
+     */
+    class snapshot final
+    {
+        friend class concurrent_AVL_tree;
+
+        const concurrent_AVL_tree* _tree;
+        reader_slot* _slot;
+        size_t _parity;
+        node* _root;
+
+        explicit snapshot(const concurrent_AVL_tree& tree) noexcept;
+
+    public:
+
+        class const_iterator final
+        {
+            friend class snapshot;
+
+            // the current node on top, below it the ancestors whose left subtree is being walked
+            std::vector<node*> _path;
+
+            void push_left(node* current);
+
+        public:
+
+            using value_type = concurrent_AVL_tree::value_type;
+            using difference_type = ptrdiff_t;
+            using reference = const value_type&;
+            using pointer = const value_type*;
+            using iterator_category = std::forward_iterator_tag;
+
+            const_iterator() = default;
+
+            reference operator*() const;
+            pointer operator->() const;
+
+            const_iterator& operator++();
+            const_iterator operator++(int);
+
+            bool operator==(const const_iterator& other) const noexcept;
+        };
+
+        snapshot(const snapshot&) = delete;
+        snapshot& operator=(const snapshot&) = delete;
+
+        snapshot(snapshot&& other) noexcept;
+        snapshot& operator=(snapshot&& other) noexcept;
+
+        ~snapshot() noexcept;
+
+        const_iterator begin() const;
+        const_iterator end() const noexcept;
+
+        const_iterator find(const tkey& key) const;
+
+        bool contains(const tkey& key) const noexcept;
+
+        bool empty() const noexcept;
+    };
+
+    // endregion snapshot definition
+
+    // region constructors declaration
+
+    explicit concurrent_AVL_tree(const compare& cmp = compare(),
+                                 pp_allocator<value_type> alloc = pp_allocator<value_type>());
+
+    concurrent_AVL_tree(const concurrent_AVL_tree&) = delete;
+    concurrent_AVL_tree& operator=(const concurrent_AVL_tree&) = delete;
+
+    /** No snapshot may outlive the tree and no other thread may still use it
+     */
+    ~concurrent_AVL_tree() noexcept;
+
+    // endregion constructors declaration
+
+    // region lookup declaration
+
+    /** Lock-free, each call reads the version current when it starts
+     */
+    bool contains(const tkey& key) const noexcept;
+
+    /** Copy of the mapped value, std::out_of_range if there is none
+     */
+    tvalue at(const tkey& key) const;
+
+    /** Number of elements after the last completed write
+     */
+    size_t size() const noexcept;
+
+    bool empty() const noexcept;
+
+    snapshot get_snapshot() const noexcept;
+
+    // endregion lookup declaration
+
+    // region modifiers declaration
+
+    /** Writers wait for each other, never for readers. Each write copies O(log n) nodes and
+     *  leaves the published tree untouched if it throws
+     */
+    bool insert(const value_type& data);
+
+    bool insert(value_type&& data);
+
+    template<class ...Args>
+    bool emplace(Args&&... args);
+
+    /** Returns true when the key was inserted, false when its value was replaced
+     */
+    bool insert_or_assign(const value_type& data);
+
+    bool insert_or_assign(value_type&& data);
+
+    size_t erase(const tkey& key);
+
+    void clear();
+
+    // endregion modifiers declaration
+
+private:
+
+    // region reader section declaration
+
+    reader_slot* enter(size_t& parity) const noexcept;
+
+    static void leave(reader_slot* slot, size_t parity) noexcept;
+
+    node* find_node(node* current, const tkey& key) const noexcept;
+
+    // endregion reader section declaration
+
+    // region path copying declaration
+
+    bool compare_keys(const tkey& lhs, const tkey& rhs) const;
+
+    template<class ...Args>
+    node* create_node(node* left, node* right, Args&&... args);
+
+    void destroy_node(node* current) noexcept;
+
+    /** The node itself while the running write built it, a copy that replaces it otherwise
+     */
+    node* writable(node* current);
+
+    static size_t height(node* current) noexcept;
+
+    static void update_height(node* current) noexcept;
+
+    node* rotate_left(node* current);
+
+    node* rotate_right(node* current);
+
+    node* balance(node* current);
+
+    template<class ...Args>
+    node* insert_into(node* current, bool assign, bool& inserted, const tkey& key, Args&&... args);
+
+    node* erase_from(node* current, const tkey& key, bool& erased);
+
+    node* erase_minimum(node* current, node*& minimum);
+
+    /** Publishes a write: keeps its nodes, retires the replaced ones and tries to reclaim older ones.
+     *  Throws only before anything is published
+     */
+    void commit(node* new_root, size_t new_size);
+
+    /** Drops a failed write, the published tree has not changed
+     */
+    void rollback() noexcept;
+
+    void try_reclaim() noexcept;
+
+    void destroy_subtree(node* subtree_root) noexcept;
+
+    template<class ...Args>
+    bool write(bool assign, const tkey& key, Args&&... args);
+
+    // endregion path copying declaration
+};
+
+// region node implementation
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+template<class ...Args>
+concurrent_AVL_tree<tkey, tvalue, compare>::node::node(node* left, node* right, Args&&... args)
+    : data(std::forward<Args>(args)...), left_subtree(left), right_subtree(right), height(1), fresh(true)
+{
+}
+
+// endregion node implementation
+
+// region snapshot implementation
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+concurrent_AVL_tree<tkey, tvalue, compare>::snapshot::snapshot(const concurrent_AVL_tree& tree) noexcept
+    : _tree(&tree)
+{
+    _slot = tree.enter(_parity);
+    _root = tree._root.load(std::memory_order_acquire);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+concurrent_AVL_tree<tkey, tvalue, compare>::snapshot::snapshot(snapshot&& other) noexcept
+    : _tree(other._tree), _slot(std::exchange(other._slot, nullptr)), _parity(other._parity), _root(other._root)
+{
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename concurrent_AVL_tree<tkey, tvalue, compare>::snapshot&
+concurrent_AVL_tree<tkey, tvalue, compare>::snapshot::operator=(snapshot&& other) noexcept
+{
+    if (this != &other)
+    {
+        if (_slot)
+        {
+            leave(_slot, _parity);
+        }
+        _tree = other._tree;
+        _slot = std::exchange(other._slot, nullptr);
+        _parity = other._parity;
+        _root = other._root;
+    }
+    return *this;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+concurrent_AVL_tree<tkey, tvalue, compare>::snapshot::~snapshot() noexcept
+{
+    if (_slot)
+    {
+        leave(_slot, _parity);
+    }
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+void concurrent_AVL_tree<tkey, tvalue, compare>::snapshot::const_iterator::push_left(node* current)
+{
+    for (; current; current = current->left_subtree)
+    {
+        _path.push_back(current);
+    }
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename concurrent_AVL_tree<tkey, tvalue, compare>::snapshot::const_iterator::reference
+concurrent_AVL_tree<tkey, tvalue, compare>::snapshot::const_iterator::operator*() const
+{
+    if (_path.empty())
+    {
+        throw std::out_of_range("Dereferencing end iterator");
+    }
+    return _path.back()->data;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename concurrent_AVL_tree<tkey, tvalue, compare>::snapshot::const_iterator::pointer
+concurrent_AVL_tree<tkey, tvalue, compare>::snapshot::const_iterator::operator->() const
+{
+    return &**this;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename concurrent_AVL_tree<tkey, tvalue, compare>::snapshot::const_iterator&
+concurrent_AVL_tree<tkey, tvalue, compare>::snapshot::const_iterator::operator++()
+{
+    if (!_path.empty())
+    {
+        node* current = _path.back();
+        _path.pop_back();
+        push_left(current->right_subtree);
+    }
+    return *this;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename concurrent_AVL_tree<tkey, tvalue, compare>::snapshot::const_iterator
+concurrent_AVL_tree<tkey, tvalue, compare>::snapshot::const_iterator::operator++(int)
+{
+    auto temp = *this;
+    ++*this;
+    return temp;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+bool concurrent_AVL_tree<tkey, tvalue, compare>::snapshot::const_iterator::operator==(
+        const const_iterator& other) const noexcept
+{
+    if (_path.empty() || other._path.empty())
+    {
+        return _path.empty() == other._path.empty();
+    }
+    return _path.back() == other._path.back();
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename concurrent_AVL_tree<tkey, tvalue, compare>::snapshot::const_iterator
+concurrent_AVL_tree<tkey, tvalue, compare>::snapshot::begin() const
+{
+    const_iterator it;
+    it.push_left(_root);
+    return it;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename concurrent_AVL_tree<tkey, tvalue, compare>::snapshot::const_iterator
+concurrent_AVL_tree<tkey, tvalue, compare>::snapshot::end() const noexcept
+{
+    return const_iterator();
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename concurrent_AVL_tree<tkey, tvalue, compare>::snapshot::const_iterator
+concurrent_AVL_tree<tkey, tvalue, compare>::snapshot::find(const tkey& key) const
+{
+    const_iterator it;
+    node* current = _root;
+    while (current)
+    {
+        if (_tree->compare_keys(key, current->data.first))
+        {
+            it._path.push_back(current);
+            current = current->left_subtree;
+        }
+        else if (_tree->compare_keys(current->data.first, key))
+        {
+            current = current->right_subtree;
+        }
+        else
+        {
+            it._path.push_back(current);
+            return it;
+        }
+    }
+    return end();
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+bool concurrent_AVL_tree<tkey, tvalue, compare>::snapshot::contains(const tkey& key) const noexcept
+{
+    return _tree->find_node(_root, key) != nullptr;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+bool concurrent_AVL_tree<tkey, tvalue, compare>::snapshot::empty() const noexcept
+{
+    return _root == nullptr;
+}
+
+// endregion snapshot implementation
+
+// region constructors implementation
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+concurrent_AVL_tree<tkey, tvalue, compare>::concurrent_AVL_tree(const compare& cmp,
+                                                                pp_allocator<value_type> alloc)
+    : compare(cmp),
+      _root(nullptr),
+      _size(0),
+      _epoch(0),
+      _slots_count(std::bit_ceil(2 * static_cast<size_t>(std::max(1u, std::thread::hardware_concurrency())))),
+      _slots(new reader_slot[_slots_count]),
+      _allocator(alloc)
+{
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+concurrent_AVL_tree<tkey, tvalue, compare>::~concurrent_AVL_tree() noexcept
+{
+    destroy_subtree(_root.load(std::memory_order_relaxed));
+    for (auto& retired : _retired)
+    {
+        for (node* current : retired)
+        {
+            destroy_node(current);
+        }
+    }
+}
+
+// endregion constructors implementation
+
+// region lookup implementation
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+bool concurrent_AVL_tree<tkey, tvalue, compare>::contains(const tkey& key) const noexcept
+{
+    size_t parity;
+    reader_slot* slot = enter(parity);
+    bool found = find_node(_root.load(std::memory_order_acquire), key) != nullptr;
+    leave(slot, parity);
+    return found;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+tvalue concurrent_AVL_tree<tkey, tvalue, compare>::at(const tkey& key) const
+{
+    snapshot current(*this);
+    node* found = find_node(current._root, key);
+    if (!found)
+    {
+        throw std::out_of_range("Key not found");
+    }
+    return found->data.second;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+size_t concurrent_AVL_tree<tkey, tvalue, compare>::size() const noexcept
+{
+    return _size.load(std::memory_order_acquire);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+bool concurrent_AVL_tree<tkey, tvalue, compare>::empty() const noexcept
+{
+    return size() == 0;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename concurrent_AVL_tree<tkey, tvalue, compare>::snapshot
+concurrent_AVL_tree<tkey, tvalue, compare>::get_snapshot() const noexcept
+{
+    return snapshot(*this);
+}
+
+// endregion lookup implementation
+
+// region modifiers implementation
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+bool concurrent_AVL_tree<tkey, tvalue, compare>::insert(const value_type& data)
+{
+    return write(false, data.first, data);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+bool concurrent_AVL_tree<tkey, tvalue, compare>::insert(value_type&& data)
+{
+    return write(false, data.first, std::move(data));
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+template<class ...Args>
+bool concurrent_AVL_tree<tkey, tvalue, compare>::emplace(Args&&... args)
+{
+    value_type data(std::forward<Args>(args)...);
+    return write(false, data.first, std::move(data));
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+bool concurrent_AVL_tree<tkey, tvalue, compare>::insert_or_assign(const value_type& data)
+{
+    return write(true, data.first, data);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+bool concurrent_AVL_tree<tkey, tvalue, compare>::insert_or_assign(value_type&& data)
+{
+    return write(true, data.first, std::move(data));
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+size_t concurrent_AVL_tree<tkey, tvalue, compare>::erase(const tkey& key)
+{
+    std::lock_guard lock(_writer);
+
+    bool erased = false;
+    try
+    {
+        node* new_root = erase_from(_root.load(std::memory_order_relaxed), key, erased);
+        if (erased)
+        {
+            commit(new_root, _size.load(std::memory_order_relaxed) - 1);
+        }
+    }
+    catch (...)
+    {
+        rollback();
+        throw;
+    }
+    return erased ? 1 : 0;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+void concurrent_AVL_tree<tkey, tvalue, compare>::clear()
+{
+    std::lock_guard lock(_writer);
+
+    node* old_root = _root.load(std::memory_order_relaxed);
+    if (!old_root)
+    {
+        return;
+    }
+
+    // the whole old version is retired, readers may still be walking any part of it
+    try
+    {
+        std::vector<node*> pending{ old_root };
+        while (!pending.empty())
+        {
+            node* current = pending.back();
+            pending.pop_back();
+            _replaced.push_back(current);
+            if (current->left_subtree)
+            {
+                pending.push_back(current->left_subtree);
+            }
+            if (current->right_subtree)
+            {
+                pending.push_back(current->right_subtree);
+            }
+        }
+        commit(nullptr, 0);
+    }
+    catch (...)
+    {
+        rollback();
+        throw;
+    }
+}
+
+// endregion modifiers implementation
+
+// region reader section implementation
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename concurrent_AVL_tree<tkey, tvalue, compare>::reader_slot*
+concurrent_AVL_tree<tkey, tvalue, compare>::enter(size_t& parity) const noexcept
+{
+    reader_slot* slot = &_slots[__detail::reader_slot_hint() & (_slots_count - 1)];
+    while (true)
+    {
+        // the count must be visible before the epoch is checked again, or a writer could miss this reader
+        size_t epoch = _epoch.load(std::memory_order_seq_cst);
+        parity = epoch & 1;
+        slot->readers[parity].fetch_add(1, std::memory_order_seq_cst);
+        if (_epoch.load(std::memory_order_seq_cst) == epoch)
+        {
+            return slot;
+        }
+        slot->readers[parity].fetch_sub(1, std::memory_order_release);
+    }
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+void concurrent_AVL_tree<tkey, tvalue, compare>::leave(reader_slot* slot, size_t parity) noexcept
+{
+    slot->readers[parity].fetch_sub(1, std::memory_order_release);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename concurrent_AVL_tree<tkey, tvalue, compare>::node*
+concurrent_AVL_tree<tkey, tvalue, compare>::find_node(node* current, const tkey& key) const noexcept
+{
+    while (current)
+    {
+        if (compare_keys(key, current->data.first))
+        {
+            current = current->left_subtree;
+        }
+        else if (compare_keys(current->data.first, key))
+        {
+            current = current->right_subtree;
+        }
+        else
+        {
+            return current;
+        }
+    }
+    return nullptr;
+}
+
+// endregion reader section implementation
+
+// region path copying implementation
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+bool concurrent_AVL_tree<tkey, tvalue, compare>::compare_keys(const tkey& lhs, const tkey& rhs) const
+{
+    return compare::operator()(lhs, rhs);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+template<class ...Args>
+typename concurrent_AVL_tree<tkey, tvalue, compare>::node*
+concurrent_AVL_tree<tkey, tvalue, compare>::create_node(node* left, node* right, Args&&... args)
+{
+    _fresh.reserve(_fresh.size() + 1);
+    node* created = _allocator.template new_object<node>(left, right, std::forward<Args>(args)...);
+    _fresh.push_back(created);
+    update_height(created);
+    return created;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+void concurrent_AVL_tree<tkey, tvalue, compare>::destroy_node(node* current) noexcept
+{
+    _allocator.template delete_object<node>(current);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename concurrent_AVL_tree<tkey, tvalue, compare>::node*
+concurrent_AVL_tree<tkey, tvalue, compare>::writable(node* current)
+{
+    if (current->fresh)
+    {
+        return current;
+    }
+
+    node* copy = create_node(current->left_subtree, current->right_subtree, current->data);
+    _replaced.push_back(current);
+    return copy;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+size_t concurrent_AVL_tree<tkey, tvalue, compare>::height(node* current) noexcept
+{
+    return current ? current->height : 0;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+void concurrent_AVL_tree<tkey, tvalue, compare>::update_height(node* current) noexcept
+{
+    current->height = static_cast<unsigned char>(
+            std::max(height(current->left_subtree), height(current->right_subtree)) + 1);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename concurrent_AVL_tree<tkey, tvalue, compare>::node*
+concurrent_AVL_tree<tkey, tvalue, compare>::rotate_left(node* current)
+{
+    node* pivot = writable(current->right_subtree);
+    current->right_subtree = pivot->left_subtree;
+    pivot->left_subtree = current;
+    update_height(current);
+    update_height(pivot);
+    return pivot;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename concurrent_AVL_tree<tkey, tvalue, compare>::node*
+concurrent_AVL_tree<tkey, tvalue, compare>::rotate_right(node* current)
+{
+    node* pivot = writable(current->left_subtree);
+    current->left_subtree = pivot->right_subtree;
+    pivot->right_subtree = current;
+    update_height(current);
+    update_height(pivot);
+    return pivot;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename concurrent_AVL_tree<tkey, tvalue, compare>::node*
+concurrent_AVL_tree<tkey, tvalue, compare>::balance(node* current)
+{
+    update_height(current);
+    size_t left = height(current->left_subtree);
+    size_t right = height(current->right_subtree);
+
+    if (right > left + 1)
+    {
+        node* child = current->right_subtree;
+        if (height(child->left_subtree) > height(child->right_subtree))
+        {
+            current->right_subtree = rotate_right(writable(child));
+        }
+        return rotate_left(current);
+    }
+    if (left > right + 1)
+    {
+        node* child = current->left_subtree;
+        if (height(child->right_subtree) > height(child->left_subtree))
+        {
+            current->left_subtree = rotate_left(writable(child));
+        }
+        return rotate_right(current);
+    }
+    return current;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+template<class ...Args>
+typename concurrent_AVL_tree<tkey, tvalue, compare>::node*
+concurrent_AVL_tree<tkey, tvalue, compare>::insert_into(node* current, bool assign, bool& inserted, const tkey& key,
+                                                       Args&&... args)
+{
+    if (!current)
+    {
+        inserted = true;
+        return create_node(nullptr, nullptr, std::forward<Args>(args)...);
+    }
+
+    if (compare_keys(key, current->data.first))
+    {
+        node* left = insert_into(current->left_subtree, assign, inserted, key, std::forward<Args>(args)...);
+        if (left == current->left_subtree)
+        {
+            return current;
+        }
+        node* copy = writable(current);
+        copy->left_subtree = left;
+        return balance(copy);
+    }
+
+    if (compare_keys(current->data.first, key))
+    {
+        node* right = insert_into(current->right_subtree, assign, inserted, key, std::forward<Args>(args)...);
+        if (right == current->right_subtree)
+        {
+            return current;
+        }
+        node* copy = writable(current);
+        copy->right_subtree = right;
+        return balance(copy);
+    }
+
+    if (!assign)
+    {
+        return current;
+    }
+
+    node* replacement = create_node(current->left_subtree, current->right_subtree, std::forward<Args>(args)...);
+    _replaced.push_back(current);
+    return replacement;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename concurrent_AVL_tree<tkey, tvalue, compare>::node*
+concurrent_AVL_tree<tkey, tvalue, compare>::erase_from(node* current, const tkey& key, bool& erased)
+{
+    if (!current)
+    {
+        return nullptr;
+    }
+
+    if (compare_keys(key, current->data.first))
+    {
+        node* left = erase_from(current->left_subtree, key, erased);
+        if (!erased)
+        {
+            return current;
+        }
+        node* copy = writable(current);
+        copy->left_subtree = left;
+        return balance(copy);
+    }
+
+    if (compare_keys(current->data.first, key))
+    {
+        node* right = erase_from(current->right_subtree, key, erased);
+        if (!erased)
+        {
+            return current;
+        }
+        node* copy = writable(current);
+        copy->right_subtree = right;
+        return balance(copy);
+    }
+
+    erased = true;
+    if (!current->left_subtree || !current->right_subtree)
+    {
+        _replaced.push_back(current);
+        return current->left_subtree ? current->left_subtree : current->right_subtree;
+    }
+
+    // the successor moves up, it is copied since readers may be standing on it
+    node* minimum;
+    node* right = erase_minimum(current->right_subtree, minimum);
+    node* replacement = create_node(current->left_subtree, right, minimum->data);
+    _replaced.push_back(current);
+    _replaced.push_back(minimum);
+    return balance(replacement);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename concurrent_AVL_tree<tkey, tvalue, compare>::node*
+concurrent_AVL_tree<tkey, tvalue, compare>::erase_minimum(node* current, node*& minimum)
+{
+    if (!current->left_subtree)
+    {
+        minimum = current;
+        return current->right_subtree;
+    }
+
+    node* left = erase_minimum(current->left_subtree, minimum);
+    node* copy = writable(current);
+    copy->left_subtree = left;
+    return balance(copy);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+void concurrent_AVL_tree<tkey, tvalue, compare>::commit(node* new_root, size_t new_size)
+{
+    // retired under the epoch the old root was still visible in
+    auto& retired = _retired[_epoch.load(std::memory_order_relaxed) & 1];
+    retired.reserve(retired.size() + _replaced.size());
+
+    for (node* current : _fresh)
+    {
+        current->fresh = false;
+    }
+    _fresh.clear();
+
+    _root.store(new_root, std::memory_order_release);
+    _size.store(new_size, std::memory_order_release);
+
+    retired.insert(retired.end(), _replaced.begin(), _replaced.end());
+    _replaced.clear();
+
+    try_reclaim();
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+void concurrent_AVL_tree<tkey, tvalue, compare>::rollback() noexcept
+{
+    for (node* current : _fresh)
+    {
+        destroy_node(current);
+    }
+    _fresh.clear();
+    _replaced.clear();
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+void concurrent_AVL_tree<tkey, tvalue, compare>::try_reclaim() noexcept
+{
+    size_t epoch = _epoch.load(std::memory_order_relaxed);
+    size_t previous = (epoch + 1) & 1;
+
+    for (size_t i = 0; i < _slots_count; ++i)
+    {
+        if (_slots[i].readers[previous].load(std::memory_order_seq_cst) != 0)
+        {
+            return;
+        }
+    }
+
+    // every reader that entered before the epoch began has left, nothing retired before then is reachable
+    for (node* current : _retired[previous])
+    {
+        destroy_node(current);
+    }
+    _retired[previous].clear();
+    _epoch.store(epoch + 1, std::memory_order_seq_cst);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+void concurrent_AVL_tree<tkey, tvalue, compare>::destroy_subtree(node* subtree_root) noexcept
+{
+    while (subtree_root)
+    {
+        // rotate left children up until the root has none, then it can go
+        if (node* left = subtree_root->left_subtree)
+        {
+            subtree_root->left_subtree = left->right_subtree;
+            left->right_subtree = subtree_root;
+            subtree_root = left;
+        }
+        else
+        {
+            node* right = subtree_root->right_subtree;
+            destroy_node(subtree_root);
+            subtree_root = right;
+        }
+    }
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+template<class ...Args>
+bool concurrent_AVL_tree<tkey, tvalue, compare>::write(bool assign, const tkey& key, Args&&... args)
+{
+    std::lock_guard lock(_writer);
+
+    bool inserted = false;
+    node* old_root = _root.load(std::memory_order_relaxed);
+    try
+    {
+        node* new_root = insert_into(old_root, assign, inserted, key, std::forward<Args>(args)...);
+        if (new_root != old_root)
+        {
+            commit(new_root, _size.load(std::memory_order_relaxed) + (inserted ? 1 : 0));
+        }
+    }
+    catch (...)
+    {
+        rollback();
+        throw;
+    }
+    return inserted;
+}
+
+// endregion path copying implementation
+
+#endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_CONCURRENT_AVL_TREE_H
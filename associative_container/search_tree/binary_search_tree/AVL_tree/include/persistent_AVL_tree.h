@@ -0,0 +1,865 @@
+#ifndef MATH_PRACTICE_AND_OPERATING_SYSTEMS_PERSISTENT_AVL_TREE_H
+#define MATH_PRACTICE_AND_OPERATING_SYSTEMS_PERSISTENT_AVL_TREE_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include <logger.h>
+#include <search_tree.h>
+#include <pp_allocator.h>
+
+/** AVL map whose copies are versions sharing their nodes. Copying takes O(1): it only counts one more owner of
+ *  the root. A change copies the O(log n) nodes on the path it touches, links them to the untouched subtrees
+ *  and leaves every other version as it was.
+ *
+ *  Nodes are reference counted atomically, so different versions may be read, changed and destroyed from
+ *  different threads at once as long as the allocator's memory resource is thread safe. One version is not
+ *  safe to change while another thread uses that same object
+ */
+template<typename tkey, typename tvalue, compator<tkey> compare = std::less<tkey>>
+class persistent_AVL_tree final : private compare
+{
+public:
+
+    using value_type = std::pair<const tkey, tvalue>;
+
+private:
+
+    struct node final
+    {
+        value_type data;
+        node* left_subtree;
+        node* right_subtree;
+
+        // versions and parent nodes pointing here
+        std::atomic<size_t> references;
+        unsigned char height;
+
+        // built by the running change and reachable from no version yet, so it can still be changed in place
+        bool fresh;
+
+        template<class ...Args>
+        node(node* left, node* right, Args&&... args);
+    };
+
+    node* _root;
+    size_t _size;
+    pp_allocator<value_type> _allocator;
+    logger* _logger;
+
+    // nodes the running change has built, a change that throws frees them and leaves the version untouched
+    std::vector<node*> _fresh;
+
+public:
+
+    // region iterator definition
+
+    /** In-order iterator, invalidated by any change to the version it came from
+     */
+    class const_iterator final
+    {
+        friend class persistent_AVL_tree;
+
+        // the current node on top, below it the ancestors whose left subtree is being walked
+        std::vector<node*> _path;
+
+        void push_left(node* current);
+
+    public:
+
+        using value_type = persistent_AVL_tree::value_type;
+        using difference_type = ptrdiff_t;
+        using reference = const value_type&;
+        using pointer = const value_type*;
+        using iterator_category = std::forward_iterator_tag;
+
+        const_iterator() = default;
+
+        reference operator*() const;
+        pointer operator->() const;
+
+        const_iterator& operator++();
+        const_iterator operator++(int);
+
+        bool operator==(const const_iterator& other) const noexcept;
+    };
+
+    // endregion iterator definition
+
+    // region constructors declaration
+
+    explicit persistent_AVL_tree(const compare& cmp = compare(),
+                                 pp_allocator<value_type> alloc = pp_allocator<value_type>(),
+                                 logger* logger = nullptr);
+
+    template<input_iterator_for_pair<tkey, tvalue> iterator>
+    persistent_AVL_tree(iterator begin, iterator end, const compare& cmp = compare(),
+                        pp_allocator<value_type> alloc = pp_allocator<value_type>(),
+                        logger* logger = nullptr);
+
+    persistent_AVL_tree(std::initializer_list<std::pair<tkey, tvalue>> data,
+                        const compare& cmp = compare(),
+                        pp_allocator<value_type> alloc = pp_allocator<value_type>(),
+                        logger* logger = nullptr);
+
+    /** Shares every node of other, O(1)
+     */
+    persistent_AVL_tree(const persistent_AVL_tree& other) noexcept;
+
+    persistent_AVL_tree(persistent_AVL_tree&& other) noexcept;
+
+    persistent_AVL_tree& operator=(const persistent_AVL_tree& other) noexcept;
+
+    persistent_AVL_tree& operator=(persistent_AVL_tree&& other) noexcept;
+
+    ~persistent_AVL_tree() noexcept;
+
+    // endregion constructors declaration
+
+    // region lookup declaration
+
+    bool contains(const tkey& key) const noexcept;
+
+    /** std::out_of_range if there is no such key. Values are only changed through insert_or_assign,
+     *  which would change them in every version sharing the node otherwise
+     */
+    const tvalue& at(const tkey& key) const;
+
+    const_iterator find(const tkey& key) const;
+
+    const_iterator begin() const;
+    const_iterator end() const noexcept;
+
+    size_t size() const noexcept;
+
+    bool empty() const noexcept;
+
+    // endregion lookup declaration
+
+    // region modifiers declaration
+
+    /** Each change copies O(log n) nodes and leaves the version untouched if it throws
+     */
+    bool insert(const value_type& data);
+
+    bool insert(value_type&& data);
+
+    template<class ...Args>
+    bool emplace(Args&&... args);
+
+    /** Returns true when the key was inserted, false when its value was replaced
+     */
+    bool insert_or_assign(const value_type& data);
+
+    bool insert_or_assign(value_type&& data);
+
+    size_t erase(const tkey& key);
+
+    /** Drops this version's hold on its nodes, other versions keep theirs
+     */
+    void clear() noexcept;
+
+    // endregion modifiers declaration
+
+private:
+
+    // region path copying declaration
+
+    bool compare_keys(const tkey& lhs, const tkey& rhs) const;
+
+    node* find_node(const tkey& key) const noexcept;
+
+    static node* retain(node* current) noexcept;
+
+    void release(node* current) noexcept;
+
+    /** Releases a reference the running change got, nodes it built are left to rollback
+     */
+    void drop(node* current) noexcept;
+
+    /** Adopts the references to left and right, drops them if it throws
+     */
+    template<class ...Args>
+    node* create_node(node* left, node* right, Args&&... args);
+
+    /** The node itself while the running change built it, a fresh copy sharing its subtrees otherwise
+     */
+    node* writable(node* current);
+
+    /** Makes the child behind the slot writable and points the slot at it
+     */
+    node* writable_child(node*& slot);
+
+    /** Copy of current with one subtree replaced by the one the caller got a reference to
+     */
+    node* replace_child(node* current, bool left, node* subtree);
+
+    static size_t height(node* current) noexcept;
+
+    static void update_height(node* current) noexcept;
+
+    node* rotate_left(node* current);
+
+    node* rotate_right(node* current);
+
+    node* balance(node* current);
+
+    /** Returns current when nothing changed and a reference the caller owns otherwise
+     */
+    template<class ...Args>
+    node* insert_into(node* current, bool assign, bool& inserted, const tkey& key, Args&&... args);
+
+    node* erase_from(node* current, const tkey& key, bool& erased);
+
+    node* erase_minimum(node* current, node*& minimum);
+
+    void commit(node* new_root, size_t new_size) noexcept;
+
+    void rollback() noexcept;
+
+    template<class ...Args>
+    bool write(bool assign, const tkey& key, Args&&... args);
+
+    // endregion path copying declaration
+};
+
+// region node implementation
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+template<class ...Args>
+persistent_AVL_tree<tkey, tvalue, compare>::node::node(node* left, node* right, Args&&... args)
+    : data(std::forward<Args>(args)...), left_subtree(left), right_subtree(right), references(1), height(1),
+      fresh(true)
+{
+}
+
+// endregion node implementation
+
+// region iterator implementation
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+void persistent_AVL_tree<tkey, tvalue, compare>::const_iterator::push_left(node* current)
+{
+    for (; current; current = current->left_subtree)
+    {
+        _path.push_back(current);
+    }
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename persistent_AVL_tree<tkey, tvalue, compare>::const_iterator::reference
+persistent_AVL_tree<tkey, tvalue, compare>::const_iterator::operator*() const
+{
+    if (_path.empty())
+    {
+        throw std::out_of_range("Dereferencing end iterator");
+    }
+    return _path.back()->data;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename persistent_AVL_tree<tkey, tvalue, compare>::const_iterator::pointer
+persistent_AVL_tree<tkey, tvalue, compare>::const_iterator::operator->() const
+{
+    return &**this;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename persistent_AVL_tree<tkey, tvalue, compare>::const_iterator&
+persistent_AVL_tree<tkey, tvalue, compare>::const_iterator::operator++()
+{
+    if (!_path.empty())
+    {
+        node* current = _path.back();
+        _path.pop_back();
+        push_left(current->right_subtree);
+    }
+    return *this;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename persistent_AVL_tree<tkey, tvalue, compare>::const_iterator
+persistent_AVL_tree<tkey, tvalue, compare>::const_iterator::operator++(int)
+{
+    auto temp = *this;
+    ++*this;
+    return temp;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+bool persistent_AVL_tree<tkey, tvalue, compare>::const_iterator::operator==(const const_iterator& other) const noexcept
+{
+    if (_path.empty() || other._path.empty())
+    {
+        return _path.empty() == other._path.empty();
+    }
+    return _path.back() == other._path.back();
+}
+
+// endregion iterator implementation
+
+// region constructors implementation
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+persistent_AVL_tree<tkey, tvalue, compare>::persistent_AVL_tree(const compare& cmp,
+                                                                pp_allocator<value_type> alloc,
+                                                                logger* logger)
+    : compare(cmp), _root(nullptr), _size(0), _allocator(alloc), _logger(logger)
+{
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+template<input_iterator_for_pair<tkey, tvalue> iterator>
+persistent_AVL_tree<tkey, tvalue, compare>::persistent_AVL_tree(iterator begin, iterator end, const compare& cmp,
+                                                                pp_allocator<value_type> alloc,
+                                                                logger* logger)
+    : persistent_AVL_tree(cmp, alloc, logger)
+{
+    for (; begin != end; ++begin)
+    {
+        insert(*begin);
+    }
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+persistent_AVL_tree<tkey, tvalue, compare>::persistent_AVL_tree(std::initializer_list<std::pair<tkey, tvalue>> data,
+                                                                const compare& cmp,
+                                                                pp_allocator<value_type> alloc,
+                                                                logger* logger)
+    : persistent_AVL_tree(data.begin(), data.end(), cmp, alloc, logger)
+{
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+persistent_AVL_tree<tkey, tvalue, compare>::persistent_AVL_tree(const persistent_AVL_tree& other) noexcept
+    : compare(other), _root(retain(other._root)), _size(other._size), _allocator(other._allocator),
+      _logger(other._logger)
+{
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+persistent_AVL_tree<tkey, tvalue, compare>::persistent_AVL_tree(persistent_AVL_tree&& other) noexcept
+    : compare(std::move(static_cast<compare&>(other))), _root(std::exchange(other._root, nullptr)),
+      _size(std::exchange(other._size, 0)), _allocator(other._allocator), _logger(other._logger)
+{
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+persistent_AVL_tree<tkey, tvalue, compare>&
+persistent_AVL_tree<tkey, tvalue, compare>::operator=(const persistent_AVL_tree& other) noexcept
+{
+    if (this != &other)
+    {
+        // the old nodes go back to the allocator they came from
+        clear();
+        static_cast<compare&>(*this) = static_cast<const compare&>(other);
+        _root = retain(other._root);
+        _size = other._size;
+        _allocator = other._allocator;
+        _logger = other._logger;
+    }
+    return *this;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+persistent_AVL_tree<tkey, tvalue, compare>&
+persistent_AVL_tree<tkey, tvalue, compare>::operator=(persistent_AVL_tree&& other) noexcept
+{
+    if (this != &other)
+    {
+        clear();
+        static_cast<compare&>(*this) = std::move(static_cast<compare&>(other));
+        _root = std::exchange(other._root, nullptr);
+        _size = std::exchange(other._size, 0);
+        _allocator = other._allocator;
+        _logger = other._logger;
+    }
+    return *this;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+persistent_AVL_tree<tkey, tvalue, compare>::~persistent_AVL_tree() noexcept
+{
+    release(_root);
+}
+
+// endregion constructors implementation
+
+// region lookup implementation
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+bool persistent_AVL_tree<tkey, tvalue, compare>::contains(const tkey& key) const noexcept
+{
+    return find_node(key) != nullptr;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+const tvalue& persistent_AVL_tree<tkey, tvalue, compare>::at(const tkey& key) const
+{
+    node* found = find_node(key);
+    if (!found)
+    {
+        throw std::out_of_range("Key not found");
+    }
+    return found->data.second;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename persistent_AVL_tree<tkey, tvalue, compare>::const_iterator
+persistent_AVL_tree<tkey, tvalue, compare>::find(const tkey& key) const
+{
+    const_iterator it;
+    node* current = _root;
+    while (current)
+    {
+        if (compare_keys(key, current->data.first))
+        {
+            it._path.push_back(current);
+            current = current->left_subtree;
+        }
+        else if (compare_keys(current->data.first, key))
+        {
+            current = current->right_subtree;
+        }
+        else
+        {
+            it._path.push_back(current);
+            return it;
+        }
+    }
+    return end();
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename persistent_AVL_tree<tkey, tvalue, compare>::const_iterator
+persistent_AVL_tree<tkey, tvalue, compare>::begin() const
+{
+    const_iterator it;
+    it.push_left(_root);
+    return it;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename persistent_AVL_tree<tkey, tvalue, compare>::const_iterator
+persistent_AVL_tree<tkey, tvalue, compare>::end() const noexcept
+{
+    return const_iterator();
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+size_t persistent_AVL_tree<tkey, tvalue, compare>::size() const noexcept
+{
+    return _size;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+bool persistent_AVL_tree<tkey, tvalue, compare>::empty() const noexcept
+{
+    return _size == 0;
+}
+
+// endregion lookup implementation
+
+// region modifiers implementation
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+bool persistent_AVL_tree<tkey, tvalue, compare>::insert(const value_type& data)
+{
+    return write(false, data.first, data);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+bool persistent_AVL_tree<tkey, tvalue, compare>::insert(value_type&& data)
+{
+    return write(false, data.first, std::move(data));
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+template<class ...Args>
+bool persistent_AVL_tree<tkey, tvalue, compare>::emplace(Args&&... args)
+{
+    value_type data(std::forward<Args>(args)...);
+    return write(false, data.first, std::move(data));
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+bool persistent_AVL_tree<tkey, tvalue, compare>::insert_or_assign(const value_type& data)
+{
+    return write(true, data.first, data);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+bool persistent_AVL_tree<tkey, tvalue, compare>::insert_or_assign(value_type&& data)
+{
+    return write(true, data.first, std::move(data));
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+size_t persistent_AVL_tree<tkey, tvalue, compare>::erase(const tkey& key)
+{
+    bool erased = false;
+    node* new_root;
+    try
+    {
+        new_root = erase_from(_root, key, erased);
+    }
+    catch (...)
+    {
+        rollback();
+        throw;
+    }
+
+    if (!erased)
+    {
+        return 0;
+    }
+    commit(new_root, _size - 1);
+    return 1;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+void persistent_AVL_tree<tkey, tvalue, compare>::clear() noexcept
+{
+    release(std::exchange(_root, nullptr));
+    _size = 0;
+}
+
+// endregion modifiers implementation
+
+// region path copying implementation
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+bool persistent_AVL_tree<tkey, tvalue, compare>::compare_keys(const tkey& lhs, const tkey& rhs) const
+{
+    return compare::operator()(lhs, rhs);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename persistent_AVL_tree<tkey, tvalue, compare>::node*
+persistent_AVL_tree<tkey, tvalue, compare>::find_node(const tkey& key) const noexcept
+{
+    node* current = _root;
+    while (current)
+    {
+        if (compare_keys(key, current->data.first))
+        {
+            current = current->left_subtree;
+        }
+        else if (compare_keys(current->data.first, key))
+        {
+            current = current->right_subtree;
+        }
+        else
+        {
+            return current;
+        }
+    }
+    return nullptr;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename persistent_AVL_tree<tkey, tvalue, compare>::node*
+persistent_AVL_tree<tkey, tvalue, compare>::retain(node* current) noexcept
+{
+    if (current)
+    {
+        current->references.fetch_add(1, std::memory_order_relaxed);
+    }
+    return current;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+void persistent_AVL_tree<tkey, tvalue, compare>::release(node* current) noexcept
+{
+    // the depth is the tree height, so the recursion stays shallow
+    if (current && current->references.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    {
+        release(current->left_subtree);
+        release(current->right_subtree);
+        _allocator.template delete_object<node>(current);
+    }
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+void persistent_AVL_tree<tkey, tvalue, compare>::drop(node* current) noexcept
+{
+    // a node taken from a version is still held by that version, so this never frees one
+    if (current && !current->fresh)
+    {
+        release(current);
+    }
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+template<class ...Args>
+typename persistent_AVL_tree<tkey, tvalue, compare>::node*
+persistent_AVL_tree<tkey, tvalue, compare>::create_node(node* left, node* right, Args&&... args)
+{
+    node* created;
+    try
+    {
+        _fresh.reserve(_fresh.size() + 1);
+        created = _allocator.template new_object<node>(left, right, std::forward<Args>(args)...);
+    }
+    catch (...)
+    {
+        drop(left);
+        drop(right);
+        throw;
+    }
+
+    _fresh.push_back(created);
+    update_height(created);
+    return created;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename persistent_AVL_tree<tkey, tvalue, compare>::node*
+persistent_AVL_tree<tkey, tvalue, compare>::writable(node* current)
+{
+    if (current->fresh)
+    {
+        return current;
+    }
+    return create_node(retain(current->left_subtree), retain(current->right_subtree), current->data);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename persistent_AVL_tree<tkey, tvalue, compare>::node*
+persistent_AVL_tree<tkey, tvalue, compare>::writable_child(node*& slot)
+{
+    node* copy = writable(slot);
+    if (copy != slot)
+    {
+        release(slot);
+        slot = copy;
+    }
+    return copy;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename persistent_AVL_tree<tkey, tvalue, compare>::node*
+persistent_AVL_tree<tkey, tvalue, compare>::replace_child(node* current, bool left, node* subtree)
+{
+    node* copy;
+    try
+    {
+        copy = writable(current);
+    }
+    catch (...)
+    {
+        drop(subtree);
+        throw;
+    }
+
+    node*& slot = left ? copy->left_subtree : copy->right_subtree;
+    drop(slot);
+    slot = subtree;
+    return balance(copy);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+size_t persistent_AVL_tree<tkey, tvalue, compare>::height(node* current) noexcept
+{
+    return current ? current->height : 0;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+void persistent_AVL_tree<tkey, tvalue, compare>::update_height(node* current) noexcept
+{
+    current->height = static_cast<unsigned char>(
+            std::max(height(current->left_subtree), height(current->right_subtree)) + 1);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename persistent_AVL_tree<tkey, tvalue, compare>::node*
+persistent_AVL_tree<tkey, tvalue, compare>::rotate_left(node* current)
+{
+    // the references move along with the links, none is gained or lost
+    node* pivot = writable_child(current->right_subtree);
+    current->right_subtree = pivot->left_subtree;
+    pivot->left_subtree = current;
+    update_height(current);
+    update_height(pivot);
+    return pivot;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename persistent_AVL_tree<tkey, tvalue, compare>::node*
+persistent_AVL_tree<tkey, tvalue, compare>::rotate_right(node* current)
+{
+    node* pivot = writable_child(current->left_subtree);
+    current->left_subtree = pivot->right_subtree;
+    pivot->right_subtree = current;
+    update_height(current);
+    update_height(pivot);
+    return pivot;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename persistent_AVL_tree<tkey, tvalue, compare>::node*
+persistent_AVL_tree<tkey, tvalue, compare>::balance(node* current)
+{
+    update_height(current);
+    size_t left = height(current->left_subtree);
+    size_t right = height(current->right_subtree);
+
+    if (right > left + 1)
+    {
+        node* child = current->right_subtree;
+        if (height(child->left_subtree) > height(child->right_subtree))
+        {
+            current->right_subtree = rotate_right(writable_child(current->right_subtree));
+        }
+        return rotate_left(current);
+    }
+    if (left > right + 1)
+    {
+        node* child = current->left_subtree;
+        if (height(child->right_subtree) > height(child->left_subtree))
+        {
+            current->left_subtree = rotate_left(writable_child(current->left_subtree));
+        }
+        return rotate_right(current);
+    }
+    return current;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+template<class ...Args>
+typename persistent_AVL_tree<tkey, tvalue, compare>::node*
+persistent_AVL_tree<tkey, tvalue, compare>::insert_into(node* current, bool assign, bool& inserted, const tkey& key,
+                                                       Args&&... args)
+{
+    if (!current)
+    {
+        inserted = true;
+        return create_node(nullptr, nullptr, std::forward<Args>(args)...);
+    }
+
+    if (compare_keys(key, current->data.first))
+    {
+        node* left = insert_into(current->left_subtree, assign, inserted, key, std::forward<Args>(args)...);
+        return left == current->left_subtree ? current : replace_child(current, true, left);
+    }
+
+    if (compare_keys(current->data.first, key))
+    {
+        node* right = insert_into(current->right_subtree, assign, inserted, key, std::forward<Args>(args)...);
+        return right == current->right_subtree ? current : replace_child(current, false, right);
+    }
+
+    if (!assign)
+    {
+        return current;
+    }
+    return create_node(retain(current->left_subtree), retain(current->right_subtree), std::forward<Args>(args)...);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename persistent_AVL_tree<tkey, tvalue, compare>::node*
+persistent_AVL_tree<tkey, tvalue, compare>::erase_from(node* current, const tkey& key, bool& erased)
+{
+    if (!current)
+    {
+        return nullptr;
+    }
+
+    if (compare_keys(key, current->data.first))
+    {
+        node* left = erase_from(current->left_subtree, key, erased);
+        return erased ? replace_child(current, true, left) : current;
+    }
+
+    if (compare_keys(current->data.first, key))
+    {
+        node* right = erase_from(current->right_subtree, key, erased);
+        return erased ? replace_child(current, false, right) : current;
+    }
+
+    erased = true;
+    if (!current->left_subtree || !current->right_subtree)
+    {
+        return retain(current->left_subtree ? current->left_subtree : current->right_subtree);
+    }
+
+    // the successor's element is copied up, the node itself may still belong to other versions
+    node* minimum;
+    node* right = erase_minimum(current->right_subtree, minimum);
+    return balance(create_node(retain(current->left_subtree), right, minimum->data));
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename persistent_AVL_tree<tkey, tvalue, compare>::node*
+persistent_AVL_tree<tkey, tvalue, compare>::erase_minimum(node* current, node*& minimum)
+{
+    if (!current->left_subtree)
+    {
+        minimum = current;
+        return retain(current->right_subtree);
+    }
+
+    node* left = erase_minimum(current->left_subtree, minimum);
+    return replace_child(current, true, left);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+void persistent_AVL_tree<tkey, tvalue, compare>::commit(node* new_root, size_t new_size) noexcept
+{
+    for (node* current : _fresh)
+    {
+        current->fresh = false;
+    }
+    _fresh.clear();
+
+    // frees only the old path nodes no other version holds
+    release(std::exchange(_root, new_root));
+    _size = new_size;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+void persistent_AVL_tree<tkey, tvalue, compare>::rollback() noexcept
+{
+    for (node* current : _fresh)
+    {
+        drop(current->left_subtree);
+        drop(current->right_subtree);
+    }
+    for (node* current : _fresh)
+    {
+        _allocator.template delete_object<node>(current);
+    }
+    _fresh.clear();
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+template<class ...Args>
+bool persistent_AVL_tree<tkey, tvalue, compare>::write(bool assign, const tkey& key, Args&&... args)
+{
+    bool inserted = false;
+    node* new_root;
+    try
+    {
+        new_root = insert_into(_root, assign, inserted, key, std::forward<Args>(args)...);
+    }
+    catch (...)
+    {
+        rollback();
+        throw;
+    }
+
+    if (new_root != _root)
+    {
+        commit(new_root, _size + (inserted ? 1 : 0));
+    }
+    return inserted;
+}
+
+// endregion path copying implementation
+
+#endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_PERSISTENT_AVL_TREE_H
@@ -1,8 +1,11 @@
 #include <gtest/gtest.h>
 #include <AVL_tree.h>
+#include <concurrent_AVL_tree.h>
+#include <persistent_AVL_tree.h>
 #include <logger_builder.h>
 #include <client_logger_builder.h>
 #include <iostream>
+#include <thread>
 
 logger *create_logger(
         std::vector<std::pair<std::string, logger::severity>> const &output_file_streams_setup,
@@ -567,6 +570,284 @@ TEST(AVLTreePositiveTests, test11)
     logger->trace("AVLTreePositiveTests.test11 finished");
 }
 
+TEST(AVLTreePositiveTests, test12)
+{
+    std::unique_ptr<logger> logger(create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "AVL_tree_tests_logs.txt",
+                logger::severity::trace
+            },
+        }));
+
+    logger->trace("AVLTreePositiveTests.test12 started");
+
+    auto avl = std::make_unique<AVL_tree<int, std::string>>(std::less<int>(), nullptr, logger.get());
+
+    avl->insert_range(std::vector<std::pair<int, std::string>>
+        {
+            { 6, "f" }, { 1, "a" }, { 4, "d" }, { 2, "b" }, { 5, "e" }, { 3, "c" }
+        });
+
+    std::vector<test_data<int, std::string>> expected_result =
+        {
+            test_data<int, std::string>(2, 1, "a", 1),
+            test_data<int, std::string>(1, 2, "b", 2),
+            test_data<int, std::string>(2, 3, "c", 1),
+            test_data<int, std::string>(0, 4, "d", 3),
+            test_data<int, std::string>(2, 5, "e", 1),
+            test_data<int, std::string>(1, 6, "f", 2)
+        };
+
+    EXPECT_TRUE(infix_iterator_test(*avl, expected_result));
+
+    avl->emplace(7, "g");
+    avl->emplace(8, "h");
+    avl->erase(1);
+
+    std::vector<test_data<int, std::string>> rebalanced_result =
+        {
+            test_data<int, std::string>(1, 2, "b", 2),
+            test_data<int, std::string>(2, 3, "c", 1),
+            test_data<int, std::string>(0, 4, "d", 4),
+            test_data<int, std::string>(2, 5, "e", 1),
+            test_data<int, std::string>(1, 6, "f", 3),
+            test_data<int, std::string>(2, 7, "g", 2),
+            test_data<int, std::string>(3, 8, "h", 1)
+        };
+
+    EXPECT_TRUE(infix_iterator_test(*avl, rebalanced_result));
+
+    logger->trace("AVLTreePositiveTests.test12 finished");
+}
+
+TEST(AVLTreePositiveTests, test13)
+{
+    std::unique_ptr<logger> logger(create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "AVL_tree_tests_logs.txt",
+                logger::severity::trace
+            },
+        }));
+
+    logger->trace("AVLTreePositiveTests.test13 started");
+
+    AVL_tree<int, int> small;
+    AVL_tree<int, int> large;
+    small.emplace(-2, 0);
+    small.emplace(-1, 0);
+    for (int i = 0; i < 1000; ++i)
+    {
+        large.emplace(i, i);
+    }
+
+    small.join(std::move(large));
+    EXPECT_EQ(small.size(), 1002u);
+    EXPECT_TRUE(large.empty());
+
+    AVL_tree<int, int> multiples;
+    for (int i = 0; i < 1500; i += 3)
+    {
+        multiples.emplace(i, -i);
+    }
+    small.set_difference(std::move(multiples));
+    EXPECT_EQ(small.size(), 1002u - 334u);
+
+    std::vector<int> keys;
+    for (auto it = small.begin(); it != small.end(); ++it)
+    {
+        keys.push_back(it->first);
+    }
+
+    std::vector<int> expected_keys{ -2, -1 };
+    for (int i = 0; i < 1000; ++i)
+    {
+        if (i % 3 != 0)
+        {
+            expected_keys.push_back(i);
+        }
+    }
+    EXPECT_EQ(keys, expected_keys);
+
+    size_t unbalanced = 0;
+    for (auto it = small.begin_prefix(); it != small.end_prefix(); ++it)
+    {
+        short balance = static_cast<short>(it.get_balance());
+        unbalanced += balance < -1 || balance > 1;
+    }
+    EXPECT_EQ(unbalanced, 0u);
+    EXPECT_LE(small.begin_prefix().get_height(), 14u);
+
+    logger->trace("AVLTreePositiveTests.test13 finished");
+}
+
+TEST(AVLTreePositiveTests, test14)
+{
+    std::unique_ptr<logger> logger(create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "AVL_tree_tests_logs.txt",
+                logger::severity::trace
+            },
+        }));
+
+    logger->trace("AVLTreePositiveTests.test14 started");
+
+    AVL_tree<int, int, std::less<int>, order_statistic> tree;
+    for (int i = 0; i < 1000; ++i)
+    {
+        tree.emplace((i * 389) % 1000, i);
+    }
+    for (int i = 0; i < 1000; i += 2)
+    {
+        tree.erase(i);
+    }
+
+    EXPECT_EQ(tree.size(), 500u);
+    for (size_t i = 0; i < 500; ++i)
+    {
+        EXPECT_EQ(tree.select(i)->first, static_cast<int>(2 * i + 1));
+    }
+    EXPECT_EQ(tree.select(500), tree.end());
+    EXPECT_EQ(tree.rank(501), 250u);
+    EXPECT_EQ(tree.rank(500), 250u);
+    EXPECT_EQ(tree.count_range(100, 200), 50u);
+
+    logger->trace("AVLTreePositiveTests.test14 finished");
+}
+
+TEST(AVLTreePositiveTests, test15)
+{
+    std::unique_ptr<logger> logger(create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "AVL_tree_tests_logs.txt",
+                logger::severity::trace
+            },
+        }));
+
+    logger->trace("AVLTreePositiveTests.test15 started");
+
+    concurrent_AVL_tree<int, int> tree;
+    constexpr int count = 2000;
+
+    // the writer only appends, so every version a reader can see holds exactly the keys 0..k-1
+    std::atomic<bool> done = false;
+    std::atomic<size_t> torn_snapshots = 0;
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 2; ++i)
+    {
+        readers.emplace_back([&]
+        {
+            while (!done.load())
+            {
+                auto snapshot = tree.get_snapshot();
+                int expected = 0;
+                for (auto const &item : snapshot)
+                {
+                    torn_snapshots += item.first != expected || item.second != 2 * expected;
+                    ++expected;
+                }
+            }
+        });
+    }
+
+    for (int i = 0; i < count; ++i)
+    {
+        EXPECT_TRUE(tree.insert({ i, 2 * i }));
+    }
+    auto before_erase = tree.get_snapshot();
+
+    for (int i = count - 1; i >= count / 2; --i)
+    {
+        EXPECT_EQ(tree.erase(i), 1u);
+    }
+    done = true;
+    for (auto &reader : readers)
+    {
+        reader.join();
+    }
+
+    EXPECT_EQ(torn_snapshots, 0u);
+    EXPECT_EQ(tree.size(), size_t{count / 2});
+    EXPECT_FALSE(tree.contains(count / 2));
+    EXPECT_TRUE(before_erase.contains(count - 1));
+    EXPECT_EQ(before_erase.find(count - 1)->second, 2 * (count - 1));
+
+    EXPECT_FALSE(tree.insert({ 5, 0 }));
+    EXPECT_FALSE(tree.insert_or_assign({ 5, -5 }));
+    EXPECT_EQ(tree.at(5), -5);
+    EXPECT_EQ(tree.erase(count), 0u);
+    EXPECT_THROW(tree.at(count), std::out_of_range);
+
+    logger->trace("AVLTreePositiveTests.test15 finished");
+}
+
+TEST(AVLTreePositiveTests, test16)
+{
+    std::unique_ptr<logger> logger(create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "AVL_tree_tests_logs.txt",
+                logger::severity::trace
+            },
+        }));
+
+    logger->trace("AVLTreePositiveTests.test16 started");
+
+    constexpr int count = 1000;
+
+    // version i holds the keys 0..i-1, each mapped to its double
+    std::vector<persistent_AVL_tree<int, int>> history;
+    history.emplace_back(std::less<int>(), pp_allocator<std::pair<const int, int>>(), logger.get());
+    for (int i = 0; i < count; ++i)
+    {
+        history.push_back(history.back());
+        EXPECT_TRUE(history.back().insert({ i, 2 * i }));
+    }
+
+    // old versions are read while newer ones are changed from another thread
+    std::atomic<size_t> torn_versions = 0;
+    std::thread reader([&]
+    {
+        for (int i = 0; i <= count; i += 7)
+        {
+            int expected = 0;
+            for (auto const &item : history[i])
+            {
+                torn_versions += item.first != expected || item.second != 2 * expected;
+                ++expected;
+            }
+            torn_versions += expected != i;
+        }
+    });
+
+    persistent_AVL_tree<int, int> latest(history.back());
+    for (int i = 0; i < count; i += 2)
+    {
+        EXPECT_EQ(latest.erase(i), 1u);
+    }
+    EXPECT_FALSE(latest.insert_or_assign({ 1, -1 }));
+    reader.join();
+
+    EXPECT_EQ(torn_versions, 0u);
+    EXPECT_EQ(latest.size(), size_t{count / 2});
+    EXPECT_EQ(latest.at(1), -1);
+    EXPECT_FALSE(latest.contains(0));
+    EXPECT_EQ(history.back().at(1), 2);
+    EXPECT_TRUE(history.back().contains(0));
+    EXPECT_EQ(history[count / 2].size(), size_t{count / 2});
+    EXPECT_EQ(history[count / 2].find(count / 2), history[count / 2].end());
+    EXPECT_EQ(latest.erase(0), 0u);
+    EXPECT_THROW(latest.at(0), std::out_of_range);
+
+    history.clear();
+    EXPECT_EQ(latest.find(999)->second, 2 * 999);
+
+    logger->trace("AVLTreePositiveTests.test16 finished");
+}
+
 int main(
     int argc,
     char **argv)
@@ -1,8 +1,9 @@
 #ifndef MATH_PRACTICE_AND_OPERATING_SYSTEMS_BINARY_SEARCH_TREE_H
 #define MATH_PRACTICE_AND_OPERATING_SYSTEMS_BINARY_SEARCH_TREE_H
 
+#include <algorithm>
+#include <bit>
 #include <list>
-#include <stack>
 #include <vector>
 #include <memory>
 #include <utility>
@@ -10,50 +11,85 @@
 #include <logger_guardant.h>
 #include <not_implemented.h>
 #include <search_tree.h>
-#include <stack>
 #include <ranges>
 #include <pp_allocator.h>
 #include <concepts>
+#include <cstdint>
+#include <future>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+#include <tuple>
 
 namespace __detail
 {
-    template<typename tkey, typename tvalue, typename compare, typename tag>
+    template<typename tkey, typename tvalue, typename compare, typename tag, typename augment = no_augmentation>
     class bst_impl;
 
     class BST_TAG;
+
+    /** Comparator marked is_transparent that orders key against the stored keys in both directions
+     */
+    template<typename compare, typename key, typename tkey>
+    concept transparent_compator = requires { typename compare::is_transparent; } &&
+                                   requires(const compare c, const key& lhs, const tkey& rhs)
+                                   {
+                                       {c(lhs, rhs)} -> std::convertible_to<bool>;
+                                       {c(rhs, lhs)} -> std::convertible_to<bool>;
+                                   };
 }
 
 
-template<typename tkey, typename tvalue, compator<tkey> compare = std::less<tkey>, typename tag = __detail::BST_TAG>
+template<typename tkey, typename tvalue, compator<tkey> compare = std::less<tkey>, typename tag = __detail::BST_TAG,
+         typename augment = no_augmentation>
 class binary_search_tree : private compare
 {
 public:
 
     using value_type = std::pair<const tkey, tvalue>;
 
-    friend class __detail::bst_impl<tkey, tvalue, compare, tag>;
+    friend class __detail::bst_impl<tkey, tvalue, compare, tag, augment>;
 
 protected:
 
-    struct node
+    /** No vtable: every tree deletes nodes through its own node type. Derived trees add no pointer-sized
+     *  fields, their per-node bits (red-black color, AVL height) live in the alignment bits of the parent link.
+     *  The augmentation is an empty base unless one is asked for
+     */
+    struct alignas(8) alignas(value_type) node : public augment::node_data
     {
 
     public:
 
+        static constexpr unsigned char tag_mask = 7;
+
         value_type data;
 
-        node* parent;
+    private:
+
+        std::uintptr_t _parent_and_tag;
+
+    public:
+
         node* left_subtree;
         node* right_subtree;
 
         template<class ...Args>
         explicit node(node* parent, Args&& ...args);
 
+        node* get_parent() const noexcept;
 
-        virtual ~node() =default;
+        /** Keeps the tag bits
+         */
+        void set_parent(node* parent) noexcept;
+
+        unsigned char get_tag() const noexcept;
+
+        void set_tag(unsigned char bits) noexcept;
     };
 
-    inline bool compare_keys(const tkey& lhs, const tkey& rhs) const;
+    template<typename lhs_key, typename rhs_key>
+    inline bool compare_keys(const lhs_key& lhs, const rhs_key& rhs) const;
 
     inline bool compare_pairs(const value_type & lhs, const value_type & rhs) const;
 
@@ -100,7 +136,7 @@ public:
         node* _backup;
 
     public:
-        friend class binary_search_tree<tkey, tvalue, compare, tag>;
+        friend class binary_search_tree<tkey, tvalue, compare, tag, augment>;
         using value_type = binary_search_tree<tkey, tvalue, compare>::value_type;
         using difference_type = ptrdiff_t;
         using reference = value_type&;
@@ -145,7 +181,7 @@ public:
         prefix_iterator _base;
 
     public:
-        friend class binary_search_tree<tkey, tvalue, compare, tag>;
+        friend class binary_search_tree<tkey, tvalue, compare, tag, augment>;
         using value_type = binary_search_tree<tkey, tvalue, compare>::value_type;
         using difference_type = ptrdiff_t;
         using reference = const value_type&;
@@ -159,10 +195,10 @@ public:
         virtual ~prefix_const_iterator() =default;
 
         bool operator==(
-                prefix_iterator const &other) const noexcept;
+                prefix_const_iterator const &other) const noexcept;
 
         bool operator!=(
-                prefix_iterator const &other) const noexcept;
+                prefix_const_iterator const &other) const noexcept;
 
         prefix_const_iterator &operator++() & noexcept;
 
@@ -192,7 +228,7 @@ public:
         prefix_iterator _base;
 
     public:
-        friend class binary_search_tree<tkey, tvalue, compare, tag>;
+        friend class binary_search_tree<tkey, tvalue, compare, tag, augment>;
         using value_type = binary_search_tree<tkey, tvalue, compare>::value_type;
         using difference_type = ptrdiff_t;
         using reference = value_type&;
@@ -240,7 +276,7 @@ public:
         prefix_const_iterator _base;
 
     public:
-        friend class binary_search_tree<tkey, tvalue, compare, tag>;
+        friend class binary_search_tree<tkey, tvalue, compare, tag, augment>;
         using value_type = binary_search_tree<tkey, tvalue, compare>::value_type;
         using difference_type = ptrdiff_t;
         using reference = const value_type&;
@@ -294,7 +330,7 @@ public:
         node* _backup;
 
     public:
-        friend class binary_search_tree<tkey, tvalue, compare, tag>;
+        friend class binary_search_tree<tkey, tvalue, compare, tag, augment>;
 
         using value_type = binary_search_tree<tkey, tvalue, compare>::value_type;
         using difference_type = ptrdiff_t;
@@ -340,7 +376,7 @@ public:
         infix_iterator _base;
 
     public:
-        friend class binary_search_tree<tkey, tvalue, compare, tag>;
+        friend class binary_search_tree<tkey, tvalue, compare, tag, augment>;
         using value_type = binary_search_tree<tkey, tvalue, compare>::value_type;
         using difference_type = ptrdiff_t;
         using reference = const value_type&;
@@ -354,10 +390,10 @@ public:
         virtual ~infix_const_iterator() =default;
 
         bool operator==(
-                infix_iterator const &other) const noexcept;
+                infix_const_iterator const &other) const noexcept;
 
         bool operator!=(
-                infix_iterator const &other) const noexcept;
+                infix_const_iterator const &other) const noexcept;
 
         infix_const_iterator &operator++() & noexcept;
 
@@ -387,7 +423,7 @@ public:
         infix_iterator _base;
 
     public:
-        friend class binary_search_tree<tkey, tvalue, compare, tag>;
+        friend class binary_search_tree<tkey, tvalue, compare, tag, augment>;
         using value_type = binary_search_tree<tkey, tvalue, compare>::value_type;
         using difference_type = ptrdiff_t;
         using reference = value_type&;
@@ -435,7 +471,7 @@ public:
         infix_const_iterator _base;
 
     public:
-        friend class binary_search_tree<tkey, tvalue, compare, tag>;
+        friend class binary_search_tree<tkey, tvalue, compare, tag, augment>;
         using value_type = binary_search_tree<tkey, tvalue, compare>::value_type;
         using difference_type = ptrdiff_t;
         using reference = const value_type&;
@@ -489,7 +525,7 @@ public:
         node* _backup;
 
     public:
-        friend class binary_search_tree<tkey, tvalue, compare, tag>;
+        friend class binary_search_tree<tkey, tvalue, compare, tag, augment>;
         using value_type = binary_search_tree<tkey, tvalue, compare>::value_type;
         using difference_type = ptrdiff_t;
         using reference = value_type&;
@@ -534,7 +570,7 @@ public:
         postfix_iterator _base;
 
     public:
-        friend class binary_search_tree<tkey, tvalue, compare, tag>;
+        friend class binary_search_tree<tkey, tvalue, compare, tag, augment>;
         using value_type = binary_search_tree<tkey, tvalue, compare>::value_type;
         using difference_type = ptrdiff_t;
         using reference = const value_type&;
@@ -548,10 +584,10 @@ public:
         virtual ~postfix_const_iterator() =default;
 
         bool operator==(
-                postfix_iterator const &other) const noexcept;
+                postfix_const_iterator const &other) const noexcept;
 
         bool operator!=(
-                postfix_iterator const &other) const noexcept;
+                postfix_const_iterator const &other) const noexcept;
 
         postfix_const_iterator &operator++() & noexcept;
 
@@ -581,7 +617,7 @@ public:
         postfix_iterator _base;
 
     public:
-        friend class binary_search_tree<tkey, tvalue, compare, tag>;
+        friend class binary_search_tree<tkey, tvalue, compare, tag, augment>;
         using value_type = binary_search_tree<tkey, tvalue, compare>::value_type;
         using difference_type = ptrdiff_t;
         using reference = value_type&;
@@ -629,7 +665,7 @@ public:
         postfix_const_iterator _base;
 
     public:
-        friend class binary_search_tree<tkey, tvalue, compare, tag>;
+        friend class binary_search_tree<tkey, tvalue, compare, tag, augment>;
         using value_type = binary_search_tree<tkey, tvalue, compare>::value_type;
         using difference_type = ptrdiff_t;
         using reference = const value_type&;
@@ -756,15 +792,28 @@ public:
     std::pair<infix_iterator, bool> insert(const value_type&);
     std::pair<infix_iterator, bool> insert(value_type&&);
 
+    /** Bulk insertion: elements are sorted unless they already are, and a tree that receives at least
+     *  size() / log2(size()) of them is rebuilt balanced in linear time. The first of equal keys is kept
+     */
     template<std::input_iterator InputIt>
     void insert(InputIt first, InputIt last);
 
     template<std::ranges::input_range R>
     void insert_range( R&& rg );
 
+    /** Constructs the node once. A key followed by a value, or a single pair, is probed before anything is built
+     */
     template<class ...Args>
     std::pair<infix_iterator, bool> emplace(Args&&...args);
 
+    /** Builds value_type(piecewise_construct, key, args) only if the key is absent, args are untouched otherwise
+     */
+    template<class ...Args>
+    std::pair<infix_iterator, bool> try_emplace(const tkey& key, Args&&...args);
+
+    template<class ...Args>
+    std::pair<infix_iterator, bool> try_emplace(tkey&& key, Args&&...args);
+
     infix_iterator insert_or_assign(const value_type&);
     infix_iterator insert_or_assign(value_type&&);
 
@@ -789,6 +838,29 @@ public:
     infix_iterator upper_bound(const tkey&);
     infix_const_iterator upper_bound(const tkey&) const;
 
+    /** Heterogeneous lookup, available when compare::is_transparent is defined, e.g. std::less<>
+     */
+    template<typename key_type> requires __detail::transparent_compator<compare, key_type, tkey>
+    bool contains(const key_type& key) const;
+
+    template<typename key_type> requires __detail::transparent_compator<compare, key_type, tkey>
+    infix_iterator find(const key_type&);
+
+    template<typename key_type> requires __detail::transparent_compator<compare, key_type, tkey>
+    infix_const_iterator find(const key_type&) const;
+
+    template<typename key_type> requires __detail::transparent_compator<compare, key_type, tkey>
+    infix_iterator lower_bound(const key_type&);
+
+    template<typename key_type> requires __detail::transparent_compator<compare, key_type, tkey>
+    infix_const_iterator lower_bound(const key_type&) const;
+
+    template<typename key_type> requires __detail::transparent_compator<compare, key_type, tkey>
+    infix_iterator upper_bound(const key_type&);
+
+    template<typename key_type> requires __detail::transparent_compator<compare, key_type, tkey>
+    infix_const_iterator upper_bound(const key_type&) const;
+
     infix_iterator erase(infix_iterator pos);
     infix_iterator erase(infix_const_iterator pos);
 
@@ -797,6 +869,54 @@ public:
 
     size_t erase(const tkey& key);
 
+    template<typename key_type> requires __detail::transparent_compator<compare, std::remove_cvref_t<key_type>, tkey> &&
+                                         (!std::convertible_to<key_type, infix_iterator>) &&
+                                         (!std::convertible_to<key_type, infix_const_iterator>)
+    size_t erase(key_type&& key);
+
+    // region order statistics definition
+
+    /** Available with the order_statistic augmentation, each O(height). select finds the element at a
+     *  zero-based position in key order, end() if index >= size()
+     */
+    infix_iterator select(size_t index) requires counts_subtrees<augment>;
+
+    infix_const_iterator select(size_t index) const requires counts_subtrees<augment>;
+
+    /** Number of keys less than key, which is the position key has or would have in the tree
+     */
+    size_t rank(const tkey& key) const requires counts_subtrees<augment>;
+
+    /** Number of keys in [lower, upper), zero if upper is not greater than lower
+     */
+    size_t count_range(const tkey& lower, const tkey& upper) const requires counts_subtrees<augment>;
+
+    // endregion order statistics definition
+
+    // region join-based set operations definition
+
+    /** Appends the elements of greater, whose keys must all compare greater than the keys here, and leaves
+     *  greater empty. O(log n) for balanced trees. Throws std::logic_error if the key ranges overlap
+     */
+    void join(binary_search_tree&& greater);
+
+    /** Moves the elements with keys not less than key into greater, which is cleared first and takes this
+     *  tree's allocator. O(log n) relinking plus a size count that walks the smaller part only
+     */
+    void split(const tkey& key, binary_search_tree& greater);
+
+    /** Set operations on keys that consume other, each O(m log(n / m + 1)) for balanced trees of sizes
+     *  m <= n. Nodes of both trees are relinked rather than copied, and on equal keys the element here is
+     *  kept. Large inputs are processed by fork-join over the two halves of other
+     */
+    void set_union(binary_search_tree&& other);
+
+    void set_intersection(binary_search_tree&& other);
+
+    void set_difference(binary_search_tree&& other);
+
+    // endregion join-based set operations definition
+
 public:
 
     // region iterators requests definition
@@ -922,37 +1042,209 @@ protected:
 
     // endregion subtree rotations definition
 
+    // region traversal steps definition
+
+    /** Neighbours of a node in each traversal order, found through parent links; nullptr past either end.
+     *  A full pass crosses every edge at most twice, so steps are amortized O(1) and never allocate
+     */
+    static node* prefix_successor(node* current) noexcept;
+
+    static node* prefix_predecessor(node* current) noexcept;
+
+    static node* infix_successor(node* current) noexcept;
+
+    static node* infix_predecessor(node* current) noexcept;
+
+    static node* postfix_successor(node* current) noexcept;
+
+    static node* postfix_predecessor(node* current) noexcept;
+
+    /** First and last node of a subtree in the given order, nullptr for an empty subtree
+     */
+    static node* leftmost(node* subtree_root) noexcept;
+
+    static node* rightmost(node* subtree_root) noexcept;
+
+    static node* prefix_last(node* subtree_root) noexcept;
+
+    static node* postfix_first(node* subtree_root) noexcept;
+
+    // endregion traversal steps definition
+
+    // region search steps definition
+
+    /** Key lookups shared by the tkey and heterogeneous overloads, nullptr when there is no such node
+     */
+    template<typename key_type>
+    node* find_node(const key_type& key) const;
+
+    template<typename key_type>
+    node* lower_bound_node(const key_type& key) const;
+
+    template<typename key_type>
+    node* upper_bound_node(const key_type& key) const;
+
+    /** Links a node built from args under the place where key belongs; args are not touched if key is present
+     */
+    template<typename key_type, class ...Args>
+    std::pair<infix_iterator, bool> emplace_unique(const key_type& key, Args&&...args);
+
+    // endregion search steps definition
+
+    // region augmentation definition
+
+    /** Recomputes the augmentation of a node from its children; a no-op without an augmentation
+     */
+    static void update_augmentation(node* current) noexcept;
+
+    static void update_augmentation_to_root(node* current) noexcept;
+
+    static size_t subtree_size(node* subtree_root) noexcept requires counts_subtrees<augment>;
+
+    /** Number of keys in the tree less than key
+     */
+    template<typename key_type>
+    size_t count_less(const key_type& key) const requires counts_subtrees<augment>;
+
+    // endregion augmentation definition
+
+    // region bulk build definition
+
+    /** Sorts and deduplicates staged elements, then either inserts them one by one or merges them with the
+     *  nodes of the tree and relinks everything through link_balanced
+     */
+    void bulk_insert(std::vector<std::pair<tkey, tvalue>>& staged);
+
+    /** Links count nodes, already in key order, into a subtree of minimal height under parent. Nodes on
+     *  last_level are leaves; post_build gives each tree type the chance to set up its per-node data
+     */
+    node* link_balanced(node** nodes, size_t count, node* parent, size_t depth, size_t last_level);
+
+    // endregion bulk build definition
+
+    // region join-based set operations steps definition
+
+    /** Smaller input size below which set operations stay on the calling thread
+     */
+    static constexpr size_t parallel_threshold = 1 << 14;
+
+    /** Detached subtree with the rank its tree balances by: the height for AVL trees, 0 for a plain tree
+     */
+    struct ranked_subtree
+    {
+        node* root;
+        size_t rank;
+    };
+
+    /** Subtrees cut off by a set operation, chained through their parent links so dropping never allocates.
+     *  They are freed on the calling thread once the operation is done, allocators need not be thread-safe
+     */
+    struct dropped_subtrees
+    {
+        node* head = nullptr;
+        node* tail = nullptr;
+
+        void push(node* subtree_root) noexcept;
+
+        void splice(dropped_subtrees& other) noexcept;
+    };
+
+    ranked_subtree root_subtree() const noexcept;
+
+    static std::tuple<ranked_subtree, node*, ranked_subtree> expose(ranked_subtree tree) noexcept;
+
+    static ranked_subtree join_subtrees(ranked_subtree left, node* middle, ranked_subtree right) noexcept;
+
+    static ranked_subtree join_subtrees(ranked_subtree left, ranked_subtree right) noexcept;
+
+    static std::pair<ranked_subtree, node*> split_last(ranked_subtree tree) noexcept;
+
+    /** Parts with keys less and greater than key, and the node holding key, if any
+     */
+    std::tuple<ranked_subtree, node*, ranked_subtree> split_subtree(ranked_subtree tree, const tkey& key) const;
+
+    ranked_subtree unite(ranked_subtree lhs, ranked_subtree rhs, dropped_subtrees& dropped, size_t spawn_depth) const;
+
+    ranked_subtree intersect(ranked_subtree lhs, ranked_subtree rhs, dropped_subtrees& dropped, size_t spawn_depth) const;
+
+    ranked_subtree subtract(ranked_subtree lhs, ranked_subtree rhs, dropped_subtrees& dropped, size_t spawn_depth) const;
+
+    /** Runs both halves of a set operation, the left one on a new thread while spawn_depth allows it
+     */
+    template<typename left_task, typename right_task>
+    static std::pair<ranked_subtree, ranked_subtree> fork_join(left_task&& left, right_task&& right,
+                                                               dropped_subtrees& dropped, size_t spawn_depth);
+
+    /** Levels of fork-join recursion worth spawning threads for, given the size of the smaller input
+     */
+    static size_t spawn_depth_for(size_t smaller_size) noexcept;
+
+    /** Makes other's nodes deallocatable through this tree's allocator, rebuilding them if the two differ
+     */
+    void adopt_nodes(binary_search_tree& other);
+
+    /** Frees every dropped subtree and returns the number of nodes freed
+     */
+    size_t free_dropped(dropped_subtrees& dropped) noexcept;
+
+    template<typename operation>
+    void apply_set_operation(binary_search_tree& other, operation&& op);
+
+    // endregion join-based set operations steps definition
+
 };
 
 namespace __detail
 {
-    template<typename tkey, typename tvalue, typename compare, typename tag>
+    template<typename tkey, typename tvalue, typename compare, typename tag, typename augment>
     class bst_impl
     {
         template<class ...Args>
-        static binary_search_tree<tkey, tvalue, compare, tag>::node* create_node(binary_search_tree<tkey, tvalue, compare, tag>& cont, typename binary_search_tree<tkey, tvalue, compare, tag>::node* parent,
+        static binary_search_tree<tkey, tvalue, compare, tag, augment>::node* create_node(binary_search_tree<tkey, tvalue, compare, tag, augment>& cont, typename binary_search_tree<tkey, tvalue, compare, tag, augment>::node* parent,
                                                                                  Args&& ...args);
 
-        static void delete_node(binary_search_tree<tkey, tvalue, compare, tag>& cont, typename binary_search_tree<tkey, tvalue, compare, tag>::node*
+        static void delete_node(binary_search_tree<tkey, tvalue, compare, tag, augment>& cont, typename binary_search_tree<tkey, tvalue, compare, tag, augment>::node*
         node_to_delete);
 
-        //Does not invalidate node*, needed for splay tree
-        static void post_search(binary_search_tree<tkey, tvalue, compare, tag>::node**){}
+        //Lookup behind the non-const find and at, a splay tree restructures around the path it took
+        template<typename key_type>
+        static binary_search_tree<tkey, tvalue, compare, tag, augment>::node* search(binary_search_tree<tkey, tvalue, compare, tag, augment>& cont, const key_type& key)
+        {
+            return cont.find_node(key);
+        }
 
         //Does not invalidate node*
-        static void post_insert(binary_search_tree<tkey, tvalue, compare, tag>& cont, binary_search_tree<tkey, tvalue, compare, tag>::node**){}
+        static void post_insert(binary_search_tree<tkey, tvalue, compare, tag, augment>& cont, binary_search_tree<tkey, tvalue, compare, tag, augment>::node** node)
+        {
+            cont.update_augmentation_to_root((*node)->get_parent());
+        }
+
+        //Called children first for every node linked by a bulk build, subtree_size counts the node itself
+        static void post_build(binary_search_tree<tkey, tvalue, compare, tag, augment>&, binary_search_tree<tkey, tvalue, compare, tag, augment>::node*,
+                               size_t, bool){}
+
+        static void erase(binary_search_tree<tkey, tvalue, compare, tag, augment>& cont, binary_search_tree<tkey, tvalue, compare, tag, augment>::node**);
+
+        static void swap(binary_search_tree<tkey, tvalue, compare, tag, augment>& lhs, binary_search_tree<tkey, tvalue, compare, tag, augment>& rhs) noexcept;
 
-        static void erase(binary_search_tree<tkey, tvalue, compare, tag>& cont, binary_search_tree<tkey, tvalue, compare, tag>::node**);
+        //Rank a join balances by, a plain tree keeps none
+        static size_t subtree_rank(binary_search_tree<tkey, tvalue, compare, tag, augment>::node*) noexcept { return 0; }
 
-        static void swap(binary_search_tree<tkey, tvalue, compare, tag>& lhs, binary_search_tree<tkey, tvalue, compare, tag>& rhs) noexcept;
+        static size_t child_rank(binary_search_tree<tkey, tvalue, compare, tag, augment>::node*, size_t, bool) noexcept { return 0; }
+
+        //Links left < middle < right under middle, restoring balance; the result has no parent
+        static binary_search_tree<tkey, tvalue, compare, tag, augment>::ranked_subtree join(
+                binary_search_tree<tkey, tvalue, compare, tag, augment>::ranked_subtree left,
+                binary_search_tree<tkey, tvalue, compare, tag, augment>::node* middle,
+                binary_search_tree<tkey, tvalue, compare, tag, augment>::ranked_subtree right) noexcept;
     public:
-        friend class binary_search_tree<tkey, tvalue, compare, tag>;
+        friend class binary_search_tree<tkey, tvalue, compare, tag, augment>;
     };
 }
 
-template<typename tkey, typename tvalue, typename compare, typename tag>
-void __detail::bst_impl<tkey, tvalue, compare, tag>::swap(binary_search_tree<tkey, tvalue, compare, tag> &lhs,
-                                                          binary_search_tree<tkey, tvalue, compare, tag> &rhs) noexcept
+template<typename tkey, typename tvalue, typename compare, typename tag, typename augment>
+void __detail::bst_impl<tkey, tvalue, compare, tag, augment>::swap(binary_search_tree<tkey, tvalue, compare, tag, augment> &lhs,
+                                                          binary_search_tree<tkey, tvalue, compare, tag, augment> &rhs) noexcept
 {
 
     std::swap(lhs._root, rhs._root);
@@ -961,32 +1253,32 @@ void __detail::bst_impl<tkey, tvalue, compare, tag>::swap(binary_search_tree<tke
     std::swap(lhs._logger, rhs._logger);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
 template<input_iterator_for_pair<tkey, tvalue> iterator>
-binary_search_tree<tkey, tvalue, compare, tag>::binary_search_tree(iterator begin, iterator end, const compare &cmp,
-                                                                   pp_allocator<typename binary_search_tree<tkey, tvalue, compare, tag>::value_type> alloc, logger *logger)
+binary_search_tree<tkey, tvalue, compare, tag, augment>::binary_search_tree(iterator begin, iterator end, const compare &cmp,
+                                                                   pp_allocator<typename binary_search_tree<tkey, tvalue, compare, tag, augment>::value_type> alloc, logger *logger)
+        : compare(cmp),
+          _allocator(alloc),
+          _logger(logger),
+          _root(nullptr),
+          _size(0)
 {
-    _root = nullptr;
-    _size = 0;
-    _allocator = alloc;
-    _logger = logger;
-    for (auto it = begin; it != end; ++it) {
-        insert(it->first, it->second, cmp);
-    }
+    insert(begin, end);
 }
 
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-bool binary_search_tree<tkey, tvalue, compare, tag>::compare_pairs(const binary_search_tree::value_type &lhs,
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+bool binary_search_tree<tkey, tvalue, compare, tag, augment>::compare_pairs(const binary_search_tree::value_type &lhs,
                                                                    const binary_search_tree::value_type &rhs) const
 {
     return compare()(lhs.first, rhs.first);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-bool binary_search_tree<tkey, tvalue, compare, tag>::compare_keys(const tkey &lhs, const tkey &rhs) const
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+template<typename lhs_key, typename rhs_key>
+bool binary_search_tree<tkey, tvalue, compare, tag, augment>::compare_keys(const lhs_key &lhs, const rhs_key &rhs) const
 {
-    return compare()(lhs, rhs);
+    return static_cast<const compare&>(*this)(lhs, rhs);
 }
 
 //конструктор с использованием итераторов
@@ -1010,246 +1302,962 @@ binary_search_tree(std::initializer_list<std::pair<tkey, tvalue>> data, const co
 
 // region node implementation
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
 template<class ...Args>
-binary_search_tree<tkey, tvalue, compare, tag>::node::node(node* parent, Args&& ...args)
+binary_search_tree<tkey, tvalue, compare, tag, augment>::node::node(node* parent, Args&& ...args)
+        : data(std::forward<Args>(args)...),
+          _parent_and_tag(reinterpret_cast<std::uintptr_t>(parent)),
+          left_subtree(nullptr),
+          right_subtree(nullptr)
 {
-    this->parent = parent;
-    this->left_subtree = nullptr;
-    this->right_subtree = nullptr;
-    new (&data) value_type(std::forward<Args>(args)...);
 }
 
-// endregion node implementation
-
-// region prefix_iterator implementation
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::node*
+binary_search_tree<tkey, tvalue, compare, tag, augment>::node::get_parent() const noexcept
+{
+    return reinterpret_cast<node*>(_parent_and_tag & ~std::uintptr_t(tag_mask));
+}
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-binary_search_tree<tkey, tvalue, compare, tag>::prefix_iterator::prefix_iterator(node* data)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+void binary_search_tree<tkey, tvalue, compare, tag, augment>::node::set_parent(node* parent) noexcept
 {
-    _data = data;
-    _backup = nullptr;
+    _parent_and_tag = reinterpret_cast<std::uintptr_t>(parent) | (_parent_and_tag & tag_mask);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-bool binary_search_tree<tkey, tvalue, compare, tag>::prefix_iterator::operator==(
-        prefix_iterator const &other) const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+unsigned char binary_search_tree<tkey, tvalue, compare, tag, augment>::node::get_tag() const noexcept
 {
-    return _data == other._data;
+    return static_cast<unsigned char>(_parent_and_tag & tag_mask);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-bool binary_search_tree<tkey, tvalue, compare, tag>::prefix_iterator::operator!=(
-        prefix_iterator const &other) const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+void binary_search_tree<tkey, tvalue, compare, tag, augment>::node::set_tag(unsigned char bits) noexcept
 {
-    return !(*this == other);
+    _parent_and_tag = (_parent_and_tag & ~std::uintptr_t(tag_mask)) | (bits & tag_mask);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::prefix_iterator &
-binary_search_tree<tkey, tvalue, compare, tag>::prefix_iterator::operator++() & noexcept
+// endregion node implementation
+
+// region traversal steps implementation
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::node*
+binary_search_tree<tkey, tvalue, compare, tag, augment>::leftmost(node* subtree_root) noexcept
 {
-    if (!_data)
+    while (subtree_root && subtree_root->left_subtree)
     {
-        return *this;
-    }
-    _backup = _data;
-    if (_data->left_subtree)
-    {
-        _data = _data->left_subtree;
-        return *this;
+        subtree_root = subtree_root->left_subtree;
     }
-    if (_data->right_subtree)
+    return subtree_root;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::node*
+binary_search_tree<tkey, tvalue, compare, tag, augment>::rightmost(node* subtree_root) noexcept
+{
+    while (subtree_root && subtree_root->right_subtree)
     {
-        _data = _data->right_subtree;
-        return *this;
+        subtree_root = subtree_root->right_subtree;
     }
-    node *parent = _data->parent;
-    while (parent)
+    return subtree_root;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::node*
+binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_last(node* subtree_root) noexcept
+{
+    while (subtree_root && (subtree_root->left_subtree || subtree_root->right_subtree))
     {
-        if (parent->left_subtree == _data && parent->right_subtree)
-        {
-            _data = parent->right_subtree;
-            return *this;
-        }
-        _data = parent;
-        parent = parent->parent;
+        subtree_root = subtree_root->right_subtree ? subtree_root->right_subtree : subtree_root->left_subtree;
     }
-    _data = nullptr;
-    return *this;
+    return subtree_root;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::prefix_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::prefix_iterator::operator++(int not_used) noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::node*
+binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_first(node* subtree_root) noexcept
 {
-    prefix_iterator temp = *this;
-    ++(*this);
-    return temp;
+    while (subtree_root && (subtree_root->left_subtree || subtree_root->right_subtree))
+    {
+        subtree_root = subtree_root->left_subtree ? subtree_root->left_subtree : subtree_root->right_subtree;
+    }
+    return subtree_root;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::prefix_iterator &
-binary_search_tree<tkey, tvalue, compare, tag>::prefix_iterator::operator--() & noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::node*
+binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_successor(node* current) noexcept
 {
-    if (!_data && _backup)
+    if (current->left_subtree)
     {
-        _data = _backup;
-        return *this;
+        return current->left_subtree;
     }
-    using bst_t = binary_search_tree<tkey, tvalue, compare, tag>;
-    using node = typename bst_t::node;
-    node* root = _data;
-    while (root->parent)
+    if (current->right_subtree)
     {
-        root = root->parent;
+        return current->right_subtree;
     }
-    node* prev = nullptr;
-    node* current = root;
-    std::stack<node*> stack;
-    if (current) stack.push(current);
-
-    while (!stack.empty()) {
-        current = stack.top();
-        stack.pop();
-
-        if (current == _data)
-        {
-            break;
-        }
-        prev = current;
 
-        if (current->right_subtree)
-            stack.push(current->right_subtree);
-        if (current->left_subtree)
-            stack.push(current->left_subtree);
+    // climb to the nearest ancestor whose right subtree is still unvisited
+    node* parent = current->get_parent();
+    while (parent && (parent->right_subtree == current || !parent->right_subtree))
+    {
+        current = parent;
+        parent = parent->get_parent();
     }
-
-    _backup = _data;
-    _data = prev;
-    return *this;
-}
-
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::prefix_iterator const
-binary_search_tree<tkey, tvalue, compare, tag>::prefix_iterator::operator--(int not_used) const noexcept
-{
-    prefix_iterator temp = *this;
-    --(*this);
-    return temp;
+    return parent ? parent->right_subtree : nullptr;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::prefix_iterator::reference
-binary_search_tree<tkey, tvalue, compare, tag>::prefix_iterator::operator*()
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::node*
+binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_predecessor(node* current) noexcept
 {
-    if (!_data)
+    node* parent = current->get_parent();
+    if (!parent || parent->left_subtree == current || !parent->left_subtree)
     {
-        throw std::out_of_range("Prefix_iterator::operator*(): points to end");
+        return parent;
     }
-    return *_data;
+    return prefix_last(parent->left_subtree);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::prefix_iterator::pointer
-binary_search_tree<tkey, tvalue, compare, tag>::prefix_iterator::operator->() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::node*
+binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_successor(node* current) noexcept
 {
-    return &(_data->data);
-}
+    if (current->right_subtree)
+    {
+        return leftmost(current->right_subtree);
+    }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-size_t binary_search_tree<tkey, tvalue, compare, tag>::prefix_iterator::depth() const noexcept
-{
-    size_t depth = 0;
-    node* n = _data ? _data : _backup;
-    while (n && n->parent)
+    node* parent = current->get_parent();
+    while (parent && parent->right_subtree == current)
     {
-        ++depth;
-        n = n->parent;
+        current = parent;
+        parent = parent->get_parent();
     }
-    return depth;
+    return parent;
 }
 
-// endregion prefix_iterator implementation
-
-// region prefix_const_iterator implementation
-
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-binary_search_tree<tkey, tvalue, compare, tag>::prefix_const_iterator::prefix_const_iterator(const node* data)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::node*
+binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_predecessor(node* current) noexcept
 {
-    _base = prefix_iterator(const_cast<typename binary_search_tree<tkey, tvalue, compare, tag>::node*>(data));
-}
+    if (current->left_subtree)
+    {
+        return rightmost(current->left_subtree);
+    }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-binary_search_tree<tkey, tvalue, compare, tag>::prefix_const_iterator::prefix_const_iterator(const prefix_iterator& other) noexcept
-{
-    _base = other;
+    node* parent = current->get_parent();
+    while (parent && parent->left_subtree == current)
+    {
+        current = parent;
+        parent = parent->get_parent();
+    }
+    return parent;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-bool binary_search_tree<tkey, tvalue, compare, tag>::prefix_const_iterator::operator==(
-        prefix_iterator const &other) const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::node*
+binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_successor(node* current) noexcept
 {
-    return _base == other;
+    node* parent = current->get_parent();
+    if (!parent || parent->right_subtree == current || !parent->right_subtree)
+    {
+        return parent;
+    }
+    return postfix_first(parent->right_subtree);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-bool binary_search_tree<tkey, tvalue, compare, tag>::prefix_const_iterator::operator!=(
-        prefix_iterator const &other) const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::node*
+binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_predecessor(node* current) noexcept
 {
-    return !(*this == other);
-}
+    if (current->right_subtree)
+    {
+        return current->right_subtree;
+    }
+    if (current->left_subtree)
+    {
+        return current->left_subtree;
+    }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::prefix_const_iterator &
-binary_search_tree<tkey, tvalue, compare, tag>::prefix_const_iterator::operator++() & noexcept
-{
-    ++_base;
-    return *this;
+    // climb to the nearest ancestor whose left subtree is still unvisited
+    node* parent = current->get_parent();
+    while (parent && (parent->left_subtree == current || !parent->left_subtree))
+    {
+        current = parent;
+        parent = parent->get_parent();
+    }
+    return parent ? parent->left_subtree : nullptr;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::prefix_const_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::prefix_const_iterator::operator++(int not_used) noexcept
-{
-    prefix_const_iterator temp = *this;
-    ++(*this);
-    return temp;
-}
+// endregion traversal steps implementation
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::prefix_const_iterator &
-binary_search_tree<tkey, tvalue, compare, tag>::prefix_const_iterator::operator--() & noexcept
-{
-    --_base;
-    return *this;
-}
+// region search steps implementation
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::prefix_const_iterator const
-binary_search_tree<tkey, tvalue, compare, tag>::prefix_const_iterator::operator--(int not_used) const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+template<typename key_type>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::node*
+binary_search_tree<tkey, tvalue, compare, tag, augment>::find_node(const key_type& key) const
 {
-    prefix_const_iterator temp = *this;
-    --(*this);
-    return temp;
+    node* current = _root;
+    while (current)
+    {
+        if (compare_keys(key, current->data.first))
+        {
+            current = current->left_subtree;
+        }
+        else if (compare_keys(current->data.first, key))
+        {
+            current = current->right_subtree;
+        }
+        else
+        {
+            return current;
+        }
+    }
+    return nullptr;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::prefix_const_iterator::reference
-binary_search_tree<tkey, tvalue, compare, tag>::prefix_const_iterator::operator*()
+//node->key >= key
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+template<typename key_type>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::node*
+binary_search_tree<tkey, tvalue, compare, tag, augment>::lower_bound_node(const key_type& key) const
 {
-    return *_base;
-}
+    node* current = _root;
+    node* result = nullptr;
+    while (current)
+    {
+        if (!compare_keys(current->data.first, key))
+        {
+            result = current;
+            current = current->left_subtree;
+        }
+        else
+        {
+            current = current->right_subtree;
+        }
+    }
+    return result;
+}
+
+//node->key > key
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+template<typename key_type>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::node*
+binary_search_tree<tkey, tvalue, compare, tag, augment>::upper_bound_node(const key_type& key) const
+{
+    node* current = _root;
+    node* result = nullptr;
+    while (current)
+    {
+        if (compare_keys(key, current->data.first))
+        {
+            result = current;
+            current = current->left_subtree;
+        }
+        else
+        {
+            current = current->right_subtree;
+        }
+    }
+    return result;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+template<typename key_type, class ...Args>
+std::pair<typename binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_iterator, bool>
+binary_search_tree<tkey, tvalue, compare, tag, augment>::emplace_unique(const key_type& key, Args&&... args)
+{
+    node** current = &_root;
+    node* parent = nullptr;
+
+    while (*current)
+    {
+        parent = *current;
+        if (compare_keys(key, (*current)->data.first))
+        {
+            current = &(*current)->left_subtree;
+        }
+        else if (compare_keys((*current)->data.first, key))
+        {
+            current = &(*current)->right_subtree;
+        }
+        else
+        {
+            return { infix_iterator(*current), false };
+        }
+    }
+
+    node* new_node = __detail::bst_impl<tkey, tvalue, compare, tag, augment>::create_node(*this, parent, std::forward<Args>(args)...);
+
+    *current = new_node;
+    ++_size;
+
+    // Вызов post_insert для балансировки
+    __detail::bst_impl<tkey, tvalue, compare, tag, augment>::post_insert(*this, current);
+
+    return { infix_iterator(new_node), true };
+}
+
+// endregion search steps implementation
+
+// region augmentation implementation
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+void binary_search_tree<tkey, tvalue, compare, tag, augment>::update_augmentation(node* current) noexcept
+{
+    if constexpr (counts_subtrees<augment>)
+    {
+        current->subtree_size = 1 + subtree_size(current->left_subtree) + subtree_size(current->right_subtree);
+    }
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+void binary_search_tree<tkey, tvalue, compare, tag, augment>::update_augmentation_to_root(node* current) noexcept
+{
+    if constexpr (!std::is_empty_v<typename augment::node_data>)
+    {
+        for (; current; current = current->get_parent())
+        {
+            update_augmentation(current);
+        }
+    }
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+size_t binary_search_tree<tkey, tvalue, compare, tag, augment>::subtree_size(node* subtree_root) noexcept
+    requires counts_subtrees<augment>
+{
+    return subtree_root ? subtree_root->subtree_size : 0;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+template<typename key_type>
+size_t binary_search_tree<tkey, tvalue, compare, tag, augment>::count_less(const key_type& key) const
+    requires counts_subtrees<augment>
+{
+    size_t less = 0;
+    node* current = _root;
+    while (current)
+    {
+        if (compare_keys(current->data.first, key))
+        {
+            less += 1 + subtree_size(current->left_subtree);
+            current = current->right_subtree;
+        }
+        else
+        {
+            current = current->left_subtree;
+        }
+    }
+    return less;
+}
+
+// endregion augmentation implementation
+
+// region bulk build implementation
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+void binary_search_tree<tkey, tvalue, compare, tag, augment>::bulk_insert(std::vector<std::pair<tkey, tvalue>>& staged)
+{
+    auto less = [this](auto const& lhs, auto const& rhs) { return compare_keys(lhs.first, rhs.first); };
+    if (!std::is_sorted(staged.begin(), staged.end(), less))
+    {
+        std::stable_sort(staged.begin(), staged.end(), less);
+    }
+    // keeps the first of equal keys, as inserting one by one would
+    staged.erase(std::unique(staged.begin(), staged.end(),
+                             [this](auto const& kept, auto const& next) { return !compare_keys(kept.first, next.first); }),
+                 staged.end());
+
+    if (staged.empty())
+    {
+        return;
+    }
+
+    // relinking costs O(size() + staged), descending costs O(staged * height)
+    if (_size != 0 && staged.size() * std::bit_width(_size) < _size)
+    {
+        for (auto& element : staged)
+        {
+            emplace(std::move(element.first), std::move(element.second));
+        }
+        return;
+    }
+
+    std::vector<node*> nodes;
+    nodes.reserve(_size + staged.size());
+    node* existing = leftmost(_root);
+
+    try
+    {
+        for (auto& element : staged)
+        {
+            while (existing && compare_keys(existing->data.first, element.first))
+            {
+                nodes.push_back(existing);
+                existing = infix_successor(existing);
+            }
+
+            if (existing && !compare_keys(element.first, existing->data.first))
+            {
+                continue;
+            }
+
+            nodes.push_back(__detail::bst_impl<tkey, tvalue, compare, tag, augment>::create_node(*this, nullptr,
+                                                                                         std::move(element.first),
+                                                                                         std::move(element.second)));
+        }
+    }
+    catch (...)
+    {
+        // the nodes built so far still go in, so nothing leaks and the tree stays valid
+        for (; existing; existing = infix_successor(existing))
+        {
+            nodes.push_back(existing);
+        }
+        _size = nodes.size();
+        _root = link_balanced(nodes.data(), nodes.size(), nullptr, 0, std::bit_width(nodes.size()) - 1);
+        throw;
+    }
+
+    for (; existing; existing = infix_successor(existing))
+    {
+        nodes.push_back(existing);
+    }
+
+    _size = nodes.size();
+    _root = link_balanced(nodes.data(), nodes.size(), nullptr, 0, std::bit_width(nodes.size()) - 1);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::node*
+binary_search_tree<tkey, tvalue, compare, tag, augment>::link_balanced(node** nodes, size_t count, node* parent, size_t depth, size_t last_level)
+{
+    if (count == 0)
+    {
+        return nullptr;
+    }
+
+    // halves differ by at most one node, so a subtree of count nodes is bit_width(count) high
+    size_t middle = count / 2;
+    node* subtree_root = nodes[middle];
+    subtree_root->set_parent(parent);
+    subtree_root->left_subtree = link_balanced(nodes, middle, subtree_root, depth + 1, last_level);
+    subtree_root->right_subtree = link_balanced(nodes + middle + 1, count - middle - 1, subtree_root, depth + 1, last_level);
+
+    update_augmentation(subtree_root);
+    __detail::bst_impl<tkey, tvalue, compare, tag, augment>::post_build(*this, subtree_root, count, depth == last_level);
+
+    return subtree_root;
+}
+
+// endregion bulk build implementation
+
+// region join-based set operations steps implementation
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+void binary_search_tree<tkey, tvalue, compare, tag, augment>::dropped_subtrees::push(node* subtree_root) noexcept
+{
+    if (subtree_root == nullptr)
+    {
+        return;
+    }
+
+    subtree_root->set_parent(nullptr);
+    if (tail)
+    {
+        tail->set_parent(subtree_root);
+    }
+    else
+    {
+        head = subtree_root;
+    }
+    tail = subtree_root;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+void binary_search_tree<tkey, tvalue, compare, tag, augment>::dropped_subtrees::splice(dropped_subtrees& other) noexcept
+{
+    if (other.head == nullptr)
+    {
+        return;
+    }
+
+    if (tail)
+    {
+        tail->set_parent(other.head);
+    }
+    else
+    {
+        head = other.head;
+    }
+    tail = other.tail;
+    other.head = other.tail = nullptr;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::ranked_subtree
+binary_search_tree<tkey, tvalue, compare, tag, augment>::root_subtree() const noexcept
+{
+    return { _root, __detail::bst_impl<tkey, tvalue, compare, tag, augment>::subtree_rank(_root) };
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+std::tuple<typename binary_search_tree<tkey, tvalue, compare, tag, augment>::ranked_subtree,
+           typename binary_search_tree<tkey, tvalue, compare, tag, augment>::node*,
+           typename binary_search_tree<tkey, tvalue, compare, tag, augment>::ranked_subtree>
+binary_search_tree<tkey, tvalue, compare, tag, augment>::expose(ranked_subtree tree) noexcept
+{
+    using impl = __detail::bst_impl<tkey, tvalue, compare, tag, augment>;
+    node* middle = tree.root;
+    return { { middle->left_subtree, impl::child_rank(middle, tree.rank, false) },
+             middle,
+             { middle->right_subtree, impl::child_rank(middle, tree.rank, true) } };
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::ranked_subtree
+binary_search_tree<tkey, tvalue, compare, tag, augment>::join_subtrees(ranked_subtree left, node* middle, ranked_subtree right) noexcept
+{
+    return __detail::bst_impl<tkey, tvalue, compare, tag, augment>::join(left, middle, right);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::ranked_subtree
+binary_search_tree<tkey, tvalue, compare, tag, augment>::join_subtrees(ranked_subtree left, ranked_subtree right) noexcept
+{
+    if (left.root == nullptr)
+    {
+        return right;
+    }
+
+    auto [rest, last] = split_last(left);
+    return join_subtrees(rest, last, right);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+std::pair<typename binary_search_tree<tkey, tvalue, compare, tag, augment>::ranked_subtree,
+          typename binary_search_tree<tkey, tvalue, compare, tag, augment>::node*>
+binary_search_tree<tkey, tvalue, compare, tag, augment>::split_last(ranked_subtree tree) noexcept
+{
+    auto [left, middle, right] = expose(tree);
+    if (right.root == nullptr)
+    {
+        return { left, middle };
+    }
+
+    auto [rest, last] = split_last(right);
+    return { join_subtrees(left, middle, rest), last };
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+std::tuple<typename binary_search_tree<tkey, tvalue, compare, tag, augment>::ranked_subtree,
+           typename binary_search_tree<tkey, tvalue, compare, tag, augment>::node*,
+           typename binary_search_tree<tkey, tvalue, compare, tag, augment>::ranked_subtree>
+binary_search_tree<tkey, tvalue, compare, tag, augment>::split_subtree(ranked_subtree tree, const tkey& key) const
+{
+    if (tree.root == nullptr)
+    {
+        return { tree, nullptr, tree };
+    }
+
+    auto [left, middle, right] = expose(tree);
+    if (compare_keys(key, middle->data.first))
+    {
+        auto [less, found, greater] = split_subtree(left, key);
+        return { less, found, join_subtrees(greater, middle, right) };
+    }
+    if (compare_keys(middle->data.first, key))
+    {
+        auto [less, found, greater] = split_subtree(right, key);
+        return { join_subtrees(left, middle, less), found, greater };
+    }
+
+    return { left, middle, right };
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::ranked_subtree
+binary_search_tree<tkey, tvalue, compare, tag, augment>::unite(ranked_subtree lhs, ranked_subtree rhs, dropped_subtrees& dropped, size_t spawn_depth) const
+{
+    if (lhs.root == nullptr)
+    {
+        return rhs;
+    }
+    if (rhs.root == nullptr)
+    {
+        return lhs;
+    }
+
+    auto [rhs_left, middle, rhs_right] = expose(rhs);
+    auto [lhs_left, found, lhs_right] = split_subtree(lhs, middle->data.first);
+    if (found)
+    {
+        middle->left_subtree = middle->right_subtree = nullptr;
+        dropped.push(std::exchange(middle, found));
+    }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::prefix_const_iterator::pointer
-binary_search_tree<tkey, tvalue, compare, tag>::prefix_const_iterator::operator->() noexcept
+    auto [left, right] = fork_join(
+            [&, lhs_left, rhs_left](dropped_subtrees& out, size_t depth) { return unite(lhs_left, rhs_left, out, depth); },
+            [&, lhs_right, rhs_right](dropped_subtrees& out, size_t depth) { return unite(lhs_right, rhs_right, out, depth); },
+            dropped, spawn_depth);
+
+    return join_subtrees(left, middle, right);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::ranked_subtree
+binary_search_tree<tkey, tvalue, compare, tag, augment>::intersect(ranked_subtree lhs, ranked_subtree rhs, dropped_subtrees& dropped, size_t spawn_depth) const
+{
+    if (lhs.root == nullptr || rhs.root == nullptr)
+    {
+        dropped.push(lhs.root);
+        dropped.push(rhs.root);
+        return { nullptr, 0 };
+    }
+
+    auto [rhs_left, middle, rhs_right] = expose(rhs);
+    auto [lhs_left, found, lhs_right] = split_subtree(lhs, middle->data.first);
+    middle->left_subtree = middle->right_subtree = nullptr;
+    dropped.push(middle);
+
+    auto [left, right] = fork_join(
+            [&, lhs_left, rhs_left](dropped_subtrees& out, size_t depth) { return intersect(lhs_left, rhs_left, out, depth); },
+            [&, lhs_right, rhs_right](dropped_subtrees& out, size_t depth) { return intersect(lhs_right, rhs_right, out, depth); },
+            dropped, spawn_depth);
+
+    return found ? join_subtrees(left, found, right) : join_subtrees(left, right);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::ranked_subtree
+binary_search_tree<tkey, tvalue, compare, tag, augment>::subtract(ranked_subtree lhs, ranked_subtree rhs, dropped_subtrees& dropped, size_t spawn_depth) const
+{
+    if (lhs.root == nullptr || rhs.root == nullptr)
+    {
+        dropped.push(rhs.root);
+        return lhs;
+    }
+
+    auto [rhs_left, middle, rhs_right] = expose(rhs);
+    auto [lhs_left, found, lhs_right] = split_subtree(lhs, middle->data.first);
+    middle->left_subtree = middle->right_subtree = nullptr;
+    dropped.push(middle);
+    if (found)
+    {
+        found->left_subtree = found->right_subtree = nullptr;
+        dropped.push(found);
+    }
+
+    auto [left, right] = fork_join(
+            [&, lhs_left, rhs_left](dropped_subtrees& out, size_t depth) { return subtract(lhs_left, rhs_left, out, depth); },
+            [&, lhs_right, rhs_right](dropped_subtrees& out, size_t depth) { return subtract(lhs_right, rhs_right, out, depth); },
+            dropped, spawn_depth);
+
+    return join_subtrees(left, right);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+template<typename left_task, typename right_task>
+std::pair<typename binary_search_tree<tkey, tvalue, compare, tag, augment>::ranked_subtree,
+          typename binary_search_tree<tkey, tvalue, compare, tag, augment>::ranked_subtree>
+binary_search_tree<tkey, tvalue, compare, tag, augment>::fork_join(left_task&& left, right_task&& right,
+                                                          dropped_subtrees& dropped, size_t spawn_depth)
+{
+    if (spawn_depth == 0)
+    {
+        ranked_subtree left_result = left(dropped, 0);
+        return { left_result, right(dropped, 0) };
+    }
+
+    // the two halves share no nodes, only the dropped lists have to be kept apart
+    dropped_subtrees left_dropped;
+    std::future<ranked_subtree> left_result;
+    try
+    {
+        left_result = std::async(std::launch::async, [&] { return left(left_dropped, spawn_depth - 1); });
+    }
+    catch (const std::system_error&)
+    {
+        ranked_subtree inline_result = left(dropped, spawn_depth - 1);
+        return { inline_result, right(dropped, spawn_depth - 1) };
+    }
+
+    ranked_subtree right_result = right(dropped, spawn_depth - 1);
+    ranked_subtree joined_left = left_result.get();
+    dropped.splice(left_dropped);
+    return { joined_left, right_result };
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+size_t binary_search_tree<tkey, tvalue, compare, tag, augment>::spawn_depth_for(size_t smaller_size) noexcept
+{
+    // each level halves the work and doubles the threads, enough levels to give every core two tasks
+    size_t threads = std::thread::hardware_concurrency();
+    if (threads < 2)
+    {
+        return 0;
+    }
+    return std::min<size_t>(std::bit_width(threads) + 1, std::bit_width(smaller_size / parallel_threshold));
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+void binary_search_tree<tkey, tvalue, compare, tag, augment>::adopt_nodes(binary_search_tree& other)
+{
+    if (_allocator == other._allocator || other._root == nullptr)
+    {
+        return;
+    }
+
+    std::vector<std::pair<tkey, tvalue>> staged;
+    staged.reserve(other._size);
+    for (node* current = leftmost(other._root); current; current = infix_successor(current))
+    {
+        staged.emplace_back(current->data.first, std::move(current->data.second));
+    }
+
+    binary_search_tree rehomed(static_cast<const compare&>(*this), _allocator, _logger);
+    rehomed.bulk_insert(staged);
+    other.clear();
+    other._root = std::exchange(rehomed._root, nullptr);
+    other._size = std::exchange(rehomed._size, 0);
+    other._allocator = _allocator;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+size_t binary_search_tree<tkey, tvalue, compare, tag, augment>::free_dropped(dropped_subtrees& dropped) noexcept
+{
+    size_t freed = 0;
+    while (dropped.head)
+    {
+        node* subtree_root = dropped.head;
+        dropped.head = subtree_root->get_parent();
+        subtree_root->set_parent(nullptr);
+
+        for (node* current = postfix_first(subtree_root); current; ++freed)
+        {
+            node* next = postfix_successor(current);
+            __detail::bst_impl<tkey, tvalue, compare, tag, augment>::delete_node(*this, current);
+            current = next;
+        }
+    }
+    dropped.tail = nullptr;
+    return freed;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+template<typename operation>
+void binary_search_tree<tkey, tvalue, compare, tag, augment>::apply_set_operation(binary_search_tree& other, operation&& op)
+{
+    if (this == &other)
+    {
+        throw std::logic_error("A tree cannot be combined with itself");
+    }
+
+    adopt_nodes(other);
+
+    size_t total = _size + other._size;
+    dropped_subtrees dropped;
+    ranked_subtree result = op(root_subtree(), other.root_subtree(), dropped, spawn_depth_for(std::min(_size, other._size)));
+
+    other._root = nullptr;
+    other._size = 0;
+    _root = result.root;
+    if (_root)
+    {
+        _root->set_parent(nullptr);
+    }
+    _size = total - free_dropped(dropped);
+}
+
+// endregion join-based set operations steps implementation
+
+// region prefix_iterator implementation
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_iterator::prefix_iterator(node* data)
+{
+    _data = data;
+    _backup = nullptr;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+bool binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_iterator::operator==(
+        prefix_iterator const &other) const noexcept
+{
+    return _data == other._data;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+bool binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_iterator::operator!=(
+        prefix_iterator const &other) const noexcept
+{
+    return !(*this == other);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_iterator &
+binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_iterator::operator++() & noexcept
+{
+    if (!_data)
+    {
+        return *this;
+    }
+    node* next = prefix_successor(_data);
+    if (!next)
+    {
+        _backup = _data;
+    }
+    _data = next;
+    return *this;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_iterator
+binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_iterator::operator++(int not_used) noexcept
+{
+    prefix_iterator temp = *this;
+    ++(*this);
+    return temp;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_iterator &
+binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_iterator::operator--() & noexcept
+{
+    if (!_data)
+    {
+        // only end remembers its neighbour, before_begin stays where it is
+        _data = std::exchange(_backup, nullptr);
+        return *this;
+    }
+    _data = prefix_predecessor(_data);
+    return *this;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_iterator const
+binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_iterator::operator--(int not_used) const noexcept
+{
+    prefix_iterator temp = *this;
+    --(*this);
+    return temp;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_iterator::reference
+binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_iterator::operator*()
+{
+    if (!_data)
+    {
+        throw std::out_of_range("Prefix_iterator::operator*(): points to end");
+    }
+    return _data->data;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_iterator::pointer
+binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_iterator::operator->() noexcept
+{
+    return &(_data->data);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+size_t binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_iterator::depth() const noexcept
+{
+    size_t depth = 0;
+    node* n = _data ? _data : _backup;
+    while (n && n->get_parent())
+    {
+        ++depth;
+        n = n->get_parent();
+    }
+    return depth;
+}
+
+// endregion prefix_iterator implementation
+
+// region prefix_const_iterator implementation
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_const_iterator::prefix_const_iterator(const node* data)
+{
+    _base = prefix_iterator(const_cast<typename binary_search_tree<tkey, tvalue, compare, tag, augment>::node*>(data));
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_const_iterator::prefix_const_iterator(const prefix_iterator& other) noexcept
+{
+    _base = other;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+bool binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_const_iterator::operator==(
+        prefix_const_iterator const &other) const noexcept
+{
+    return _base == other._base;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+bool binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_const_iterator::operator!=(
+        prefix_const_iterator const &other) const noexcept
+{
+    return !(*this == other);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_const_iterator &
+binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_const_iterator::operator++() & noexcept
+{
+    ++_base;
+    return *this;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_const_iterator
+binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_const_iterator::operator++(int not_used) noexcept
+{
+    prefix_const_iterator temp = *this;
+    ++(*this);
+    return temp;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_const_iterator &
+binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_const_iterator::operator--() & noexcept
+{
+    --_base;
+    return *this;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_const_iterator const
+binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_const_iterator::operator--(int not_used) const noexcept
+{
+    prefix_const_iterator temp = *this;
+    --(*this);
+    return temp;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_const_iterator::reference
+binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_const_iterator::operator*()
+{
+    return *_base;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_const_iterator::pointer
+binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_const_iterator::operator->() noexcept
 {
     return _base.operator->();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-size_t binary_search_tree<tkey, tvalue, compare, tag>::prefix_const_iterator::depth() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+size_t binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_const_iterator::depth() const noexcept
 {
     return _base.depth();
 }
@@ -1258,93 +2266,93 @@ size_t binary_search_tree<tkey, tvalue, compare, tag>::prefix_const_iterator::de
 
 // region prefix_reverse_iterator implementation
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-binary_search_tree<tkey, tvalue, compare, tag>::prefix_reverse_iterator::prefix_reverse_iterator(node* data)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_reverse_iterator::prefix_reverse_iterator(node* data)
 {
     _base = prefix_iterator(data);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-binary_search_tree<tkey, tvalue, compare, tag>::prefix_reverse_iterator::prefix_reverse_iterator(const prefix_iterator& it) noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_reverse_iterator::prefix_reverse_iterator(const prefix_iterator& it) noexcept
 {
     _base = it;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-binary_search_tree<tkey, tvalue, compare, tag>::prefix_reverse_iterator::operator binary_search_tree<tkey, tvalue, compare, tag>::prefix_iterator() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_reverse_iterator::operator binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_iterator() const noexcept
 {
     return _base;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::prefix_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::prefix_reverse_iterator::base() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_iterator
+binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_reverse_iterator::base() const noexcept
 {
     return _base;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-bool binary_search_tree<tkey, tvalue, compare, tag>::prefix_reverse_iterator::operator==(prefix_reverse_iterator const &other) const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+bool binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_reverse_iterator::operator==(prefix_reverse_iterator const &other) const noexcept
 {
     return _base == other._base;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-bool binary_search_tree<tkey, tvalue, compare, tag>::prefix_reverse_iterator::operator!=(prefix_reverse_iterator const &other) const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+bool binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_reverse_iterator::operator!=(prefix_reverse_iterator const &other) const noexcept
 {
     return !(*this == other);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::prefix_reverse_iterator &
-binary_search_tree<tkey, tvalue, compare, tag>::prefix_reverse_iterator::operator++() & noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_reverse_iterator &
+binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_reverse_iterator::operator++() & noexcept
 {
     --_base;
     return *this;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::prefix_reverse_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::prefix_reverse_iterator::operator++(int not_used) noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_reverse_iterator
+binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_reverse_iterator::operator++(int not_used) noexcept
 {
     prefix_reverse_iterator temp = *this;
     ++(*this);
     return temp;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::prefix_reverse_iterator &
-binary_search_tree<tkey, tvalue, compare, tag>::prefix_reverse_iterator::operator--() & noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_reverse_iterator &
+binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_reverse_iterator::operator--() & noexcept
 {
     ++_base;
     return *this;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::prefix_reverse_iterator const
-binary_search_tree<tkey, tvalue, compare, tag>::prefix_reverse_iterator::operator--(int not_used) const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_reverse_iterator const
+binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_reverse_iterator::operator--(int not_used) const noexcept
 {
     prefix_reverse_iterator temp = *this;
     --(*this);
     return temp;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::prefix_reverse_iterator::reference
-binary_search_tree<tkey, tvalue, compare, tag>::prefix_reverse_iterator::operator*()
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_reverse_iterator::reference
+binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_reverse_iterator::operator*()
 {
     return *_base;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::prefix_reverse_iterator::pointer
-binary_search_tree<tkey, tvalue, compare, tag>::prefix_reverse_iterator::operator->() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_reverse_iterator::pointer
+binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_reverse_iterator::operator->() noexcept
 {
     return _base.operator->();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-size_t binary_search_tree<tkey, tvalue, compare, tag>::prefix_reverse_iterator::depth() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+size_t binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_reverse_iterator::depth() const noexcept
 {
     return _base.depth();
 }
@@ -1353,54 +2361,54 @@ size_t binary_search_tree<tkey, tvalue, compare, tag>::prefix_reverse_iterator::
 
 // region prefix_const_reverse_iterator implementation
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-binary_search_tree<tkey, tvalue, compare, tag>::prefix_const_reverse_iterator::prefix_const_reverse_iterator(const node* data)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_const_reverse_iterator::prefix_const_reverse_iterator(const node* data)
 {
     _base = prefix_const_iterator(const_cast<node*>(data));
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-binary_search_tree<tkey, tvalue, compare, tag>::prefix_const_reverse_iterator::prefix_const_reverse_iterator(const prefix_const_iterator& it) noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_const_reverse_iterator::prefix_const_reverse_iterator(const prefix_const_iterator& it) noexcept
 {
     _base = it;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-binary_search_tree<tkey, tvalue, compare, tag>::prefix_const_reverse_iterator::operator binary_search_tree<tkey, tvalue, compare, tag>::prefix_const_iterator() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_const_reverse_iterator::operator binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_const_iterator() const noexcept
 {
     return _base;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::prefix_const_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::prefix_const_reverse_iterator::base() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_const_iterator
+binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_const_reverse_iterator::base() const noexcept
 {
     return _base;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-bool binary_search_tree<tkey, tvalue, compare, tag>::prefix_const_reverse_iterator::operator==(prefix_const_reverse_iterator const &other) const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+bool binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_const_reverse_iterator::operator==(prefix_const_reverse_iterator const &other) const noexcept
 {
     return _base == other._base;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-bool binary_search_tree<tkey, tvalue, compare, tag>::prefix_const_reverse_iterator::operator!=(prefix_const_reverse_iterator const &other) const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+bool binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_const_reverse_iterator::operator!=(prefix_const_reverse_iterator const &other) const noexcept
 {
     return !(*this == other);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::prefix_const_reverse_iterator &
-binary_search_tree<tkey, tvalue, compare, tag>::prefix_const_reverse_iterator::operator++() & noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_const_reverse_iterator &
+binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_const_reverse_iterator::operator++() & noexcept
 {
     --_base;
     return *this;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::prefix_const_reverse_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::prefix_const_reverse_iterator::operator++(int not_used) noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_const_reverse_iterator
+binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_const_reverse_iterator::operator++(int not_used) noexcept
 {
     prefix_const_reverse_iterator temp = *this;
     ++(*this);
@@ -1408,39 +2416,39 @@ binary_search_tree<tkey, tvalue, compare, tag>::prefix_const_reverse_iterator::o
 
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::prefix_const_reverse_iterator &
-binary_search_tree<tkey, tvalue, compare, tag>::prefix_const_reverse_iterator::operator--() & noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_const_reverse_iterator &
+binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_const_reverse_iterator::operator--() & noexcept
 {
     ++_base;
     return *this;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::prefix_const_reverse_iterator const
-binary_search_tree<tkey, tvalue, compare, tag>::prefix_const_reverse_iterator::operator--(int not_used) const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_const_reverse_iterator const
+binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_const_reverse_iterator::operator--(int not_used) const noexcept
 {
     prefix_const_reverse_iterator temp = *this;
     --(*this);
     return temp;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::prefix_const_reverse_iterator::reference
-binary_search_tree<tkey, tvalue, compare, tag>::prefix_const_reverse_iterator::operator*()
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_const_reverse_iterator::reference
+binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_const_reverse_iterator::operator*()
 {
     return *_base;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::prefix_const_reverse_iterator::pointer
-binary_search_tree<tkey, tvalue, compare, tag>::prefix_const_reverse_iterator::operator->() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_const_reverse_iterator::pointer
+binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_const_reverse_iterator::operator->() noexcept
 {
     return _base.operator->();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-size_t binary_search_tree<tkey, tvalue, compare, tag>::prefix_const_reverse_iterator::depth() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+size_t binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_const_reverse_iterator::depth() const noexcept
 {
     return _base.depth();
 }
@@ -1448,98 +2456,75 @@ size_t binary_search_tree<tkey, tvalue, compare, tag>::prefix_const_reverse_iter
 // endregion prefix_const_reverse_iterator implementation
 
 // region infix_iterator implementation
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator::infix_iterator(node* data)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_iterator::infix_iterator(node* data)
         : _data(data), _backup(nullptr)
 {}
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-bool binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator::operator==(infix_iterator const &other) const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+bool binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_iterator::operator==(infix_iterator const &other) const noexcept
 {
     return _data == other._data;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-bool binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator::operator!=(infix_iterator const &other) const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+bool binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_iterator::operator!=(infix_iterator const &other) const noexcept
 {
     return !(*this == other);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator &
-binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator::operator++() & noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_iterator &
+binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_iterator::operator++() & noexcept
 {
     if (!_data)
     {
         return *this;
     }
-    if (_data->right_subtree)
+    node* next = infix_successor(_data);
+    if (!next)
     {
-        _data = _data->right_subtree;
-        while (_data->left_subtree)
-        {
-            _data = _data->left_subtree;
-        }
-    }
-    else
-    {
-        node* parent = _data->parent;
-        while (parent && _data == parent->right_subtree)
-        {
-            _data = parent;
-            parent = parent->parent;
-        }
-        _data = parent;
+        _backup = _data;
     }
+    _data = next;
     return *this;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator::operator++(int not_used) noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_iterator
+binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_iterator::operator++(int not_used) noexcept
 {
     infix_iterator temp = *this;
     ++(*this);
     return temp;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator &
-binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator::operator--() & noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_iterator &
+binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_iterator::operator--() & noexcept
 {
     if (!_data)
     {
-        _data = _backup;
+        // only end remembers its neighbour, before_begin stays where it is
+        _data = std::exchange(_backup, nullptr);
         return *this;
     }
-    if (_data->left_subtree) {
-        _data = _data->left_subtree;
-        while (_data->right_subtree)
-            _data = _data->right_subtree;
-    }
-    else {
-        node* parent = _data->parent;
-        while (parent && _data == parent->left_subtree) {
-            _data = parent;
-            parent = parent->parent;
-        }
-        _data = parent;
-    }
+    _data = infix_predecessor(_data);
     return *this;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator const
-binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator::operator--(int not_used) const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_iterator const
+binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_iterator::operator--(int not_used) const noexcept
 {
     infix_iterator temp = *this;
     --(*this);
     return temp;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator::reference
-binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator::operator*()
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_iterator::reference
+binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_iterator::operator*()
 {
     if (!_data)
     {
@@ -1548,21 +2533,21 @@ binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator::operator*()
     return _data->data;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator::pointer
-binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator::operator->() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_iterator::pointer
+binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_iterator::operator->() noexcept
 {
     return &(_data->data);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-size_t binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator::depth() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+size_t binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_iterator::depth() const noexcept
 {
     size_t depth = 0;
     node* temp = _data;
-    while (temp && temp->parent) {
+    while (temp && temp->get_parent()) {
         ++depth;
-        temp = temp->parent;
+        temp = temp->get_parent();
     }
     return depth;
 }
@@ -1571,80 +2556,80 @@ size_t binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator::depth() c
 
 // region infix_const_iterator implementation
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-binary_search_tree<tkey, tvalue, compare, tag>::infix_const_iterator::infix_const_iterator(const node* data)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_const_iterator::infix_const_iterator(const node* data)
 {
     _base = infix_iterator(const_cast<node*>(data));
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-binary_search_tree<tkey, tvalue, compare, tag>::infix_const_iterator::infix_const_iterator(const infix_iterator& it) noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_const_iterator::infix_const_iterator(const infix_iterator& it) noexcept
 {
     _base = it;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-bool binary_search_tree<tkey, tvalue, compare, tag>::infix_const_iterator::operator==(infix_iterator const &other) const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+bool binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_const_iterator::operator==(infix_const_iterator const &other) const noexcept
 {
-    return _base == other;
+    return _base == other._base;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-bool binary_search_tree<tkey, tvalue, compare, tag>::infix_const_iterator::operator!=(infix_iterator const &other) const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+bool binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_const_iterator::operator!=(infix_const_iterator const &other) const noexcept
 {
     return !(*this == other);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::infix_const_iterator &
-binary_search_tree<tkey, tvalue, compare, tag>::infix_const_iterator::operator++() & noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_const_iterator &
+binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_const_iterator::operator++() & noexcept
 {
     ++_base;
     return *this;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::infix_const_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::infix_const_iterator::operator++(int not_used) noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_const_iterator
+binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_const_iterator::operator++(int not_used) noexcept
 {
     infix_const_iterator temp = *this;
     ++(*this);
     return temp;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::infix_const_iterator &
-binary_search_tree<tkey, tvalue, compare, tag>::infix_const_iterator::operator--() & noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_const_iterator &
+binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_const_iterator::operator--() & noexcept
 {
     --_base;
     return *this;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::infix_const_iterator const
-binary_search_tree<tkey, tvalue, compare, tag>::infix_const_iterator::operator--(int not_used) const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_const_iterator const
+binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_const_iterator::operator--(int not_used) const noexcept
 {
     infix_const_iterator temp = *this;
     --(*this);
     return temp;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::infix_const_iterator::reference
-binary_search_tree<tkey, tvalue, compare, tag>::infix_const_iterator::operator*()
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_const_iterator::reference
+binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_const_iterator::operator*()
 {
     return *_base;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::infix_const_iterator::pointer
-binary_search_tree<tkey, tvalue, compare, tag>::infix_const_iterator::operator->() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_const_iterator::pointer
+binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_const_iterator::operator->() noexcept
 {
     return _base.operator->();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-size_t binary_search_tree<tkey, tvalue, compare, tag>::infix_const_iterator::depth() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+size_t binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_const_iterator::depth() const noexcept
 {
     return _base.depth();
 }
@@ -1653,93 +2638,93 @@ size_t binary_search_tree<tkey, tvalue, compare, tag>::infix_const_iterator::dep
 
 // region infix_reverse_iterator implementation
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-binary_search_tree<tkey, tvalue, compare, tag>::infix_reverse_iterator::infix_reverse_iterator(node* data)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_reverse_iterator::infix_reverse_iterator(node* data)
 {
     _base = infix_iterator(data);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-binary_search_tree<tkey, tvalue, compare, tag>::infix_reverse_iterator::infix_reverse_iterator(const infix_iterator& it) noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_reverse_iterator::infix_reverse_iterator(const infix_iterator& it) noexcept
 {
     _base = it;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-binary_search_tree<tkey, tvalue, compare, tag>::infix_reverse_iterator::operator binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_reverse_iterator::operator binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_iterator() const noexcept
 {
     return _base;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::infix_reverse_iterator::base() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_iterator
+binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_reverse_iterator::base() const noexcept
 {
     return _base;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-bool binary_search_tree<tkey, tvalue, compare, tag>::infix_reverse_iterator::operator==(infix_reverse_iterator const &other) const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+bool binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_reverse_iterator::operator==(infix_reverse_iterator const &other) const noexcept
 {
     return _base == other._base;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-bool binary_search_tree<tkey, tvalue, compare, tag>::infix_reverse_iterator::operator!=(infix_reverse_iterator const &other) const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+bool binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_reverse_iterator::operator!=(infix_reverse_iterator const &other) const noexcept
 {
     return !(*this == other);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::infix_reverse_iterator &
-binary_search_tree<tkey, tvalue, compare, tag>::infix_reverse_iterator::operator++() & noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_reverse_iterator &
+binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_reverse_iterator::operator++() & noexcept
 {
     --_base;
     return *this;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::infix_reverse_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::infix_reverse_iterator::operator++(int not_used) noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_reverse_iterator
+binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_reverse_iterator::operator++(int not_used) noexcept
 {
     infix_reverse_iterator temp = *this;
     ++(*this);
     return temp;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::infix_reverse_iterator &
-binary_search_tree<tkey, tvalue, compare, tag>::infix_reverse_iterator::operator--() & noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_reverse_iterator &
+binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_reverse_iterator::operator--() & noexcept
 {
     ++_base;
     return *this;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::infix_reverse_iterator const
-binary_search_tree<tkey, tvalue, compare, tag>::infix_reverse_iterator::operator--(int not_used) const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_reverse_iterator const
+binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_reverse_iterator::operator--(int not_used) const noexcept
 {
     infix_reverse_iterator temp = *this;
     --(*this);
     return temp;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::infix_reverse_iterator::reference
-binary_search_tree<tkey, tvalue, compare, tag>::infix_reverse_iterator::operator*()
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_reverse_iterator::reference
+binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_reverse_iterator::operator*()
 {
     return *_base;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::infix_reverse_iterator::pointer
-binary_search_tree<tkey, tvalue, compare, tag>::infix_reverse_iterator::operator->() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_reverse_iterator::pointer
+binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_reverse_iterator::operator->() noexcept
 {
     return _base.operator->();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-size_t binary_search_tree<tkey, tvalue, compare, tag>::infix_reverse_iterator::depth() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+size_t binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_reverse_iterator::depth() const noexcept
 {
     return _base.depth();
 }
@@ -1748,93 +2733,93 @@ size_t binary_search_tree<tkey, tvalue, compare, tag>::infix_reverse_iterator::d
 
 // region infix_const_reverse_iterator implementation
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-binary_search_tree<tkey, tvalue, compare, tag>::infix_const_reverse_iterator::infix_const_reverse_iterator(const node* data)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_const_reverse_iterator::infix_const_reverse_iterator(const node* data)
 {
     _base = infix_const_iterator(const_cast<node*>(data));
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-binary_search_tree<tkey, tvalue, compare, tag>::infix_const_reverse_iterator::infix_const_reverse_iterator(const infix_const_iterator& it) noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_const_reverse_iterator::infix_const_reverse_iterator(const infix_const_iterator& it) noexcept
 {
     _base = it;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-binary_search_tree<tkey, tvalue, compare, tag>::infix_const_reverse_iterator::operator binary_search_tree<tkey, tvalue, compare, tag>::infix_const_iterator() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_const_reverse_iterator::operator binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_const_iterator() const noexcept
 {
     return _base;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::infix_const_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::infix_const_reverse_iterator::base() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_const_iterator
+binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_const_reverse_iterator::base() const noexcept
 {
     return _base;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-bool binary_search_tree<tkey, tvalue, compare, tag>::infix_const_reverse_iterator::operator==(infix_const_reverse_iterator const &other) const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+bool binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_const_reverse_iterator::operator==(infix_const_reverse_iterator const &other) const noexcept
 {
     return _base == other._base;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-bool binary_search_tree<tkey, tvalue, compare, tag>::infix_const_reverse_iterator::operator!=(infix_const_reverse_iterator const &other) const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+bool binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_const_reverse_iterator::operator!=(infix_const_reverse_iterator const &other) const noexcept
 {
     return !(*this == other);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::infix_const_reverse_iterator &
-binary_search_tree<tkey, tvalue, compare, tag>::infix_const_reverse_iterator::operator++() & noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_const_reverse_iterator &
+binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_const_reverse_iterator::operator++() & noexcept
 {
     --_base;
     return *this;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::infix_const_reverse_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::infix_const_reverse_iterator::operator++(int not_used) noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_const_reverse_iterator
+binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_const_reverse_iterator::operator++(int not_used) noexcept
 {
     infix_const_reverse_iterator temp = *this;
     ++(*this);
     return temp;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::infix_const_reverse_iterator &
-binary_search_tree<tkey, tvalue, compare, tag>::infix_const_reverse_iterator::operator--() & noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_const_reverse_iterator &
+binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_const_reverse_iterator::operator--() & noexcept
 {
     ++_base;
     return *this;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::infix_const_reverse_iterator const
-binary_search_tree<tkey, tvalue, compare, tag>::infix_const_reverse_iterator::operator--(int not_used) const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_const_reverse_iterator const
+binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_const_reverse_iterator::operator--(int not_used) const noexcept
 {
     infix_const_reverse_iterator temp = *this;
     --(*this);
     return temp;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::infix_const_reverse_iterator::reference
-binary_search_tree<tkey, tvalue, compare, tag>::infix_const_reverse_iterator::operator*()
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_const_reverse_iterator::reference
+binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_const_reverse_iterator::operator*()
 {
     return *_base;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::infix_const_reverse_iterator::pointer
-binary_search_tree<tkey, tvalue, compare, tag>::infix_const_reverse_iterator::operator->() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_const_reverse_iterator::pointer
+binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_const_reverse_iterator::operator->() noexcept
 {
     return _base.operator->();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-size_t binary_search_tree<tkey, tvalue, compare, tag>::infix_const_reverse_iterator::depth() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+size_t binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_const_reverse_iterator::depth() const noexcept
 {
     return _base.depth();
 }
@@ -1843,118 +2828,77 @@ size_t binary_search_tree<tkey, tvalue, compare, tag>::infix_const_reverse_itera
 
 // region postfix_iterator implementation
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-binary_search_tree<tkey, tvalue, compare, tag>::postfix_iterator::postfix_iterator(node* data)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_iterator::postfix_iterator(node* data)
 {
     _data = data;
     _backup = nullptr;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-bool binary_search_tree<tkey, tvalue, compare, tag>::postfix_iterator::operator==(postfix_iterator const &other) const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+bool binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_iterator::operator==(postfix_iterator const &other) const noexcept
 {
-    return _data = other._data;
+    return _data == other._data;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-bool binary_search_tree<tkey, tvalue, compare, tag>::postfix_iterator::operator!=(postfix_iterator const &other) const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+bool binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_iterator::operator!=(postfix_iterator const &other) const noexcept
 {
     return !(*this == other);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::postfix_iterator &
-binary_search_tree<tkey, tvalue, compare, tag>::postfix_iterator::operator++() & noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_iterator &
+binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_iterator::operator++() & noexcept
 {
     if (!_data)
     {
-        return *this;
-    }
-    node* parent = _data->parent;
-    if (!parent)
-    {
-        _data = nullptr;
-        return *this;
-    }
-    if (parent->left_subtree == _data && parent->right_subtree)
-    {
-        _data = parent->right_subtree;
-        while (_data->left_subtree ||_data->right_subtree)
-        {
-            if (_data->left_subtree)
-            {
-                _data = _data->left_subtree;
-            }
-            else
-            {
-                _data = _data->right_subtree;
-            }
-        }
+        return *this;
     }
-    else
+    node* next = postfix_successor(_data);
+    if (!next)
     {
-        _data = parent;
+        _backup = _data;
     }
+    _data = next;
     return *this;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::postfix_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::postfix_iterator::operator++(int not_used) noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_iterator
+binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_iterator::operator++(int not_used) noexcept
 {
     postfix_iterator temp = *this;
     ++(*this);
     return temp;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::postfix_iterator &
-binary_search_tree<tkey, tvalue, compare, tag>::postfix_iterator::operator--() & noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_iterator &
+binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_iterator::operator--() & noexcept
 {
-    if (!_data && _backup) {
-        _data = _backup;
-        return *this;
-    }
-    node* current = _data;
-    node* parent = _data->parent;
-    while (parent)
+    if (!_data)
     {
-        if (parent->right_subtree == current && parent->left_subtree)
-        {
-            current = parent->left_subtree;
-            while (current->left_subtree || current->right_subtree)
-            {
-                if (current->right_subtree)
-                {
-                    current = current->right_subtree;
-                }
-                else
-                {
-                    current = current->left_subtree;
-                }
-            }
-            _data = current;
-            return *this;
-        }
-        current = parent;
-        parent = parent->parent;
+        // only end remembers its neighbour, before_begin stays where it is
+        _data = std::exchange(_backup, nullptr);
+        return *this;
     }
-    _data = nullptr;
+    _data = postfix_predecessor(_data);
     return *this;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::postfix_iterator const
-binary_search_tree<tkey, tvalue, compare, tag>::postfix_iterator::operator--(int not_used) const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_iterator const
+binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_iterator::operator--(int not_used) const noexcept
 {
     postfix_iterator temp = *this;
     --(*this);
     return temp;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::postfix_iterator::reference
-binary_search_tree<tkey, tvalue, compare, tag>::postfix_iterator::operator*()
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_iterator::reference
+binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_iterator::operator*()
 {
     if (!_data) {
         throw std::out_of_range("Dereferencing end() iterator in postfix_iterator");
@@ -1962,22 +2906,22 @@ binary_search_tree<tkey, tvalue, compare, tag>::postfix_iterator::operator*()
     return _data->data;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::postfix_iterator::pointer
-binary_search_tree<tkey, tvalue, compare, tag>::postfix_iterator::operator->() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_iterator::pointer
+binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_iterator::operator->() noexcept
 {
     return &(_data->data);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-size_t binary_search_tree<tkey, tvalue, compare, tag>::postfix_iterator::depth() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+size_t binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_iterator::depth() const noexcept
 {
     size_t depth = 0;
     node* temp = _data ? _data : _backup;
-    while (temp && temp->parent)
+    while (temp && temp->get_parent())
     {
         ++depth;
-        temp = temp->parent;
+        temp = temp->get_parent();
     }
     return depth;
 }
@@ -1986,94 +2930,81 @@ size_t binary_search_tree<tkey, tvalue, compare, tag>::postfix_iterator::depth()
 
 // region postfix_const_iterator implementation
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-binary_search_tree<tkey, tvalue, compare, tag>::postfix_const_iterator::postfix_const_iterator(const node* data)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_const_iterator::postfix_const_iterator(const node* data)
 {
-    _base._data = const_cast<node*>(data);
-    _base._backup = nullptr;
-
-    // Обход к самому первому элементу в постфиксе
-    if (_base._data)
-    {
-        while (_base._data->left_subtree || _base._data->right_subtree)
-        {
-            if (_base._data->left_subtree)
-                _base._data = _base._data->left_subtree;
-            else
-                _base._data = _base._data->right_subtree;
-        }
-    }
+    _base = postfix_iterator(const_cast<node*>(data));
 }
 
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-binary_search_tree<tkey, tvalue, compare, tag>::postfix_const_iterator::postfix_const_iterator(const postfix_iterator& it) noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_const_iterator::postfix_const_iterator(const postfix_iterator& it) noexcept
 {
     _base = it;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-bool binary_search_tree<tkey, tvalue, compare, tag>::postfix_const_iterator::operator==(postfix_iterator const &other) const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+bool binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_const_iterator::operator==(postfix_const_iterator const &other) const noexcept
 {
-    return _base == other;
+    return _base == other._base;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-bool binary_search_tree<tkey, tvalue, compare, tag>::postfix_const_iterator::operator!=(postfix_iterator const &other) const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+bool binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_const_iterator::operator!=(postfix_const_iterator const &other) const noexcept
 {
     return !(*this == other);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::postfix_const_iterator &
-binary_search_tree<tkey, tvalue, compare, tag>::postfix_const_iterator::operator++() & noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_const_iterator &
+binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_const_iterator::operator++() & noexcept
 {
     ++_base;
     return *this;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::postfix_const_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::postfix_const_iterator::operator++(int not_used) noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_const_iterator
+binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_const_iterator::operator++(int not_used) noexcept
 {
     postfix_iterator temp = *this;
     ++(*this);
     return temp;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::postfix_const_iterator &
-binary_search_tree<tkey, tvalue, compare, tag>::postfix_const_iterator::operator--() & noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_const_iterator &
+binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_const_iterator::operator--() & noexcept
 {
     --_base;
     return *this;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::postfix_const_iterator const
-binary_search_tree<tkey, tvalue, compare, tag>::postfix_const_iterator::operator--(int not_used) const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_const_iterator const
+binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_const_iterator::operator--(int not_used) const noexcept
 {
     postfix_iterator temp = *this;
     --(*this);
     return temp;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::postfix_const_iterator::reference
-binary_search_tree<tkey, tvalue, compare, tag>::postfix_const_iterator::operator*()
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_const_iterator::reference
+binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_const_iterator::operator*()
 {
     return *_base;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::postfix_const_iterator::pointer
-binary_search_tree<tkey, tvalue, compare, tag>::postfix_const_iterator::operator->() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_const_iterator::pointer
+binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_const_iterator::operator->() noexcept
 {
     return _base.operator->();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-size_t binary_search_tree<tkey, tvalue, compare, tag>::postfix_const_iterator::depth() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+size_t binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_const_iterator::depth() const noexcept
 {
     return _base.depth();
 }
@@ -2082,93 +3013,93 @@ size_t binary_search_tree<tkey, tvalue, compare, tag>::postfix_const_iterator::d
 
 // region postfix_reverse_iterator implementation
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-binary_search_tree<tkey, tvalue, compare, tag>::postfix_reverse_iterator::postfix_reverse_iterator(node* data)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_reverse_iterator::postfix_reverse_iterator(node* data)
 {
     _base = postfix_iterator(data);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-binary_search_tree<tkey, tvalue, compare, tag>::postfix_reverse_iterator::postfix_reverse_iterator(const postfix_iterator& it) noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_reverse_iterator::postfix_reverse_iterator(const postfix_iterator& it) noexcept
 {
     _base = it;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-binary_search_tree<tkey, tvalue, compare, tag>::postfix_reverse_iterator::operator binary_search_tree<tkey, tvalue, compare, tag>::postfix_iterator() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_reverse_iterator::operator binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_iterator() const noexcept
 {
     return _base;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::postfix_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::postfix_reverse_iterator::base() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_iterator
+binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_reverse_iterator::base() const noexcept
 {
     return _base;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-bool binary_search_tree<tkey, tvalue, compare, tag>::postfix_reverse_iterator::operator==(postfix_reverse_iterator const &other) const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+bool binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_reverse_iterator::operator==(postfix_reverse_iterator const &other) const noexcept
 {
     return _base == other._base;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-bool binary_search_tree<tkey, tvalue, compare, tag>::postfix_reverse_iterator::operator!=(postfix_reverse_iterator const &other) const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+bool binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_reverse_iterator::operator!=(postfix_reverse_iterator const &other) const noexcept
 {
     return !(*this == other);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::postfix_reverse_iterator &
-binary_search_tree<tkey, tvalue, compare, tag>::postfix_reverse_iterator::operator++() & noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_reverse_iterator &
+binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_reverse_iterator::operator++() & noexcept
 {
     --_base;
     return *this;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::postfix_reverse_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::postfix_reverse_iterator::operator++(int not_used) noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_reverse_iterator
+binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_reverse_iterator::operator++(int not_used) noexcept
 {
     postfix_reverse_iterator temp = *this;
     ++(*this);
     return temp;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::postfix_reverse_iterator &
-binary_search_tree<tkey, tvalue, compare, tag>::postfix_reverse_iterator::operator--() & noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_reverse_iterator &
+binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_reverse_iterator::operator--() & noexcept
 {
     ++_base;
     return *this;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::postfix_reverse_iterator const
-binary_search_tree<tkey, tvalue, compare, tag>::postfix_reverse_iterator::operator--(int not_used) const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_reverse_iterator const
+binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_reverse_iterator::operator--(int not_used) const noexcept
 {
     postfix_reverse_iterator temp = *this;
     --(*this);
     return temp;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::postfix_reverse_iterator::reference
-binary_search_tree<tkey, tvalue, compare, tag>::postfix_reverse_iterator::operator*()
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_reverse_iterator::reference
+binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_reverse_iterator::operator*()
 {
     return *_base;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::postfix_reverse_iterator::pointer
-binary_search_tree<tkey, tvalue, compare, tag>::postfix_reverse_iterator::operator->() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_reverse_iterator::pointer
+binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_reverse_iterator::operator->() noexcept
 {
     return _base.operator->();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-size_t binary_search_tree<tkey, tvalue, compare, tag>::postfix_reverse_iterator::depth() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+size_t binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_reverse_iterator::depth() const noexcept
 {
     return _base.depth();
 }
@@ -2177,93 +3108,93 @@ size_t binary_search_tree<tkey, tvalue, compare, tag>::postfix_reverse_iterator:
 
 // region postfix_const_reverse_iterator implementation
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-binary_search_tree<tkey, tvalue, compare, tag>::postfix_const_reverse_iterator::postfix_const_reverse_iterator(const node* data)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_const_reverse_iterator::postfix_const_reverse_iterator(const node* data)
 {
     _base = postfix_const_iterator(const_cast<node*>(data));
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-binary_search_tree<tkey, tvalue, compare, tag>::postfix_const_reverse_iterator::postfix_const_reverse_iterator(const postfix_const_iterator& it) noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_const_reverse_iterator::postfix_const_reverse_iterator(const postfix_const_iterator& it) noexcept
 {
     _base = it;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-binary_search_tree<tkey, tvalue, compare, tag>::postfix_const_reverse_iterator::operator binary_search_tree<tkey, tvalue, compare, tag>::postfix_const_iterator() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_const_reverse_iterator::operator binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_const_iterator() const noexcept
 {
     return _base;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::postfix_const_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::postfix_const_reverse_iterator::base() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_const_iterator
+binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_const_reverse_iterator::base() const noexcept
 {
     return _base;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-bool binary_search_tree<tkey, tvalue, compare, tag>::postfix_const_reverse_iterator::operator==(postfix_const_reverse_iterator const &other) const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+bool binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_const_reverse_iterator::operator==(postfix_const_reverse_iterator const &other) const noexcept
 {
     return _base == other._base;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-bool binary_search_tree<tkey, tvalue, compare, tag>::postfix_const_reverse_iterator::operator!=(postfix_const_reverse_iterator const &other) const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+bool binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_const_reverse_iterator::operator!=(postfix_const_reverse_iterator const &other) const noexcept
 {
     return !(*this == other);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::postfix_const_reverse_iterator &
-binary_search_tree<tkey, tvalue, compare, tag>::postfix_const_reverse_iterator::operator++() & noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_const_reverse_iterator &
+binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_const_reverse_iterator::operator++() & noexcept
 {
     --_base;
     return *this;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::postfix_const_reverse_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::postfix_const_reverse_iterator::operator++(int not_used) noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_const_reverse_iterator
+binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_const_reverse_iterator::operator++(int not_used) noexcept
 {
     postfix_const_reverse_iterator temp = *this;
     ++(*this);
     return this;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::postfix_const_reverse_iterator &
-binary_search_tree<tkey, tvalue, compare, tag>::postfix_const_reverse_iterator::operator--() & noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_const_reverse_iterator &
+binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_const_reverse_iterator::operator--() & noexcept
 {
     ++_base;
     return *this;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::postfix_const_reverse_iterator const
-binary_search_tree<tkey, tvalue, compare, tag>::postfix_const_reverse_iterator::operator--(int not_used) const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_const_reverse_iterator const
+binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_const_reverse_iterator::operator--(int not_used) const noexcept
 {
     postfix_const_reverse_iterator temp = *this;
     --(*this);
     return this;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::postfix_const_reverse_iterator::reference
-binary_search_tree<tkey, tvalue, compare, tag>::postfix_const_reverse_iterator::operator*()
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_const_reverse_iterator::reference
+binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_const_reverse_iterator::operator*()
 {
     return *_base;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::postfix_const_reverse_iterator::pointer
-binary_search_tree<tkey, tvalue, compare, tag>::postfix_const_reverse_iterator::operator->() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_const_reverse_iterator::pointer
+binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_const_reverse_iterator::operator->() noexcept
 {
     return _base.operator->();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-size_t binary_search_tree<tkey, tvalue, compare, tag>::postfix_const_reverse_iterator::depth() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+size_t binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_const_reverse_iterator::depth() const noexcept
 {
     return _base.depth();
 }
@@ -2272,8 +3203,8 @@ size_t binary_search_tree<tkey, tvalue, compare, tag>::postfix_const_reverse_ite
 
 // region binary_search_tree implementation
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-binary_search_tree<tkey, tvalue, compare, tag>::binary_search_tree(
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+binary_search_tree<tkey, tvalue, compare, tag, augment>::binary_search_tree(
         const compare& comp,
         pp_allocator<value_type> alloc,
         logger* logger)
@@ -2284,8 +3215,8 @@ binary_search_tree<tkey, tvalue, compare, tag>::binary_search_tree(
           _size(0)
 { }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-binary_search_tree<tkey, tvalue, compare, tag>::binary_search_tree(
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+binary_search_tree<tkey, tvalue, compare, tag, augment>::binary_search_tree(
         pp_allocator<value_type> alloc,
         const compare& comp,
         logger* logger)
@@ -2296,9 +3227,9 @@ binary_search_tree<tkey, tvalue, compare, tag>::binary_search_tree(
           _size(0)
 { }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
 template<std::ranges::input_range Range>
-binary_search_tree<tkey, tvalue, compare, tag>::binary_search_tree(
+binary_search_tree<tkey, tvalue, compare, tag, augment>::binary_search_tree(
         Range&& range,
         const compare& cmp,
         pp_allocator<value_type> alloc,
@@ -2310,17 +3241,15 @@ binary_search_tree<tkey, tvalue, compare, tag>::binary_search_tree(
           _size(0)
 {
     try {
-        for (auto&& [key, value] : range) {
-            insert(key, value);
-        }
+        insert_range(std::forward<Range>(range));
     } catch (...) {
         clear();
         throw std::out_of_range("Tests wants it?");
     }
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-binary_search_tree<tkey, tvalue, compare, tag>::binary_search_tree(
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+binary_search_tree<tkey, tvalue, compare, tag, augment>::binary_search_tree(
         std::initializer_list<std::pair<tkey, tvalue>> data,
         const compare& cmp,
         pp_allocator<value_type> alloc,
@@ -2332,9 +3261,7 @@ binary_search_tree<tkey, tvalue, compare, tag>::binary_search_tree(
           _size(0)
 {
     try {
-        for (auto&& [key, value] : data) {
-            insert(key, value);
-        }
+        insert_range(data);
     } catch (...) {
         clear();
         throw std::out_of_range("Tests want it?");
@@ -2346,22 +3273,26 @@ binary_search_tree<tkey, tvalue, compare, tag>::binary_search_tree(
 
 // region binary_search_tree 5_rules implementation
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-binary_search_tree<tkey, tvalue, compare, tag>::binary_search_tree(const binary_search_tree &other)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+binary_search_tree<tkey, tvalue, compare, tag, augment>::binary_search_tree(const binary_search_tree &other)
 {
     static_cast<compare&>(*this) = static_cast<const compare&>(other);
     _root = nullptr;
     _size = 0;
     _allocator = other._allocator;
     _logger = other._logger;
-    for (auto it = other.begin_infix(); it != other.end_infix(); ++it)
+
+    std::vector<std::pair<tkey, tvalue>> staged;
+    staged.reserve(other._size);
+    for (node* current = leftmost(other._root); current; current = infix_successor(current))
     {
-        insert(*it);
+        staged.emplace_back(current->data);
     }
+    bulk_insert(staged);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-binary_search_tree<tkey, tvalue, compare, tag>::binary_search_tree(binary_search_tree &&other) noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+binary_search_tree<tkey, tvalue, compare, tag, augment>::binary_search_tree(binary_search_tree &&other) noexcept
 {
     static_cast<compare&>(*this) = std::move(static_cast<compare&>(other));
     _root = other._root;
@@ -2373,9 +3304,9 @@ binary_search_tree<tkey, tvalue, compare, tag>::binary_search_tree(binary_search
     other._logger = nullptr;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-binary_search_tree<tkey, tvalue, compare, tag>&
-binary_search_tree<tkey, tvalue, compare, tag>::operator=(const binary_search_tree &other)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+binary_search_tree<tkey, tvalue, compare, tag, augment>&
+binary_search_tree<tkey, tvalue, compare, tag, augment>::operator=(const binary_search_tree &other)
 {
     if (this != &other)
     {
@@ -2384,17 +3315,20 @@ binary_search_tree<tkey, tvalue, compare, tag>::operator=(const binary_search_tr
         _allocator = other._allocator;
         _logger = other._logger;
 
-        for (auto it = other.begin_infix(); it != other.end_infix(); ++it)
+        std::vector<std::pair<tkey, tvalue>> staged;
+        staged.reserve(other._size);
+        for (node* current = leftmost(other._root); current; current = infix_successor(current))
         {
-            insert(*it);
+            staged.emplace_back(current->data);
         }
+        bulk_insert(staged);
     }
     return *this;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-binary_search_tree<tkey, tvalue, compare, tag>&
-binary_search_tree<tkey, tvalue, compare, tag>::operator=(binary_search_tree &&other) noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+binary_search_tree<tkey, tvalue, compare, tag, augment>&
+binary_search_tree<tkey, tvalue, compare, tag, augment>::operator=(binary_search_tree &&other) noexcept
 {
     if (this != &other)
     {
@@ -2412,8 +3346,8 @@ binary_search_tree<tkey, tvalue, compare, tag>::operator=(binary_search_tree &&o
     return *this;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-binary_search_tree<tkey, tvalue, compare, tag>::~binary_search_tree()
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+binary_search_tree<tkey, tvalue, compare, tag, augment>::~binary_search_tree()
 {
     clear();
 }
@@ -2422,67 +3356,57 @@ binary_search_tree<tkey, tvalue, compare, tag>::~binary_search_tree()
 
 // region binary_search_tree methods_access implementation
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-tvalue& binary_search_tree<tkey, tvalue, compare, tag>::at(const tkey& key)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+tvalue& binary_search_tree<tkey, tvalue, compare, tag, augment>::at(const tkey& key)
 {
-    node* current = _root;
-    while (current)
+    node* found = __detail::bst_impl<tkey, tvalue, compare, tag, augment>::search(*this, key);
+    if (!found)
     {
-        if (compare_keys(key, current->data.first))
-            current = current->left_subtree;
-        else if (compare_keys(current->data.first, key))
-            current = current->right_subtree;
-        else
-            return current->data.second;
+        throw std::out_of_range("Key not found");
     }
 
-    throw std::out_of_range("Key not found");
+    return found->data.second;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-const tvalue& binary_search_tree<tkey, tvalue, compare, tag>::at(const tkey& key) const
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+const tvalue& binary_search_tree<tkey, tvalue, compare, tag, augment>::at(const tkey& key) const
 {
-    node* current = _root;
-    while (current)
+    node* found = find_node(key);
+    if (!found)
     {
-        if (compare_keys(key, current->data.first))
-            current = current->left_subtree;
-        else if (compare_keys(current->data.first, key))
-            current = current->right_subtree;
-        else
-            return current->data.second;
+        throw std::out_of_range("Key not found");
     }
 
-    throw std::out_of_range("Key not found");
+    return found->data.second;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-tvalue& binary_search_tree<tkey, tvalue, compare, tag>::operator[](const tkey& key)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+tvalue& binary_search_tree<tkey, tvalue, compare, tag, augment>::operator[](const tkey& key)
 {
-    return emplace(key, tvalue{}).first.operator*().second;
+    return try_emplace(key).first.operator*().second;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-tvalue& binary_search_tree<tkey, tvalue, compare, tag>::operator[](tkey&& key)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+tvalue& binary_search_tree<tkey, tvalue, compare, tag, augment>::operator[](tkey&& key)
 {
-    return emplace(std::move(key), tvalue{}).first.operator*().second;
+    return try_emplace(std::move(key)).first.operator*().second;
 }
 
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-bool binary_search_tree<tkey, tvalue, compare, tag>::empty() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+bool binary_search_tree<tkey, tvalue, compare, tag, augment>::empty() const noexcept
 {
     return _size == 0;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-size_t binary_search_tree<tkey, tvalue, compare, tag>::size() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+size_t binary_search_tree<tkey, tvalue, compare, tag, augment>::size() const noexcept
 {
     return _size;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-void binary_search_tree<tkey, tvalue, compare, tag>::clear() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+void binary_search_tree<tkey, tvalue, compare, tag, augment>::clear() noexcept
 {
     while (_root != nullptr)
     {
@@ -2496,66 +3420,108 @@ void binary_search_tree<tkey, tvalue, compare, tag>::clear() noexcept
 
 // region binary_search_tree methods_insert and methods_emplace implementation
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-std::pair<typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator, bool>
-binary_search_tree<tkey, tvalue, compare, tag>::insert(const value_type& value)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+std::pair<typename binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_iterator, bool>
+binary_search_tree<tkey, tvalue, compare, tag, augment>::insert(const value_type& value)
 {
     return emplace(value.first, value.second);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-std::pair<typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator, bool>
-binary_search_tree<tkey, tvalue, compare, tag>::insert(value_type&& value)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+std::pair<typename binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_iterator, bool>
+binary_search_tree<tkey, tvalue, compare, tag, augment>::insert(value_type&& value)
 {
     return emplace(std::move(value.first), std::move(value.second));
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
 template<std::input_iterator InputIt>
-void binary_search_tree<tkey, tvalue, compare, tag>::insert(InputIt first, InputIt last)
+void binary_search_tree<tkey, tvalue, compare, tag, augment>::insert(InputIt first, InputIt last)
 {
-    for (; first != last; ++first)
-    {
-        insert(*first);
-    }
+    insert_range(std::ranges::subrange(std::move(first), std::move(last)));
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-template<class ...Args>
-std::pair<typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator, bool>
-binary_search_tree<tkey, tvalue, compare, tag>::emplace(Args&&... args)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+template<std::ranges::input_range R>
+void binary_search_tree<tkey, tvalue, compare, tag, augment>::insert_range(R&& rg)
 {
-    value_type temp(std::forward<Args>(args)...);
-    const tkey& key = temp.first;
-
-    node** current = &_root;
-    node* parent = nullptr;
+    std::vector<std::pair<tkey, tvalue>> staged;
+    if constexpr (std::ranges::sized_range<R>)
+    {
+        staged.reserve(std::ranges::size(rg));
+    }
 
-    while (*current) {
-        parent = *current;
-        if (compare_keys(key, (*current)->data.first)) {
-            current = &(*current)->left_subtree;
-        } else if (compare_keys((*current)->data.first, key)) {
-            current = &(*current)->right_subtree;
-        } else {
-            return { infix_iterator(*current), false };
-        }
+    for (auto&& element : rg)
+    {
+        staged.emplace_back(std::forward<decltype(element)>(element));
     }
 
-    node* new_node = __detail::bst_impl<tkey, tvalue, compare, tag>::create_node(*this, parent, std::forward<Args>(args)...);
+    bulk_insert(staged);
+}
 
-    *current = new_node;
-    ++_size;
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+template<class ...Args>
+std::pair<typename binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_iterator, bool>
+binary_search_tree<tkey, tvalue, compare, tag, augment>::emplace(Args&&... args)
+{
+    if constexpr (sizeof...(Args) == 2)
+    {
+        return [this]<typename key_arg, typename value_arg>(key_arg&& key, value_arg&& value)
+        {
+            if constexpr (std::same_as<std::remove_cvref_t<key_arg>, tkey>)
+            {
+                return emplace_unique(key, std::forward<key_arg>(key), std::forward<value_arg>(value));
+            }
+            else
+            {
+                value_type temp(std::forward<key_arg>(key), std::forward<value_arg>(value));
+                return emplace_unique(temp.first, std::move(temp));
+            }
+        }(std::forward<Args>(args)...);
+    }
+    else if constexpr (sizeof...(Args) == 1)
+    {
+        return [this]<typename pair_arg>(pair_arg&& pair)
+        {
+            if constexpr (requires { { pair.first } -> std::convertible_to<const tkey&>; })
+            {
+                return emplace_unique(static_cast<const tkey&>(pair.first), std::forward<pair_arg>(pair));
+            }
+            else
+            {
+                value_type temp(std::forward<pair_arg>(pair));
+                return emplace_unique(temp.first, std::move(temp));
+            }
+        }(std::forward<Args>(args)...);
+    }
+    else
+    {
+        value_type temp(std::forward<Args>(args)...);
+        return emplace_unique(temp.first, std::move(temp));
+    }
+}
 
-    // Вызов post_insert для балансировки
-    __detail::bst_impl<tkey, tvalue, compare, tag>::post_insert(*this, current);
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+template<class ...Args>
+std::pair<typename binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_iterator, bool>
+binary_search_tree<tkey, tvalue, compare, tag, augment>::try_emplace(const tkey& key, Args&&... args)
+{
+    return emplace_unique(key, std::piecewise_construct, std::forward_as_tuple(key),
+                          std::forward_as_tuple(std::forward<Args>(args)...));
+}
 
-    return { infix_iterator(new_node), true };
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+template<class ...Args>
+std::pair<typename binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_iterator, bool>
+binary_search_tree<tkey, tvalue, compare, tag, augment>::try_emplace(tkey&& key, Args&&... args)
+{
+    return emplace_unique(key, std::piecewise_construct, std::forward_as_tuple(std::move(key)),
+                          std::forward_as_tuple(std::forward<Args>(args)...));
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::insert_or_assign(const value_type& value)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_iterator
+binary_search_tree<tkey, tvalue, compare, tag, augment>::insert_or_assign(const value_type& value)
 {
     auto [it, inserted] = insert(value);
     if (!inserted)
@@ -2565,9 +3531,9 @@ binary_search_tree<tkey, tvalue, compare, tag>::insert_or_assign(const value_typ
     return it;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::insert_or_assign(value_type&& value)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_iterator
+binary_search_tree<tkey, tvalue, compare, tag, augment>::insert_or_assign(value_type&& value)
 {
     auto [it, inserted] = insert(value);
     if (!inserted)
@@ -2577,9 +3543,9 @@ binary_search_tree<tkey, tvalue, compare, tag>::insert_or_assign(value_type&& va
     return it;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
 template<std::input_iterator InputIt>
-void binary_search_tree<tkey, tvalue, compare, tag>::insert_or_assign(InputIt first, InputIt last)
+void binary_search_tree<tkey, tvalue, compare, tag, augment>::insert_or_assign(InputIt first, InputIt last)
 {
     for (; first != last; ++first)
     {
@@ -2587,10 +3553,10 @@ void binary_search_tree<tkey, tvalue, compare, tag>::insert_or_assign(InputIt fi
     }
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
 template<class ...Args>
-typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::emplace_or_assign(Args&&... args)
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_iterator
+binary_search_tree<tkey, tvalue, compare, tag, augment>::emplace_or_assign(Args&&... args)
 {
     value_type temp(std::forward<Args>(args)...);
     return insert_or_assign(std::move(temp));
@@ -2600,8 +3566,8 @@ binary_search_tree<tkey, tvalue, compare, tag>::emplace_or_assign(Args&&... args
 
 // region binary_search_tree swap_method implementation
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-void binary_search_tree<tkey, tvalue, compare, tag>::swap(binary_search_tree& other) noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+void binary_search_tree<tkey, tvalue, compare, tag, augment>::swap(binary_search_tree& other) noexcept
 {
     std::swap(_root, other._root);
     std::swap(_size, other._size);
@@ -2613,146 +3579,138 @@ void binary_search_tree<tkey, tvalue, compare, tag>::swap(binary_search_tree& ot
 
 // region binary_search_tree methods_search and methods_erase implementation
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-bool binary_search_tree<tkey, tvalue, compare, tag>::contains(const tkey& key) const
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+bool binary_search_tree<tkey, tvalue, compare, tag, augment>::contains(const tkey& key) const
 {
-    return find(key) != infix_const_iterator(nullptr);
+    return find_node(key) != nullptr;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::find(const tkey& key)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_iterator
+binary_search_tree<tkey, tvalue, compare, tag, augment>::find(const tkey& key)
 {
-    node* current = _root;
-    while (current) {
-        if (compare_keys(key, current->data.first)) {
-            current = current->left_subtree;
-        } else if (compare_keys(current->data.first, key)) {
-            current = current->right_subtree;
-        } else {
-            return infix_iterator(current);
-        }
-    }
-    return infix_iterator(nullptr);
+    return infix_iterator(__detail::bst_impl<tkey, tvalue, compare, tag, augment>::search(*this, key));
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::infix_const_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::find(const tkey& key) const
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_const_iterator
+binary_search_tree<tkey, tvalue, compare, tag, augment>::find(const tkey& key) const
 {
-    node* current = _root;
-    while (current) {
-        if (compare_keys(key, current->data.first)) {
-            current = current->left_subtree;
-        } else if (compare_keys(current->data.first, key)) {
-            current = current->right_subtree;
-        } else {
-            return infix_const_iterator(current);
-        }
-    }
-    return infix_const_iterator(nullptr);
+    return infix_const_iterator(find_node(key));
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::lower_bound(const tkey& key)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_iterator
+binary_search_tree<tkey, tvalue, compare, tag, augment>::lower_bound(const tkey& key)
 {
-    node* current = _root;
-    node* result = nullptr;
-    while (current) {
-        if (!compare_keys(current->data.first, key)) {
-            result = current;
-            current = current->left_subtree;
-        } else {
-            current = current->right_subtree;
-        }
-    }
-    return infix_iterator(result);
+    return infix_iterator(lower_bound_node(key));
 }
 
-//node->key >= key
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::infix_const_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::lower_bound(const tkey& key) const
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_const_iterator
+binary_search_tree<tkey, tvalue, compare, tag, augment>::lower_bound(const tkey& key) const
 {
-    node* current = _root;
-    node* result = nullptr;
-    while (current) {
-        if (!compare_keys(current->data.first, key)) {
-            result = current;
-            current = current->left_subtree;
-        } else {
-            current = current->right_subtree;
-        }
-    }
-    return infix_const_iterator(result);
+    return infix_const_iterator(lower_bound_node(key));
 }
 
-//node->key > key
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::upper_bound(const tkey& key)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_iterator
+binary_search_tree<tkey, tvalue, compare, tag, augment>::upper_bound(const tkey& key)
 {
-    node* current = _root;
-    node* result = nullptr;
-    while (current) {
-        if (compare_keys(key, current->data.first)) {
-            result = current;
-            current = current->left_subtree;
-        } else {
-            current = current->right_subtree;
-        }
-    }
-    return infix_iterator(result);
+    return infix_iterator(upper_bound_node(key));
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::infix_const_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::upper_bound(const tkey& key) const
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_const_iterator
+binary_search_tree<tkey, tvalue, compare, tag, augment>::upper_bound(const tkey& key) const
 {
-    node* current = _root;
-    node* result = nullptr;
-    while (current) {
-        if (compare_keys(key, current->data.first)) {
-            result = current;
-            current = current->left_subtree;
-        } else {
-            current = current->right_subtree;
-        }
-    }
-    return infix_const_iterator(result);
+    return infix_const_iterator(upper_bound_node(key));
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+template<typename key_type> requires __detail::transparent_compator<compare, key_type, tkey>
+bool binary_search_tree<tkey, tvalue, compare, tag, augment>::contains(const key_type& key) const
+{
+    return find_node(key) != nullptr;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+template<typename key_type> requires __detail::transparent_compator<compare, key_type, tkey>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_iterator
+binary_search_tree<tkey, tvalue, compare, tag, augment>::find(const key_type& key)
+{
+    return infix_iterator(__detail::bst_impl<tkey, tvalue, compare, tag, augment>::search(*this, key));
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+template<typename key_type> requires __detail::transparent_compator<compare, key_type, tkey>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_const_iterator
+binary_search_tree<tkey, tvalue, compare, tag, augment>::find(const key_type& key) const
+{
+    return infix_const_iterator(find_node(key));
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+template<typename key_type> requires __detail::transparent_compator<compare, key_type, tkey>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_iterator
+binary_search_tree<tkey, tvalue, compare, tag, augment>::lower_bound(const key_type& key)
+{
+    return infix_iterator(lower_bound_node(key));
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+template<typename key_type> requires __detail::transparent_compator<compare, key_type, tkey>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_const_iterator
+binary_search_tree<tkey, tvalue, compare, tag, augment>::lower_bound(const key_type& key) const
+{
+    return infix_const_iterator(lower_bound_node(key));
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+template<typename key_type> requires __detail::transparent_compator<compare, key_type, tkey>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_iterator
+binary_search_tree<tkey, tvalue, compare, tag, augment>::upper_bound(const key_type& key)
+{
+    return infix_iterator(upper_bound_node(key));
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+template<typename key_type> requires __detail::transparent_compator<compare, key_type, tkey>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_const_iterator
+binary_search_tree<tkey, tvalue, compare, tag, augment>::upper_bound(const key_type& key) const
+{
+    return infix_const_iterator(upper_bound_node(key));
 }
 
 // 1. Удаление одного элемента по итератору
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::erase(infix_iterator pos)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_iterator
+binary_search_tree<tkey, tvalue, compare, tag, augment>::erase(infix_iterator pos)
 {
-    if (pos == end()) {
+    if (!pos._data) {
         return pos;
     }
 
     node* node_to_delete = pos._data;
     infix_iterator next = pos;
     ++next;
-    __detail::bst_impl<tkey, tvalue, compare, tag>::erase(*this, &node_to_delete);
+    __detail::bst_impl<tkey, tvalue, compare, tag, augment>::erase(*this, &node_to_delete);
 
-    --_size;
     return next;
 }
 
 // 2. Удаление по const итератору
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::erase(infix_const_iterator pos)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_iterator
+binary_search_tree<tkey, tvalue, compare, tag, augment>::erase(infix_const_iterator pos)
 {
-    return erase(infix_iterator(const_cast<value_type*>(&*pos)));
+    return erase(infix_iterator(const_cast<node*>(pos._base._data)));
 }
 
 // 3. Удаление диапазона обычных итераторов
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::erase(infix_iterator first, infix_iterator last)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_iterator
+binary_search_tree<tkey, tvalue, compare, tag, augment>::erase(infix_iterator first, infix_iterator last)
 {
     while (first != last) {
         first = erase(first);
@@ -2761,9 +3719,9 @@ binary_search_tree<tkey, tvalue, compare, tag>::erase(infix_iterator first, infi
 }
 
 // 4. Удаление диапазона константных итераторов
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::erase(infix_const_iterator first, infix_const_iterator last)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_iterator
+binary_search_tree<tkey, tvalue, compare, tag, augment>::erase(infix_const_iterator first, infix_const_iterator last)
 {
     return erase(
             infix_iterator(const_cast<node*>(first._base._data)),
@@ -2772,13 +3730,30 @@ binary_search_tree<tkey, tvalue, compare, tag>::erase(infix_const_iterator first
 }
 
 // 5. Удаление по ключу
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-size_t binary_search_tree<tkey, tvalue, compare, tag>::erase(const tkey& key)
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+size_t binary_search_tree<tkey, tvalue, compare, tag, augment>::erase(const tkey& key)
+{
+    node* node_to_delete = find_node(key);
+
+    if (node_to_delete) {
+        __detail::bst_impl<tkey, tvalue, compare, tag, augment>::erase(*this, &node_to_delete);
+        return 1;
+    }
+
+    return 0;
+}
+
+// 6. Удаление по ключу сравнимого типа
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+template<typename key_type> requires __detail::transparent_compator<compare, std::remove_cvref_t<key_type>, tkey> &&
+                                     (!std::convertible_to<key_type, typename binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_iterator>) &&
+                                     (!std::convertible_to<key_type, typename binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_const_iterator>)
+size_t binary_search_tree<tkey, tvalue, compare, tag, augment>::erase(key_type&& key)
 {
-    auto it = find(key); // Возвращает итератор, у которого есть _backup
+    node* node_to_delete = find_node(key);
 
-    if (it != end()) {
-        __detail::bst_impl<tkey, tvalue, compare, tag>::erase(*this, &it._data);
+    if (node_to_delete) {
+        __detail::bst_impl<tkey, tvalue, compare, tag, augment>::erase(*this, &node_to_delete);
         return 1;
     }
 
@@ -2787,11 +3762,171 @@ size_t binary_search_tree<tkey, tvalue, compare, tag>::erase(const tkey& key)
 
 // endregion binary_search_tree methods_search and methods_erase implementation
 
+// region binary_search_tree join-based set operations implementation
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+void binary_search_tree<tkey, tvalue, compare, tag, augment>::join(binary_search_tree&& greater)
+{
+    if (this == &greater)
+    {
+        throw std::logic_error("A tree cannot be joined with itself");
+    }
+    if (greater._root == nullptr)
+    {
+        return;
+    }
+    if (_root != nullptr && !compare_keys(rightmost(_root)->data.first, leftmost(greater._root)->data.first))
+    {
+        throw std::logic_error("Joined tree must hold greater keys only");
+    }
+
+    adopt_nodes(greater);
+
+    _root = join_subtrees(root_subtree(), greater.root_subtree()).root;
+    _root->set_parent(nullptr);
+    _size += std::exchange(greater._size, 0);
+    greater._root = nullptr;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+void binary_search_tree<tkey, tvalue, compare, tag, augment>::split(const tkey& key, binary_search_tree& greater)
+{
+    if (this == &greater)
+    {
+        throw std::logic_error("A tree cannot be split into itself");
+    }
+
+    greater.clear();
+    greater._allocator = _allocator;
+
+    auto [less, found, not_less] = split_subtree(root_subtree(), key);
+    if (found)
+    {
+        found->left_subtree = found->right_subtree = nullptr;
+        not_less = join_subtrees({ nullptr, 0 }, found, not_less);
+    }
+
+    _root = less.root;
+    greater._root = not_less.root;
+    for (node* root : { _root, greater._root })
+    {
+        if (root)
+        {
+            root->set_parent(nullptr);
+        }
+    }
+
+    if constexpr (counts_subtrees<augment>)
+    {
+        greater._size = subtree_size(greater._root);
+        _size -= greater._size;
+        return;
+    }
+
+    // both parts are walked in step, so only the smaller one is counted to its end
+    size_t total = _size;
+    size_t counted = 0;
+    node* lhs = leftmost(_root);
+    node* rhs = leftmost(greater._root);
+    for (; lhs && rhs; ++counted)
+    {
+        lhs = infix_successor(lhs);
+        rhs = infix_successor(rhs);
+    }
+    _size = lhs ? total - counted : counted;
+    greater._size = total - _size;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+void binary_search_tree<tkey, tvalue, compare, tag, augment>::set_union(binary_search_tree&& other)
+{
+    apply_set_operation(other, [this](ranked_subtree lhs, ranked_subtree rhs, dropped_subtrees& dropped, size_t spawn_depth)
+    {
+        return unite(lhs, rhs, dropped, spawn_depth);
+    });
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+void binary_search_tree<tkey, tvalue, compare, tag, augment>::set_intersection(binary_search_tree&& other)
+{
+    apply_set_operation(other, [this](ranked_subtree lhs, ranked_subtree rhs, dropped_subtrees& dropped, size_t spawn_depth)
+    {
+        return intersect(lhs, rhs, dropped, spawn_depth);
+    });
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+void binary_search_tree<tkey, tvalue, compare, tag, augment>::set_difference(binary_search_tree&& other)
+{
+    apply_set_operation(other, [this](ranked_subtree lhs, ranked_subtree rhs, dropped_subtrees& dropped, size_t spawn_depth)
+    {
+        return subtract(lhs, rhs, dropped, spawn_depth);
+    });
+}
+
+// endregion binary_search_tree join-based set operations implementation
+
+// region binary_search_tree order statistics implementation
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_iterator
+binary_search_tree<tkey, tvalue, compare, tag, augment>::select(size_t index)
+    requires counts_subtrees<augment>
+{
+    node* current = _root;
+    while (current)
+    {
+        size_t left_size = subtree_size(current->left_subtree);
+        if (index < left_size)
+        {
+            current = current->left_subtree;
+        }
+        else if (index == left_size)
+        {
+            return infix_iterator(current);
+        }
+        else
+        {
+            index -= left_size + 1;
+            current = current->right_subtree;
+        }
+    }
+    return end();
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_const_iterator
+binary_search_tree<tkey, tvalue, compare, tag, augment>::select(size_t index) const
+    requires counts_subtrees<augment>
+{
+    return const_cast<binary_search_tree*>(this)->select(index);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+size_t binary_search_tree<tkey, tvalue, compare, tag, augment>::rank(const tkey& key) const
+    requires counts_subtrees<augment>
+{
+    return count_less(key);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+size_t binary_search_tree<tkey, tvalue, compare, tag, augment>::count_range(const tkey& lower, const tkey& upper) const
+    requires counts_subtrees<augment>
+{
+    if (!compare_keys(lower, upper))
+    {
+        return 0;
+    }
+    return count_less(upper) - count_less(lower);
+}
+
+// endregion binary_search_tree order statistics implementation
+
 // region infix_iterators requests implementation
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::begin() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_iterator
+binary_search_tree<tkey, tvalue, compare, tag, augment>::begin() noexcept
 {
     node* current = _root;
     while (current && current->left_subtree)
@@ -2801,16 +3936,16 @@ binary_search_tree<tkey, tvalue, compare, tag>::begin() noexcept
     return infix_iterator(current);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::end() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_iterator
+binary_search_tree<tkey, tvalue, compare, tag, augment>::end() noexcept
 {
-    return infix_iterator(nullptr);
+    return end_infix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::infix_const_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::begin() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_const_iterator
+binary_search_tree<tkey, tvalue, compare, tag, augment>::begin() const noexcept
 {
     node* current = _root;
     while (current && current->left_subtree)
@@ -2820,30 +3955,30 @@ binary_search_tree<tkey, tvalue, compare, tag>::begin() const noexcept
     return infix_const_iterator(current);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::infix_const_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::end() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_const_iterator
+binary_search_tree<tkey, tvalue, compare, tag, augment>::end() const noexcept
 {
-    return infix_const_iterator(nullptr);
+    return end_infix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::infix_const_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::cbegin() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_const_iterator
+binary_search_tree<tkey, tvalue, compare, tag, augment>::cbegin() const noexcept
 {
     return begin();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::infix_const_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::cend() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_const_iterator
+binary_search_tree<tkey, tvalue, compare, tag, augment>::cend() const noexcept
 {
     return end();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::infix_reverse_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::rbegin() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_reverse_iterator
+binary_search_tree<tkey, tvalue, compare, tag, augment>::rbegin() noexcept
 {
     node* current = _root;
     while (current && current->right_subtree)
@@ -2853,16 +3988,16 @@ binary_search_tree<tkey, tvalue, compare, tag>::rbegin() noexcept
     return infix_reverse_iterator(current);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::infix_reverse_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::rend() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_reverse_iterator
+binary_search_tree<tkey, tvalue, compare, tag, augment>::rend() noexcept
 {
     return infix_reverse_iterator(nullptr);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::infix_const_reverse_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::rbegin() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_const_reverse_iterator
+binary_search_tree<tkey, tvalue, compare, tag, augment>::rbegin() const noexcept
 {
     node* current = _root;
     while (current && current->right_subtree)
@@ -2872,23 +4007,23 @@ binary_search_tree<tkey, tvalue, compare, tag>::rbegin() const noexcept
     return infix_const_reverse_iterator(current);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::infix_const_reverse_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::rend() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_const_reverse_iterator
+binary_search_tree<tkey, tvalue, compare, tag, augment>::rend() const noexcept
 {
     return infix_const_reverse_iterator(nullptr);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::infix_const_reverse_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::crbegin() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_const_reverse_iterator
+binary_search_tree<tkey, tvalue, compare, tag, augment>::crbegin() const noexcept
 {
     return rbegin();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::infix_const_reverse_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::crend() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_const_reverse_iterator
+binary_search_tree<tkey, tvalue, compare, tag, augment>::crend() const noexcept
 {
     return rend();
 }
@@ -2897,87 +4032,91 @@ binary_search_tree<tkey, tvalue, compare, tag>::crend() const noexcept
 
 // region prefix_iterators requests implementation
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::prefix_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::begin_prefix() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_iterator
+binary_search_tree<tkey, tvalue, compare, tag, augment>::begin_prefix() noexcept
 {
     node* current = _root;
     return prefix_iterator(current);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::prefix_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::end_prefix() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_iterator
+binary_search_tree<tkey, tvalue, compare, tag, augment>::end_prefix() noexcept
 {
-    return prefix_iterator(nullptr);
+    prefix_iterator it(nullptr);
+    it._backup = prefix_last(_root);
+    return it;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::prefix_const_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::begin_prefix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_const_iterator
+binary_search_tree<tkey, tvalue, compare, tag, augment>::begin_prefix() const noexcept
 {
     return prefix_const_iterator(_root);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::prefix_const_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::end_prefix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_const_iterator
+binary_search_tree<tkey, tvalue, compare, tag, augment>::end_prefix() const noexcept
 {
-    return prefix_const_iterator(nullptr);
+    prefix_iterator it(nullptr);
+    it._backup = prefix_last(_root);
+    return prefix_const_iterator(it);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::prefix_const_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::cbegin_prefix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_const_iterator
+binary_search_tree<tkey, tvalue, compare, tag, augment>::cbegin_prefix() const noexcept
 {
     return begin_prefix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::prefix_const_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::cend_prefix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_const_iterator
+binary_search_tree<tkey, tvalue, compare, tag, augment>::cend_prefix() const noexcept
 {
     return end_prefix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::prefix_reverse_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::rbegin_prefix() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_reverse_iterator
+binary_search_tree<tkey, tvalue, compare, tag, augment>::rbegin_prefix() noexcept
 {
-    return prefix_reverse_iterator(_root);
+    return prefix_reverse_iterator(prefix_last(_root));
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::prefix_reverse_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::rend_prefix() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_reverse_iterator
+binary_search_tree<tkey, tvalue, compare, tag, augment>::rend_prefix() noexcept
 {
     return prefix_reverse_iterator(nullptr);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::prefix_const_reverse_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::rbegin_prefix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_const_reverse_iterator
+binary_search_tree<tkey, tvalue, compare, tag, augment>::rbegin_prefix() const noexcept
 {
-    return prefix_const_reverse_iterator(_root);
+    return prefix_const_reverse_iterator(prefix_last(_root));
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::prefix_const_reverse_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::rend_prefix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_const_reverse_iterator
+binary_search_tree<tkey, tvalue, compare, tag, augment>::rend_prefix() const noexcept
 {
     return prefix_const_reverse_iterator(nullptr);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::prefix_const_reverse_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::crbegin_prefix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_const_reverse_iterator
+binary_search_tree<tkey, tvalue, compare, tag, augment>::crbegin_prefix() const noexcept
 {
     return rbegin_prefix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::prefix_const_reverse_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::crend_prefix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::prefix_const_reverse_iterator
+binary_search_tree<tkey, tvalue, compare, tag, augment>::crend_prefix() const noexcept
 {
     return rend_prefix();
 }
@@ -2986,9 +4125,9 @@ binary_search_tree<tkey, tvalue, compare, tag>::crend_prefix() const noexcept
 
 // region infix_iterators methods implementation
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::begin_infix() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_iterator
+binary_search_tree<tkey, tvalue, compare, tag, augment>::begin_infix() noexcept
 {
     node* current = _root;
     while (current && current->left_subtree)
@@ -2998,16 +4137,18 @@ binary_search_tree<tkey, tvalue, compare, tag>::begin_infix() noexcept
     return infix_iterator(current);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::infix_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::end_infix() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_iterator
+binary_search_tree<tkey, tvalue, compare, tag, augment>::end_infix() noexcept
 {
-    return infix_iterator(nullptr);
+    infix_iterator it(nullptr);
+    it._backup = rightmost(_root);
+    return it;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::infix_const_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::begin_infix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_const_iterator
+binary_search_tree<tkey, tvalue, compare, tag, augment>::begin_infix() const noexcept
 {
     node* current = _root;
     while (current && current->left_subtree)
@@ -3017,30 +4158,32 @@ binary_search_tree<tkey, tvalue, compare, tag>::begin_infix() const noexcept
     return infix_const_iterator(current);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::infix_const_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::end_infix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_const_iterator
+binary_search_tree<tkey, tvalue, compare, tag, augment>::end_infix() const noexcept
 {
-    return infix_const_iterator(nullptr);
+    infix_iterator it(nullptr);
+    it._backup = rightmost(_root);
+    return infix_const_iterator(it);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::infix_const_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::cbegin_infix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_const_iterator
+binary_search_tree<tkey, tvalue, compare, tag, augment>::cbegin_infix() const noexcept
 {
     return begin_infix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::infix_const_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::cend_infix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_const_iterator
+binary_search_tree<tkey, tvalue, compare, tag, augment>::cend_infix() const noexcept
 {
     return end_infix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::infix_reverse_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::rbegin_infix() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_reverse_iterator
+binary_search_tree<tkey, tvalue, compare, tag, augment>::rbegin_infix() noexcept
 {
     node* current = _root;
     while (current && current->right_subtree)
@@ -3050,16 +4193,16 @@ binary_search_tree<tkey, tvalue, compare, tag>::rbegin_infix() noexcept
     return infix_reverse_iterator(current);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::infix_reverse_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::rend_infix() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_reverse_iterator
+binary_search_tree<tkey, tvalue, compare, tag, augment>::rend_infix() noexcept
 {
     return infix_reverse_iterator(nullptr);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::infix_const_reverse_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::rbegin_infix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_const_reverse_iterator
+binary_search_tree<tkey, tvalue, compare, tag, augment>::rbegin_infix() const noexcept
 {
     node* current = _root;
     while (current && current->right_subtree)
@@ -3069,23 +4212,23 @@ binary_search_tree<tkey, tvalue, compare, tag>::rbegin_infix() const noexcept
     return infix_const_reverse_iterator(current);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::infix_const_reverse_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::rend_infix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_const_reverse_iterator
+binary_search_tree<tkey, tvalue, compare, tag, augment>::rend_infix() const noexcept
 {
     return infix_const_reverse_iterator(nullptr);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::infix_const_reverse_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::crbegin_infix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_const_reverse_iterator
+binary_search_tree<tkey, tvalue, compare, tag, augment>::crbegin_infix() const noexcept
 {
     return rbegin_infix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::infix_const_reverse_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::crend_infix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::infix_const_reverse_iterator
+binary_search_tree<tkey, tvalue, compare, tag, augment>::crend_infix() const noexcept
 {
     return rend_infix();
 }
@@ -3094,86 +4237,90 @@ binary_search_tree<tkey, tvalue, compare, tag>::crend_infix() const noexcept
 
 // region postfix_iterators requests implementation
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::postfix_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::begin_postfix() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_iterator
+binary_search_tree<tkey, tvalue, compare, tag, augment>::begin_postfix() noexcept
 {
-    return postfix_iterator(_root);
+    return postfix_iterator(postfix_first(_root));
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::postfix_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::end_postfix() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_iterator
+binary_search_tree<tkey, tvalue, compare, tag, augment>::end_postfix() noexcept
 {
-    return postfix_iterator(nullptr);
+    postfix_iterator it(nullptr);
+    it._backup = _root;
+    return it;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::postfix_const_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::begin_postfix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_const_iterator
+binary_search_tree<tkey, tvalue, compare, tag, augment>::begin_postfix() const noexcept
 {
-    return postfix_const_iterator(_root);
+    return postfix_const_iterator(postfix_first(_root));
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::postfix_const_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::end_postfix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_const_iterator
+binary_search_tree<tkey, tvalue, compare, tag, augment>::end_postfix() const noexcept
 {
-    return postfix_const_iterator(nullptr);
+    postfix_iterator it(nullptr);
+    it._backup = _root;
+    return postfix_const_iterator(it);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::postfix_const_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::cbegin_postfix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_const_iterator
+binary_search_tree<tkey, tvalue, compare, tag, augment>::cbegin_postfix() const noexcept
 {
-    return postfix_const_iterator(_root);
+    return begin_postfix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::postfix_const_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::cend_postfix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_const_iterator
+binary_search_tree<tkey, tvalue, compare, tag, augment>::cend_postfix() const noexcept
 {
     return end_postfix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::postfix_reverse_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::rbegin_postfix() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_reverse_iterator
+binary_search_tree<tkey, tvalue, compare, tag, augment>::rbegin_postfix() noexcept
 {
     return postfix_reverse_iterator(_root);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::postfix_reverse_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::rend_postfix() noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_reverse_iterator
+binary_search_tree<tkey, tvalue, compare, tag, augment>::rend_postfix() noexcept
 {
     return postfix_reverse_iterator(nullptr);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::postfix_const_reverse_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::rbegin_postfix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_const_reverse_iterator
+binary_search_tree<tkey, tvalue, compare, tag, augment>::rbegin_postfix() const noexcept
 {
     return postfix_const_reverse_iterator(_root);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::postfix_const_reverse_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::rend_postfix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_const_reverse_iterator
+binary_search_tree<tkey, tvalue, compare, tag, augment>::rend_postfix() const noexcept
 {
     return postfix_const_reverse_iterator(nullptr);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::postfix_const_reverse_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::crbegin_postfix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_const_reverse_iterator
+binary_search_tree<tkey, tvalue, compare, tag, augment>::crbegin_postfix() const noexcept
 {
     return rbegin_postfix();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-typename binary_search_tree<tkey, tvalue, compare, tag>::postfix_const_reverse_iterator
-binary_search_tree<tkey, tvalue, compare, tag>::crend_postfix() const noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+typename binary_search_tree<tkey, tvalue, compare, tag, augment>::postfix_const_reverse_iterator
+binary_search_tree<tkey, tvalue, compare, tag, augment>::crend_postfix() const noexcept
 {
     return rend_postfix();
 }
@@ -3184,56 +4331,60 @@ binary_search_tree<tkey, tvalue, compare, tag>::crend_postfix() const noexcept
 
 //region subtree rotations implementation
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-void binary_search_tree<tkey, tvalue, compare, tag>::small_left_rotation(node *&subtree_root) noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+void binary_search_tree<tkey, tvalue, compare, tag, augment>::small_left_rotation(node *&subtree_root) noexcept
 {   node* new_root = subtree_root->right_subtree;
     subtree_root->right_subtree = new_root->left_subtree;
     if (new_root->left_subtree != nullptr) {
-        new_root->left_subtree->parent = subtree_root;
+        new_root->left_subtree->set_parent(subtree_root);
     }
     new_root->left_subtree = subtree_root;
-    new_root->parent = subtree_root->parent;
-    subtree_root->parent = new_root;
+    new_root->set_parent(subtree_root->get_parent());
+    subtree_root->set_parent(new_root);
+    update_augmentation(subtree_root);
+    update_augmentation(new_root);
     subtree_root = new_root;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-void binary_search_tree<tkey, tvalue, compare, tag>::small_right_rotation(node *&subtree_root) noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+void binary_search_tree<tkey, tvalue, compare, tag, augment>::small_right_rotation(node *&subtree_root) noexcept
 {
     node* new_root = subtree_root->left_subtree;
     subtree_root->left_subtree = new_root->right_subtree;
     if (new_root->right_subtree != nullptr) {
-        new_root->right_subtree->parent = subtree_root;
+        new_root->right_subtree->set_parent(subtree_root);
     }
     new_root->right_subtree = subtree_root;
-    new_root->parent = subtree_root->parent;
-    subtree_root->parent = new_root;
+    new_root->set_parent(subtree_root->get_parent());
+    subtree_root->set_parent(new_root);
+    update_augmentation(subtree_root);
+    update_augmentation(new_root);
     subtree_root = new_root;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-void binary_search_tree<tkey, tvalue, compare, tag>::big_left_rotation(node *&subtree_root) noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+void binary_search_tree<tkey, tvalue, compare, tag, augment>::big_left_rotation(node *&subtree_root) noexcept
 {
     small_right_rotation(subtree_root->right_subtree);
     small_left_rotation(subtree_root);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-void binary_search_tree<tkey, tvalue, compare, tag>::big_right_rotation(node *&subtree_root) noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+void binary_search_tree<tkey, tvalue, compare, tag, augment>::big_right_rotation(node *&subtree_root) noexcept
 {
     small_left_rotation(subtree_root->left_subtree);
     small_right_rotation(subtree_root);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-void binary_search_tree<tkey, tvalue, compare, tag>::double_left_rotation(node *&subtree_root) noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+void binary_search_tree<tkey, tvalue, compare, tag, augment>::double_left_rotation(node *&subtree_root) noexcept
 {
     small_left_rotation(subtree_root->right_subtree);
     small_left_rotation(subtree_root);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, typename tag>
-void binary_search_tree<tkey, tvalue, compare, tag>::double_right_rotation(node *&subtree_root) noexcept
+template<typename tkey, typename tvalue, compator<tkey> compare, typename tag, typename augment>
+void binary_search_tree<tkey, tvalue, compare, tag, augment>::double_right_rotation(node *&subtree_root) noexcept
 {
     small_right_rotation(subtree_root->left_subtree);
     small_right_rotation(subtree_root);
@@ -3242,15 +4393,15 @@ void binary_search_tree<tkey, tvalue, compare, tag>::double_right_rotation(node
 //endregion subtree rotations implementation
 
 namespace __detail {
-    template<typename tkey, typename tvalue, typename compare, typename tag>
+    template<typename tkey, typename tvalue, typename compare, typename tag, typename augment>
     template<typename... Args>
-    typename binary_search_tree<tkey, tvalue, compare, tag>::node*
-    bst_impl<tkey, tvalue, compare, tag>::create_node(
-            binary_search_tree<tkey, tvalue, compare, tag>& cont,
-            typename binary_search_tree<tkey, tvalue, compare, tag>::node* parent,
+    typename binary_search_tree<tkey, tvalue, compare, tag, augment>::node*
+    bst_impl<tkey, tvalue, compare, tag, augment>::create_node(
+            binary_search_tree<tkey, tvalue, compare, tag, augment>& cont,
+            typename binary_search_tree<tkey, tvalue, compare, tag, augment>::node* parent,
             Args&&... args)
     {
-        using tree_type = binary_search_tree<tkey, tvalue, compare, tag>;
+        using tree_type = binary_search_tree<tkey, tvalue, compare, tag, augment>;
         using node_type = typename tree_type::node;
         pp_allocator<node_type> node_allocator(cont._allocator.resource());
         void* raw = node_allocator.allocate_bytes(sizeof(node_type), alignof(node_type));
@@ -3266,23 +4417,44 @@ namespace __detail {
         return new_node;
     }
 
-    template<typename tkey, typename tvalue, typename compare, typename tag>
-    void bst_impl<tkey, tvalue, compare, tag>::delete_node(
-            binary_search_tree<tkey, tvalue, compare, tag>& cont,
-            typename binary_search_tree<tkey, tvalue, compare, tag>::node* node_to_delete)
+    template<typename tkey, typename tvalue, typename compare, typename tag, typename augment>
+    void bst_impl<tkey, tvalue, compare, tag, augment>::delete_node(
+            binary_search_tree<tkey, tvalue, compare, tag, augment>& cont,
+            typename binary_search_tree<tkey, tvalue, compare, tag, augment>::node* node_to_delete)
     {
-        using node_t = typename binary_search_tree<tkey, tvalue, compare, tag>::node;
+        using node_t = typename binary_search_tree<tkey, tvalue, compare, tag, augment>::node;
 
         cont._allocator.template destroy<node_t>(node_to_delete);
         cont._allocator.deallocate_bytes(reinterpret_cast<void*>(node_to_delete), sizeof(node_t), alignof(node_t));
     }
 
-    template<typename tkey, typename tvalue, typename compare, typename tag>
-    void bst_impl<tkey, tvalue, compare, tag>::erase(
-            binary_search_tree<tkey, tvalue, compare, tag>& cont,
-            typename binary_search_tree<tkey, tvalue, compare, tag>::node** node_ptr)
+    template<typename tkey, typename tvalue, typename compare, typename tag, typename augment>
+    typename binary_search_tree<tkey, tvalue, compare, tag, augment>::ranked_subtree bst_impl<tkey, tvalue, compare, tag, augment>::join(
+            typename binary_search_tree<tkey, tvalue, compare, tag, augment>::ranked_subtree left,
+            typename binary_search_tree<tkey, tvalue, compare, tag, augment>::node* middle,
+            typename binary_search_tree<tkey, tvalue, compare, tag, augment>::ranked_subtree right) noexcept
+    {
+        middle->set_parent(nullptr);
+        middle->left_subtree = left.root;
+        middle->right_subtree = right.root;
+        if (left.root)
+        {
+            left.root->set_parent(middle);
+        }
+        if (right.root)
+        {
+            right.root->set_parent(middle);
+        }
+        binary_search_tree<tkey, tvalue, compare, tag, augment>::update_augmentation(middle);
+        return { middle, 0 };
+    }
+
+    template<typename tkey, typename tvalue, typename compare, typename tag, typename augment>
+    void bst_impl<tkey, tvalue, compare, tag, augment>::erase(
+            binary_search_tree<tkey, tvalue, compare, tag, augment>& cont,
+            typename binary_search_tree<tkey, tvalue, compare, tag, augment>::node** node_ptr)
     {
-        using node_type = typename binary_search_tree<tkey, tvalue, compare, tag>::node;
+        using node_type = typename binary_search_tree<tkey, tvalue, compare, tag, augment>::node;
         node_type* node = *node_ptr;
 
         if (!node)
@@ -3291,18 +4463,20 @@ namespace __detail {
         }
         const bool has_left = node->left_subtree != nullptr;
         const bool has_right = node->right_subtree != nullptr;
+        // lowest node whose subtree lost an element
+        node_type* changed = node->get_parent();
 
         if (!has_left && !has_right)
         {
-            if (node->parent)
+            if (node->get_parent())
             {
-                if (node->parent->left_subtree == node)
+                if (node->get_parent()->left_subtree == node)
                 {
-                    node->parent->left_subtree = nullptr;
+                    node->get_parent()->left_subtree = nullptr;
                 }
                 else
                 {
-                    node->parent->right_subtree = nullptr;
+                    node->get_parent()->right_subtree = nullptr;
                 }
             }
             else
@@ -3315,17 +4489,17 @@ namespace __detail {
         else if (has_left != has_right)
         {
             node_type* child = has_left ? node->left_subtree : node->right_subtree;
-            child->parent = node->parent;
+            child->set_parent(node->get_parent());
 
-            if (node->parent)
+            if (node->get_parent())
             {
-                if (node->parent->left_subtree == node)
+                if (node->get_parent()->left_subtree == node)
                 {
-                    node->parent->left_subtree = child;
+                    node->get_parent()->left_subtree = child;
                 }
                 else
                 {
-                    node->parent->right_subtree = child;
+                    node->get_parent()->right_subtree = child;
                 }
             }
             else
@@ -3344,43 +4518,45 @@ namespace __detail {
                 successor_ptr = &((*successor_ptr)->right_subtree);
             }
             node_type* successor = *successor_ptr;
-            if (successor->parent->left_subtree == successor)
+            changed = successor->get_parent() == node ? successor : successor->get_parent();
+            // the rightmost node of the left subtree can only have a left child
+            if (successor->get_parent()->left_subtree == successor)
             {
-                successor->parent->left_subtree = successor->right_subtree;
+                successor->get_parent()->left_subtree = successor->left_subtree;
             }
             else
             {
-                successor->parent->right_subtree = successor->right_subtree;
+                successor->get_parent()->right_subtree = successor->left_subtree;
             }
 
-            if (successor->right_subtree)
+            if (successor->left_subtree)
             {
-                successor->right_subtree->parent = successor->parent;
+                successor->left_subtree->set_parent(successor->get_parent());
             }
 
             successor->left_subtree = node->left_subtree;
             if (successor->left_subtree)
             {
-                successor->left_subtree->parent = successor;
+                successor->left_subtree->set_parent(successor);
             }
 
             successor->right_subtree = node->right_subtree;
             if (successor->right_subtree)
             {
-                successor->right_subtree->parent = successor;
+                successor->right_subtree->set_parent(successor);
             }
 
-            successor->parent = node->parent;
+            successor->set_parent(node->get_parent());
 
-            if (node->parent)
+            if (node->get_parent())
             {
-                if (node->parent->left_subtree == node)
+                if (node->get_parent()->left_subtree == node)
                 {
-                    node->parent->left_subtree = successor;
+                    node->get_parent()->left_subtree = successor;
                 }
                 else
                 {
-                    node->parent->right_subtree = successor;
+                    node->get_parent()->right_subtree = successor;
                 }
             }
             else
@@ -3391,6 +4567,9 @@ namespace __detail {
             delete_node(cont, node);
             *node_ptr = successor;
         }
+
+        --cont._size;
+        cont.update_augmentation_to_root(changed);
     }
 
 }
@@ -10,17 +10,25 @@ namespace __detail
     template<typename tkey, typename tvalue, typename compare>
     class bst_impl<tkey, tvalue, compare, RB_TAG>
     {
+        friend class binary_search_tree<tkey, tvalue, compare, RB_TAG>;
         template<class ...Args>
         static binary_search_tree<tkey, tvalue, compare, RB_TAG>::node* create_node(binary_search_tree<tkey, tvalue, compare, RB_TAG>& cont, Args&& ...args);
 
         static void delete_node(binary_search_tree<tkey, tvalue, compare, RB_TAG>& cont);
 
-        //Does not invalidate node*, needed for splay tree
-        static void post_search(binary_search_tree<tkey, tvalue, compare, RB_TAG>::node**){}
+        //Lookup behind the non-const find and at, a splay tree restructures around the path it took
+        template<typename key_type>
+        static binary_search_tree<tkey, tvalue, compare, RB_TAG>::node* search(binary_search_tree<tkey, tvalue, compare, RB_TAG>& cont, const key_type& key)
+        {
+            return cont.find_node(key);
+        }
 
         //Does not invalidate node*
         static void post_insert(binary_search_tree<tkey, tvalue, compare, RB_TAG>& cont, binary_search_tree<tkey, tvalue, compare, RB_TAG>::node**);
 
+        static void post_build(binary_search_tree<tkey, tvalue, compare, RB_TAG>& cont, binary_search_tree<tkey, tvalue, compare, RB_TAG>::node* built,
+                               size_t subtree_size, bool on_last_level);
+
         static void erase(binary_search_tree<tkey, tvalue, compare, RB_TAG>& cont, binary_search_tree<tkey, tvalue, compare, RB_TAG>::node**);
 
         static void swap(binary_search_tree<tkey, tvalue, compare, RB_TAG>& lhs, binary_search_tree<tkey, tvalue, compare, RB_TAG>& rhs) noexcept;
@@ -42,16 +50,19 @@ public:
 private:
 
     using parent = binary_search_tree<tkey, tvalue, compare, __detail::RB_TAG>;
+    friend class __detail::bst_impl<tkey, tvalue, compare, __detail::RB_TAG>;
     
+    /** Color is kept in the tag bits of the parent link
+     */
     struct node final:
         parent::node
     {
-        node_color color;
+        node_color get_color() const noexcept;
+
+        void set_color(node_color color) noexcept;
 
         template<class ...Args>
         node(parent::node* par, Args&&... args);
-
-        ~node() noexcept override =default;
     };
 
 
@@ -606,6 +617,20 @@ namespace __detail {
         throw not_implemented("template<typename tkey, typename tvalue, typename compare> void bst_impl<tkey, tvalue, compare, RB_TAG>::post_insert(binary_search_tree<tkey, tvalue, compare, RB_TAG>& cont, typename binary_search_tree<tkey, tvalue, compare, RB_TAG>::node**)", "your code should be here...");
     }
 
+    template<typename tkey, typename tvalue, typename compare>
+    void bst_impl<tkey, tvalue, compare, RB_TAG>::post_build(
+            binary_search_tree<tkey, tvalue, compare, RB_TAG>&,
+            typename binary_search_tree<tkey, tvalue, compare, RB_TAG>::node* built,
+            size_t,
+            bool on_last_level)
+    {
+        using node_type = typename red_black_tree<tkey, tvalue, compare>::node;
+        using node_color = typename red_black_tree<tkey, tvalue, compare>::node_color;
+
+        // every level above the last is full, so all paths count the same blacks when only the last level is red
+        static_cast<node_type*>(built)->set_color(on_last_level && built->get_parent() ? node_color::RED : node_color::BLACK);
+    }
+
     template<typename tkey, typename tvalue, typename compare>
     void bst_impl<tkey, tvalue, compare, RB_TAG>::erase(
             binary_search_tree<tkey, tvalue, compare, RB_TAG>& cont,
@@ -628,8 +653,21 @@ namespace __detail {
 template<typename tkey, typename tvalue, compator<tkey> compare>
 template<class ...Args>
 red_black_tree<tkey, tvalue, compare>::node::node(parent::node* par, Args&&... args)
+        : parent::node(par, std::forward<Args>(args)...)
+{
+    set_color(node_color::RED);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+typename red_black_tree<tkey, tvalue, compare>::node_color red_black_tree<tkey, tvalue, compare>::node::get_color() const noexcept
+{
+    return static_cast<node_color>(this->get_tag());
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+void red_black_tree<tkey, tvalue, compare>::node::set_color(node_color color) noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare> template<class ...Args> red_black_tree<tkey, tvalue, compare>::node::node(parent::node* par, Args&&... args)", "your code should be here...");
+    this->set_tag(static_cast<unsigned char>(color));
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
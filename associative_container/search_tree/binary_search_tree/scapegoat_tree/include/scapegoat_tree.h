@@ -14,17 +14,48 @@ namespace __detail
         template<class ...Args>
         static binary_search_tree<tkey, tvalue, compare, SPG_TAG>::node* create_node(binary_search_tree<tkey, tvalue, compare, SPG_TAG>& cont, Args&& ...args);
 
-        static void delete_node(binary_search_tree<tkey, tvalue, compare, SPG_TAG>& cont);
+        static void delete_node(binary_search_tree<tkey, tvalue, compare, SPG_TAG>& cont, binary_search_tree<tkey, tvalue, compare, SPG_TAG>::node*);
 
-        //Does not invalidate node*, needed for splay tree
-        static void post_search(binary_search_tree<tkey, tvalue, compare, SPG_TAG>::node**){}
+        //Lookup behind the non-const find and at, a splay tree restructures around the path it took
+        template<typename key_type>
+        static binary_search_tree<tkey, tvalue, compare, SPG_TAG>::node* search(binary_search_tree<tkey, tvalue, compare, SPG_TAG>& cont, const key_type& key)
+        {
+            return cont.find_node(key);
+        }
 
         //Does not invalidate node*
         static void post_insert(binary_search_tree<tkey, tvalue, compare, SPG_TAG>& cont, binary_search_tree<tkey, tvalue, compare, SPG_TAG>::node**);
 
+        static void post_build(binary_search_tree<tkey, tvalue, compare, SPG_TAG>& cont, binary_search_tree<tkey, tvalue, compare, SPG_TAG>::node* built,
+                               size_t subtree_size, bool on_last_level);
+
         static void erase(binary_search_tree<tkey, tvalue, compare, SPG_TAG>& cont, binary_search_tree<tkey, tvalue, compare, SPG_TAG>::node**);
 
         static void swap(binary_search_tree<tkey, tvalue, compare, SPG_TAG>& lhs, binary_search_tree<tkey, tvalue, compare, SPG_TAG>& rhs) noexcept;
+
+        static size_t subtree_rank(binary_search_tree<tkey, tvalue, compare, SPG_TAG>::node*) noexcept { return 0; }
+
+        static size_t child_rank(binary_search_tree<tkey, tvalue, compare, SPG_TAG>::node*, size_t, bool) noexcept { return 0; }
+
+        //Links without rebalancing, the next update on a path through middle rebuilds what went out of balance
+        static binary_search_tree<tkey, tvalue, compare, SPG_TAG>::ranked_subtree join(
+                binary_search_tree<tkey, tvalue, compare, SPG_TAG>::ranked_subtree left,
+                binary_search_tree<tkey, tvalue, compare, SPG_TAG>::node* middle,
+                binary_search_tree<tkey, tvalue, compare, SPG_TAG>::ranked_subtree right) noexcept;
+
+        //Recounts the sizes from lowest up to the root and rebuilds the highest node left out of balance
+        static void rebalance_path(binary_search_tree<tkey, tvalue, compare, SPG_TAG>& cont, binary_search_tree<tkey, tvalue, compare, SPG_TAG>::node* lowest) noexcept;
+
+        //Relinks a subtree into one of minimal height without allocating: right rotations turn it into a list
+        //through the right links, which is then consumed in order. O(size), the recursion is only log2(size) deep
+        static void rebuild(binary_search_tree<tkey, tvalue, compare, SPG_TAG>& cont, binary_search_tree<tkey, tvalue, compare, SPG_TAG>::node* subtree_root) noexcept;
+
+        static binary_search_tree<tkey, tvalue, compare, SPG_TAG>::node* flatten(binary_search_tree<tkey, tvalue, compare, SPG_TAG>::node* subtree_root) noexcept;
+
+        static binary_search_tree<tkey, tvalue, compare, SPG_TAG>::node* link_list(binary_search_tree<tkey, tvalue, compare, SPG_TAG>::node*& list, size_t count) noexcept;
+
+    public:
+        friend class binary_search_tree<tkey, tvalue, compare, SPG_TAG>;
     };
 }
 
@@ -36,7 +67,10 @@ class scapegoat_tree final:
 private:
 
     using parent = binary_search_tree<tkey, tvalue, compare, __detail::SPG_TAG>;
-    
+    friend class __detail::bst_impl<tkey, tvalue, compare, __detail::SPG_TAG>;
+
+    /** The subtree size is kept up to date by every update, so finding a scapegoat never counts nodes
+     */
     struct node final:
         parent::node
     {
@@ -48,9 +82,14 @@ private:
         template<class ...Args>
         node(parent::node* par, Args&&... args);
 
+        static size_t size_of(parent::node* subtree_root) noexcept;
+
         void recalculate_size() noexcept;
+
+        /** A child holds more than alpha of the subtree
+         */
         bool is_disbalanced(double alpha) noexcept;
-        
+
     };
 
 public:
@@ -83,21 +122,28 @@ public:
             logger* log = nullptr, double alpha = 0.7);
 
 public:
-    
+
     ~scapegoat_tree() noexcept final;
-    
+
     scapegoat_tree(scapegoat_tree const &other);
-    
+
     scapegoat_tree &operator=(scapegoat_tree const &other);
-    
+
     scapegoat_tree(scapegoat_tree &&other) noexcept;
-    
+
     scapegoat_tree &operator=(scapegoat_tree &&other) noexcept;
 
+    void swap(parent& other) noexcept override;
+
 public:
-    
+
+    /** Alpha in [0.5, 1]: lower keeps the tree closer to perfect balance at the price of more rebuilds,
+     *  1 never rebuilds. Applies from the next update. Throws std::invalid_argument outside that range
+     */
     void setup_alpha(double alpha);
 
+    double get_alpha() const noexcept;
+
 private:
 
     double _alpha;
@@ -118,37 +164,268 @@ scapegoat_tree(std::initializer_list<std::pair<tkey, tvalue>> data, const compar
         pp_allocator<U> alloc = pp_allocator<U>(),
         logger* log = nullptr, double alpha = 0.7) -> scapegoat_tree<tkey, tvalue, compare>;
 
+namespace __detail
+{
+    template<typename tkey, typename tvalue, typename compare>
+    template<class ...Args>
+    typename binary_search_tree<tkey, tvalue, compare, SPG_TAG>::node* bst_impl<tkey, tvalue, compare, SPG_TAG>::create_node(
+            binary_search_tree<tkey, tvalue, compare, SPG_TAG>& cont, Args&& ...args)
+    {
+        using node_type = typename scapegoat_tree<tkey, tvalue, compare>::node;
+        return cont._allocator.template new_object<node_type>(std::forward<Args>(args)...);
+    }
+
+    template<typename tkey, typename tvalue, typename compare>
+    void bst_impl<tkey, tvalue, compare, SPG_TAG>::delete_node(
+            binary_search_tree<tkey, tvalue, compare, SPG_TAG>& cont, binary_search_tree<tkey, tvalue, compare, SPG_TAG>::node* node)
+    {
+        using node_type = typename scapegoat_tree<tkey, tvalue, compare>::node;
+        if (node)
+        {
+            cont._allocator.template delete_object<node_type>(static_cast<node_type*>(node));
+        }
+    }
+
+    template<typename tkey, typename tvalue, typename compare>
+    void bst_impl<tkey, tvalue, compare, SPG_TAG>::post_build(
+            binary_search_tree<tkey, tvalue, compare, SPG_TAG>&,
+            typename binary_search_tree<tkey, tvalue, compare, SPG_TAG>::node* built,
+            size_t subtree_size,
+            bool)
+    {
+        static_cast<typename scapegoat_tree<tkey, tvalue, compare>::node*>(built)->size = subtree_size;
+    }
+
+    template<typename tkey, typename tvalue, typename compare>
+    void bst_impl<tkey, tvalue, compare, SPG_TAG>::post_insert(
+            binary_search_tree<tkey, tvalue, compare, SPG_TAG>& cont,
+            typename binary_search_tree<tkey, tvalue, compare, SPG_TAG>::node** node)
+    {
+        rebalance_path(cont, (*node)->get_parent());
+    }
+
+    template<typename tkey, typename tvalue, typename compare>
+    void bst_impl<tkey, tvalue, compare, SPG_TAG>::rebalance_path(
+            binary_search_tree<tkey, tvalue, compare, SPG_TAG>& cont,
+            typename binary_search_tree<tkey, tvalue, compare, SPG_TAG>::node* lowest) noexcept
+    {
+        using node_type = typename scapegoat_tree<tkey, tvalue, compare>::node;
+
+        const double alpha = static_cast<scapegoat_tree<tkey, tvalue, compare>&>(cont)._alpha;
+        node_type* scapegoat = nullptr;
+        for (auto* current = lowest; current; current = current->get_parent())
+        {
+            auto* counted = static_cast<node_type*>(current);
+            counted->recalculate_size();
+            if (counted->is_disbalanced(alpha))
+            {
+                scapegoat = counted;
+            }
+        }
+
+        if (scapegoat)
+        {
+            rebuild(cont, scapegoat);
+        }
+    }
+
+    template<typename tkey, typename tvalue, typename compare>
+    typename binary_search_tree<tkey, tvalue, compare, SPG_TAG>::node* bst_impl<tkey, tvalue, compare, SPG_TAG>::flatten(
+            typename binary_search_tree<tkey, tvalue, compare, SPG_TAG>::node* subtree_root) noexcept
+    {
+        using node_type = typename binary_search_tree<tkey, tvalue, compare, SPG_TAG>::node;
+
+        // every rotation moves one node onto the list for good, so there are fewer than size of them
+        node_type* head = subtree_root;
+        node_type** link = &head;
+        while (*link)
+        {
+            node_type* current = *link;
+            if (current->left_subtree)
+            {
+                node_type* child = current->left_subtree;
+                current->left_subtree = child->right_subtree;
+                child->right_subtree = current;
+                *link = child;
+            }
+            else
+            {
+                link = &current->right_subtree;
+            }
+        }
+        return head;
+    }
+
+    template<typename tkey, typename tvalue, typename compare>
+    typename binary_search_tree<tkey, tvalue, compare, SPG_TAG>::node* bst_impl<tkey, tvalue, compare, SPG_TAG>::link_list(
+            typename binary_search_tree<tkey, tvalue, compare, SPG_TAG>::node*& list, size_t count) noexcept
+    {
+        using node_type = typename scapegoat_tree<tkey, tvalue, compare>::node;
+
+        if (count == 0)
+        {
+            return nullptr;
+        }
+
+        // the same split as a bulk build: the middle is count / 2, the left half never larger
+        auto* left = link_list(list, count / 2);
+        auto* subtree_root = static_cast<node_type*>(list);
+        list = list->right_subtree;
+
+        subtree_root->left_subtree = left;
+        if (left)
+        {
+            left->set_parent(subtree_root);
+        }
+        subtree_root->right_subtree = link_list(list, count - count / 2 - 1);
+        if (subtree_root->right_subtree)
+        {
+            subtree_root->right_subtree->set_parent(subtree_root);
+        }
+        subtree_root->size = count;
+        return subtree_root;
+    }
+
+    template<typename tkey, typename tvalue, typename compare>
+    void bst_impl<tkey, tvalue, compare, SPG_TAG>::rebuild(
+            binary_search_tree<tkey, tvalue, compare, SPG_TAG>& cont,
+            typename binary_search_tree<tkey, tvalue, compare, SPG_TAG>::node* subtree_root) noexcept
+    {
+        auto* above = subtree_root->get_parent();
+        auto*& link = above ? (above->left_subtree == subtree_root ? above->left_subtree : above->right_subtree) : cont._root;
+
+        auto* list = flatten(subtree_root);
+        link = link_list(list, scapegoat_tree<tkey, tvalue, compare>::node::size_of(subtree_root));
+        link->set_parent(above);
+    }
+
+    template<typename tkey, typename tvalue, typename compare>
+    void bst_impl<tkey, tvalue, compare, SPG_TAG>::erase(
+            binary_search_tree<tkey, tvalue, compare, SPG_TAG>& cont,
+            typename binary_search_tree<tkey, tvalue, compare, SPG_TAG>::node** node_ptr)
+    {
+        using tree_type = binary_search_tree<tkey, tvalue, compare, SPG_TAG>;
+        using node_type = typename tree_type::node;
+
+        node_type* target = *node_ptr;
+        if (!target)
+        {
+            return;
+        }
+
+        node_type* above = target->get_parent();
+        node_type*& link = above ? (above->left_subtree == target ? above->left_subtree : above->right_subtree) : cont._root;
+
+        // lowest node whose subtree lost an element
+        node_type* lowest = above;
+        node_type* replacement = target->left_subtree ? target->left_subtree : target->right_subtree;
+
+        if (target->left_subtree && target->right_subtree)
+        {
+            replacement = tree_type::rightmost(target->left_subtree);
+            lowest = replacement;
+            if (replacement != target->left_subtree)
+            {
+                lowest = replacement->get_parent();
+                lowest->right_subtree = replacement->left_subtree;
+                if (replacement->left_subtree)
+                {
+                    replacement->left_subtree->set_parent(lowest);
+                }
+                replacement->left_subtree = target->left_subtree;
+                replacement->left_subtree->set_parent(replacement);
+            }
+            replacement->right_subtree = target->right_subtree;
+            replacement->right_subtree->set_parent(replacement);
+        }
+
+        if (replacement)
+        {
+            replacement->set_parent(above);
+        }
+        link = replacement;
+
+        delete_node(cont, target);
+        --cont._size;
+        *node_ptr = replacement;
+
+        rebalance_path(cont, lowest);
+    }
+
+    template<typename tkey, typename tvalue, typename compare>
+    void bst_impl<tkey, tvalue, compare, SPG_TAG>::swap(
+            binary_search_tree<tkey, tvalue, compare, SPG_TAG>& lhs,
+            binary_search_tree<tkey, tvalue, compare, SPG_TAG>& rhs) noexcept
+    {
+        std::swap(lhs._root, rhs._root);
+        std::swap(lhs._size, rhs._size);
+        std::swap(lhs._allocator, rhs._allocator);
+        std::swap(lhs._logger, rhs._logger);
+    }
+
+    template<typename tkey, typename tvalue, typename compare>
+    typename binary_search_tree<tkey, tvalue, compare, SPG_TAG>::ranked_subtree bst_impl<tkey, tvalue, compare, SPG_TAG>::join(
+            typename binary_search_tree<tkey, tvalue, compare, SPG_TAG>::ranked_subtree left,
+            typename binary_search_tree<tkey, tvalue, compare, SPG_TAG>::node* middle,
+            typename binary_search_tree<tkey, tvalue, compare, SPG_TAG>::ranked_subtree right) noexcept
+    {
+        middle->set_parent(nullptr);
+        middle->left_subtree = left.root;
+        middle->right_subtree = right.root;
+        if (left.root)
+        {
+            left.root->set_parent(middle);
+        }
+        if (right.root)
+        {
+            right.root->set_parent(middle);
+        }
+        static_cast<typename scapegoat_tree<tkey, tvalue, compare>::node*>(middle)->recalculate_size();
+        return { middle, 0 };
+    }
+}
+
 // region implementation
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 scapegoat_tree<tkey, tvalue, compare>::node::node(tkey const &key_, tvalue &&value_)
+        : parent::node(nullptr, key_, std::move(value_)),
+          size(1)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare> scapegoat_tree<tkey, tvalue, compare>::node::node(tkey const &key_, tvalue &&value_)", "your code should be here...");
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 scapegoat_tree<tkey, tvalue, compare>::node::node(tkey const &key_, const tvalue& value_)
+        : parent::node(nullptr, key_, value_),
+          size(1)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare> scapegoat_tree<tkey, tvalue, compare>::node::node(tkey const &key_, const tvalue& value_)", "your code should be here...");
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 template<class ...Args>
 scapegoat_tree<tkey, tvalue, compare>::node::node(parent::node* par, Args&&... args)
+        : parent::node(par, std::forward<Args>(args)...),
+          size(1)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare> template<class ...Args> scapegoat_tree<tkey, tvalue, compare>::node::node(parent::node* par, Args&&... args)", "your code should be here...");
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+size_t scapegoat_tree<tkey, tvalue, compare>::node::size_of(parent::node* subtree_root) noexcept
+{
+    return subtree_root ? static_cast<node*>(subtree_root)->size : 0;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 void scapegoat_tree<tkey, tvalue, compare>::node::recalculate_size() noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare> void scapegoat_tree<tkey, tvalue, compare>::node::recalculate_size() noexcept ", "your code should be here...");
+    size = 1 + size_of(this->left_subtree) + size_of(this->right_subtree);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 bool scapegoat_tree<tkey, tvalue, compare>::node::is_disbalanced(double alpha) noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare> bool scapegoat_tree<tkey, tvalue, compare>::node::is_disbalanced(double alpha) noexcept ", "your code should be here...");
+    const size_t heavier = std::max(size_of(this->left_subtree), size_of(this->right_subtree));
+    return static_cast<double>(heavier) > alpha * static_cast<double>(size);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
@@ -156,9 +433,9 @@ scapegoat_tree<tkey, tvalue, compare>::scapegoat_tree(
         const compare& comp,
         pp_allocator<value_type> alloc,
         logger *log,
-        double alpha)
+        double alpha) : parent(comp, alloc, log)
 {
-    throw not_implemented("emplate<typename tkey, typename tvalue, compator<tkey> compare> scapegoat_tree<tkey, tvalue, compare>::scapegoat_tree(const compare& comp, pp_allocator<value_type> alloc, logger *log, double alpha)", "your code should be here...");
+    setup_alpha(alpha);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
@@ -166,9 +443,9 @@ scapegoat_tree<tkey, tvalue, compare>::scapegoat_tree(
         pp_allocator<value_type> alloc,
         const compare& comp,
         logger *log,
-        double alpha)
+        double alpha) : parent(comp, alloc, log)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare> scapegoat_tree<tkey, tvalue, compare>::scapegoat_tree(pp_allocator<value_type> alloc, const compare& comp, logger *log, double alpha)", "your code should be here...");
+    setup_alpha(alpha);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
@@ -179,9 +456,11 @@ scapegoat_tree<tkey, tvalue, compare>::scapegoat_tree(
         const compare& cmp,
         pp_allocator<value_type> alloc,
         logger* log,
-        double alpha)
+        double alpha) : parent(cmp, alloc, log)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare> template<input_iterator_for_pair<tkey, tvalue> iterator> scapegoat_tree<tkey, tvalue, compare>::scapegoat_tree(iterator begin, iterator end, const compare& cmp, pp_allocator<value_type> alloc, logger* log,double alpha)", "your code should be here...");
+    // alpha has to be set before the first insertion looks for a scapegoat
+    setup_alpha(alpha);
+    this->insert(begin, end);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
@@ -191,9 +470,10 @@ scapegoat_tree<tkey, tvalue, compare>::scapegoat_tree(
         const compare& cmp,
         pp_allocator<value_type> alloc,
         logger* log,
-        double alpha)
+        double alpha) : parent(cmp, alloc, log)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare> template<std::ranges::input_range Range>scapegoat_tree<tkey, tvalue, compare>::scapegoat_tree(Range&& range, const compare& cmp, pp_allocator<value_type> alloc, logger* log, double alpha)", "your code should be here...");
+    setup_alpha(alpha);
+    this->insert_range(std::forward<Range>(range));
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
@@ -202,47 +482,81 @@ scapegoat_tree<tkey, tvalue, compare>::scapegoat_tree(
         const compare& cmp,
         pp_allocator<value_type> alloc,
         logger* log,
-        double alpha)
+        double alpha) : parent(cmp, alloc, log)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare> scapegoat_tree<tkey, tvalue, compare>::scapegoat_tree(std::initializer_list<std::pair<tkey, tvalue>> data, const compare& cmp, pp_allocator<value_type> alloc, logger* log, double alpha)", "your code should be here...");
+    setup_alpha(alpha);
+    this->insert_range(data);
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 scapegoat_tree<tkey, tvalue, compare>::~scapegoat_tree() noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare> scapegoat_tree<tkey, tvalue, compare>::~scapegoat_tree() noexcept", "your code should be here...");
+    // the erase hook reads this tree's settings, which are gone once the base destructor runs
+    this->clear();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 scapegoat_tree<tkey, tvalue, compare>::scapegoat_tree(scapegoat_tree const &other)
+        : parent(other),
+          _alpha(other._alpha)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare> scapegoat_tree<tkey, tvalue, compare>::scapegoat_tree(scapegoat_tree const &other)", "your code should be here...");
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 scapegoat_tree<tkey, tvalue, compare> &scapegoat_tree<tkey, tvalue, compare>::operator=(scapegoat_tree const &other)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare> scapegoat_tree<tkey, tvalue, compare> &scapegoat_tree<tkey, tvalue, compare>::operator=(scapegoat_tree const &other) ", "your code should be here...");
+    if (this != &other)
+    {
+        parent::operator=(other);
+        _alpha = other._alpha;
+    }
+    return *this;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 scapegoat_tree<tkey, tvalue, compare>::scapegoat_tree(scapegoat_tree &&other) noexcept
+        : parent(std::move(other)),
+          _alpha(other._alpha)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare> scapegoat_tree<tkey, tvalue, compare>::scapegoat_tree(scapegoat_tree &&other) noexcept", "your code should be here...");
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 scapegoat_tree<tkey, tvalue, compare> &scapegoat_tree<tkey, tvalue, compare>::operator=(scapegoat_tree &&other) noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare> scapegoat_tree<tkey, tvalue, compare> &scapegoat_tree<tkey, tvalue, compare>::operator=(scapegoat_tree &&other) noexcept", "your code should be here...");
+    if (this != &other)
+    {
+        parent::operator=(std::move(other));
+        _alpha = other._alpha;
+    }
+    return *this;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+void scapegoat_tree<tkey, tvalue, compare>::swap(parent& other) noexcept
+{
+    if (this != &other)
+    {
+        parent::swap(other);
+        std::swap(_alpha, static_cast<scapegoat_tree&>(other)._alpha);
+    }
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 void scapegoat_tree<tkey, tvalue, compare>::setup_alpha(double alpha)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare> void scapegoat_tree<tkey, tvalue, compare>::setup_alpha(double alpha)", "your code should be here...");
+    if (!(alpha >= 0.5 && alpha <= 1))
+    {
+        throw std::invalid_argument("Scapegoat tree alpha must lie in [0.5, 1]");
+    }
+    _alpha = alpha;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+double scapegoat_tree<tkey, tvalue, compare>::get_alpha() const noexcept
+{
+    return _alpha;
 }
 
 // endregion implementation
 
-#endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_SCAPEGOAT_TREE_H
\ No newline at end of file
+#endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_SCAPEGOAT_TREE_H
@@ -3,6 +3,7 @@
 #include <logger_builder.h>
 #include <client_logger_builder.h>
 #include <iostream>
+#include <cmath>
 
 
 logger *create_logger(
@@ -517,6 +518,61 @@ TEST(scapegoatTreePositiveTests, test10)
     logger->trace("scapegoatTreePositiveTests.test10 finished");
 }
 
+TEST(scapegoatTreePositiveTests, test11)
+{
+    std::unique_ptr<logger> logger(create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "scapegoat_tree_tests_logs.txt",
+                logger::severity::trace
+            },
+        }));
+
+    logger->trace("scapegoatTreePositiveTests.test11 started");
+
+    for (double alpha : { 0.5, 0.6, 0.75, 0.9 })
+    {
+        scapegoat_tree<int, int> sg(std::less<int>(), nullptr, logger.get(), alpha);
+        EXPECT_EQ(sg.get_alpha(), alpha);
+
+        for (int i = 0; i < 2000; ++i)
+        {
+            sg.emplace(i, i);
+        }
+        for (int i = 0; i < 2000; i += 3)
+        {
+            EXPECT_EQ(sg.erase(i), 1u);
+        }
+
+        // every insertion and erasure rebuilds the topmost unbalanced node on its path
+        size_t height = 0;
+        for (auto it = sg.cbegin(); it != sg.cend(); ++it)
+        {
+            height = std::max(height, it.depth());
+        }
+        EXPECT_LE(height, std::log(sg.size() + 1.0) / std::log(1 / alpha) + 2);
+
+        int expected = 0;
+        for (auto const &item : sg)
+        {
+            expected += expected % 3 == 0;
+            EXPECT_EQ(item.first, expected);
+            EXPECT_EQ(item.second, expected);
+            ++expected;
+        }
+        EXPECT_EQ(sg.size(), 1333u);
+
+        scapegoat_tree<int, int> copy(sg);
+        EXPECT_EQ(copy.get_alpha(), alpha);
+        EXPECT_EQ(copy.size(), sg.size());
+    }
+
+    EXPECT_THROW((scapegoat_tree<int, int>(std::less<int>(), nullptr, logger.get(), 0.4)), std::invalid_argument);
+    EXPECT_THROW((scapegoat_tree<int, int>(std::less<int>(), nullptr, logger.get(), 1.5)), std::invalid_argument);
+
+    logger->trace("scapegoatTreePositiveTests.test11 finished");
+}
+
 int main(
     int argc,
     char **argv)
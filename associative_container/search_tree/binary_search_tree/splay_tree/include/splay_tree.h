@@ -3,6 +3,19 @@
 
 #include <binary_search_tree.h>
 
+/** How a splay tree restructures around an accessed node
+ */
+enum class splay_strategy
+{
+    // rotations from the node up to the root through parent links, the classic splay
+    bottom_up,
+    // a single pass from the root that splits the path into a left and a right tree and reassembles them
+    top_down,
+    // bottom-up, but a zig-zig step rotates only the parent and goes on from it, so every node on the path
+    // gets about half as deep as before instead of the accessed node reaching the root
+    semi
+};
+
 namespace __detail
 {
     class SPL_TAG;
@@ -13,17 +26,59 @@ namespace __detail
         template<class ...Args>
         static binary_search_tree<tkey, tvalue, compare, SPL_TAG>::node* create_node(binary_search_tree<tkey, tvalue, compare, SPL_TAG>& cont, Args&& ...args);
 
-        static void delete_node(binary_search_tree<tkey, tvalue, compare, SPL_TAG>& cont);
+        static void delete_node(binary_search_tree<tkey, tvalue, compare, SPL_TAG>& cont, binary_search_tree<tkey, tvalue, compare, SPL_TAG>::node*);
 
-        //Does not invalidate node*, needed for splay tree
-        static void post_search(binary_search_tree<tkey, tvalue, compare, SPL_TAG>::node**){}
+        //Splays the node holding key, or the last node of the path if there is none, when the lookup period allows
+        template<typename key_type>
+        static binary_search_tree<tkey, tvalue, compare, SPL_TAG>::node* search(binary_search_tree<tkey, tvalue, compare, SPL_TAG>& cont, const key_type& key);
 
         //Does not invalidate node*
         static void post_insert(binary_search_tree<tkey, tvalue, compare, SPL_TAG>& cont, binary_search_tree<tkey, tvalue, compare, SPL_TAG>::node**);
 
+        static void post_build(binary_search_tree<tkey, tvalue, compare, SPL_TAG>&, binary_search_tree<tkey, tvalue, compare, SPL_TAG>::node*,
+                               size_t, bool){}
+
         static void erase(binary_search_tree<tkey, tvalue, compare, SPL_TAG>& cont, binary_search_tree<tkey, tvalue, compare, SPL_TAG>::node**);
 
         static void swap(binary_search_tree<tkey, tvalue, compare, SPL_TAG>& lhs, binary_search_tree<tkey, tvalue, compare, SPL_TAG>& rhs) noexcept;
+
+        static size_t subtree_rank(binary_search_tree<tkey, tvalue, compare, SPL_TAG>::node*) noexcept { return 0; }
+
+        static size_t child_rank(binary_search_tree<tkey, tvalue, compare, SPL_TAG>::node*, size_t, bool) noexcept { return 0; }
+
+        static binary_search_tree<tkey, tvalue, compare, SPL_TAG>::ranked_subtree join(
+                binary_search_tree<tkey, tvalue, compare, SPL_TAG>::ranked_subtree left,
+                binary_search_tree<tkey, tvalue, compare, SPL_TAG>::node* middle,
+                binary_search_tree<tkey, tvalue, compare, SPL_TAG>::ranked_subtree right) noexcept;
+
+        //Restructures around a node that was just reached, following the strategy of the tree
+        static void access(binary_search_tree<tkey, tvalue, compare, SPL_TAG>& cont, binary_search_tree<tkey, tvalue, compare, SPL_TAG>::node* accessed);
+
+        //The link that points to current: a child pointer of its parent, or the root
+        static binary_search_tree<tkey, tvalue, compare, SPL_TAG>::node*& link_of(binary_search_tree<tkey, tvalue, compare, SPL_TAG>& cont,
+                                                                                  binary_search_tree<tkey, tvalue, compare, SPL_TAG>::node* current) noexcept;
+
+        //Moves current one level up, above its parent
+        static void rotate_up(binary_search_tree<tkey, tvalue, compare, SPL_TAG>& cont, binary_search_tree<tkey, tvalue, compare, SPL_TAG>::node* current) noexcept;
+
+        //Both stop once the parent of current is top, nullptr to go up to the root
+        static void splay_bottom_up(binary_search_tree<tkey, tvalue, compare, SPL_TAG>& cont, binary_search_tree<tkey, tvalue, compare, SPL_TAG>::node* current,
+                                    binary_search_tree<tkey, tvalue, compare, SPL_TAG>::node* top) noexcept;
+
+        static void semi_splay(binary_search_tree<tkey, tvalue, compare, SPL_TAG>& cont, binary_search_tree<tkey, tvalue, compare, SPL_TAG>::node* current,
+                               binary_search_tree<tkey, tvalue, compare, SPL_TAG>::node* top) noexcept;
+
+        //Splays the subtree towards the node direction points to: negative is left of a node, positive right of it,
+        //zero the node itself. Parent links are set as nodes are linked, the result keeps the parent of subtree_root
+        template<typename direction>
+        static binary_search_tree<tkey, tvalue, compare, SPL_TAG>::node* splay_top_down(binary_search_tree<tkey, tvalue, compare, SPL_TAG>::node* subtree_root,
+                                                                                        direction&& towards);
+
+        template<typename key_type>
+        static auto key_direction(binary_search_tree<tkey, tvalue, compare, SPL_TAG>& cont, const key_type& key);
+
+    public:
+        friend class binary_search_tree<tkey, tvalue, compare, SPL_TAG>;
     };
 }
 
@@ -32,6 +87,19 @@ class splay_tree final: public binary_search_tree<tkey, tvalue, compare, __detai
 {
 
     using parent = binary_search_tree<tkey, tvalue, compare, __detail::SPL_TAG>;
+    friend class __detail::bst_impl<tkey, tvalue, compare, __detail::SPL_TAG>;
+
+    splay_strategy _strategy = splay_strategy::bottom_up;
+
+    size_t _lookup_period = 1;
+
+    // xorshift state for the lookup draws, fixed so a run can be replayed
+    std::uint64_t _lookup_draw = 0x9E3779B97F4A7C15;
+
+    /** Whether the next lookup restructures the tree
+     */
+    bool lookup_splays() noexcept;
+
 public:
 
     using value_type = parent::value_type;
@@ -62,17 +130,35 @@ public:
             logger* log = nullptr);
 
 public:
-    
+
     ~splay_tree() noexcept final;
-    
+
     splay_tree(splay_tree const &other);
-    
+
     splay_tree &operator=(splay_tree const &other);
-    
+
     splay_tree(splay_tree &&other) noexcept;
-    
+
     splay_tree &operator=(splay_tree &&other) noexcept;
 
+    void swap(parent& other) noexcept override;
+
+public:
+
+    /** bottom_up by default. Insertions and erasures always restructure with the current strategy
+     */
+    void set_strategy(splay_strategy strategy) noexcept;
+
+    splay_strategy get_strategy() const noexcept;
+
+    /** Non-const find and at splay with probability 1 / period and are plain descents otherwise, so reads of
+     *  a skewed workload keep hot keys near the root without rotating on every call. 1, the default, splays
+     *  on every lookup and 0 on none. Const lookups and contains never restructure
+     */
+    void set_lookup_splay_period(size_t period) noexcept;
+
+    size_t get_lookup_splay_period() const noexcept;
+
 };
 
 template<typename compare, typename U, typename iterator>
@@ -92,22 +178,398 @@ splay_tree(std::initializer_list<std::pair<tkey, tvalue>> data, const compare& c
 
 // region implementation
 
+namespace __detail
+{
+    template<typename tkey, typename tvalue, typename compare>
+    template<class ...Args>
+    typename binary_search_tree<tkey, tvalue, compare, SPL_TAG>::node* bst_impl<tkey, tvalue, compare, SPL_TAG>::create_node(
+            binary_search_tree<tkey, tvalue, compare, SPL_TAG>& cont, Args&& ...args)
+    {
+        using node_type = typename binary_search_tree<tkey, tvalue, compare, SPL_TAG>::node;
+        return cont._allocator.template new_object<node_type>(std::forward<Args>(args)...);
+    }
+
+    template<typename tkey, typename tvalue, typename compare>
+    void bst_impl<tkey, tvalue, compare, SPL_TAG>::delete_node(
+            binary_search_tree<tkey, tvalue, compare, SPL_TAG>& cont, binary_search_tree<tkey, tvalue, compare, SPL_TAG>::node* node)
+    {
+        using node_type = typename binary_search_tree<tkey, tvalue, compare, SPL_TAG>::node;
+        if (node)
+        {
+            cont._allocator.template delete_object<node_type>(node);
+        }
+    }
+
+    template<typename tkey, typename tvalue, typename compare>
+    typename binary_search_tree<tkey, tvalue, compare, SPL_TAG>::node*& bst_impl<tkey, tvalue, compare, SPL_TAG>::link_of(
+            binary_search_tree<tkey, tvalue, compare, SPL_TAG>& cont,
+            typename binary_search_tree<tkey, tvalue, compare, SPL_TAG>::node* current) noexcept
+    {
+        auto* parent = current->get_parent();
+        if (!parent)
+        {
+            return cont._root;
+        }
+        return parent->left_subtree == current ? parent->left_subtree : parent->right_subtree;
+    }
+
+    template<typename tkey, typename tvalue, typename compare>
+    void bst_impl<tkey, tvalue, compare, SPL_TAG>::rotate_up(
+            binary_search_tree<tkey, tvalue, compare, SPL_TAG>& cont,
+            typename binary_search_tree<tkey, tvalue, compare, SPL_TAG>::node* current) noexcept
+    {
+        using tree_type = binary_search_tree<tkey, tvalue, compare, SPL_TAG>;
+        auto* parent = current->get_parent();
+        if (parent->left_subtree == current)
+        {
+            tree_type::small_right_rotation(link_of(cont, parent));
+        }
+        else
+        {
+            tree_type::small_left_rotation(link_of(cont, parent));
+        }
+    }
+
+    template<typename tkey, typename tvalue, typename compare>
+    void bst_impl<tkey, tvalue, compare, SPL_TAG>::splay_bottom_up(
+            binary_search_tree<tkey, tvalue, compare, SPL_TAG>& cont,
+            typename binary_search_tree<tkey, tvalue, compare, SPL_TAG>::node* current,
+            typename binary_search_tree<tkey, tvalue, compare, SPL_TAG>::node* top) noexcept
+    {
+        while (current->get_parent() != top)
+        {
+            auto* parent = current->get_parent();
+            auto* grandparent = parent->get_parent();
+            if (grandparent != top)
+            {
+                // zig-zig rotates the parent first, zig-zag rotates current twice
+                const bool same_side = (grandparent->left_subtree == parent) == (parent->left_subtree == current);
+                rotate_up(cont, same_side ? parent : current);
+            }
+            rotate_up(cont, current);
+        }
+    }
+
+    template<typename tkey, typename tvalue, typename compare>
+    void bst_impl<tkey, tvalue, compare, SPL_TAG>::semi_splay(
+            binary_search_tree<tkey, tvalue, compare, SPL_TAG>& cont,
+            typename binary_search_tree<tkey, tvalue, compare, SPL_TAG>::node* current,
+            typename binary_search_tree<tkey, tvalue, compare, SPL_TAG>::node* top) noexcept
+    {
+        while (current->get_parent() != top && current->get_parent()->get_parent() != top)
+        {
+            auto* parent = current->get_parent();
+            auto* grandparent = parent->get_parent();
+            if ((grandparent->left_subtree == parent) == (parent->left_subtree == current))
+            {
+                rotate_up(cont, parent);
+                current = parent;
+            }
+            else
+            {
+                rotate_up(cont, current);
+                rotate_up(cont, current);
+            }
+        }
+    }
+
+    template<typename tkey, typename tvalue, typename compare>
+    template<typename direction>
+    typename binary_search_tree<tkey, tvalue, compare, SPL_TAG>::node* bst_impl<tkey, tvalue, compare, SPL_TAG>::splay_top_down(
+            typename binary_search_tree<tkey, tvalue, compare, SPL_TAG>::node* subtree_root,
+            direction&& towards)
+    {
+        using node_type = typename binary_search_tree<tkey, tvalue, compare, SPL_TAG>::node;
+
+        node_type* above = subtree_root->get_parent();
+
+        // nodes passed on the way down: smaller ones hang off the right spine of the left tree,
+        // greater ones off the left spine of the right tree
+        node_type* left_tree = nullptr;
+        node_type** left_hook = &left_tree;
+        node_type* left_max = nullptr;
+        node_type* right_tree = nullptr;
+        node_type** right_hook = &right_tree;
+        node_type* right_min = nullptr;
+
+        node_type* current = subtree_root;
+        while (true)
+        {
+            const int side = towards(current);
+            if (side < 0)
+            {
+                if (!current->left_subtree)
+                {
+                    break;
+                }
+                if (towards(current->left_subtree) < 0)
+                {
+                    node_type* child = current->left_subtree;
+                    current->left_subtree = child->right_subtree;
+                    if (current->left_subtree)
+                    {
+                        current->left_subtree->set_parent(current);
+                    }
+                    child->right_subtree = current;
+                    current->set_parent(child);
+                    current = child;
+                    if (!current->left_subtree)
+                    {
+                        break;
+                    }
+                }
+                *right_hook = current;
+                current->set_parent(right_min);
+                right_min = current;
+                right_hook = &current->left_subtree;
+                current = current->left_subtree;
+            }
+            else if (side > 0)
+            {
+                if (!current->right_subtree)
+                {
+                    break;
+                }
+                if (towards(current->right_subtree) > 0)
+                {
+                    node_type* child = current->right_subtree;
+                    current->right_subtree = child->left_subtree;
+                    if (current->right_subtree)
+                    {
+                        current->right_subtree->set_parent(current);
+                    }
+                    child->left_subtree = current;
+                    current->set_parent(child);
+                    current = child;
+                    if (!current->right_subtree)
+                    {
+                        break;
+                    }
+                }
+                *left_hook = current;
+                current->set_parent(left_max);
+                left_max = current;
+                left_hook = &current->right_subtree;
+                current = current->right_subtree;
+            }
+            else
+            {
+                break;
+            }
+        }
+
+        *left_hook = current->left_subtree;
+        if (current->left_subtree)
+        {
+            current->left_subtree->set_parent(left_max);
+        }
+        *right_hook = current->right_subtree;
+        if (current->right_subtree)
+        {
+            current->right_subtree->set_parent(right_min);
+        }
+
+        current->left_subtree = left_tree;
+        if (left_tree)
+        {
+            left_tree->set_parent(current);
+        }
+        current->right_subtree = right_tree;
+        if (right_tree)
+        {
+            right_tree->set_parent(current);
+        }
+        current->set_parent(above);
+        return current;
+    }
+
+    template<typename tkey, typename tvalue, typename compare>
+    template<typename key_type>
+    auto bst_impl<tkey, tvalue, compare, SPL_TAG>::key_direction(binary_search_tree<tkey, tvalue, compare, SPL_TAG>& cont, const key_type& key)
+    {
+        return [&cont, &key](typename binary_search_tree<tkey, tvalue, compare, SPL_TAG>::node* current)
+        {
+            if (cont.compare_keys(key, current->data.first))
+            {
+                return -1;
+            }
+            return cont.compare_keys(current->data.first, key) ? 1 : 0;
+        };
+    }
+
+    template<typename tkey, typename tvalue, typename compare>
+    void bst_impl<tkey, tvalue, compare, SPL_TAG>::access(
+            binary_search_tree<tkey, tvalue, compare, SPL_TAG>& cont,
+            typename binary_search_tree<tkey, tvalue, compare, SPL_TAG>::node* accessed)
+    {
+        switch (static_cast<splay_tree<tkey, tvalue, compare>&>(cont)._strategy)
+        {
+            case splay_strategy::bottom_up:
+                splay_bottom_up(cont, accessed, nullptr);
+                break;
+            case splay_strategy::top_down:
+                cont._root = splay_top_down(cont._root, key_direction(cont, accessed->data.first));
+                break;
+            case splay_strategy::semi:
+                semi_splay(cont, accessed, nullptr);
+                break;
+        }
+    }
+
+    template<typename tkey, typename tvalue, typename compare>
+    template<typename key_type>
+    typename binary_search_tree<tkey, tvalue, compare, SPL_TAG>::node* bst_impl<tkey, tvalue, compare, SPL_TAG>::search(
+            binary_search_tree<tkey, tvalue, compare, SPL_TAG>& cont, const key_type& key)
+    {
+        using node_type = typename binary_search_tree<tkey, tvalue, compare, SPL_TAG>::node;
+
+        auto& tree = static_cast<splay_tree<tkey, tvalue, compare>&>(cont);
+        if (!cont._root || !tree.lookup_splays())
+        {
+            return cont.find_node(key);
+        }
+
+        auto towards = key_direction(cont, key);
+        if (tree._strategy == splay_strategy::top_down)
+        {
+            cont._root = splay_top_down(cont._root, towards);
+            return towards(cont._root) == 0 ? cont._root : nullptr;
+        }
+
+        node_type* last = nullptr;
+        node_type* current = cont._root;
+        while (current)
+        {
+            last = current;
+            const int side = towards(current);
+            if (side == 0)
+            {
+                break;
+            }
+            current = side < 0 ? current->left_subtree : current->right_subtree;
+        }
+        access(cont, last);
+        return current;
+    }
+
+    template<typename tkey, typename tvalue, typename compare>
+    void bst_impl<tkey, tvalue, compare, SPL_TAG>::post_insert(
+            binary_search_tree<tkey, tvalue, compare, SPL_TAG>& cont,
+            typename binary_search_tree<tkey, tvalue, compare, SPL_TAG>::node** node)
+    {
+        access(cont, *node);
+    }
+
+    template<typename tkey, typename tvalue, typename compare>
+    void bst_impl<tkey, tvalue, compare, SPL_TAG>::erase(
+            binary_search_tree<tkey, tvalue, compare, SPL_TAG>& cont,
+            typename binary_search_tree<tkey, tvalue, compare, SPL_TAG>::node** node_ptr)
+    {
+        using tree_type = binary_search_tree<tkey, tvalue, compare, SPL_TAG>;
+        using node_type = typename tree_type::node;
+
+        node_type* target = *node_ptr;
+        if (!target)
+        {
+            return;
+        }
+
+        // bottom_up and top_down bring target to the root, semi only closer to it; either way it is then
+        // replaced by the join of its subtrees, with the greatest node of the left one lifted to its top
+        access(cont, target);
+        const bool top_down = static_cast<splay_tree<tkey, tvalue, compare>&>(cont)._strategy == splay_strategy::top_down;
+
+        node_type* right = target->right_subtree;
+        node_type* replacement = right;
+        if (target->left_subtree)
+        {
+            if (top_down)
+            {
+                replacement = splay_top_down(target->left_subtree, [](node_type*) { return 1; });
+            }
+            else
+            {
+                replacement = tree_type::rightmost(target->left_subtree);
+                splay_bottom_up(cont, replacement, target);
+            }
+            replacement->right_subtree = right;
+            if (right)
+            {
+                right->set_parent(replacement);
+            }
+        }
+
+        if (replacement)
+        {
+            replacement->set_parent(target->get_parent());
+        }
+        link_of(cont, target) = replacement;
+
+        delete_node(cont, target);
+        --cont._size;
+        *node_ptr = replacement;
+    }
+
+    template<typename tkey, typename tvalue, typename compare>
+    void bst_impl<tkey, tvalue, compare, SPL_TAG>::swap(
+            binary_search_tree<tkey, tvalue, compare, SPL_TAG>& lhs,
+            binary_search_tree<tkey, tvalue, compare, SPL_TAG>& rhs) noexcept
+    {
+        std::swap(lhs._root, rhs._root);
+        std::swap(lhs._size, rhs._size);
+        std::swap(lhs._allocator, rhs._allocator);
+        std::swap(lhs._logger, rhs._logger);
+    }
+
+    template<typename tkey, typename tvalue, typename compare>
+    typename binary_search_tree<tkey, tvalue, compare, SPL_TAG>::ranked_subtree bst_impl<tkey, tvalue, compare, SPL_TAG>::join(
+            typename binary_search_tree<tkey, tvalue, compare, SPL_TAG>::ranked_subtree left,
+            typename binary_search_tree<tkey, tvalue, compare, SPL_TAG>::node* middle,
+            typename binary_search_tree<tkey, tvalue, compare, SPL_TAG>::ranked_subtree right) noexcept
+    {
+        middle->set_parent(nullptr);
+        middle->left_subtree = left.root;
+        middle->right_subtree = right.root;
+        if (left.root)
+        {
+            left.root->set_parent(middle);
+        }
+        if (right.root)
+        {
+            right.root->set_parent(middle);
+        }
+        return { middle, 0 };
+    }
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+bool splay_tree<tkey, tvalue, compare>::lookup_splays() noexcept
+{
+    if (_lookup_period <= 1)
+    {
+        return _lookup_period == 1;
+    }
+
+    _lookup_draw ^= _lookup_draw << 13;
+    _lookup_draw ^= _lookup_draw >> 7;
+    _lookup_draw ^= _lookup_draw << 17;
+    return _lookup_draw % _lookup_period == 0;
+}
+
 template<typename tkey, typename tvalue, compator<tkey> compare>
 splay_tree<tkey, tvalue, compare>::splay_tree(
         const compare& comp,
         pp_allocator<value_type> alloc,
-        logger *log)
+        logger *log) : parent(comp, alloc, log)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare> splay_tree<tkey, tvalue, compare>::splay_tree(const compare& comp, pp_allocator<value_type> alloc, logger *log)", "your code should be here...");
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 splay_tree<tkey, tvalue, compare>::splay_tree(
         pp_allocator<value_type> alloc,
         const compare& comp,
-        logger *log)
+        logger *log) : parent(comp, alloc, log)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare> splay_tree<tkey, tvalue, compare>::splay_tree(pp_allocator<value_type> alloc, const compare& comp, logger *log)", "your code should be here...");
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
@@ -117,9 +579,8 @@ splay_tree<tkey, tvalue, compare>::splay_tree(
         iterator end,
         const compare& cmp,
         pp_allocator<value_type> alloc,
-        logger* log)
+        logger* log) : parent(begin, end, cmp, alloc, log)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare> template<input_iterator_for_pair<tkey, tvalue> iterator>splay_tree<tkey, tvalue, compare>::splay_tree(iterator begin,iterator end,const compare& cmp,pp_allocator<value_type> alloc,logger* log)", "your code should be here...");
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
@@ -128,9 +589,8 @@ splay_tree<tkey, tvalue, compare>::splay_tree(
         Range&& range,
         const compare& cmp,
         pp_allocator<value_type> alloc,
-        logger* log)
+        logger* log) : parent(std::forward<Range>(range), cmp, alloc, log)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare> template<std::ranges::input_range Range> splay_tree<tkey, tvalue, compare>::splay_tree(Range&& range, const compare& cmp, pp_allocator<value_type> alloc, logger* log)", "your code should be here...");
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
@@ -138,41 +598,99 @@ splay_tree<tkey, tvalue, compare>::splay_tree(
         std::initializer_list<std::pair<tkey, tvalue>> data,
         const compare& cmp,
         pp_allocator<value_type> alloc,
-        logger* log)
+        logger* log) : parent(data, cmp, alloc, log)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare> splay_tree<tkey, tvalue, compare>::splay_tree(std::initializer_list<std::pair<tkey, tvalue>> data, const compare& cmp, pp_allocator<value_type> alloc, logger* log)", "your code should be here...");
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 splay_tree<tkey, tvalue, compare>::~splay_tree() noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare> splay_tree<tkey, tvalue, compare>::~splay_tree() noexcept", "your code should be here...");
+    // the erase hook reads this tree's settings, which are gone once the base destructor runs
+    this->clear();
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 splay_tree<tkey, tvalue, compare>::splay_tree(splay_tree const &other)
+        : parent(other),
+          _strategy(other._strategy),
+          _lookup_period(other._lookup_period),
+          _lookup_draw(other._lookup_draw)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare> splay_tree<tkey, tvalue, compare>::splay_tree(splay_tree const &other)", "your code should be here...");
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 splay_tree<tkey, tvalue, compare> &splay_tree<tkey, tvalue, compare>::operator=(splay_tree const &other)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare> splay_tree<tkey, tvalue, compare> &splay_tree<tkey, tvalue, compare>::operator=(splay_tree const &other)", "your code should be here...");
+    if (this != &other)
+    {
+        parent::operator=(other);
+        _strategy = other._strategy;
+        _lookup_period = other._lookup_period;
+        _lookup_draw = other._lookup_draw;
+    }
+    return *this;
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 splay_tree<tkey, tvalue, compare>::splay_tree(splay_tree &&other) noexcept
+        : parent(std::move(other)),
+          _strategy(other._strategy),
+          _lookup_period(other._lookup_period),
+          _lookup_draw(other._lookup_draw)
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare> splay_tree<tkey, tvalue, compare>::splay_tree(splay_tree &&other) noexcept", "your code should be here...");
 }
 
 template<typename tkey, typename tvalue, compator<tkey> compare>
 splay_tree<tkey, tvalue, compare> &splay_tree<tkey, tvalue, compare>::operator=(splay_tree &&other) noexcept
 {
-    throw not_implemented("template<typename tkey, typename tvalue, compator<tkey> compare> splay_tree<tkey, tvalue, compare> &splay_tree<tkey, tvalue, compare>::operator=(splay_tree &&other) noexcept", "your code should be here...");
+    if (this != &other)
+    {
+        parent::operator=(std::move(other));
+        _strategy = other._strategy;
+        _lookup_period = other._lookup_period;
+        _lookup_draw = other._lookup_draw;
+    }
+    return *this;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+void splay_tree<tkey, tvalue, compare>::swap(parent& other) noexcept
+{
+    if (this != &other)
+    {
+        parent::swap(other);
+        // every tree with the splay tag is a splay_tree, the settings travel with the elements
+        auto& other_splay = static_cast<splay_tree&>(other);
+        std::swap(_strategy, other_splay._strategy);
+        std::swap(_lookup_period, other_splay._lookup_period);
+        std::swap(_lookup_draw, other_splay._lookup_draw);
+    }
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+void splay_tree<tkey, tvalue, compare>::set_strategy(splay_strategy strategy) noexcept
+{
+    _strategy = strategy;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+splay_strategy splay_tree<tkey, tvalue, compare>::get_strategy() const noexcept
+{
+    return _strategy;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+void splay_tree<tkey, tvalue, compare>::set_lookup_splay_period(size_t period) noexcept
+{
+    _lookup_period = period;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare>
+size_t splay_tree<tkey, tvalue, compare>::get_lookup_splay_period() const noexcept
+{
+    return _lookup_period;
 }
 
 // endregion implementation
 
-#endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_SPLAY_TREE_H
\ No newline at end of file
+#endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_SPLAY_TREE_H
@@ -517,6 +517,69 @@ TEST(splayTreePositiveTests, test10)
     logger->trace("splayTreePositiveTests.test10 finished");
 }
 
+TEST(splayTreePositiveTests, test11)
+{
+    std::unique_ptr<logger> logger(create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "splay_tree_tests_logs.txt",
+                logger::severity::trace
+            },
+        }));
+
+    logger->trace("splayTreePositiveTests.test11 started");
+
+    for (auto strategy : { splay_strategy::bottom_up, splay_strategy::top_down, splay_strategy::semi })
+    {
+        splay_tree<int, int> splay(std::less<int>(), nullptr, logger.get());
+        splay.set_strategy(strategy);
+
+        for (int i = 0; i < 500; ++i)
+        {
+            splay.emplace((i * 37) % 500, i);
+        }
+        for (int i = 0; i < 500; i += 3)
+        {
+            EXPECT_EQ(splay.erase(i), 1u);
+        }
+
+        // a full splay leaves the key it looked up at the root, semi-splaying only moves it up
+        EXPECT_EQ(splay.find(250)->first, 250);
+        if (strategy != splay_strategy::semi)
+        {
+            EXPECT_EQ(splay.cbegin_prefix()->first, 250);
+        }
+        EXPECT_EQ(splay.find(501), splay.end());
+
+        int expected = 0;
+        for (auto const &item : splay)
+        {
+            expected += expected % 3 == 0;
+            EXPECT_EQ(item.first, expected);
+            EXPECT_EQ(item.second, (expected * 473) % 500);
+            ++expected;
+        }
+        EXPECT_EQ(splay.size(), 333u);
+    }
+
+    splay_tree<int, int> splay(std::less<int>(), nullptr, logger.get());
+    for (int i = 0; i < 100; ++i)
+    {
+        splay.emplace(i, i);
+    }
+
+    // lookups with period 0 are plain descents and leave the shape alone
+    splay.set_lookup_splay_period(0);
+    EXPECT_EQ(splay.at(0), 0);
+    EXPECT_EQ(splay.cbegin_prefix()->first, 99);
+
+    splay.set_lookup_splay_period(1);
+    EXPECT_EQ(splay.at(0), 0);
+    EXPECT_EQ(splay.cbegin_prefix()->first, 0);
+
+    logger->trace("splayTreePositiveTests.test11 finished");
+}
+
 int main(
     int argc,
     char **argv)
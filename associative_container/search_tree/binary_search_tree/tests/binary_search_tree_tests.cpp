@@ -546,6 +546,281 @@ TEST(binarySearchTreePositiveTests, test10)
 }
 
 
+TEST(binarySearchTreePositiveTests, test11)
+{
+    std::unique_ptr<logger> logger(create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "binary_search_tree_tests_logs.txt",
+                logger::severity::trace
+            }
+        }));
+    logger->trace("binarySearchTreePositiveTests.test11 started");
+
+    auto bst = std::make_unique<binary_search_tree<int, std::string>>(std::less<int>(), nullptr, logger.get());
+
+    bst->emplace(8, "a");
+    bst->emplace(3, "b");
+    bst->emplace(10, "c");
+    bst->emplace(1, "d");
+    bst->emplace(6, "e");
+    bst->emplace(14, "f");
+    bst->emplace(4, "g");
+    bst->emplace(7, "h");
+    bst->emplace(13, "i");
+
+    auto keys = [](auto first, auto last)
+    {
+        std::vector<int> result;
+        for (; first != last; ++first)
+        {
+            result.push_back(first->first);
+        }
+        return result;
+    };
+
+    std::vector<int> prefix = { 8, 3, 1, 6, 4, 7, 10, 14, 13 };
+    std::vector<int> infix = { 1, 3, 4, 6, 7, 8, 10, 13, 14 };
+    std::vector<int> postfix = { 1, 4, 7, 6, 3, 13, 14, 10, 8 };
+
+    EXPECT_EQ(keys(bst->begin_prefix(), bst->end_prefix()), prefix);
+    EXPECT_EQ(keys(bst->begin_infix(), bst->end_infix()), infix);
+    EXPECT_EQ(keys(bst->begin_postfix(), bst->end_postfix()), postfix);
+    EXPECT_EQ(keys(bst->cbegin_postfix(), bst->cend_postfix()), postfix);
+
+    std::reverse(prefix.begin(), prefix.end());
+    std::reverse(infix.begin(), infix.end());
+    std::reverse(postfix.begin(), postfix.end());
+
+    EXPECT_EQ(keys(bst->rbegin_prefix(), bst->rend_prefix()), prefix);
+    EXPECT_EQ(keys(bst->rbegin_infix(), bst->rend_infix()), infix);
+    EXPECT_EQ(keys(bst->rbegin_postfix(), bst->rend_postfix()), postfix);
+    EXPECT_EQ(keys(bst->crbegin_prefix(), bst->crend_prefix()), prefix);
+
+    auto it = bst->end_postfix();
+    --it;
+    EXPECT_EQ(it->first, 8);
+    --it;
+    EXPECT_EQ(it->first, 10);
+    ++it;
+    ++it;
+    EXPECT_TRUE(it == bst->end_postfix());
+
+    logger->trace("binarySearchTreePositiveTests.test11 finished");
+}
+
+struct counted
+{
+    static inline size_t constructions = 0;
+
+    int value;
+
+    counted(int v) : value(v) { ++constructions; }
+    counted(counted const &other) : value(other.value) { ++constructions; }
+    counted(counted &&other) noexcept : value(other.value) { ++constructions; }
+};
+
+TEST(binarySearchTreePositiveTests, test12)
+{
+    std::unique_ptr<logger> logger(create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "binary_search_tree_tests_logs.txt",
+                logger::severity::trace
+            }
+        }));
+    logger->trace("binarySearchTreePositiveTests.test12 started");
+
+    auto bst = std::make_unique<binary_search_tree<std::string, counted, std::less<>>>(std::less<>(), nullptr, logger.get());
+
+    EXPECT_TRUE(bst->emplace("kiwi", 1).second);
+    EXPECT_TRUE(bst->emplace(std::string("apple"), 2).second);
+    EXPECT_TRUE(bst->try_emplace("melon", 3).second);
+    EXPECT_TRUE(bst->try_emplace(std::string("fig"), 4).second);
+
+    counted::constructions = 0;
+    std::string key = "banana";
+    EXPECT_TRUE(bst->try_emplace(std::move(key), 5).second);
+    EXPECT_EQ(counted::constructions, 1u);
+
+    counted::constructions = 0;
+    std::string existing = "kiwi";
+    EXPECT_FALSE(bst->try_emplace(std::move(existing), 6).second);
+    EXPECT_FALSE(bst->emplace(std::string("apple"), 7).second);
+    EXPECT_EQ(counted::constructions, 0u);
+    EXPECT_EQ(existing, "kiwi");
+
+    std::string_view kiwi = "kiwi";
+    EXPECT_TRUE(bst->contains(kiwi));
+    EXPECT_FALSE(bst->contains(std::string_view("grape")));
+    EXPECT_EQ(bst->find(kiwi)->second.value, 1);
+    EXPECT_TRUE(bst->find(std::string_view("grape")) == bst->end());
+    EXPECT_EQ(bst->lower_bound(std::string_view("c"))->first, "fig");
+    EXPECT_EQ(bst->upper_bound(std::string_view("fig"))->first, "kiwi");
+    EXPECT_EQ(bst->at("melon").value, 3);
+
+    EXPECT_EQ(bst->size(), 5u);
+    EXPECT_EQ(bst->erase(std::string_view("fig")), 1u);
+    EXPECT_EQ(bst->erase(std::string_view("fig")), 0u);
+    EXPECT_EQ(bst->erase(std::string("banana")), 1u);
+    EXPECT_EQ(bst->size(), 3u);
+
+    std::vector<std::string> keys;
+    for (auto it = bst->begin(); it != bst->end(); ++it)
+    {
+        keys.push_back(it->first);
+    }
+    EXPECT_EQ(keys, (std::vector<std::string>{ "apple", "kiwi", "melon" }));
+
+    logger->trace("binarySearchTreePositiveTests.test12 finished");
+}
+
+TEST(binarySearchTreePositiveTests, test13)
+{
+    std::unique_ptr<logger> logger(create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "binary_search_tree_tests_logs.txt",
+                logger::severity::trace
+            }
+        }));
+    logger->trace("binarySearchTreePositiveTests.test13 started");
+
+    auto bst = std::make_unique<binary_search_tree<int, std::string>>(std::less<int>(), nullptr, logger.get());
+
+    std::vector<std::pair<int, std::string>> unsorted{ { 5, "a" }, { 1, "b" }, { 3, "c" }, { 5, "d" }, { 2, "e" }, { 4, "f" }, { 1, "g" } };
+    bst->insert_range(unsorted);
+
+    std::vector<test_data<int, std::string>> expected_result =
+        {
+            test_data<int, std::string>(2, 1, "b"),
+            test_data<int, std::string>(1, 2, "e"),
+            test_data<int, std::string>(0, 3, "c"),
+            test_data<int, std::string>(2, 4, "f"),
+            test_data<int, std::string>(1, 5, "a")
+        };
+
+    EXPECT_EQ(bst->size(), 5u);
+    EXPECT_TRUE(infix_iterator_test(*bst, expected_result));
+
+    std::vector<std::pair<int, std::string>> more{ { 0, "h" }, { 3, "i" }, { 6, "j" } };
+    bst->insert(more.begin(), more.end());
+
+    std::vector<int> keys;
+    for (auto it = bst->begin(); it != bst->end(); ++it)
+    {
+        keys.push_back(it->first);
+    }
+    EXPECT_EQ(keys, (std::vector<int>{ 0, 1, 2, 3, 4, 5, 6 }));
+    EXPECT_EQ(bst->at(3), "c");
+
+    binary_search_tree<int, std::string> from_list({ { 2, "x" }, { 1, "y" }, { 3, "z" } });
+    EXPECT_EQ(from_list.size(), 3u);
+    EXPECT_EQ(from_list.begin_prefix()->first, 2);
+
+    logger->trace("binarySearchTreePositiveTests.test13 finished");
+}
+
+TEST(binarySearchTreePositiveTests, test14)
+{
+    std::unique_ptr<logger> logger(create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "binary_search_tree_tests_logs.txt",
+                logger::severity::trace
+            }
+        }));
+    logger->trace("binarySearchTreePositiveTests.test14 started");
+
+    auto keys_of = [](binary_search_tree<int, std::string> const &tree)
+    {
+        std::vector<int> keys;
+        for (auto it = tree.cbegin(); it != tree.cend(); ++it)
+        {
+            keys.push_back(it->first);
+        }
+        return keys;
+    };
+
+    binary_search_tree<int, std::string> lhs({ { 1, "a" }, { 3, "b" }, { 5, "c" }, { 7, "d" }, { 9, "e" } });
+    binary_search_tree<int, std::string> rhs({ { 2, "x" }, { 3, "y" }, { 9, "z" }, { 10, "w" } });
+
+    lhs.set_union(std::move(rhs));
+    EXPECT_EQ(keys_of(lhs), (std::vector<int>{ 1, 2, 3, 5, 7, 9, 10 }));
+    EXPECT_EQ(lhs.size(), 7u);
+    EXPECT_EQ(lhs.at(3), "b");
+    EXPECT_TRUE(rhs.empty());
+
+    binary_search_tree<int, std::string> odd({ { 1, "" }, { 3, "" }, { 5, "" }, { 11, "" } });
+    lhs.set_intersection(std::move(odd));
+    EXPECT_EQ(keys_of(lhs), (std::vector<int>{ 1, 3, 5 }));
+    EXPECT_EQ(lhs.size(), 3u);
+    EXPECT_EQ(lhs.at(5), "c");
+
+    binary_search_tree<int, std::string> three({ { 3, "" }, { 4, "" } });
+    lhs.set_difference(std::move(three));
+    EXPECT_EQ(keys_of(lhs), (std::vector<int>{ 1, 5 }));
+    EXPECT_EQ(lhs.size(), 2u);
+
+    binary_search_tree<int, std::string> greater({ { 6, "f" }, { 8, "g" } });
+    lhs.join(std::move(greater));
+    EXPECT_EQ(keys_of(lhs), (std::vector<int>{ 1, 5, 6, 8 }));
+    EXPECT_EQ(lhs.size(), 4u);
+
+    binary_search_tree<int, std::string> overlapping({ { 2, "" } });
+    EXPECT_THROW(lhs.join(std::move(overlapping)), std::logic_error);
+
+    binary_search_tree<int, std::string> upper;
+    lhs.split(5, upper);
+    EXPECT_EQ(keys_of(lhs), (std::vector<int>{ 1 }));
+    EXPECT_EQ(keys_of(upper), (std::vector<int>{ 5, 6, 8 }));
+    EXPECT_EQ(lhs.size(), 1u);
+    EXPECT_EQ(upper.size(), 3u);
+
+    logger->trace("binarySearchTreePositiveTests.test14 finished");
+}
+
+TEST(binarySearchTreePositiveTests, test15)
+{
+    std::unique_ptr<logger> logger(create_logger(std::vector<std::pair<std::string, logger::severity>>
+        {
+            {
+                "binary_search_tree_tests_logs.txt",
+                logger::severity::trace
+            }
+        }));
+    logger->trace("binarySearchTreePositiveTests.test15 started");
+
+    binary_search_tree<int, std::string, std::less<int>, __detail::BST_TAG, order_statistic> tree(
+        { { 50, "a" }, { 20, "b" }, { 80, "c" }, { 10, "d" }, { 30, "e" }, { 70, "f" }, { 90, "g" } });
+    tree.emplace(25, "h");
+    tree.emplace(95, "i");
+    tree.erase(80);
+
+    std::vector<int> keys{ 10, 20, 25, 30, 50, 70, 90, 95 };
+    for (size_t i = 0; i < keys.size(); ++i)
+    {
+        EXPECT_EQ(tree.select(i)->first, keys[i]);
+        EXPECT_EQ(tree.rank(keys[i]), i);
+    }
+    EXPECT_EQ(tree.select(keys.size()), tree.end());
+    EXPECT_EQ(tree.rank(0), 0u);
+    EXPECT_EQ(tree.rank(60), 5u);
+    EXPECT_EQ(tree.rank(100), 8u);
+
+    EXPECT_EQ(tree.count_range(20, 70), 4u);
+    EXPECT_EQ(tree.count_range(21, 71), 4u);
+    EXPECT_EQ(tree.count_range(70, 20), 0u);
+
+    binary_search_tree<int, std::string, std::less<int>, __detail::BST_TAG, order_statistic> upper;
+    tree.split(30, upper);
+    EXPECT_EQ(upper.select(0)->first, 30);
+    EXPECT_EQ(upper.rank(95), 4u);
+    EXPECT_EQ(tree.count_range(0, 100), 3u);
+
+    logger->trace("binarySearchTreePositiveTests.test15 finished");
+}
+
 int main(
     int argc,
     char **argv)
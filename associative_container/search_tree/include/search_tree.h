@@ -5,7 +5,32 @@
 #include <associative_container.h>
 #include <logger_guardant.h>
 #include <not_implemented.h>
+#include <concepts>
+#include <cstddef>
 
+/** Per-node data a search tree keeps on top of its own balance information, selected by template argument.
+ *  The default adds nothing, so trees that do not ask for an augmentation keep their node size
+ */
+struct no_augmentation
+{
+    struct node_data {};
+};
+
+/** Subtree sizes in every node: select, rank and count_range run in O(height) instead of walking the tree
+ */
+struct order_statistic
+{
+    struct node_data
+    {
+        std::size_t subtree_size = 1;
+    };
+};
+
+template<typename augment>
+concept counts_subtrees = requires(typename augment::node_data data)
+                          {
+                              {data.subtree_size} -> std::convertible_to<std::size_t>;
+                          };
 
 
 #endif //MATH_PRACTICE_AND_OPERATING_SYSTEMS_SEARCH_TREE_H
\ No newline at end of file
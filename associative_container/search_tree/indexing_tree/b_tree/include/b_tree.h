@@ -9,10 +9,11 @@
 #include <initializer_list>
 #include <iterator>
 #include <stack>
+#include <type_traits>
 #include <utility>
 #include <functional>
 
-template<typename tkey, typename tvalue, compator<tkey> compare = std::less<tkey>, std::size_t t = 5>
+template<typename tkey, typename tvalue, compator<tkey> compare = std::less<tkey>, std::size_t t = 5, typename augment = no_augmentation>
 class B_tree final : private logger_guardant, private compare {
 public:
 	using tree_data_type = std::pair<tkey, tvalue>;
@@ -31,7 +32,10 @@ private:
 	// endregion comparators declaration
 
 
-	struct btree_node {
+	/*
+     * With the order_statistic augmentation every node also counts the keys of its whole subtree
+     */
+	struct btree_node : public augment::node_data {
 		boost::container::static_vector<tree_data_type, maximum_keys_in_node + 1> _keys;
 		boost::container::static_vector<btree_node*, maximum_keys_in_node + 2> _pointers;
 		btree_node() noexcept;
@@ -49,6 +53,22 @@ private:
 	logger* get_logger() const noexcept override;
 	pp_allocator<value_type> get_allocator() const noexcept;
 
+	// region augmentation declaration
+
+	static void update_augmentation(btree_node* node) noexcept;
+
+	static size_t subtree_size(btree_node* node) noexcept requires counts_subtrees<augment>;
+
+	size_t count_less(const tkey& key) const requires counts_subtrees<augment>;
+
+	// endregion augmentation declaration
+
+	/*
+     * Refills child index of parent after an erase left it with too few keys: borrows a key through the parent
+     * from a sibling that can spare one, otherwise merges the child with a sibling
+     */
+	void restore_child(btree_node* parent, size_t index);
+
 public:
 	// region constructors declaration
 
@@ -306,6 +326,27 @@ public:
 
 	// endregion lookup declaration
 
+	// region order statistics declaration
+
+	/*
+     * Available with the order_statistic augmentation, each visits O(t) entries per level.
+     * select finds the element at a zero-based position in key order, end() if index >= size()
+     */
+	btree_iterator select(size_t index) requires counts_subtrees<augment>;
+	btree_const_iterator select(size_t index) const requires counts_subtrees<augment>;
+
+	/*
+     * Number of keys less than key, which is the position key has or would have in the tree
+     */
+	size_t rank(const tkey& key) const requires counts_subtrees<augment>;
+
+	/*
+     * Number of keys in [lower, upper), zero if upper is not greater than lower
+     */
+	size_t count_range(const tkey& lower, const tkey& upper) const requires counts_subtrees<augment>;
+
+	// endregion order statistics declaration
+
 	// region modifiers declaration
 
 	void clear() noexcept;
@@ -354,51 +395,102 @@ template<typename tkey, typename tvalue, compator<tkey> compare = std::less<tkey
 B_tree(std::initializer_list<std::pair<tkey, tvalue>> data, const compare& cmp = compare(), pp_allocator<U> = pp_allocator<U>(),
 	   logger* logger = nullptr) -> B_tree<tkey, tvalue, compare, t>;
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-bool B_tree<tkey, tvalue, compare, t>::compare_pairs(const B_tree::tree_data_type& lhs,
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+bool B_tree<tkey, tvalue, compare, t, augment>::compare_pairs(const B_tree::tree_data_type& lhs,
 													 const B_tree::tree_data_type& rhs) const {
 	return compare_keys(lhs.first, rhs.first);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-bool B_tree<tkey, tvalue, compare, t>::compare_keys(const tkey& lhs, const tkey& rhs) const {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+bool B_tree<tkey, tvalue, compare, t, augment>::compare_keys(const tkey& lhs, const tkey& rhs) const {
 	return compare::operator()(lhs, rhs);
 }
 
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-B_tree<tkey, tvalue, compare, t>::btree_node::btree_node() noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+B_tree<tkey, tvalue, compare, t, augment>::btree_node::btree_node() noexcept {
 	_keys.reserve(maximum_keys_in_node + 1);
 	_pointers.reserve(maximum_keys_in_node + 2);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-logger* B_tree<tkey, tvalue, compare, t>::get_logger() const noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+logger* B_tree<tkey, tvalue, compare, t, augment>::get_logger() const noexcept {
 	return _logger;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-pp_allocator<typename B_tree<tkey, tvalue, compare, t>::value_type> B_tree<tkey, tvalue, compare, t>::get_allocator() const noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+pp_allocator<typename B_tree<tkey, tvalue, compare, t, augment>::value_type> B_tree<tkey, tvalue, compare, t, augment>::get_allocator() const noexcept {
 	return _allocator;
 }
 
+// region augmentation implementation
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+void B_tree<tkey, tvalue, compare, t, augment>::update_augmentation(btree_node* node) noexcept {
+	if constexpr (counts_subtrees<augment>) {
+		size_t size = node->_keys.size();
+		for (auto* child: node->_pointers) {
+			size += child->subtree_size;
+		}
+		node->subtree_size = size;
+	}
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+size_t B_tree<tkey, tvalue, compare, t, augment>::subtree_size(btree_node* node) noexcept
+	requires counts_subtrees<augment>
+{
+	return node ? node->subtree_size : 0;
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+size_t B_tree<tkey, tvalue, compare, t, augment>::count_less(const tkey& key) const
+	requires counts_subtrees<augment>
+{
+	size_t result = 0;
+	btree_node* node = _root;
+	while (node) {
+		size_t lo = 0, hi = node->_keys.size();
+		while (lo < hi) {
+			size_t mid = (lo + hi) / 2;
+			if (compare_keys(node->_keys[mid].first, key))
+				lo = mid + 1;
+			else
+				hi = mid;
+		}
+		result += lo;
+		if (node->_pointers.empty()) break;
+
+		for (size_t i = 0; i < lo; ++i) {
+			result += node->_pointers[i]->subtree_size;
+		}
+		if (lo < node->_keys.size() && !compare_keys(key, node->_keys[lo].first)) {
+			return result + node->_pointers[lo]->subtree_size;
+		}
+		node = node->_pointers[lo];
+	}
+	return result;
+}
+
+// endregion augmentation implementation
+
 // region constructors implementation
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-B_tree<tkey, tvalue, compare, t>::B_tree(const compare& cmp, pp_allocator<value_type> alloc, logger* logger)
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+B_tree<tkey, tvalue, compare, t, augment>::B_tree(const compare& cmp, pp_allocator<value_type> alloc, logger* logger)
 	: _allocator(alloc), _logger(logger), _root(nullptr), _size(0) {
 	compare::operator=(cmp);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-B_tree<tkey, tvalue, compare, t>::B_tree(pp_allocator<value_type> alloc, const compare& comp, logger* logger)
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+B_tree<tkey, tvalue, compare, t, augment>::B_tree(pp_allocator<value_type> alloc, const compare& comp, logger* logger)
 	: _allocator(alloc), _logger(logger), _root(nullptr), _size(0) {
 	compare::operator=(comp);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
 template<input_iterator_for_pair<tkey, tvalue> iterator>
-B_tree<tkey, tvalue, compare, t>::B_tree(iterator begin, iterator end,
+B_tree<tkey, tvalue, compare, t, augment>::B_tree(iterator begin, iterator end,
 										 const compare& cmp,
 										 pp_allocator<value_type> alloc,
 										 logger* logger) : _allocator(alloc), _logger(logger), _root(nullptr), _size(0) {
@@ -407,8 +499,8 @@ B_tree<tkey, tvalue, compare, t>::B_tree(iterator begin, iterator end,
 		insert(*it);
 	}
 }
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-B_tree<tkey, tvalue, compare, t>::B_tree(std::initializer_list<std::pair<tkey, tvalue>> data, const compare& cmp,
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+B_tree<tkey, tvalue, compare, t, augment>::B_tree(std::initializer_list<std::pair<tkey, tvalue>> data, const compare& cmp,
 										 pp_allocator<value_type> alloc,
 										 logger* logger) : _allocator(alloc), _logger(logger), _root(nullptr), _size(0) {
 	compare::operator=(cmp);
@@ -421,13 +513,13 @@ B_tree<tkey, tvalue, compare, t>::B_tree(std::initializer_list<std::pair<tkey, t
 
 // region five implementation
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-B_tree<tkey, tvalue, compare, t>::~B_tree() noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+B_tree<tkey, tvalue, compare, t, augment>::~B_tree() noexcept {
 	clear();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-B_tree<tkey, tvalue, compare, t>::B_tree(const B_tree& other) : _allocator(other._allocator),
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+B_tree<tkey, tvalue, compare, t, augment>::B_tree(const B_tree& other) : _allocator(other._allocator),
 																_logger(other._logger),
 																_root(nullptr),
 																_size(0) {
@@ -437,8 +529,8 @@ B_tree<tkey, tvalue, compare, t>::B_tree(const B_tree& other) : _allocator(other
 	}
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-B_tree<tkey, tvalue, compare, t>& B_tree<tkey, tvalue, compare, t>::operator=(const B_tree& other) {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+B_tree<tkey, tvalue, compare, t, augment>& B_tree<tkey, tvalue, compare, t, augment>::operator=(const B_tree& other) {
 	if (this != &other) {
 		clear();
 		_allocator = other._allocator;
@@ -451,8 +543,8 @@ B_tree<tkey, tvalue, compare, t>& B_tree<tkey, tvalue, compare, t>::operator=(co
 	return *this;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-B_tree<tkey, tvalue, compare, t>::B_tree(B_tree&& other) noexcept : _allocator(std::move(other._allocator)),
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+B_tree<tkey, tvalue, compare, t, augment>::B_tree(B_tree&& other) noexcept : _allocator(std::move(other._allocator)),
 																	_logger(other._logger),
 																	_root(other._root),
 																	_size(other._size) {
@@ -462,8 +554,8 @@ B_tree<tkey, tvalue, compare, t>::B_tree(B_tree&& other) noexcept : _allocator(s
 	other._logger = nullptr;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-B_tree<tkey, tvalue, compare, t>& B_tree<tkey, tvalue, compare, t>::operator=(B_tree&& other) noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+B_tree<tkey, tvalue, compare, t, augment>& B_tree<tkey, tvalue, compare, t, augment>::operator=(B_tree&& other) noexcept {
 	if (this != &other) {
 		clear();
 		_allocator = std::move(other._allocator);
@@ -482,25 +574,25 @@ B_tree<tkey, tvalue, compare, t>& B_tree<tkey, tvalue, compare, t>::operator=(B_
 
 // region iterators implementation
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-B_tree<tkey, tvalue, compare, t>::btree_iterator::btree_iterator(
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+B_tree<tkey, tvalue, compare, t, augment>::btree_iterator::btree_iterator(
 		const std::stack<std::pair<btree_node**, size_t>>& path, size_t index) : _path(path), _index(index) {}
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-typename B_tree<tkey, tvalue, compare, t>::btree_iterator::reference
-B_tree<tkey, tvalue, compare, t>::btree_iterator::operator*() const noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+typename B_tree<tkey, tvalue, compare, t, augment>::btree_iterator::reference
+B_tree<tkey, tvalue, compare, t, augment>::btree_iterator::operator*() const noexcept {
 	return (*(_path.top().first))->_keys[_path.top().second];
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-typename B_tree<tkey, tvalue, compare, t>::btree_iterator::pointer
-B_tree<tkey, tvalue, compare, t>::btree_iterator::operator->() const noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+typename B_tree<tkey, tvalue, compare, t, augment>::btree_iterator::pointer
+B_tree<tkey, tvalue, compare, t, augment>::btree_iterator::operator->() const noexcept {
 	return &((*(_path.top().first))->_keys[_path.top().second]);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-typename B_tree<tkey, tvalue, compare, t>::btree_iterator&
-B_tree<tkey, tvalue, compare, t>::btree_iterator::operator++() {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+typename B_tree<tkey, tvalue, compare, t, augment>::btree_iterator&
+B_tree<tkey, tvalue, compare, t, augment>::btree_iterator::operator++() {
 	if (_path.empty()) return *this;
 
 	auto& [node_ptr, pointer_idx] = _path.top();
@@ -540,17 +632,17 @@ B_tree<tkey, tvalue, compare, t>::btree_iterator::operator++() {
 	return *this;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-typename B_tree<tkey, tvalue, compare, t>::btree_iterator
-B_tree<tkey, tvalue, compare, t>::btree_iterator::operator++(int) {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+typename B_tree<tkey, tvalue, compare, t, augment>::btree_iterator
+B_tree<tkey, tvalue, compare, t, augment>::btree_iterator::operator++(int) {
 	btree_iterator temp = *this;
 	++(*this);
 	return temp;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-typename B_tree<tkey, tvalue, compare, t>::btree_iterator&
-B_tree<tkey, tvalue, compare, t>::btree_iterator::operator--() {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+typename B_tree<tkey, tvalue, compare, t, augment>::btree_iterator&
+B_tree<tkey, tvalue, compare, t, augment>::btree_iterator::operator--() {
 	if (_path.empty()) {
 		return *this;
 	}
@@ -592,16 +684,16 @@ B_tree<tkey, tvalue, compare, t>::btree_iterator::operator--() {
 	return *this;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-typename B_tree<tkey, tvalue, compare, t>::btree_iterator
-B_tree<tkey, tvalue, compare, t>::btree_iterator::operator--(int) {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+typename B_tree<tkey, tvalue, compare, t, augment>::btree_iterator
+B_tree<tkey, tvalue, compare, t, augment>::btree_iterator::operator--(int) {
 	btree_iterator temp = *this;
 	--(*this);
 	return temp;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-bool B_tree<tkey, tvalue, compare, t>::btree_iterator::operator==(const self& other) const noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+bool B_tree<tkey, tvalue, compare, t, augment>::btree_iterator::operator==(const self& other) const noexcept {
 	if (_path.empty() && other._path.empty()) {
 		return true;
 	}
@@ -611,60 +703,60 @@ bool B_tree<tkey, tvalue, compare, t>::btree_iterator::operator==(const self& ot
 	return _path.top().first == other._path.top().first && _index == other._index;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-bool B_tree<tkey, tvalue, compare, t>::btree_iterator::operator!=(const self& other) const noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+bool B_tree<tkey, tvalue, compare, t, augment>::btree_iterator::operator!=(const self& other) const noexcept {
 	return !(*this == other);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-size_t B_tree<tkey, tvalue, compare, t>::btree_iterator::depth() const noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+size_t B_tree<tkey, tvalue, compare, t, augment>::btree_iterator::depth() const noexcept {
 	return _path.size() - 1;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-size_t B_tree<tkey, tvalue, compare, t>::btree_iterator::current_node_keys_count() const noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+size_t B_tree<tkey, tvalue, compare, t, augment>::btree_iterator::current_node_keys_count() const noexcept {
 	if (_path.empty()) {
 		return 0;
 	}
 	return (*_path.top().first)->_keys.size();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-bool B_tree<tkey, tvalue, compare, t>::btree_iterator::is_terminate_node() const noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+bool B_tree<tkey, tvalue, compare, t, augment>::btree_iterator::is_terminate_node() const noexcept {
 	if (_path.empty()) {
 		return true;
 	}
 	return (*_path.top().first)->_pointers.empty();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-size_t B_tree<tkey, tvalue, compare, t>::btree_iterator::index() const noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+size_t B_tree<tkey, tvalue, compare, t, augment>::btree_iterator::index() const noexcept {
 	return _index;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-B_tree<tkey, tvalue, compare, t>::btree_const_iterator::btree_const_iterator(
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+B_tree<tkey, tvalue, compare, t, augment>::btree_const_iterator::btree_const_iterator(
 		const std::stack<std::pair<btree_node* const*, size_t>>& path, size_t index) : _path(path), _index(index) {}
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-B_tree<tkey, tvalue, compare, t>::btree_const_iterator::btree_const_iterator(
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+B_tree<tkey, tvalue, compare, t, augment>::btree_const_iterator::btree_const_iterator(
 		const btree_iterator& it) noexcept : _path(it._path), _index(it._index) {}
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-typename B_tree<tkey, tvalue, compare, t>::btree_const_iterator::reference
-B_tree<tkey, tvalue, compare, t>::btree_const_iterator::operator*() const noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+typename B_tree<tkey, tvalue, compare, t, augment>::btree_const_iterator::reference
+B_tree<tkey, tvalue, compare, t, augment>::btree_const_iterator::operator*() const noexcept {
 	return (*(_path.top().first))->_keys[_path.top().second];
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-typename B_tree<tkey, tvalue, compare, t>::btree_const_iterator::pointer
-B_tree<tkey, tvalue, compare, t>::btree_const_iterator::operator->() const noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+typename B_tree<tkey, tvalue, compare, t, augment>::btree_const_iterator::pointer
+B_tree<tkey, tvalue, compare, t, augment>::btree_const_iterator::operator->() const noexcept {
 	return &((*(_path.top().first))->_keys[_path.top().second]);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-typename B_tree<tkey, tvalue, compare, t>::btree_const_iterator&
-B_tree<tkey, tvalue, compare, t>::btree_const_iterator::operator++() {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+typename B_tree<tkey, tvalue, compare, t, augment>::btree_const_iterator&
+B_tree<tkey, tvalue, compare, t, augment>::btree_const_iterator::operator++() {
 	if (_path.empty()) return *this;
 
 	auto& [node_ptr, pointer_idx] = _path.top();
@@ -704,9 +796,9 @@ B_tree<tkey, tvalue, compare, t>::btree_const_iterator::operator++() {
 	return *this;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-typename B_tree<tkey, tvalue, compare, t>::btree_const_iterator&
-B_tree<tkey, tvalue, compare, t>::btree_const_iterator::operator--() {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+typename B_tree<tkey, tvalue, compare, t, augment>::btree_const_iterator&
+B_tree<tkey, tvalue, compare, t, augment>::btree_const_iterator::operator--() {
 	if (_path.empty()) {
 		return *this;
 	}
@@ -748,227 +840,227 @@ B_tree<tkey, tvalue, compare, t>::btree_const_iterator::operator--() {
 	return *this;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-bool B_tree<tkey, tvalue, compare, t>::btree_const_iterator::operator==(const self& other) const noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+bool B_tree<tkey, tvalue, compare, t, augment>::btree_const_iterator::operator==(const self& other) const noexcept {
 	if (_path.empty() && other._path.empty()) return true;
 	if (_path.empty() || other._path.empty()) return false;
 
 	return _path.top().first == other._path.top().first && _index == other._index;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-bool B_tree<tkey, tvalue, compare, t>::btree_const_iterator::operator!=(const self& other) const noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+bool B_tree<tkey, tvalue, compare, t, augment>::btree_const_iterator::operator!=(const self& other) const noexcept {
 	return !(*this == other);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-size_t B_tree<tkey, tvalue, compare, t>::btree_const_iterator::depth() const noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+size_t B_tree<tkey, tvalue, compare, t, augment>::btree_const_iterator::depth() const noexcept {
 	return _path.size() - 1;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-size_t B_tree<tkey, tvalue, compare, t>::btree_const_iterator::current_node_keys_count() const noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+size_t B_tree<tkey, tvalue, compare, t, augment>::btree_const_iterator::current_node_keys_count() const noexcept {
 	if (_path.empty()) return 0;
 	return (*_path.top().first)->_keys.size();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-bool B_tree<tkey, tvalue, compare, t>::btree_const_iterator::is_terminate_node() const noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+bool B_tree<tkey, tvalue, compare, t, augment>::btree_const_iterator::is_terminate_node() const noexcept {
 	if (_path.empty()) return true;
 	return (*_path.top().first)->_pointers.empty();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-size_t B_tree<tkey, tvalue, compare, t>::btree_const_iterator::index() const noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+size_t B_tree<tkey, tvalue, compare, t, augment>::btree_const_iterator::index() const noexcept {
 	return _index;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-B_tree<tkey, tvalue, compare, t>::btree_reverse_iterator::btree_reverse_iterator(
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+B_tree<tkey, tvalue, compare, t, augment>::btree_reverse_iterator::btree_reverse_iterator(
 		const std::stack<std::pair<btree_node**, size_t>>& path, size_t index) : _path(path), _index(index) {}
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-B_tree<tkey, tvalue, compare, t>::btree_reverse_iterator::btree_reverse_iterator(
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+B_tree<tkey, tvalue, compare, t, augment>::btree_reverse_iterator::btree_reverse_iterator(
 		const btree_iterator& it) noexcept : _path(it._path), _index(it._index) {}
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-B_tree<tkey, tvalue, compare, t>::btree_reverse_iterator::operator B_tree<tkey, tvalue, compare, t>::btree_iterator() const noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+B_tree<tkey, tvalue, compare, t, augment>::btree_reverse_iterator::operator B_tree<tkey, tvalue, compare, t, augment>::btree_iterator() const noexcept {
 	return btree_iterator(_path, _index);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-typename B_tree<tkey, tvalue, compare, t>::btree_reverse_iterator::reference
-B_tree<tkey, tvalue, compare, t>::btree_reverse_iterator::operator*() const noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+typename B_tree<tkey, tvalue, compare, t, augment>::btree_reverse_iterator::reference
+B_tree<tkey, tvalue, compare, t, augment>::btree_reverse_iterator::operator*() const noexcept {
 	return (*_path.top().first)->_keys[_index];
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-typename B_tree<tkey, tvalue, compare, t>::btree_reverse_iterator::pointer
-B_tree<tkey, tvalue, compare, t>::btree_reverse_iterator::operator->() const noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+typename B_tree<tkey, tvalue, compare, t, augment>::btree_reverse_iterator::pointer
+B_tree<tkey, tvalue, compare, t, augment>::btree_reverse_iterator::operator->() const noexcept {
 	return &((*_path.top().first)->_keys[_index]);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-typename B_tree<tkey, tvalue, compare, t>::btree_reverse_iterator&
-B_tree<tkey, tvalue, compare, t>::btree_reverse_iterator::operator++() {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+typename B_tree<tkey, tvalue, compare, t, augment>::btree_reverse_iterator&
+B_tree<tkey, tvalue, compare, t, augment>::btree_reverse_iterator::operator++() {
 	auto fwd = static_cast<btree_iterator>(*this);
 	--fwd;
 	*this = btree_reverse_iterator(fwd);
 	return *this;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-typename B_tree<tkey, tvalue, compare, t>::btree_reverse_iterator
-B_tree<tkey, tvalue, compare, t>::btree_reverse_iterator::operator++(int) {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+typename B_tree<tkey, tvalue, compare, t, augment>::btree_reverse_iterator
+B_tree<tkey, tvalue, compare, t, augment>::btree_reverse_iterator::operator++(int) {
 	btree_const_iterator temp = *this;
 	--(*this);
 	return temp;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-typename B_tree<tkey, tvalue, compare, t>::btree_reverse_iterator&
-B_tree<tkey, tvalue, compare, t>::btree_reverse_iterator::operator--() {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+typename B_tree<tkey, tvalue, compare, t, augment>::btree_reverse_iterator&
+B_tree<tkey, tvalue, compare, t, augment>::btree_reverse_iterator::operator--() {
 	auto fwd = static_cast<btree_iterator>(*this);
 	++fwd;
 	*this = btree_reverse_iterator(fwd);
 	return *this;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-typename B_tree<tkey, tvalue, compare, t>::btree_reverse_iterator
-B_tree<tkey, tvalue, compare, t>::btree_reverse_iterator::operator--(int) {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+typename B_tree<tkey, tvalue, compare, t, augment>::btree_reverse_iterator
+B_tree<tkey, tvalue, compare, t, augment>::btree_reverse_iterator::operator--(int) {
 	btree_const_iterator temp = *this;
 	++(*this);
 	return temp;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-bool B_tree<tkey, tvalue, compare, t>::btree_reverse_iterator::operator==(const self& other) const noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+bool B_tree<tkey, tvalue, compare, t, augment>::btree_reverse_iterator::operator==(const self& other) const noexcept {
 	if (_path.empty() && other._path.empty()) return true;
 	if (_path.empty() || other._path.empty()) return false;
 
 	return _path.top().first == other._path.top().first && _index == other._index;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-bool B_tree<tkey, tvalue, compare, t>::btree_reverse_iterator::operator!=(const self& other) const noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+bool B_tree<tkey, tvalue, compare, t, augment>::btree_reverse_iterator::operator!=(const self& other) const noexcept {
 	return !(*this == other);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-size_t B_tree<tkey, tvalue, compare, t>::btree_reverse_iterator::depth() const noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+size_t B_tree<tkey, tvalue, compare, t, augment>::btree_reverse_iterator::depth() const noexcept {
 	return _path.size() - 1;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-size_t B_tree<tkey, tvalue, compare, t>::btree_reverse_iterator::current_node_keys_count() const noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+size_t B_tree<tkey, tvalue, compare, t, augment>::btree_reverse_iterator::current_node_keys_count() const noexcept {
 	if (_path.empty()) return 0;
 	return (*_path.top().first)->_keys.size();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-bool B_tree<tkey, tvalue, compare, t>::btree_reverse_iterator::is_terminate_node() const noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+bool B_tree<tkey, tvalue, compare, t, augment>::btree_reverse_iterator::is_terminate_node() const noexcept {
 	if (_path.empty()) return true;
 	return (*_path.top().first)->_pointers.empty();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-size_t B_tree<tkey, tvalue, compare, t>::btree_reverse_iterator::index() const noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+size_t B_tree<tkey, tvalue, compare, t, augment>::btree_reverse_iterator::index() const noexcept {
 	return _index;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-B_tree<tkey, tvalue, compare, t>::btree_const_reverse_iterator::btree_const_reverse_iterator(
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+B_tree<tkey, tvalue, compare, t, augment>::btree_const_reverse_iterator::btree_const_reverse_iterator(
 		const std::stack<std::pair<btree_node* const*, size_t>>& path, size_t index) : _path(path), _index(index) {}
 
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-B_tree<tkey, tvalue, compare, t>::btree_const_reverse_iterator::btree_const_reverse_iterator(
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+B_tree<tkey, tvalue, compare, t, augment>::btree_const_reverse_iterator::btree_const_reverse_iterator(
 		const btree_reverse_iterator& it) noexcept : _path(it._path), _index(it._index) {}
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-B_tree<tkey, tvalue, compare, t>::btree_const_reverse_iterator::operator B_tree<tkey, tvalue, compare, t>::btree_const_iterator() const noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+B_tree<tkey, tvalue, compare, t, augment>::btree_const_reverse_iterator::operator B_tree<tkey, tvalue, compare, t, augment>::btree_const_iterator() const noexcept {
 	return btree_const_iterator(_path, _index);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-typename B_tree<tkey, tvalue, compare, t>::btree_const_reverse_iterator::reference
-B_tree<tkey, tvalue, compare, t>::btree_const_reverse_iterator::operator*() const noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+typename B_tree<tkey, tvalue, compare, t, augment>::btree_const_reverse_iterator::reference
+B_tree<tkey, tvalue, compare, t, augment>::btree_const_reverse_iterator::operator*() const noexcept {
 	return (*_path.top().first)->_keys[_index];
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-typename B_tree<tkey, tvalue, compare, t>::btree_const_reverse_iterator::pointer
-B_tree<tkey, tvalue, compare, t>::btree_const_reverse_iterator::operator->() const noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+typename B_tree<tkey, tvalue, compare, t, augment>::btree_const_reverse_iterator::pointer
+B_tree<tkey, tvalue, compare, t, augment>::btree_const_reverse_iterator::operator->() const noexcept {
 	return &((*_path.top().first)->_keys[_index]);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-typename B_tree<tkey, tvalue, compare, t>::btree_const_reverse_iterator&
-B_tree<tkey, tvalue, compare, t>::btree_const_reverse_iterator::operator++() {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+typename B_tree<tkey, tvalue, compare, t, augment>::btree_const_reverse_iterator&
+B_tree<tkey, tvalue, compare, t, augment>::btree_const_reverse_iterator::operator++() {
 	auto fwd = static_cast<btree_iterator>(*this);
 	--fwd;
 	*this = btree_reverse_iterator(fwd);
 	return *this;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-typename B_tree<tkey, tvalue, compare, t>::btree_const_reverse_iterator
-B_tree<tkey, tvalue, compare, t>::btree_const_reverse_iterator::operator++(int) {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+typename B_tree<tkey, tvalue, compare, t, augment>::btree_const_reverse_iterator
+B_tree<tkey, tvalue, compare, t, augment>::btree_const_reverse_iterator::operator++(int) {
 	btree_const_iterator temp = *this;
 	--(*this);
 	return temp;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-typename B_tree<tkey, tvalue, compare, t>::btree_const_reverse_iterator&
-B_tree<tkey, tvalue, compare, t>::btree_const_reverse_iterator::operator--() {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+typename B_tree<tkey, tvalue, compare, t, augment>::btree_const_reverse_iterator&
+B_tree<tkey, tvalue, compare, t, augment>::btree_const_reverse_iterator::operator--() {
 	auto fwd = static_cast<btree_iterator>(*this);
 	++fwd;
 	*this = btree_reverse_iterator(fwd);
 	return *this;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-typename B_tree<tkey, tvalue, compare, t>::btree_const_reverse_iterator
-B_tree<tkey, tvalue, compare, t>::btree_const_reverse_iterator::operator--(int) {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+typename B_tree<tkey, tvalue, compare, t, augment>::btree_const_reverse_iterator
+B_tree<tkey, tvalue, compare, t, augment>::btree_const_reverse_iterator::operator--(int) {
 	btree_const_iterator temp = *this;
 	++(*this);
 	return temp;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-bool B_tree<tkey, tvalue, compare, t>::btree_const_reverse_iterator::operator==(const self& other) const noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+bool B_tree<tkey, tvalue, compare, t, augment>::btree_const_reverse_iterator::operator==(const self& other) const noexcept {
 	if (_path.empty() && other._path.empty()) return true;
 	if (_path.empty() || other._path.empty()) return false;
 
 	return _path.top().first == other._path.top().first && _index == other._index;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-bool B_tree<tkey, tvalue, compare, t>::btree_const_reverse_iterator::operator!=(const self& other) const noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+bool B_tree<tkey, tvalue, compare, t, augment>::btree_const_reverse_iterator::operator!=(const self& other) const noexcept {
 	return !(*this == other);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-size_t B_tree<tkey, tvalue, compare, t>::btree_const_reverse_iterator::depth() const noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+size_t B_tree<tkey, tvalue, compare, t, augment>::btree_const_reverse_iterator::depth() const noexcept {
 	return _path.size() - 1;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-size_t B_tree<tkey, tvalue, compare, t>::btree_const_reverse_iterator::current_node_keys_count() const noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+size_t B_tree<tkey, tvalue, compare, t, augment>::btree_const_reverse_iterator::current_node_keys_count() const noexcept {
 	if (_path.empty()) return 0;
 	return (*_path.top().first)->_keys.size();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-bool B_tree<tkey, tvalue, compare, t>::btree_const_reverse_iterator::is_terminate_node() const noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+bool B_tree<tkey, tvalue, compare, t, augment>::btree_const_reverse_iterator::is_terminate_node() const noexcept {
 	if (_path.empty()) return true;
 	return (*_path.top().first)->_pointers.empty();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-size_t B_tree<tkey, tvalue, compare, t>::btree_const_reverse_iterator::index() const noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+size_t B_tree<tkey, tvalue, compare, t, augment>::btree_const_reverse_iterator::index() const noexcept {
 	return _index;
 }
 
@@ -976,8 +1068,8 @@ size_t B_tree<tkey, tvalue, compare, t>::btree_const_reverse_iterator::index() c
 
 // region element access implementation
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-tvalue& B_tree<tkey, tvalue, compare, t>::at(const tkey& key) {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+tvalue& B_tree<tkey, tvalue, compare, t, augment>::at(const tkey& key) {
 	auto it = find(key);
 	if (it == end()) {
 		throw std::out_of_range("Key not found in B-tree");
@@ -985,8 +1077,8 @@ tvalue& B_tree<tkey, tvalue, compare, t>::at(const tkey& key) {
 	return it->second;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-const tvalue& B_tree<tkey, tvalue, compare, t>::at(const tkey& key) const {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+const tvalue& B_tree<tkey, tvalue, compare, t, augment>::at(const tkey& key) const {
 	auto it = find(key);
 	if (it == end()) {
 		throw std::out_of_range("Key not found in B-tree");
@@ -994,8 +1086,8 @@ const tvalue& B_tree<tkey, tvalue, compare, t>::at(const tkey& key) const {
 	return it->second;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-tvalue& B_tree<tkey, tvalue, compare, t>::operator[](const tkey& key) {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+tvalue& B_tree<tkey, tvalue, compare, t, augment>::operator[](const tkey& key) {
 	auto it = find(key);
 	if (it == end()) {
 		it = insert(std::make_pair(key, tvalue())).first;
@@ -1003,8 +1095,8 @@ tvalue& B_tree<tkey, tvalue, compare, t>::operator[](const tkey& key) {
 	return it->second;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-tvalue& B_tree<tkey, tvalue, compare, t>::operator[](tkey&& key) {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+tvalue& B_tree<tkey, tvalue, compare, t, augment>::operator[](tkey&& key) {
 	auto it = find(key);
 	if (it == end()) {
 		it = insert(std::make_pair(key, tvalue())).first;
@@ -1017,8 +1109,8 @@ tvalue& B_tree<tkey, tvalue, compare, t>::operator[](tkey&& key) {
 
 // region iterator begins implementation
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-typename B_tree<tkey, tvalue, compare, t>::btree_iterator B_tree<tkey, tvalue, compare, t>::begin() {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+typename B_tree<tkey, tvalue, compare, t, augment>::btree_iterator B_tree<tkey, tvalue, compare, t, augment>::begin() {
 	if (!_root) {
 		return end();
 	}
@@ -1033,14 +1125,14 @@ typename B_tree<tkey, tvalue, compare, t>::btree_iterator B_tree<tkey, tvalue, c
 }
 
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-typename B_tree<tkey, tvalue, compare, t>::btree_iterator B_tree<tkey, tvalue, compare, t>::end() {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+typename B_tree<tkey, tvalue, compare, t, augment>::btree_iterator B_tree<tkey, tvalue, compare, t, augment>::end() {
 	return btree_iterator();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-typename B_tree<tkey, tvalue, compare, t>::btree_const_iterator
-B_tree<tkey, tvalue, compare, t>::begin() const {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+typename B_tree<tkey, tvalue, compare, t, augment>::btree_const_iterator
+B_tree<tkey, tvalue, compare, t, augment>::begin() const {
 	if (!_root) {
 		return end();
 	}
@@ -1056,23 +1148,23 @@ B_tree<tkey, tvalue, compare, t>::begin() const {
 
 
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-typename B_tree<tkey, tvalue, compare, t>::btree_const_iterator B_tree<tkey, tvalue, compare, t>::end() const {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+typename B_tree<tkey, tvalue, compare, t, augment>::btree_const_iterator B_tree<tkey, tvalue, compare, t, augment>::end() const {
 	return btree_const_iterator();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-typename B_tree<tkey, tvalue, compare, t>::btree_const_iterator B_tree<tkey, tvalue, compare, t>::cbegin() const {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+typename B_tree<tkey, tvalue, compare, t, augment>::btree_const_iterator B_tree<tkey, tvalue, compare, t, augment>::cbegin() const {
 	return begin();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-typename B_tree<tkey, tvalue, compare, t>::btree_const_iterator B_tree<tkey, tvalue, compare, t>::cend() const {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+typename B_tree<tkey, tvalue, compare, t, augment>::btree_const_iterator B_tree<tkey, tvalue, compare, t, augment>::cend() const {
 	return end();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-typename B_tree<tkey, tvalue, compare, t>::btree_reverse_iterator B_tree<tkey, tvalue, compare, t>::rbegin() {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+typename B_tree<tkey, tvalue, compare, t, augment>::btree_reverse_iterator B_tree<tkey, tvalue, compare, t, augment>::rbegin() {
 	if (!_root) {
 		return rend();
 	}
@@ -1086,13 +1178,13 @@ typename B_tree<tkey, tvalue, compare, t>::btree_reverse_iterator B_tree<tkey, t
 	return btree_reverse_iterator(path, current->_keys.size() - 1);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-typename B_tree<tkey, tvalue, compare, t>::btree_reverse_iterator B_tree<tkey, tvalue, compare, t>::rend() {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+typename B_tree<tkey, tvalue, compare, t, augment>::btree_reverse_iterator B_tree<tkey, tvalue, compare, t, augment>::rend() {
 	return btree_reverse_iterator();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-typename B_tree<tkey, tvalue, compare, t>::btree_const_reverse_iterator B_tree<tkey, tvalue, compare, t>::rbegin() const {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+typename B_tree<tkey, tvalue, compare, t, augment>::btree_const_reverse_iterator B_tree<tkey, tvalue, compare, t, augment>::rbegin() const {
 	if (!_root) {
 		return rend();
 	}
@@ -1106,18 +1198,18 @@ typename B_tree<tkey, tvalue, compare, t>::btree_const_reverse_iterator B_tree<t
 	return btree_const_reverse_iterator(path, current->_keys.size() - 1);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-typename B_tree<tkey, tvalue, compare, t>::btree_const_reverse_iterator B_tree<tkey, tvalue, compare, t>::rend() const {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+typename B_tree<tkey, tvalue, compare, t, augment>::btree_const_reverse_iterator B_tree<tkey, tvalue, compare, t, augment>::rend() const {
 	return btree_const_reverse_iterator();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-typename B_tree<tkey, tvalue, compare, t>::btree_const_reverse_iterator B_tree<tkey, tvalue, compare, t>::crbegin() const {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+typename B_tree<tkey, tvalue, compare, t, augment>::btree_const_reverse_iterator B_tree<tkey, tvalue, compare, t, augment>::crbegin() const {
 	return rbegin();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-typename B_tree<tkey, tvalue, compare, t>::btree_const_reverse_iterator B_tree<tkey, tvalue, compare, t>::crend() const {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+typename B_tree<tkey, tvalue, compare, t, augment>::btree_const_reverse_iterator B_tree<tkey, tvalue, compare, t, augment>::crend() const {
 	return rend();
 }
 
@@ -1125,18 +1217,18 @@ typename B_tree<tkey, tvalue, compare, t>::btree_const_reverse_iterator B_tree<t
 
 // region lookup implementation
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-size_t B_tree<tkey, tvalue, compare, t>::size() const noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+size_t B_tree<tkey, tvalue, compare, t, augment>::size() const noexcept {
 	return _size;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-bool B_tree<tkey, tvalue, compare, t>::empty() const noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+bool B_tree<tkey, tvalue, compare, t, augment>::empty() const noexcept {
 	return _size == 0;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-typename B_tree<tkey, tvalue, compare, t>::btree_iterator B_tree<tkey, tvalue, compare, t>::find(const tkey& key) {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+typename B_tree<tkey, tvalue, compare, t, augment>::btree_iterator B_tree<tkey, tvalue, compare, t, augment>::find(const tkey& key) {
 	if (!_root)
 		return end();
 
@@ -1169,8 +1261,8 @@ typename B_tree<tkey, tvalue, compare, t>::btree_iterator B_tree<tkey, tvalue, c
 	return end();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-typename B_tree<tkey, tvalue, compare, t>::btree_const_iterator B_tree<tkey, tvalue, compare, t>::find(const tkey& key) const {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+typename B_tree<tkey, tvalue, compare, t, augment>::btree_const_iterator B_tree<tkey, tvalue, compare, t, augment>::find(const tkey& key) const {
 	if (!_root) return cend();
 	std::stack<std::pair<btree_node* const*, size_t>> path;
 	btree_node* const* node_ptr = &_root;
@@ -1197,8 +1289,8 @@ typename B_tree<tkey, tvalue, compare, t>::btree_const_iterator B_tree<tkey, tva
 	return cend();
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-typename B_tree<tkey, tvalue, compare, t>::btree_iterator B_tree<tkey, tvalue, compare, t>::lower_bound(const tkey& key) {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+typename B_tree<tkey, tvalue, compare, t, augment>::btree_iterator B_tree<tkey, tvalue, compare, t, augment>::lower_bound(const tkey& key) {
 	if (!_root) return end();
 	std::stack<std::pair<btree_node**, size_t>> path;
 	btree_node* node = _root;
@@ -1222,8 +1314,8 @@ typename B_tree<tkey, tvalue, compare, t>::btree_iterator B_tree<tkey, tvalue, c
 	}
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-typename B_tree<tkey, tvalue, compare, t>::btree_const_iterator B_tree<tkey, tvalue, compare, t>::lower_bound(const tkey& key) const {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+typename B_tree<tkey, tvalue, compare, t, augment>::btree_const_iterator B_tree<tkey, tvalue, compare, t, augment>::lower_bound(const tkey& key) const {
 	if (!_root) return cend();
 	std::stack<std::pair<btree_node* const*, size_t>> path;
 	btree_node* const* node_ptr = &_root;
@@ -1248,8 +1340,8 @@ typename B_tree<tkey, tvalue, compare, t>::btree_const_iterator B_tree<tkey, tva
 	}
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-typename B_tree<tkey, tvalue, compare, t>::btree_iterator B_tree<tkey, tvalue, compare, t>::upper_bound(const tkey& key) {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+typename B_tree<tkey, tvalue, compare, t, augment>::btree_iterator B_tree<tkey, tvalue, compare, t, augment>::upper_bound(const tkey& key) {
 	if (!_root) return end();
 	std::stack<std::pair<btree_node**, size_t>> path;
 	btree_node* node = _root;
@@ -1273,8 +1365,8 @@ typename B_tree<tkey, tvalue, compare, t>::btree_iterator B_tree<tkey, tvalue, c
 	}
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-typename B_tree<tkey, tvalue, compare, t>::btree_const_iterator B_tree<tkey, tvalue, compare, t>::upper_bound(const tkey& key) const {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+typename B_tree<tkey, tvalue, compare, t, augment>::btree_const_iterator B_tree<tkey, tvalue, compare, t, augment>::upper_bound(const tkey& key) const {
 	if (!_root) return cend();
 	std::stack<std::pair<btree_node* const*, size_t>> path;
 	btree_node* const* node_ptr = &_root;
@@ -1298,17 +1390,86 @@ typename B_tree<tkey, tvalue, compare, t>::btree_const_iterator B_tree<tkey, tva
 	}
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-bool B_tree<tkey, tvalue, compare, t>::contains(const tkey& key) const {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+bool B_tree<tkey, tvalue, compare, t, augment>::contains(const tkey& key) const {
 	return find(key) != end();
 }
 
 // endregion lookup implementation
 
+// region order statistics implementation
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+typename B_tree<tkey, tvalue, compare, t, augment>::btree_iterator B_tree<tkey, tvalue, compare, t, augment>::select(size_t index)
+	requires counts_subtrees<augment>
+{
+	if (index >= _size) return end();
+
+	std::stack<std::pair<btree_node**, size_t>> path;
+	btree_node** ptr = &_root;
+	while (true) {
+		btree_node* node = *ptr;
+		size_t i = 0;
+		for (; i < node->_keys.size(); ++i) {
+			size_t left = node->_pointers.empty() ? 0 : node->_pointers[i]->subtree_size;
+			if (index < left) break;
+			if (index == left) {
+				path.emplace(ptr, i);
+				return btree_iterator(path, i);
+			}
+			index -= left + 1;
+		}
+		path.emplace(ptr, i);
+		ptr = &node->_pointers[i];
+	}
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+typename B_tree<tkey, tvalue, compare, t, augment>::btree_const_iterator B_tree<tkey, tvalue, compare, t, augment>::select(size_t index) const
+	requires counts_subtrees<augment>
+{
+	if (index >= _size) return cend();
+
+	std::stack<std::pair<btree_node* const*, size_t>> path;
+	btree_node* const* ptr = &_root;
+	while (true) {
+		btree_node* node = *ptr;
+		size_t i = 0;
+		for (; i < node->_keys.size(); ++i) {
+			size_t left = node->_pointers.empty() ? 0 : node->_pointers[i]->subtree_size;
+			if (index < left) break;
+			if (index == left) {
+				path.emplace(ptr, i);
+				return btree_const_iterator(path, i);
+			}
+			index -= left + 1;
+		}
+		path.emplace(ptr, i);
+		ptr = &node->_pointers[i];
+	}
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+size_t B_tree<tkey, tvalue, compare, t, augment>::rank(const tkey& key) const
+	requires counts_subtrees<augment>
+{
+	return count_less(key);
+}
+
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+size_t B_tree<tkey, tvalue, compare, t, augment>::count_range(const tkey& lower, const tkey& upper) const
+	requires counts_subtrees<augment>
+{
+	if (!compare_keys(lower, upper)) return 0;
+	return count_less(upper) - count_less(lower);
+}
+
+// endregion order statistics implementation
+
 // region modifiers implementation
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-void B_tree<tkey, tvalue, compare, t>::clear() noexcept {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+void B_tree<tkey, tvalue, compare, t, augment>::clear() noexcept {
 	if (_root) {
 		std::stack<btree_node*> nodes;
 		nodes.push(_root);
@@ -1327,12 +1488,13 @@ void B_tree<tkey, tvalue, compare, t>::clear() noexcept {
 	}
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-std::pair<typename B_tree<tkey, tvalue, compare, t>::btree_iterator, bool>
-B_tree<tkey, tvalue, compare, t>::insert(const tree_data_type& data) {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+std::pair<typename B_tree<tkey, tvalue, compare, t, augment>::btree_iterator, bool>
+B_tree<tkey, tvalue, compare, t, augment>::insert(const tree_data_type& data) {
 	if (!_root) {
 		_root = new btree_node();
 		_root->_keys.push_back(data);
+		update_augmentation(_root);
 		_size = 1;
 		return {btree_iterator(), true};
 	}
@@ -1345,6 +1507,9 @@ B_tree<tkey, tvalue, compare, t>::insert(const tree_data_type& data) {
 		while (idx < cur->_keys.size() && compare_keys(cur->_keys[idx].first, data.first)) {
 			++idx;
 		}
+		if (idx < cur->_keys.size() && !compare_keys(data.first, cur->_keys[idx].first)) {
+			return {btree_iterator(), false};
+		}
 		path_stack.push({cur, idx});
 		if (cur->_pointers.empty()) break;
 		cur = cur->_pointers[idx];
@@ -1355,11 +1520,6 @@ B_tree<tkey, tvalue, compare, t>::insert(const tree_data_type& data) {
 			keys.begin(), keys.end(), data,
 			[this](auto const& a, auto const& b) { return compare_pairs(a, b); }
 	);
-	if (it != keys.end() &&
-		!compare_keys(data.first, it->first) &&
-		!compare_keys(it->first, data.first)) {
-		return {btree_iterator(), false};
-	}
 	keys.insert(it, data);
 	++_size;
 
@@ -1367,7 +1527,12 @@ B_tree<tkey, tvalue, compare, t>::insert(const tree_data_type& data) {
 		auto [node, child_idx] = path_stack.top();
 		path_stack.pop();
 
-		if (node->_keys.size() <= maximum_keys_in_node) break;
+		if (node->_keys.size() <= maximum_keys_in_node) {
+			// subtree sizes above the leaf still grow by one, other augmentations have nothing left to fix
+			update_augmentation(node);
+			if constexpr (std::is_empty_v<typename augment::node_data>) break;
+			continue;
+		}
 
 		size_t mid = t;
 		auto mid_key = node->_keys[mid];
@@ -1385,12 +1550,15 @@ B_tree<tkey, tvalue, compare, t>::insert(const tree_data_type& data) {
 			);
 			node->_pointers.resize(mid + 1);
 		}
+		update_augmentation(node);
+		update_augmentation(right);
 
 		if (path_stack.empty()) {
 			btree_node* new_root = new btree_node();
 			new_root->_keys.push_back(mid_key);
 			new_root->_pointers.push_back(node);
 			new_root->_pointers.push_back(right);
+			update_augmentation(new_root);
 			_root = new_root;
 		} else {
 			auto [parent, ignored] = path_stack.top();
@@ -1411,22 +1579,22 @@ B_tree<tkey, tvalue, compare, t>::insert(const tree_data_type& data) {
 	return {btree_iterator(), true};
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-std::pair<typename B_tree<tkey, tvalue, compare, t>::btree_iterator, bool>
-B_tree<tkey, tvalue, compare, t>::insert(tree_data_type&& data) {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+std::pair<typename B_tree<tkey, tvalue, compare, t, augment>::btree_iterator, bool>
+B_tree<tkey, tvalue, compare, t, augment>::insert(tree_data_type&& data) {
 	return insert(data);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
 template<typename... Args>
-std::pair<typename B_tree<tkey, tvalue, compare, t>::btree_iterator, bool>
-B_tree<tkey, tvalue, compare, t>::emplace(Args&&... args) {
+std::pair<typename B_tree<tkey, tvalue, compare, t, augment>::btree_iterator, bool>
+B_tree<tkey, tvalue, compare, t, augment>::emplace(Args&&... args) {
 	return insert(tree_data_type(std::forward<Args>(args)...));
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-typename B_tree<tkey, tvalue, compare, t>::btree_iterator
-B_tree<tkey, tvalue, compare, t>::insert_or_assign(const tree_data_type& data) {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+typename B_tree<tkey, tvalue, compare, t, augment>::btree_iterator
+B_tree<tkey, tvalue, compare, t, augment>::insert_or_assign(const tree_data_type& data) {
 	auto it = find(data.first);
 	if (it != end()) {
 		it->second = data.second;
@@ -1435,9 +1603,9 @@ B_tree<tkey, tvalue, compare, t>::insert_or_assign(const tree_data_type& data) {
 	return insert(data).first;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-typename B_tree<tkey, tvalue, compare, t>::btree_iterator
-B_tree<tkey, tvalue, compare, t>::insert_or_assign(tree_data_type&& data) {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+typename B_tree<tkey, tvalue, compare, t, augment>::btree_iterator
+B_tree<tkey, tvalue, compare, t, augment>::insert_or_assign(tree_data_type&& data) {
 	auto it = find(data.first);
 	if (it != end()) {
 		it->second = std::move(data.second);
@@ -1446,81 +1614,85 @@ B_tree<tkey, tvalue, compare, t>::insert_or_assign(tree_data_type&& data) {
 	return insert(std::move(data)).first;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
 template<typename... Args>
-typename B_tree<tkey, tvalue, compare, t>::btree_iterator
-B_tree<tkey, tvalue, compare, t>::emplace_or_assign(Args&&... args) {
+typename B_tree<tkey, tvalue, compare, t, augment>::btree_iterator
+B_tree<tkey, tvalue, compare, t, augment>::emplace_or_assign(Args&&... args) {
 	return insert_or_assign(tree_data_type(std::forward<Args>(args)...));
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-typename B_tree<tkey, tvalue, compare, t>::btree_iterator
-B_tree<tkey, tvalue, compare, t>::erase(btree_iterator pos) {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+typename B_tree<tkey, tvalue, compare, t, augment>::btree_iterator
+B_tree<tkey, tvalue, compare, t, augment>::erase(btree_iterator pos) {
 	if (pos == end()) return pos;
 	tkey key = pos->first;
 	++pos;
+	if (pos == end()) {
+		erase(key);
+		return end();
+	}
+
+	// merges free nodes the iterator path points into, so the successor is looked up again
+	tkey next = pos->first;
 	erase(key);
-	return pos;
+	return find(next);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-typename B_tree<tkey, tvalue, compare, t>::btree_iterator
-B_tree<tkey, tvalue, compare, t>::erase(btree_const_iterator pos) {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+typename B_tree<tkey, tvalue, compare, t, augment>::btree_iterator
+B_tree<tkey, tvalue, compare, t, augment>::erase(btree_const_iterator pos) {
 	return erase(btree_iterator(pos));
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-typename B_tree<tkey, tvalue, compare, t>::btree_iterator
-B_tree<tkey, tvalue, compare, t>::erase(btree_iterator first, btree_iterator last) {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+typename B_tree<tkey, tvalue, compare, t, augment>::btree_iterator
+B_tree<tkey, tvalue, compare, t, augment>::erase(btree_iterator first, btree_iterator last) {
 	while (first != last) {
 		first = erase(first);
 	}
 	return last;
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-typename B_tree<tkey, tvalue, compare, t>::btree_iterator
-B_tree<tkey, tvalue, compare, t>::erase(btree_const_iterator beg, btree_const_iterator en) {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+typename B_tree<tkey, tvalue, compare, t, augment>::btree_iterator
+B_tree<tkey, tvalue, compare, t, augment>::erase(btree_const_iterator beg, btree_const_iterator en) {
 	return erase(btree_iterator(beg), btree_iterator(en));
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-typename B_tree<tkey, tvalue, compare, t>::btree_iterator
-B_tree<tkey, tvalue, compare, t>::erase(const tkey& key) {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+typename B_tree<tkey, tvalue, compare, t, augment>::btree_iterator
+B_tree<tkey, tvalue, compare, t, augment>::erase(const tkey& key) {
 	if (!_root) return end();
 
 	std::function<bool(btree_node*, const tkey&)> remove_key;
 	remove_key = [this, &remove_key](btree_node* node, const tkey& k) -> bool {
 		size_t idx = 0;
 		while (idx < node->_keys.size() && compare_keys(node->_keys[idx].first, k)) ++idx;
-		if (idx < node->_keys.size() && !compare_keys(k, node->_keys[idx].first) && !compare_keys(node->_keys[idx].first, k)) {
-			if (node->_pointers.empty()) {
-				node->_keys.erase(node->_keys.begin() + idx);
-				--_size;
-				return node->_keys.size() < minimum_keys_in_node;
-			} else {
-				btree_node* pred = node->_pointers[idx];
-				while (!pred->_pointers.empty()) pred = pred->_pointers.back();
-				auto pred_pair = pred->_keys.back();
-				node->_keys[idx] = pred_pair;
-				bool underflow = remove_key(node->_pointers[idx], pred_pair.first);
-
-				if (underflow) {
-					node->_pointers[idx]->_keys.push_back({});
-				}
-				return false;
-			}
-		}
+		bool found = idx < node->_keys.size() && !compare_keys(k, node->_keys[idx].first);
 
 		if (node->_pointers.empty()) {
+			if (!found) return false;
+			node->_keys.erase(node->_keys.begin() + idx);
+			--_size;
+			update_augmentation(node);
 			return node->_keys.size() < minimum_keys_in_node;
 		}
 
-		bool underflow = remove_key(node->_pointers[idx], k);
+		bool underflow;
+		if (found) {
+			btree_node* pred = node->_pointers[idx];
+			while (!pred->_pointers.empty()) pred = pred->_pointers.back();
+			node->_keys[idx] = pred->_keys.back();
+			underflow = remove_key(node->_pointers[idx], node->_keys[idx].first);
+		} else {
+			underflow = remove_key(node->_pointers[idx], k);
+		}
+
 		if (underflow) {
-			//borrow / merge
+			restore_child(node, idx);
 		}
-		return false;
+		update_augmentation(node);
+		return node->_keys.size() < minimum_keys_in_node;
 	};
 
 	remove_key(_root, key);
@@ -1538,15 +1710,64 @@ B_tree<tkey, tvalue, compare, t>::erase(const tkey& key) {
 	return find(key);
 }
 
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+void B_tree<tkey, tvalue, compare, t, augment>::restore_child(btree_node* parent, size_t index) {
+	btree_node* child = parent->_pointers[index];
+
+	if (index > 0 && parent->_pointers[index - 1]->_keys.size() > minimum_keys_in_node) {
+		btree_node* left = parent->_pointers[index - 1];
+		child->_keys.insert(child->_keys.begin(), std::move(parent->_keys[index - 1]));
+		parent->_keys[index - 1] = std::move(left->_keys.back());
+		left->_keys.pop_back();
+		if (!left->_pointers.empty()) {
+			child->_pointers.insert(child->_pointers.begin(), left->_pointers.back());
+			left->_pointers.pop_back();
+		}
+		update_augmentation(left);
+		update_augmentation(child);
+		return;
+	}
+
+	if (index + 1 < parent->_pointers.size() && parent->_pointers[index + 1]->_keys.size() > minimum_keys_in_node) {
+		btree_node* right = parent->_pointers[index + 1];
+		child->_keys.push_back(std::move(parent->_keys[index]));
+		parent->_keys[index] = std::move(right->_keys.front());
+		right->_keys.erase(right->_keys.begin());
+		if (!right->_pointers.empty()) {
+			child->_pointers.push_back(right->_pointers.front());
+			right->_pointers.erase(right->_pointers.begin());
+		}
+		update_augmentation(right);
+		update_augmentation(child);
+		return;
+	}
+
+	// neither sibling can spare a key, the pair and their separator fit in one node
+	if (index > 0) --index;
+	btree_node* left = parent->_pointers[index];
+	btree_node* right = parent->_pointers[index + 1];
+	left->_keys.push_back(std::move(parent->_keys[index]));
+	for (auto& data: right->_keys) {
+		left->_keys.push_back(std::move(data));
+	}
+	for (auto* pointer: right->_pointers) {
+		left->_pointers.push_back(pointer);
+	}
+	parent->_keys.erase(parent->_keys.begin() + index);
+	parent->_pointers.erase(parent->_pointers.begin() + index + 1);
+	delete right;
+	update_augmentation(left);
+}
+
 // endregion modifiers implementation
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
-bool compare_pairs(const typename B_tree<tkey, tvalue, compare, t>::tree_data_type& lhs,
-				   const typename B_tree<tkey, tvalue, compare, t>::tree_data_type& rhs) {
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
+bool compare_pairs(const typename B_tree<tkey, tvalue, compare, t, augment>::tree_data_type& lhs,
+				   const typename B_tree<tkey, tvalue, compare, t, augment>::tree_data_type& rhs) {
 	return compare()(lhs.first, rhs.first);
 }
 
-template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t>
+template<typename tkey, typename tvalue, compator<tkey> compare, std::size_t t, typename augment>
 bool compare_keys(const tkey& lhs, const tkey& rhs) {
 	return compare()(lhs, rhs);
 }
@@ -1,5 +1,6 @@
 #include "gtest/gtest.h"
 
+#include <algorithm>
 #include <list>
 #include <random>
 #include <vector>
@@ -590,6 +591,63 @@ TEST(bTreePositiveTests, test9) {
 	logger->trace("bTreePositiveTests.test9 finished");
 }
 
+TEST(bTreePositiveTests, test10)
+{
+    std::unique_ptr<logger> logger( create_logger(std::vector<std::pair<std::string, logger::severity>>
+                                                          {
+                                                                  { "b_tree_tests_logs.txt", logger::severity::trace }
+                                                          }));
+
+    logger->trace("bTreePositiveTests.test10 started");
+
+    B_tree<int, int, std::less<int>, 2, order_statistic> tree(std::less<int>(), nullptr, logger.get());
+    std::vector<int> keys;
+
+    std::mt19937 gen(7);
+    for (int i = 0; i < 400; ++i)
+    {
+        int key = static_cast<int>(gen() % 1000);
+        if (tree.insert({ key, -key }).second)
+        {
+            keys.insert(std::lower_bound(keys.begin(), keys.end(), key), key);
+        }
+    }
+
+    // erasing every other key forces borrows and merges down to a two-level tree
+    for (size_t i = 0; i < keys.size(); ++i)
+    {
+        tree.erase(keys[i]);
+        keys.erase(keys.begin() + i);
+    }
+
+    ASSERT_EQ(tree.size(), keys.size());
+    for (size_t i = 0; i < keys.size(); ++i)
+    {
+        auto it = tree.select(i);
+        ASSERT_NE(it, tree.end());
+        EXPECT_EQ(it->first, keys[i]);
+        EXPECT_EQ(it->second, -keys[i]);
+        EXPECT_EQ(tree.rank(keys[i]), i);
+        EXPECT_EQ(tree.rank(keys[i] + 1), i + 1);
+    }
+    EXPECT_EQ(tree.select(keys.size()), tree.end());
+
+    auto const &const_tree = tree;
+    EXPECT_EQ(const_tree.select(0)->first, keys.front());
+    EXPECT_EQ(tree.count_range(100, 500), static_cast<size_t>(
+        std::lower_bound(keys.begin(), keys.end(), 500) - std::lower_bound(keys.begin(), keys.end(), 100)));
+    EXPECT_EQ(tree.count_range(500, 100), 0u);
+
+    std::vector<int> actual;
+    for (auto const &item : const_tree)
+    {
+        actual.push_back(item.first);
+    }
+    EXPECT_EQ(actual, keys);
+
+    logger->trace("bTreePositiveTests.test10 finished");
+}
+
 TEST(bTreeNegativeTests, test1)
 {
     std::unique_ptr<logger> logger( create_logger(std::vector<std::pair<std::string, logger::severity>>